@@ -0,0 +1,149 @@
+#!/usr/bin/env python
+"""Create a delta patch for OTA_FEATURE_DELTA uploads, see OTADeltaPatcher in src/esphome/ota_delta.h.
+
+Usage: ota_delta.py BASE_IMAGE NEW_IMAGE PATCH
+
+BASE_IMAGE must be the exact image that is running on the node (the node sends its MD5 during the
+OTA handshake, an uploader should only send the patch if it matches). The patch is sent instead of
+NEW_IMAGE; the size and MD5 in the OTA header still describe NEW_IMAGE.
+"""
+from __future__ import print_function
+
+import argparse
+import hashlib
+import struct
+import sys
+
+MAGIC = b'EDLT'
+OP_END = 0x00
+OP_COPY = 0x01
+OP_INSERT = 0x02
+OP_ADD = 0x03
+
+# Length of the byte strings used to find matches in the base image.
+KEY_SIZE = 8
+# Shorter exact matches are cheaper as part of an insert than as a separate operation.
+MIN_MATCH = 16
+
+
+def _index(base):
+    index = {}
+    for i in range(len(base) - KEY_SIZE + 1):
+        index.setdefault(base[i:i + KEY_SIZE], i)
+    return index
+
+
+def _extend(base, new, base_pos, new_pos):
+    """Length of the exact match of base[base_pos:] and new[new_pos:]."""
+    length = 0
+    limit = min(len(base) - base_pos, len(new) - new_pos)
+    while length < limit and base[base_pos + length] == new[new_pos + length]:
+        length += 1
+    return length
+
+
+def _extend_approximate(base, new, base_pos, new_pos):
+    """Length of the best approximate match, like bsdiff: more than half of the bytes must be equal.
+
+    OP_ADD data is sent uncompressed, so the match ends before a long exact match, which is cheaper as OP_COPY.
+    """
+    best_length = 0
+    best_score = 0
+    score = 0
+    run = 0
+    limit = min(len(base) - base_pos, len(new) - new_pos)
+    for i in range(limit):
+        if base[base_pos + i] == new[new_pos + i]:
+            score += 1
+            run += 1
+            if run == 2 * MIN_MATCH and i + 1 - run > 0:
+                return min(best_length, i + 1 - run)
+        else:
+            score -= 1
+            run = 0
+        if score > best_score:
+            best_score = score
+            best_length = i + 1
+        elif score < best_score - 32:
+            break
+    return best_length
+
+
+def create_patch(base, new):
+    base = bytearray(base)
+    new = bytearray(new)
+    index = _index(bytes(base))
+    out = bytearray()
+    out += MAGIC
+    out += hashlib.md5(bytes(base)).hexdigest().encode('ascii')
+    out += struct.pack('>I', len(base))
+
+    pending = bytearray()
+
+    def flush_insert():
+        if pending:
+            out.append(OP_INSERT)
+            out.extend(struct.pack('>I', len(pending)))
+            out.extend(pending)
+            del pending[:]
+
+    pos = 0
+    # Where the base image continues after the last match; code that only moved usually continues there.
+    next_base = 0
+    while pos < len(new):
+        length = 0
+        base_pos = index.get(bytes(new[pos:pos + KEY_SIZE]))
+        if base_pos is not None:
+            length = _extend(base, new, base_pos, pos)
+        if next_base < len(base) and base_pos != next_base:
+            # Prefer continuing where the last match ended, the index only knows the first occurrence
+            continued = _extend(base, new, next_base, pos)
+            if continued >= max(length, MIN_MATCH):
+                base_pos, length = next_base, continued
+        if length < MIN_MATCH and next_base < len(base):
+            approx = _extend_approximate(base, new, next_base, pos)
+            if approx >= MIN_MATCH:
+                flush_insert()
+                out.append(OP_ADD)
+                out.extend(struct.pack('>II', next_base, approx))
+                out.extend((new[pos + i] - base[next_base + i]) & 0xFF for i in range(approx))
+                pos += approx
+                next_base += approx
+                continue
+        if length < MIN_MATCH:
+            pending.append(new[pos])
+            pos += 1
+            next_base += 1
+            continue
+
+        flush_insert()
+        out.append(OP_COPY)
+        out.extend(struct.pack('>II', base_pos, length))
+        pos += length
+        next_base = base_pos + length
+
+    flush_insert()
+    out.append(OP_END)
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Create a delta patch for ESPHome OTA updates.")
+    parser.add_argument('base', help="The image running on the node.")
+    parser.add_argument('new', help="The image to upload.")
+    parser.add_argument('patch', help="Where to write the patch.")
+    args = parser.parse_args()
+
+    with open(args.base, 'rb') as f:
+        base = f.read()
+    with open(args.new, 'rb') as f:
+        new = f.read()
+    patch = create_patch(base, new)
+    with open(args.patch, 'wb') as f:
+        f.write(patch)
+    print("Patch is {} bytes ({:.1f}% of the new image)".format(len(patch), 100.0 * len(patch) / max(len(new), 1)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
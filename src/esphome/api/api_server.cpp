@@ -225,6 +225,14 @@ const std::vector<APIServer::HomeAssistantStateSubscription> &APIServer::get_sta
 }
 uint16_t APIServer::get_port() const { return this->port_; }
 void APIServer::set_reboot_timeout(uint32_t reboot_timeout) { this->reboot_timeout_ = reboot_timeout; }
+#ifdef USE_ESP32_CAMERA
+void APIServer::set_camera_max_update_interval(uint32_t camera_max_update_interval) {
+  this->camera_max_update_interval_ = camera_max_update_interval;
+}
+uint32_t APIServer::get_camera_max_update_interval() const { return this->camera_max_update_interval_; }
+uint32_t APIServer::get_camera_dropped_images() const { return this->camera_dropped_images_; }
+uint32_t APIServer::get_camera_image_latency() const { return this->camera_image_latency_; }
+#endif
 #ifdef USE_HOMEASSISTANT_TIME
 void APIServer::request_time() {
   for (auto *client : this->clients_) {
@@ -250,6 +258,9 @@ APIConnection::APIConnection(AsyncClient *client, APIServer *parent)
   this->recv_buffer_.reserve(32);
   this->client_info_ = this->client_->remoteIP().toString().c_str();
   this->last_traffic_ = millis();
+#ifdef USE_ESP32_CAMERA
+  this->camera_max_update_interval_ = parent->get_camera_max_update_interval();
+#endif
 }
 APIConnection::~APIConnection() { delete this->client_; }
 void APIConnection::on_error_(int8_t error) {
@@ -764,6 +775,13 @@ void APIConnection::loop() {
   }
 
 #ifdef USE_ESP32_CAMERA
+  if (!this->image_reader_.available() && this->pending_image_ != nullptr &&
+      millis() - this->last_image_start_ >= this->camera_max_update_interval_) {
+    this->last_image_start_ = millis();
+    this->image_timestamp_ = this->pending_image_->get_timestamp();
+    this->image_reader_.set_image(std::move(this->pending_image_));
+    this->pending_image_.reset();
+  }
   if (this->image_reader_.available()) {
     uint32_t space = this->client_->space();
     // reserve 15 bytes for metadata, and at least 64 bytes of data
@@ -783,6 +801,10 @@ void APIConnection::loop() {
       }
       if (success && done) {
         this->image_reader_.return_image();
+        this->image_latency_ = millis() - this->image_timestamp_;
+        this->parent_->camera_image_latency_ = this->image_latency_;
+        ESP_LOGV(TAG, "Sent camera image to '%s': latency=%ums dropped=%u", this->client_info_.c_str(),
+                 this->image_latency_, this->dropped_images_);
       }
     }
   }
@@ -1171,10 +1193,15 @@ void APIConnection::send_time_request() { this->send_empty_message(APIMessageTyp
 void APIConnection::send_camera_state(std::shared_ptr<CameraImage> image) {
   if (!this->state_subscription_)
     return;
-  if (this->image_reader_.available())
-    return;
-  this->image_reader_.set_image(image);
+  // Latest wins: the image is started in loop() once the previous one is sent and the update interval passed.
+  if (this->pending_image_ != nullptr) {
+    this->dropped_images_++;
+    this->parent_->camera_dropped_images_++;
+  }
+  this->pending_image_ = std::move(image);
 }
+uint32_t APIConnection::get_dropped_images() const { return this->dropped_images_; }
+uint32_t APIConnection::get_image_latency() const { return this->image_latency_; }
 #endif
 
 #ifdef USE_ESP32_CAMERA
@@ -1182,7 +1209,10 @@ void APIConnection::on_camera_image_request_(const CameraImageRequest &req) {
   if (global_esp32_camera == nullptr)
     return;
 
-  ESP_LOGV(TAG, "on_camera_image_request_ stream=%s single=%s", YESNO(req.get_stream()), YESNO(req.get_single()));
+  ESP_LOGV(TAG, "on_camera_image_request_ stream=%s single=%s max_update_interval=%u", YESNO(req.get_stream()),
+           YESNO(req.get_single()), req.get_max_update_interval());
+  if (req.get_max_update_interval() != 0)
+    this->camera_max_update_interval_ = req.get_max_update_interval();
   if (req.get_single()) {
     global_esp32_camera->request_image();
   }
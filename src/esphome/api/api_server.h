@@ -66,6 +66,10 @@ class APIConnection {
 #endif
 #ifdef USE_ESP32_CAMERA
   void send_camera_state(std::shared_ptr<CameraImage> image);
+  /// The number of camera images replaced by a newer one before they were sent to this client.
+  uint32_t get_dropped_images() const;
+  /// Time from capture until the last chunk of the last image was sent to this client, in ms.
+  uint32_t get_image_latency() const;
 #endif
 #ifdef USE_CLIMATE
   bool send_climate_state(climate::ClimateDevice *climate);
@@ -142,6 +146,15 @@ class APIConnection {
   InitialStateIterator initial_state_iterator_;
 #ifdef USE_ESP32_CAMERA
   CameraImageReader image_reader_;
+  /// The newest image that hasn't been started yet, replaced if a newer image arrives first.
+  std::shared_ptr<CameraImage> pending_image_;
+  uint32_t image_timestamp_{0};
+  uint32_t last_image_start_{0};
+  uint32_t dropped_images_{0};
+  /// Time from capture until the last chunk of the last image was sent, in ms.
+  uint32_t image_latency_{0};
+  /// The minimum time (in ms) between two images sent to this client, see CameraImageRequest.
+  uint32_t camera_max_update_interval_{0};
 #endif
 
   bool state_subscription_{false};
@@ -166,6 +179,18 @@ class APIServer : public Component, public StoringUpdateListenerController {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+#ifdef USE_ESP32_CAMERA
+  /** Set the default minimum time (in ms) between two camera images sent to a single client.
+   *
+   * Defaults to 0 (no limit). Each client can request its own interval with CameraImageRequest.
+   */
+  void set_camera_max_update_interval(uint32_t camera_max_update_interval);
+  uint32_t get_camera_max_update_interval() const;
+  /// The number of camera images dropped for all clients since boot, because a newer image arrived first.
+  uint32_t get_camera_dropped_images() const;
+  /// The latency of the last camera image sent to any client, in ms.
+  uint32_t get_camera_image_latency() const;
+#endif
   void handle_disconnect(APIConnection *conn);
 #ifdef USE_BINARY_SENSOR
   void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override;
@@ -215,6 +240,13 @@ class APIServer : public Component, public StoringUpdateListenerController {
   AsyncServer server_{0};
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
+#ifdef USE_ESP32_CAMERA
+  friend APIConnection;
+
+  uint32_t camera_max_update_interval_{0};
+  uint32_t camera_dropped_images_{0};
+  uint32_t camera_image_latency_{0};
+#endif
   uint32_t last_connected_{0};
   std::vector<APIConnection *> clients_;
   std::string password_;
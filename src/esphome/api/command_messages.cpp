@@ -315,6 +315,7 @@ bool SwitchCommandRequest::get_state() const { return this->state_; }
 #ifdef USE_ESP32_CAMERA
 bool CameraImageRequest::get_single() const { return this->single_; }
 bool CameraImageRequest::get_stream() const { return this->stream_; }
+uint32_t CameraImageRequest::get_max_update_interval() const { return this->max_update_interval_; }
 bool CameraImageRequest::decode_varint(uint32_t field_id, uint32_t value) {
   switch (field_id) {
     case 1:
@@ -325,6 +326,10 @@ bool CameraImageRequest::decode_varint(uint32_t field_id, uint32_t value) {
       // bool stream = 2;
       this->stream_ = value;
       return true;
+    case 3:
+      // uint32 max_update_interval = 3;
+      this->max_update_interval_ = value;
+      return true;
     default:
       return false;
   }
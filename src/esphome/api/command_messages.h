@@ -127,11 +127,13 @@ class CameraImageRequest : public APIMessage {
   bool decode_varint(uint32_t field_id, uint32_t value) override;
   bool get_single() const;
   bool get_stream() const;
+  uint32_t get_max_update_interval() const;
   APIMessageType message_type() const override;
 
  protected:
   bool single_{false};
   bool stream_{false};
+  uint32_t max_update_interval_{0};
 };
 #endif
 
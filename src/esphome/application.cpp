@@ -123,6 +123,7 @@ void HOT Application::loop() {
     feed_wdt();
   }
   global_state = new_global_state;
+  global_preferences.loop();
 
   const uint32_t now = millis();
   if (HighFrequencyLoopRequester::is_high_frequency()) {
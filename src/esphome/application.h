@@ -12,6 +12,7 @@
 #include "esphome/deep_sleep_component.h"
 #include "esphome/esp32_ble_beacon.h"
 #include "esphome/esp32_ble_tracker.h"
+#include "esphome/esp32_ble_decoders.h"
 #include "esphome/esp_one_wire.h"
 #include "esphome/esphal.h"
 #include "esphome/esppreferences.h"
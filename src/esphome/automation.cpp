@@ -1,8 +1,11 @@
 #include "esphome/automation.h"
 #include "esphome/espmath.h"
+#include "esphome/log.h"
 
 ESPHOME_NAMESPACE_BEGIN
 
+static const char *TAG = "automation";
+
 void StartupTrigger::setup() { this->trigger(); }
 float StartupTrigger::get_setup_priority() const {
   // Run after everything is set up
@@ -36,7 +39,79 @@ bool RangeCondition::check(float x) {
   }
 }
 
-void Script::execute() { this->trigger(); }
-void Script::stop() { this->parent_->stop(); }
+void Script::execute() {
+  if (this->parent_ == nullptr)
+    return;
+  if (!this->finish_action_added_) {
+    // The actions are added after the automation is constructed, so the end marker is appended on the first run.
+    this->parent_->add_action(new LambdaAction<>([this]() { this->finish_(); }));
+    this->finish_action_added_ = true;
+  }
+
+  this->check_finished_();
+  if (this->running_ > 0) {
+    switch (this->mode_) {
+      case SCRIPT_MODE_SINGLE:
+        ESP_LOGW(TAG, "Script is already running, ignoring execution.");
+        return;
+      case SCRIPT_MODE_RESTART:
+        this->stop();
+        break;
+      case SCRIPT_MODE_QUEUED:
+        if (this->max_runs_ != 0 && this->queued_ + 1u >= this->max_runs_) {
+          ESP_LOGW(TAG, "Script already has %u runs, dropping execution.", this->max_runs_);
+          return;
+        }
+        this->queued_++;
+        return;
+      case SCRIPT_MODE_PARALLEL:
+      default:
+        break;
+    }
+  }
+
+  this->running_++;
+  this->trigger_run_();
+}
+void Script::stop() {
+  this->queued_ = 0;
+  this->running_ = 0;
+  if (this->parent_ != nullptr)
+    this->parent_->stop();
+}
+void Script::set_mode(ScriptMode mode) { this->mode_ = mode; }
+void Script::set_max_runs(uint16_t max_runs) { this->max_runs_ = max_runs; }
+bool Script::is_running() const {
+  // Same as check_finished_(), without forgetting the runs.
+  return this->running_ > 0 && (this->triggering_ > 0 || this->parent_->is_running());
+}
+void Script::finish_() {
+  if (this->running_ > 0)
+    this->running_--;
+  if (this->running_ == 0 && this->queued_ > 0) {
+    this->queued_--;
+    this->running_++;
+    this->trigger_run_();
+    return;
+  }
+  this->check_finished_();
+}
+void Script::trigger_run_() {
+  this->triggering_++;
+  this->trigger();
+  this->triggering_--;
+  this->check_finished_();
+}
+void Script::check_finished_() {
+  if (this->running_ == 0 || this->triggering_ > 0 || this->parent_->is_running())
+    return;
+  ESP_LOGV(TAG, "%u script runs ended without reaching the end of the actions.", this->running_);
+  this->running_ = 0;
+  if (this->queued_ > 0) {
+    this->queued_--;
+    this->running_++;
+    this->trigger_run_();
+  }
+}
 
 ESPHOME_NAMESPACE_END
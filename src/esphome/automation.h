@@ -23,6 +23,13 @@ template<typename... Ts> class Condition {
  public:
   virtual bool check(Ts... x) = 0;
 
+  /** Register a callback that is called whenever an input of this condition may have changed.
+   *
+   * @return Whether this condition can notify about all of its inputs. If not (for example for lambdas),
+   *         users of this condition have to re-evaluate it periodically.
+   */
+  virtual bool subscribe(std::function<void()> &&callback);
+
   bool check_tuple(const std::tuple<Ts...> &tuple);
 
  protected:
@@ -33,6 +40,7 @@ template<typename... Ts> class AndCondition : public Condition<Ts...> {
  public:
   explicit AndCondition(const std::vector<Condition<Ts...> *> &conditions);
   bool check(Ts... x) override;
+  bool subscribe(std::function<void()> &&callback) override;
 
  protected:
   std::vector<Condition<Ts...> *> conditions_;
@@ -42,6 +50,7 @@ template<typename... Ts> class OrCondition : public Condition<Ts...> {
  public:
   explicit OrCondition(const std::vector<Condition<Ts...> *> &conditions);
   bool check(Ts... x) override;
+  bool subscribe(std::function<void()> &&callback) override;
 
  protected:
   std::vector<Condition<Ts...> *> conditions_;
@@ -112,7 +121,17 @@ class IntervalTrigger : public Trigger<>, public PollingComponent {
 template<typename... Ts> class ScriptExecuteAction;
 template<typename... Ts> class ScriptStopAction;
 
-template<typename... Ts> class ScriptStopAction;
+/// What a script does when it's executed while it's already running.
+enum ScriptMode {
+  /// Ignore the execution.
+  SCRIPT_MODE_SINGLE = 0,
+  /// Stop the running script and start it again.
+  SCRIPT_MODE_RESTART,
+  /// Start the script again once the running one is done.
+  SCRIPT_MODE_QUEUED,
+  /// Start the script right away, the runs are executed alongside each other.
+  SCRIPT_MODE_PARALLEL,
+};
 
 class Script : public Trigger<> {
  public:
@@ -120,9 +139,38 @@ class Script : public Trigger<> {
 
   void stop();
 
+  /// Set the run mode of this script, defaults to SCRIPT_MODE_PARALLEL.
+  void set_mode(ScriptMode mode);
+  /// The maximum number of runs (running and queued) with SCRIPT_MODE_QUEUED, 0 for no limit.
+  void set_max_runs(uint16_t max_runs);
+
+  /// Whether a run of this script hasn't reached the end of the actions yet.
+  bool is_running() const;
+
   template<typename... Ts> ScriptExecuteAction<Ts...> *make_execute_action();
 
   template<typename... Ts> ScriptStopAction<Ts...> *make_stop_action();
+
+ protected:
+  /// Called at the end of the actions of each run.
+  void finish_();
+  /// Trigger a run that's already counted in running_.
+  void trigger_run_();
+  /** Forget runs that ended without reaching the end of the actions.
+   *
+   * An action can drop a run, for example a while action that's already looping ignores the run. Once no run
+   * is being executed and no action holds a pending run anymore, all counted runs are over.
+   */
+  void check_finished_();
+
+  ScriptMode mode_{SCRIPT_MODE_PARALLEL};
+  uint16_t max_runs_{0};
+  /// The number of runs that haven't reached the end of the actions yet.
+  uint16_t running_{0};
+  uint16_t queued_{0};
+  /// The depth of runs that are being executed right now (the actions are played synchronously).
+  uint8_t triggering_{0};
+  bool finish_action_added_{false};
 };
 
 template<typename... Ts> class ActionList;
@@ -133,6 +181,8 @@ template<typename... Ts> class Action {
   void play_next(Ts... x);
   virtual void stop();
   void stop_next();
+  /// Whether this action or one of the next actions holds a run that continues later (for example in a delay).
+  virtual bool is_running() const;
 
   void play_next_tuple(const std::tuple<Ts...> &tuple);
 
@@ -150,12 +200,26 @@ template<typename... Ts> class DelayAction : public Action<Ts...>, public Compon
 
   template<typename V> void set_delay(V value) { this->delay_ = value; }
   void stop() override;
+  bool is_running() const override;
 
   void play(Ts... x) override;
+  void loop() override;
   float get_setup_priority() const override;
 
  protected:
+  /// A run of the automation that's waiting in this delay, with the arguments it continues with.
+  struct PendingRun {
+    uint32_t start;
+    uint32_t delay;
+    std::tuple<Ts...> args;
+    bool active;
+  };
+
   TemplatableValue<uint32_t, Ts...> delay_{0};
+  /// Each run waits in its own slot, so triggering again doesn't affect earlier runs. Slots are reused.
+  std::vector<PendingRun> runs_;
+  /// The number of runs that are being continued with the next actions right now.
+  uint16_t continuing_{0};
 };
 
 template<typename... Ts> class LambdaAction : public Action<Ts...> {
@@ -179,6 +243,8 @@ template<typename... Ts> class IfAction : public Action<Ts...> {
 
   void stop() override;
 
+  bool is_running() const override;
+
  protected:
   std::vector<Condition<Ts...> *> conditions_;
   ActionList<Ts...> then_;
@@ -195,28 +261,57 @@ template<typename... Ts> class WhileAction : public Action<Ts...> {
 
   void stop() override;
 
+  bool is_running() const override;
+
  protected:
   std::vector<Condition<Ts...> *> conditions_;
   ActionList<Ts...> then_;
   bool is_running_{false};
 };
 
+/** Wait until all conditions are true, then continue with the next action.
+ *
+ * If all conditions can subscribe to their inputs, they're only re-evaluated after one of the inputs
+ * changed, otherwise on every loop() iteration. With a wait timeout the next action is executed after
+ * that time even if the conditions are still false.
+ */
 template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Component {
  public:
   WaitUntilAction(const std::vector<Condition<Ts...> *> &conditions);
 
+  template<typename V> void set_wait_timeout(V value) { this->wait_timeout_ = value; }
+
   void play(Ts... x) override;
 
   void stop() override;
 
+  bool is_running() const override;
+
   void loop() override;
 
   float get_setup_priority() const override;
 
  protected:
+  /// A run of the automation that's waiting for the conditions, with the arguments it continues with.
+  struct PendingRun {
+    uint32_t start;
+    uint32_t timeout;
+    std::tuple<Ts...> args;
+    bool active;
+  };
+
+  bool check_conditions_(const std::tuple<Ts...> &args);
+
   std::vector<Condition<Ts...> *> conditions_;
-  bool triggered_{false};
-  std::tuple<Ts...> var_{};
+  TemplatableValue<uint32_t, Ts...> wait_timeout_{0};
+  /// Whether all conditions notify us about changes of their inputs.
+  bool event_driven_{true};
+  /// Whether an input changed since the conditions were last evaluated.
+  bool dirty_{false};
+  /// Each run waits in its own slot, like with DelayAction. Slots are reused.
+  std::vector<PendingRun> runs_;
+  /// The number of runs that are being continued with the next actions right now.
+  uint16_t continuing_{0};
 };
 
 template<typename... Ts> class UpdateComponentAction : public Action<Ts...> {
@@ -255,6 +350,7 @@ template<typename... Ts> class ActionList {
   void play(Ts... x);
   void stop();
   bool empty() const;
+  bool is_running() const;
 
  protected:
   Action<Ts...> *actions_begin_{nullptr};
@@ -275,6 +371,9 @@ template<typename... Ts> class Automation {
 
   void trigger(Ts... x);
 
+  /// Whether an action of this automation holds a run that continues later.
+  bool is_running() const;
+
  protected:
   Trigger<Ts...> *trigger_;
   std::vector<Condition<Ts...> *> conditions_;
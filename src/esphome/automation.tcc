@@ -10,6 +10,7 @@ template<int... S>
 bool Condition<Ts...>::check_tuple_(const std::tuple<Ts...> &tuple, seq<S...>) {
   return this->check(std::get<S>(tuple)...);
 }
+template<typename... Ts> bool Condition<Ts...>::subscribe(std::function<void()> &&callback) { return false; }
 
 template<typename... Ts> bool AndCondition<Ts...>::check(Ts... x) {
   for (auto *condition : this->conditions_) {
@@ -20,6 +21,15 @@ template<typename... Ts> bool AndCondition<Ts...>::check(Ts... x) {
   return true;
 }
 
+template<typename... Ts> bool AndCondition<Ts...>::subscribe(std::function<void()> &&callback) {
+  bool all = true;
+  for (auto *condition : this->conditions_) {
+    std::function<void()> f = callback;
+    all &= condition->subscribe(std::move(f));
+  }
+  return all;
+}
+
 template<typename... Ts>
 AndCondition<Ts...>::AndCondition(const std::vector<Condition<Ts...> *> &conditions) : conditions_(conditions) {}
 
@@ -32,6 +42,15 @@ template<typename... Ts> bool OrCondition<Ts...>::check(Ts... x) {
   return false;
 }
 
+template<typename... Ts> bool OrCondition<Ts...>::subscribe(std::function<void()> &&callback) {
+  bool all = true;
+  for (auto *condition : this->conditions_) {
+    std::function<void()> f = callback;
+    all &= condition->subscribe(std::move(f));
+  }
+  return all;
+}
+
 template<typename... Ts>
 OrCondition<Ts...>::OrCondition(const std::vector<Condition<Ts...> *> &conditions) : conditions_(conditions) {}
 template<typename... Ts> void Trigger<Ts...>::set_parent(Automation<Ts...> *parent) { this->parent_ = parent; }
@@ -58,6 +77,9 @@ template<typename... Ts> void Action<Ts...>::stop_next() {
     this->next_->stop();
   }
 }
+template<typename... Ts> bool Action<Ts...>::is_running() const {
+  return this->next_ != nullptr && this->next_->is_running();
+}
 template<typename... Ts> void Action<Ts...>::play_next_tuple(const std::tuple<Ts...> &tuple) {
   this->play_next_tuple_(tuple, typename gens<sizeof...(Ts)>::type());
 }
@@ -70,14 +92,45 @@ void Action<Ts...>::play_next_tuple_(const std::tuple<Ts...> &tuple, seq<S...>)
 template<typename... Ts> DelayAction<Ts...>::DelayAction() = default;
 
 template<typename... Ts> void DelayAction<Ts...>::play(Ts... x) {
-  auto f = std::bind(&DelayAction<Ts...>::play_next, this, x...);
-  this->set_timeout(this->delay_.value(x...), f);
+  const uint32_t delay = this->delay_.value(x...);
+  for (auto &run : this->runs_) {
+    if (!run.active) {
+      run.start = millis();
+      run.delay = delay;
+      run.args = std::make_tuple(x...);
+      run.active = true;
+      return;
+    }
+  }
+  this->runs_.push_back(PendingRun{millis(), delay, std::make_tuple(x...), true});
+}
+template<typename... Ts> void DelayAction<Ts...>::loop() {
+  // Index based, the next actions can start new runs of this delay (and grow runs_).
+  for (size_t i = 0; i < this->runs_.size(); i++) {
+    if (!this->runs_[i].active || millis() - this->runs_[i].start < this->runs_[i].delay)
+      continue;
+    this->runs_[i].active = false;
+    const std::tuple<Ts...> args = this->runs_[i].args;
+    this->continuing_++;
+    this->play_next_tuple(args);
+    this->continuing_--;
+  }
 }
 template<typename... Ts> float DelayAction<Ts...>::get_setup_priority() const { return setup_priority::HARDWARE; }
 template<typename... Ts> void DelayAction<Ts...>::stop() {
-  this->cancel_timeout("");
+  for (auto &run : this->runs_)
+    run.active = false;
   this->stop_next();
 }
+template<typename... Ts> bool DelayAction<Ts...>::is_running() const {
+  if (this->continuing_ > 0)
+    return true;
+  for (auto &run : this->runs_) {
+    if (run.active)
+      return true;
+  }
+  return Action<Ts...>::is_running();
+}
 
 template<typename... Ts> Condition<Ts...> *Automation<Ts...>::add_condition(Condition<Ts...> *condition) {
   this->conditions_.push_back(condition);
@@ -92,7 +145,7 @@ template<typename... Ts> Automation<Ts...>::Automation(Trigger<Ts...> *trigger)
   this->trigger_->set_parent(this);
 }
 template<typename... Ts> Action<Ts...> *Automation<Ts...>::add_action(Action<Ts...> *action) {
-  this->actions_.add_action(action);
+  return this->actions_.add_action(action);
 }
 template<typename... Ts> void Automation<Ts...>::add_actions(const std::vector<Action<Ts...> *> &actions) {
   this->actions_.add_actions(actions);
@@ -106,6 +159,7 @@ template<typename... Ts> void Automation<Ts...>::trigger(Ts... x) {
   this->actions_.play(x...);
 }
 template<typename... Ts> void Automation<Ts...>::stop() { this->actions_.stop(); }
+template<typename... Ts> bool Automation<Ts...>::is_running() const { return this->actions_.is_running(); }
 template<typename... Ts> LambdaCondition<Ts...>::LambdaCondition(std::function<bool(Ts...)> &&f) : f_(std::move(f)) {}
 template<typename... Ts> bool LambdaCondition<Ts...>::check(Ts... x) { return this->f_(x...); }
 
@@ -137,6 +191,9 @@ template<typename... Ts> void ActionList<Ts...>::stop() {
     this->actions_begin_->stop();
 }
 template<typename... Ts> bool ActionList<Ts...>::empty() const { return this->actions_begin_ == nullptr; }
+template<typename... Ts> bool ActionList<Ts...>::is_running() const {
+  return this->actions_begin_ != nullptr && this->actions_begin_->is_running();
+}
 template<typename... Ts>
 IfAction<Ts...>::IfAction(const std::vector<Condition<Ts...> *> conditions) : conditions_(conditions) {}
 template<typename... Ts> void IfAction<Ts...>::play(Ts... x) {
@@ -174,6 +231,9 @@ template<typename... Ts> void IfAction<Ts...>::stop() {
   this->else_.stop();
   this->stop_next();
 }
+template<typename... Ts> bool IfAction<Ts...>::is_running() const {
+  return this->then_.is_running() || this->else_.is_running() || Action<Ts...>::is_running();
+}
 
 template<typename... Ts> void UpdateComponentAction<Ts...>::play(Ts... x) {
   this->component_->update();
@@ -186,7 +246,7 @@ UpdateComponentAction<Ts...>::UpdateComponentAction(PollingComponent *component)
 template<typename... Ts> ScriptExecuteAction<Ts...>::ScriptExecuteAction(Script *script) : script_(script) {}
 
 template<typename... Ts> void ScriptExecuteAction<Ts...>::play(Ts... x) {
-  this->script_->trigger();
+  this->script_->execute();
   this->play_next(x...);
 }
 
@@ -261,30 +321,74 @@ template<typename... Ts> void WhileAction<Ts...>::stop() {
   this->is_running_ = false;
   this->stop_next();
 }
+template<typename... Ts> bool WhileAction<Ts...>::is_running() const {
+  return this->is_running_ || this->then_.is_running() || Action<Ts...>::is_running();
+}
 
 template<typename... Ts>
-WaitUntilAction<Ts...>::WaitUntilAction(const std::vector<Condition<Ts...> *> &conditions) : conditions_(conditions) {}
+WaitUntilAction<Ts...>::WaitUntilAction(const std::vector<Condition<Ts...> *> &conditions) : conditions_(conditions) {
+  for (auto *condition : this->conditions_) {
+    if (!condition->subscribe([this]() { this->dirty_ = true; }))
+      this->event_driven_ = false;
+  }
+}
 template<typename... Ts> void WaitUntilAction<Ts...>::play(Ts... x) {
-  this->var_ = std::make_tuple(x...);
-  this->triggered_ = true;
-  this->loop();
+  auto args = std::make_tuple(x...);
+  if (this->check_conditions_(args)) {
+    this->play_next(x...);
+    return;
+  }
+
+  const uint32_t timeout = this->wait_timeout_.value(x...);
+  for (auto &run : this->runs_) {
+    if (!run.active) {
+      run.start = millis();
+      run.timeout = timeout;
+      run.args = args;
+      run.active = true;
+      return;
+    }
+  }
+  this->runs_.push_back(PendingRun{millis(), timeout, args, true});
 }
 template<typename... Ts> void WaitUntilAction<Ts...>::stop() {
-  this->triggered_ = false;
+  for (auto &run : this->runs_)
+    run.active = false;
   this->stop_next();
 }
+template<typename... Ts> bool WaitUntilAction<Ts...>::is_running() const {
+  if (this->continuing_ > 0)
+    return true;
+  for (auto &run : this->runs_) {
+    if (run.active)
+      return true;
+  }
+  return Action<Ts...>::is_running();
+}
 template<typename... Ts> void WaitUntilAction<Ts...>::loop() {
-  if (!this->triggered_)
-    return;
+  const bool check = !this->event_driven_ || this->dirty_;
+  this->dirty_ = false;
 
+  // Index based, the next actions can start new runs of this action (and grow runs_).
+  for (size_t i = 0; i < this->runs_.size(); i++) {
+    if (!this->runs_[i].active)
+      continue;
+    const bool timed_out = this->runs_[i].timeout != 0 && millis() - this->runs_[i].start >= this->runs_[i].timeout;
+    if (!timed_out && (!check || !this->check_conditions_(this->runs_[i].args)))
+      continue;
+    this->runs_[i].active = false;
+    const std::tuple<Ts...> args = this->runs_[i].args;
+    this->continuing_++;
+    this->play_next_tuple(args);
+    this->continuing_--;
+  }
+}
+template<typename... Ts> bool WaitUntilAction<Ts...>::check_conditions_(const std::tuple<Ts...> &args) {
   for (auto *condition : this->conditions_) {
-    if (!condition->check_tuple(this->var_)) {
-      return;
-    }
+    if (!condition->check_tuple(args))
+      return false;
   }
-
-  this->triggered_ = false;
-  this->play_next_tuple(this->var_);
+  return true;
 }
 template<typename... Ts> float WaitUntilAction<Ts...>::get_setup_priority() const {
   return setup_priority::HARDWARE_LATE;
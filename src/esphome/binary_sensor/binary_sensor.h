@@ -202,6 +202,7 @@ template<typename... Ts> class BinarySensorCondition : public Condition<Ts...> {
  public:
   BinarySensorCondition(BinarySensor *parent, bool state, uint32_t for_time = 0);
   bool check(Ts... x) override;
+  bool subscribe(std::function<void()> &&callback) override;
 
  protected:
   BinarySensor *parent_;
@@ -232,6 +233,13 @@ template<typename... Ts> bool BinarySensorCondition<Ts...>::check(Ts... x) {
 
   return millis() - this->last_state_time_ >= this->for_time_;
 }
+template<typename... Ts> bool BinarySensorCondition<Ts...>::subscribe(std::function<void()> &&callback) {
+  // With a for time the condition becomes true without a state change, so it needs to be polled.
+  if (this->for_time_ != 0)
+    return false;
+  this->parent_->add_on_state_callback([callback](bool state) { callback(); });
+  return true;
+}
 
 template<typename... Ts>
 BinarySensorCondition<Ts...> *BinarySensor::make_binary_sensor_is_on_condition(uint32_t for_time) {
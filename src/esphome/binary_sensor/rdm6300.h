@@ -25,8 +25,9 @@ class RDM6300Component : public Component, public UARTDevice {
   float get_setup_priority() const override;
 
  protected:
-  int8_t read_state_{-1};
-  uint8_t buffer_[6];
+  void parse_frame_(const uint8_t *data);
+
+  UARTFrameReader frame_reader_;
   std::vector<RDM6300BinarySensor *> cards_;
   uint32_t last_id_{0};
 };
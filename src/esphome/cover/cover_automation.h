@@ -101,6 +101,10 @@ template<typename... Ts> class CoverIsOpenCondition : public Condition<Ts...> {
  public:
   CoverIsOpenCondition(Cover *cover) : cover_(cover) {}
   bool check(Ts... x) override { return this->cover_->is_fully_open(); }
+  bool subscribe(std::function<void()> &&callback) override {
+    this->cover_->add_on_state_callback(std::move(callback));
+    return true;
+  }
 
  protected:
   Cover *cover_;
@@ -109,6 +113,10 @@ template<typename... Ts> class CoverIsClosedCondition : public Condition<Ts...>
  public:
   CoverIsClosedCondition(Cover *cover) : cover_(cover) {}
   bool check(Ts... x) override { return this->cover_->is_fully_closed(); }
+  bool subscribe(std::function<void()> &&callback) override {
+    this->cover_->add_on_state_callback(std::move(callback));
+    return true;
+  }
 
  protected:
   Cover *cover_;
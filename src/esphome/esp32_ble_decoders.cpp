@@ -0,0 +1,371 @@
+#include "esphome/defines.h"
+
+#ifdef USE_ESP32_BLE_TRACKER
+
+#include "esphome/esp32_ble_decoders.h"
+#include "esphome/log.h"
+
+#include <algorithm>
+
+ESPHOME_NAMESPACE_BEGIN
+
+// bt_trace.h
+#undef TAG
+
+static const char *TAG = "esp32_ble_tracker";
+
+enum XiaomiDataType {
+  XIAOMI_NO_DATA = 0,
+  XIAOMI_TEMPERATURE_HUMIDITY,
+  XIAOMI_TEMPERATURE,
+  XIAOMI_HUMIDITY,
+  XIAOMI_BATTERY_LEVEL,
+  XIAOMI_CONDUCTIVITY,
+  XIAOMI_ILLUMINANCE,
+  XIAOMI_MOISTURE,
+};
+
+static XiaomiDataType parse_xiaomi(uint8_t data_type, const uint8_t *data, uint8_t data_length, float *data1,
+                                   float *data2) {
+  switch (data_type) {
+    case 0x0D: {  // temperature+humidity, 4 bytes, 16-bit signed integer (LE) each, 0.1 °C, 0.1 %
+      if (data_length != 4)
+        return XIAOMI_NO_DATA;
+      const int16_t temperature = uint16_t(data[0]) | (uint16_t(data[1]) << 8);
+      const int16_t humidity = uint16_t(data[2]) | (uint16_t(data[3]) << 8);
+      *data1 = temperature / 10.0f;
+      *data2 = humidity / 10.0f;
+      return XIAOMI_TEMPERATURE_HUMIDITY;
+    }
+    case 0x0A: {  // battery, 1 byte, 8-bit unsigned integer, 1 %
+      if (data_length != 1)
+        return XIAOMI_NO_DATA;
+      *data1 = data[0];
+      return XIAOMI_BATTERY_LEVEL;
+    }
+    case 0x06: {  // humidity, 2 bytes, 16-bit signed integer (LE), 0.1 %
+      if (data_length != 2)
+        return XIAOMI_NO_DATA;
+      const int16_t humidity = uint16_t(data[0]) | (uint16_t(data[1]) << 8);
+      *data1 = humidity / 10.0f;
+      return XIAOMI_HUMIDITY;
+    }
+    case 0x04: {  // temperature, 2 bytes, 16-bit signed integer (LE), 0.1 °C
+      if (data_length != 2)
+        return XIAOMI_NO_DATA;
+      const int16_t temperature = uint16_t(data[0]) | (uint16_t(data[1]) << 8);
+      *data1 = temperature / 10.0f;
+      return XIAOMI_TEMPERATURE;
+    }
+    case 0x09: {  // conductivity, 2 bytes, 16-bit unsigned integer (LE), 1 µS/cm
+      if (data_length != 2)
+        return XIAOMI_NO_DATA;
+      const uint16_t conductivity = uint16_t(data[0]) | (uint16_t(data[1]) << 8);
+      *data1 = conductivity;
+      return XIAOMI_CONDUCTIVITY;
+    }
+    case 0x07: {  // illuminance, 3 bytes, 24-bit unsigned integer (LE), 1 lx
+      if (data_length != 3)
+        return XIAOMI_NO_DATA;
+      const uint32_t illuminance = uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16);
+      *data1 = illuminance;
+      return XIAOMI_ILLUMINANCE;
+    }
+    case 0x08: {  // soil moisture, 1 byte, 8-bit unsigned integer, 1 %
+      if (data_length != 1)
+        return XIAOMI_NO_DATA;
+      *data1 = data[0];
+      return XIAOMI_MOISTURE;
+    }
+    default:
+      return XIAOMI_NO_DATA;
+  }
+}
+
+void XiaomiDecoder::add_device(XiaomiDevice *device) { this->devices_.emplace(device->get_address(), device); }
+void XiaomiDecoder::decode(const ESPBTDevice &device, const ESPBTDataView &service_data) {
+  const auto *raw = service_data.data;
+
+  if (service_data.length < 14) {
+    ESP_LOGVV(TAG, "Xiaomi service data too short!");
+    return;
+  }
+
+  bool is_mijia = (raw[1] & 0x20) == 0x20 && raw[2] == 0xAA && raw[3] == 0x01;
+  bool is_miflora = (raw[1] & 0x20) == 0x20 && raw[2] == 0x98 && raw[3] == 0x00;
+
+  if (!is_mijia && !is_miflora) {
+    ESP_LOGVV(TAG, "Xiaomi no magic bytes");
+    return;
+  }
+
+  const char *type = is_mijia ? "MiJia" : "MiFlora";
+  uint8_t raw_offset = is_mijia ? 11 : 12;
+
+  const uint8_t raw_type = raw[raw_offset];
+  const uint8_t data_length = raw[raw_offset + 2];
+  const uint8_t *data = &raw[raw_offset + 3];
+  const uint8_t expected_length = data_length + raw_offset + 3;
+  const uint8_t actual_length = service_data.length;
+  if (expected_length != actual_length) {
+    ESP_LOGV(TAG, "Xiaomi %s data length mismatch (%u != %d)", type, expected_length, actual_length);
+    return;
+  }
+  float data1, data2;
+  XiaomiDataType data_type = parse_xiaomi(raw_type, data, data_length, &data1, &data2);
+  if (data_type == XIAOMI_NO_DATA)
+    return;
+
+  std::string address_str = device.address_str();
+  switch (data_type) {
+    case XIAOMI_TEMPERATURE_HUMIDITY:
+      ESP_LOGD(TAG, "Xiaomi %s %s Got temperature=%.1f°C, humidity=%.1f%%", type, address_str.c_str(), data1, data2);
+      break;
+    case XIAOMI_TEMPERATURE:
+      ESP_LOGD(TAG, "Xiaomi %s %s Got temperature=%.1f°C", type, address_str.c_str(), data1);
+      break;
+    case XIAOMI_HUMIDITY:
+      ESP_LOGD(TAG, "Xiaomi %s %s Got humidity=%.1f%%", type, address_str.c_str(), data1);
+      break;
+    case XIAOMI_BATTERY_LEVEL:
+      ESP_LOGD(TAG, "Xiaomi %s %s Got battery level=%.0f%%", type, address_str.c_str(), data1);
+      break;
+    case XIAOMI_MOISTURE:
+      ESP_LOGD(TAG, "Xiaomi %s %s Got moisture=%.0f%%", type, address_str.c_str(), data1);
+      break;
+    case XIAOMI_ILLUMINANCE:
+      ESP_LOGD(TAG, "Xiaomi %s %s Got illuminance=%.0flx", type, address_str.c_str(), data1);
+      break;
+    case XIAOMI_CONDUCTIVITY:
+      ESP_LOGD(TAG, "Xiaomi %s %s Got soil conductivity=%.0fµS/cm", type, address_str.c_str(), data1);
+      break;
+    default:
+      break;
+  }
+
+  auto range = this->devices_.equal_range(device.address_uint64());
+  for (auto it = range.first; it != range.second; ++it) {
+    XiaomiDevice *dev = it->second;
+    switch (data_type) {
+      case XIAOMI_TEMPERATURE_HUMIDITY:
+        if (dev->get_temperature_sensor() != nullptr)
+          dev->get_temperature_sensor()->publish_state(data1);
+        if (dev->get_humidity_sensor() != nullptr)
+          dev->get_humidity_sensor()->publish_state(data2);
+        break;
+      case XIAOMI_HUMIDITY:
+        if (dev->get_humidity_sensor() != nullptr)
+          dev->get_humidity_sensor()->publish_state(data1);
+        break;
+      case XIAOMI_BATTERY_LEVEL:
+        if (dev->get_battery_level_sensor() != nullptr)
+          dev->get_battery_level_sensor()->publish_state(data1);
+        break;
+      case XIAOMI_TEMPERATURE:
+        if (dev->get_temperature_sensor() != nullptr)
+          dev->get_temperature_sensor()->publish_state(data1);
+        break;
+      case XIAOMI_MOISTURE:
+        if (dev->get_moisture_sensor() != nullptr)
+          dev->get_moisture_sensor()->publish_state(data1);
+        break;
+      case XIAOMI_ILLUMINANCE:
+        if (dev->get_illuminance_sensor() != nullptr)
+          dev->get_illuminance_sensor()->publish_state(data1);
+        break;
+      case XIAOMI_CONDUCTIVITY:
+        if (dev->get_conductivity_sensor() != nullptr)
+          dev->get_conductivity_sensor()->publish_state(data1);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+static int16_t ble_read_int16_be(const uint8_t *data) { return int16_t((uint16_t(data[0]) << 8) | data[1]); }
+static uint16_t ble_read_uint16_be(const uint8_t *data) { return (uint16_t(data[0]) << 8) | data[1]; }
+static std::string ble_address_to_string(uint64_t address) {
+  char buffer[18];
+  sprintf(buffer, "%02X:%02X:%02X:%02X:%02X:%02X", uint8_t(address >> 40), uint8_t(address >> 32),
+          uint8_t(address >> 24), uint8_t(address >> 16), uint8_t(address >> 8), uint8_t(address));
+  return buffer;
+}
+
+RuuviDevice::RuuviDevice(ESP32BLETracker *parent, uint64_t address) : parent_(parent), address_(address) {}
+RuuviTemperatureSensor *RuuviDevice::make_temperature_sensor(const std::string &name) {
+  return this->temperature_sensor_ = new RuuviTemperatureSensor(name, this);
+}
+RuuviHumiditySensor *RuuviDevice::make_humidity_sensor(const std::string &name) {
+  return this->humidity_sensor_ = new RuuviHumiditySensor(name, this);
+}
+RuuviPressureSensor *RuuviDevice::make_pressure_sensor(const std::string &name) {
+  return this->pressure_sensor_ = new RuuviPressureSensor(name, this);
+}
+RuuviBatteryVoltageSensor *RuuviDevice::make_battery_voltage_sensor(const std::string &name) {
+  return this->battery_voltage_sensor_ = new RuuviBatteryVoltageSensor(name, this);
+}
+uint64_t RuuviDevice::get_address() const { return this->address_; }
+uint32_t RuuviDevice::get_update_interval() const { return this->parent_->get_scan_interval() * 1000u; }
+
+void RuuviDecoder::add_device(RuuviDevice *device) { this->devices_.emplace(device->get_address(), device); }
+void RuuviDecoder::decode(const ESPBTDevice &device, const ESPBTDataView &manufacturer_data) {
+  auto range = this->devices_.equal_range(device.address_uint64());
+  if (range.first == range.second || manufacturer_data.empty())
+    return;
+
+  const uint8_t *data = manufacturer_data.data;
+  float temperature, humidity, pressure, battery_voltage;
+  switch (data[0]) {
+    case 0x03: {  // RAWv1
+      if (manufacturer_data.length < 14)
+        return;
+      humidity = data[1] / 2.0f;
+      // sign and magnitude, integer part and hundredths
+      temperature = (data[2] & 0x7F) + data[3] / 100.0f;
+      if (data[2] & 0x80)
+        temperature = -temperature;
+      pressure = (ble_read_uint16_be(data + 4) + 50000) / 100.0f;
+      battery_voltage = ble_read_uint16_be(data + 12) / 1000.0f;
+      break;
+    }
+    case 0x05: {  // RAWv2
+      if (manufacturer_data.length < 24)
+        return;
+      // The maximum values (minimum for the signed temperature) mean "not available"
+      const int16_t temperature_raw = ble_read_int16_be(data + 1);
+      const uint16_t humidity_raw = ble_read_uint16_be(data + 3);
+      const uint16_t pressure_raw = ble_read_uint16_be(data + 5);
+      const uint16_t battery_raw = ble_read_uint16_be(data + 13) >> 5;
+      temperature = temperature_raw == INT16_MIN ? NAN : temperature_raw * 0.005f;
+      humidity = humidity_raw == 0xFFFF ? NAN : humidity_raw * 0.0025f;
+      pressure = pressure_raw == 0xFFFF ? NAN : (pressure_raw + 50000) / 100.0f;
+      battery_voltage = battery_raw == 0x7FF ? NAN : (battery_raw + 1600) / 1000.0f;
+      break;
+    }
+    default:
+      ESP_LOGV(TAG, "Ruuvi unsupported data format %u", data[0]);
+      return;
+  }
+
+  ESP_LOGD(TAG, "Ruuvi %s Got temperature=%.2f°C, humidity=%.1f%%, pressure=%.2fhPa, battery=%.3fV",
+           device.address_str().c_str(), temperature, humidity, pressure, battery_voltage);
+  for (auto it = range.first; it != range.second; ++it) {
+    RuuviDevice *dev = it->second;
+    if (dev->temperature_sensor_ != nullptr && !isnan(temperature))
+      dev->temperature_sensor_->publish_state(temperature);
+    if (dev->humidity_sensor_ != nullptr && !isnan(humidity))
+      dev->humidity_sensor_->publish_state(humidity);
+    if (dev->pressure_sensor_ != nullptr && !isnan(pressure))
+      dev->pressure_sensor_->publish_state(pressure);
+    if (dev->battery_voltage_sensor_ != nullptr && !isnan(battery_voltage))
+      dev->battery_voltage_sensor_->publish_state(battery_voltage);
+  }
+}
+void RuuviDecoder::dump_config() {
+  for (auto &entry : this->devices_) {
+    RuuviDevice *dev = entry.second;
+    ESP_LOGCONFIG(TAG, "  RuuviTag %s", ble_address_to_string(dev->get_address()).c_str());
+    LOG_SENSOR("    ", "Temperature", dev->temperature_sensor_);
+    LOG_SENSOR("    ", "Humidity", dev->humidity_sensor_);
+    LOG_SENSOR("    ", "Pressure", dev->pressure_sensor_);
+    LOG_SENSOR("    ", "Battery Voltage", dev->battery_voltage_sensor_);
+  }
+}
+
+ESP32BLEIBeaconPresence::ESP32BLEIBeaconPresence(const std::string &name, std::array<uint8_t, 16> uuid,
+                                                 int32_t major, int32_t minor)
+    : BinarySensor(name), uuid_(uuid), major_(major), minor_(minor) {}
+std::string ESP32BLEIBeaconPresence::device_class() { return "presence"; }
+
+void IBeaconDecoder::add_presence_sensor(ESP32BLEIBeaconPresence *sensor) { this->presence_sensors_.push_back(sensor); }
+void IBeaconDecoder::decode(const ESPBTDevice &device, const ESPBTDataView &manufacturer_data) {
+  // type 0x02, length 0x15, proximity UUID, major, minor, measured power
+  const uint8_t *data = manufacturer_data.data;
+  if (manufacturer_data.length < 23 || data[0] != 0x02 || data[1] != 0x15)
+    return;
+  const uint8_t *uuid = data + 2;
+  const uint16_t major = ble_read_uint16_be(data + 18);
+  const uint16_t minor = ble_read_uint16_be(data + 20);
+  ESP_LOGV(TAG, "iBeacon %s major=%u minor=%u RSSI=%d", device.address_str().c_str(), major, minor,
+           device.get_rssi());
+
+  for (auto *sensor : this->presence_sensors_) {
+    if (sensor->seen_ || !std::equal(sensor->uuid_.begin(), sensor->uuid_.end(), uuid))
+      continue;
+    if ((sensor->major_ != -1 && sensor->major_ != major) || (sensor->minor_ != -1 && sensor->minor_ != minor))
+      continue;
+    sensor->seen_ = true;
+    sensor->publish_state(true);
+  }
+}
+void IBeaconDecoder::on_scan_start() {
+  for (auto *sensor : this->presence_sensors_) {
+    if (!sensor->seen_)
+      sensor->publish_state(false);
+    sensor->seen_ = false;
+  }
+}
+void IBeaconDecoder::dump_config() {
+  for (auto *sensor : this->presence_sensors_) {
+    LOG_BINARY_SENSOR("  ", "iBeacon Presence", sensor);
+    char uuid[37];
+    const uint8_t *u = sensor->uuid_.data();
+    sprintf(uuid, "%02X%02X%02X%02X-%02X%02X-%02X%02X-%02X%02X-%02X%02X%02X%02X%02X%02X", u[0], u[1], u[2], u[3],
+            u[4], u[5], u[6], u[7], u[8], u[9], u[10], u[11], u[12], u[13], u[14], u[15]);
+    ESP_LOGCONFIG(TAG, "    UUID: %s", uuid);
+    if (sensor->major_ != -1) {
+      ESP_LOGCONFIG(TAG, "    Major: %d", sensor->major_);
+    }
+    if (sensor->minor_ != -1) {
+      ESP_LOGCONFIG(TAG, "    Minor: %d", sensor->minor_);
+    }
+  }
+}
+
+EddystoneDevice::EddystoneDevice(ESP32BLETracker *parent, uint64_t address) : parent_(parent), address_(address) {}
+EddystoneTemperatureSensor *EddystoneDevice::make_temperature_sensor(const std::string &name) {
+  return this->temperature_sensor_ = new EddystoneTemperatureSensor(name, this);
+}
+EddystoneBatteryVoltageSensor *EddystoneDevice::make_battery_voltage_sensor(const std::string &name) {
+  return this->battery_voltage_sensor_ = new EddystoneBatteryVoltageSensor(name, this);
+}
+uint64_t EddystoneDevice::get_address() const { return this->address_; }
+uint32_t EddystoneDevice::get_update_interval() const { return this->parent_->get_scan_interval() * 1000u; }
+
+void EddystoneDecoder::add_device(EddystoneDevice *device) { this->devices_.emplace(device->get_address(), device); }
+void EddystoneDecoder::decode(const ESPBTDevice &device, const ESPBTDataView &service_data) {
+  // frame type 0x20 TLM, version 0x00 (unencrypted), battery voltage, temperature, advertisement count, uptime
+  const uint8_t *data = service_data.data;
+  if (service_data.length < 14 || data[0] != 0x20 || data[1] != 0x00)
+    return;
+  auto range = this->devices_.equal_range(device.address_uint64());
+  if (range.first == range.second)
+    return;
+
+  const uint16_t battery_mv = ble_read_uint16_be(data + 2);
+  const int16_t temperature_raw = ble_read_int16_be(data + 4);
+  ESP_LOGD(TAG, "Eddystone %s Got battery=%umV, temperature=%.1f°C", device.address_str().c_str(), battery_mv,
+           temperature_raw / 256.0f);
+
+  for (auto it = range.first; it != range.second; ++it) {
+    EddystoneDevice *dev = it->second;
+    // 0 and 0x8000 mean not supported
+    if (dev->battery_voltage_sensor_ != nullptr && battery_mv != 0)
+      dev->battery_voltage_sensor_->publish_state(battery_mv / 1000.0f);
+    if (dev->temperature_sensor_ != nullptr && uint16_t(temperature_raw) != 0x8000)
+      dev->temperature_sensor_->publish_state(temperature_raw / 256.0f);
+  }
+}
+void EddystoneDecoder::dump_config() {
+  for (auto &entry : this->devices_) {
+    EddystoneDevice *dev = entry.second;
+    ESP_LOGCONFIG(TAG, "  Eddystone %s", ble_address_to_string(dev->get_address()).c_str());
+    LOG_SENSOR("    ", "Temperature", dev->temperature_sensor_);
+    LOG_SENSOR("    ", "Battery Voltage", dev->battery_voltage_sensor_);
+  }
+}
+
+ESPHOME_NAMESPACE_END
+
+#endif  // USE_ESP32_BLE_TRACKER
@@ -0,0 +1,153 @@
+#ifndef ESPHOME_ESP32_BLE_DECODERS_H
+#define ESPHOME_ESP32_BLE_DECODERS_H
+
+#include "esphome/defines.h"
+
+#ifdef USE_ESP32_BLE_TRACKER
+
+#include "esphome/esp32_ble_tracker.h"
+#include "esphome/binary_sensor/binary_sensor.h"
+#include "esphome/sensor/sensor.h"
+
+#include <array>
+#include <unordered_map>
+
+ESPHOME_NAMESPACE_BEGIN
+
+/// Decodes the service data of Xiaomi MiJia and MiFlora sensors.
+class XiaomiDecoder : public ESPBTAdvDecoder {
+ public:
+  static const uint16_t SERVICE_UUID = 0xFE95;
+
+  void add_device(XiaomiDevice *device);
+
+  void decode(const ESPBTDevice &device, const ESPBTDataView &data) override;
+
+ protected:
+  std::unordered_multimap<uint64_t, XiaomiDevice *> devices_;
+};
+
+using RuuviTemperatureSensor = sensor::EmptyPollingParentSensor<2, sensor::ICON_EMPTY, sensor::UNIT_C, RuuviDevice>;
+using RuuviHumiditySensor =
+    sensor::EmptyPollingParentSensor<1, sensor::ICON_WATER_PERCENT, sensor::UNIT_PERCENT, RuuviDevice>;
+using RuuviPressureSensor = sensor::EmptyPollingParentSensor<2, sensor::ICON_GAUGE, sensor::UNIT_HPA, RuuviDevice>;
+using RuuviBatteryVoltageSensor =
+    sensor::EmptyPollingParentSensor<3, sensor::ICON_BATTERY, sensor::UNIT_V, RuuviDevice>;
+
+/// A RuuviTag, its values are decoded from the RAWv1 (3) and RAWv2 (5) data formats.
+class RuuviDevice {
+ public:
+  RuuviDevice(ESP32BLETracker *parent, uint64_t address);
+
+  RuuviTemperatureSensor *make_temperature_sensor(const std::string &name);
+  RuuviHumiditySensor *make_humidity_sensor(const std::string &name);
+  RuuviPressureSensor *make_pressure_sensor(const std::string &name);
+  RuuviBatteryVoltageSensor *make_battery_voltage_sensor(const std::string &name);
+
+  uint64_t get_address() const;
+  uint32_t get_update_interval() const;
+
+ protected:
+  friend RuuviDecoder;
+
+  ESP32BLETracker *parent_;
+  uint64_t address_;
+  RuuviTemperatureSensor *temperature_sensor_{nullptr};
+  RuuviHumiditySensor *humidity_sensor_{nullptr};
+  RuuviPressureSensor *pressure_sensor_{nullptr};
+  RuuviBatteryVoltageSensor *battery_voltage_sensor_{nullptr};
+};
+
+/// Decodes the manufacturer data of RuuviTags.
+class RuuviDecoder : public ESPBTAdvDecoder {
+ public:
+  static const uint16_t COMPANY_ID = 0x0499;
+
+  void add_device(RuuviDevice *device);
+
+  void decode(const ESPBTDevice &device, const ESPBTDataView &data) override;
+
+  void dump_config() override;
+
+ protected:
+  std::unordered_multimap<uint64_t, RuuviDevice *> devices_;
+};
+
+/// A binary sensor that is on while an iBeacon with a proximity UUID (and optionally major/minor) is seen.
+class ESP32BLEIBeaconPresence : public binary_sensor::BinarySensor {
+ public:
+  ESP32BLEIBeaconPresence(const std::string &name, std::array<uint8_t, 16> uuid, int32_t major, int32_t minor);
+
+ protected:
+  friend IBeaconDecoder;
+
+  std::string device_class() override;
+
+  std::array<uint8_t, 16> uuid_;
+  int32_t major_;
+  int32_t minor_;
+  bool seen_{false};
+};
+
+/// Decodes iBeacon frames in the manufacturer data of Apple (company ID 0x004C).
+class IBeaconDecoder : public ESPBTAdvDecoder {
+ public:
+  static const uint16_t COMPANY_ID = 0x004C;
+
+  void add_presence_sensor(ESP32BLEIBeaconPresence *sensor);
+
+  void decode(const ESPBTDevice &device, const ESPBTDataView &data) override;
+
+  void on_scan_start() override;
+
+  void dump_config() override;
+
+ protected:
+  std::vector<ESP32BLEIBeaconPresence *> presence_sensors_;
+};
+
+using EddystoneTemperatureSensor =
+    sensor::EmptyPollingParentSensor<1, sensor::ICON_EMPTY, sensor::UNIT_C, EddystoneDevice>;
+using EddystoneBatteryVoltageSensor =
+    sensor::EmptyPollingParentSensor<3, sensor::ICON_BATTERY, sensor::UNIT_V, EddystoneDevice>;
+
+/// An Eddystone beacon, its values are decoded from the unencrypted telemetry (TLM) frames.
+class EddystoneDevice {
+ public:
+  EddystoneDevice(ESP32BLETracker *parent, uint64_t address);
+
+  EddystoneTemperatureSensor *make_temperature_sensor(const std::string &name);
+  EddystoneBatteryVoltageSensor *make_battery_voltage_sensor(const std::string &name);
+
+  uint64_t get_address() const;
+  uint32_t get_update_interval() const;
+
+ protected:
+  friend EddystoneDecoder;
+
+  ESP32BLETracker *parent_;
+  uint64_t address_;
+  EddystoneTemperatureSensor *temperature_sensor_{nullptr};
+  EddystoneBatteryVoltageSensor *battery_voltage_sensor_{nullptr};
+};
+
+/// Decodes the service data of Eddystone beacons.
+class EddystoneDecoder : public ESPBTAdvDecoder {
+ public:
+  static const uint16_t SERVICE_UUID = 0xFEAA;
+
+  void add_device(EddystoneDevice *device);
+
+  void decode(const ESPBTDevice &device, const ESPBTDataView &data) override;
+
+  void dump_config() override;
+
+ protected:
+  std::unordered_multimap<uint64_t, EddystoneDevice *> devices_;
+};
+
+ESPHOME_NAMESPACE_END
+
+#endif  // USE_ESP32_BLE_TRACKER
+
+#endif  // ESPHOME_ESP32_BLE_DECODERS_H
@@ -0,0 +1,94 @@
+#include "esphome/defines.h"
+
+#ifdef USE_ESP32_BLE_TRACKER
+
+#include "esphome/esp32_ble_mac_table.h"
+
+ESPHOME_NAMESPACE_BEGIN
+
+size_t ESPBTMacTable::hash_(uint64_t address) {
+  // 64-bit finalizer of MurmurHash3, MAC addresses of one vendor share the upper bytes
+  address ^= address >> 33;
+  address *= 0xFF51AFD7ED558CCDULL;
+  address ^= address >> 33;
+  return address & (CAPACITY - 1);
+}
+size_t ESPBTMacTable::find_(uint64_t address) const {
+  size_t index = hash_(address);
+  for (size_t i = 0; i < CAPACITY; i++) {
+    const uint64_t entry = this->entries_[index];
+    if (entry == 0 || (entry & ADDRESS_MASK) == address)
+      return index;
+    index = (index + 1) & (CAPACITY - 1);
+  }
+  return CAPACITY;
+}
+uint16_t ESPBTMacTable::age_(size_t index) const { return this->generation_ - uint16_t(this->entries_[index] >> 48); }
+void ESPBTMacTable::erase_(size_t index) {
+  size_t next = index;
+  while (true) {
+    next = (next + 1) & (CAPACITY - 1);
+    const uint64_t entry = this->entries_[next];
+    if (entry == 0)
+      break;
+    // The entry can stay if its home slot is cyclically in (index, next]
+    const size_t home = hash_(entry & ADDRESS_MASK);
+    if (index <= next ? (index < home && home <= next) : (index < home || home <= next))
+      continue;
+    this->entries_[index] = entry;
+    index = next;
+  }
+  this->entries_[index] = 0;
+  this->size_--;
+}
+void ESPBTMacTable::evict_(uint16_t max_age) {
+  for (size_t i = 0; i < CAPACITY;) {
+    // Erasing shifts the next entry into this slot, so check it again
+    if (this->entries_[i] != 0 && this->age_(i) >= max_age) {
+      this->erase_(i);
+    } else {
+      i++;
+    }
+  }
+}
+void ESPBTMacTable::next_scan() {
+  this->generation_++;
+  if (this->generation_ == 0) {
+    // Ages can't be computed across the wrap around, forget everything
+    for (auto &entry : this->entries_)
+      entry = 0;
+    this->size_ = 0;
+    this->generation_ = 1;
+    return;
+  }
+  this->evict_(MAX_AGE);
+}
+bool ESPBTMacTable::mark_seen(uint64_t address) {
+  address &= ADDRESS_MASK;
+  size_t index = this->find_(address);
+  if (index != CAPACITY && this->entries_[index] != 0) {
+    const bool first = this->age_(index) != 0;
+    this->entries_[index] = address | (uint64_t(this->generation_) << 48);
+    return first;
+  }
+
+  // Keep the load factor below 3/4 so that probe sequences stay short
+  if (this->size_ >= CAPACITY / 4 * 3) {
+    this->evict_(1);
+    if (this->size_ >= CAPACITY / 4 * 3)
+      return true;
+    index = this->find_(address);
+  }
+  this->entries_[index] = address | (uint64_t(this->generation_) << 48);
+  this->size_++;
+  return true;
+}
+bool ESPBTMacTable::seen_in_current_scan(uint64_t address) const {
+  const size_t index = this->find_(address & ADDRESS_MASK);
+  return index != CAPACITY && this->entries_[index] != 0 && this->age_(index) == 0;
+}
+size_t ESPBTMacTable::size() const { return this->size_; }
+
+ESPHOME_NAMESPACE_END
+
+#endif  // USE_ESP32_BLE_TRACKER
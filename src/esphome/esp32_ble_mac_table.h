@@ -0,0 +1,64 @@
+#ifndef ESPHOME_ESP32_BLE_MAC_TABLE_H
+#define ESPHOME_ESP32_BLE_MAC_TABLE_H
+
+#include "esphome/defines.h"
+
+#ifdef USE_ESP32_BLE_TRACKER
+
+#include <cstddef>
+#include <cstdint>
+
+ESPHOME_NAMESPACE_BEGIN
+
+/** A fixed-capacity open-addressing set of MAC addresses that remembers the scan an address was last seen in.
+ *
+ * Used to find out whether a device was already discovered during the current scan without a linear search
+ * and without allocating memory while scanning. Addresses that haven't been seen for MAX_AGE scans are
+ * forgotten when the next scan starts.
+ */
+class ESPBTMacTable {
+ public:
+  /// The number of slots, must be a power of two.
+  static const size_t CAPACITY = 512;
+  /// The number of scans an address is remembered after it was last seen.
+  static const uint16_t MAX_AGE = 4;
+
+  /// Start a new scan, forgetting all addresses that haven't been seen for MAX_AGE scans.
+  void next_scan();
+
+  /** Mark an address as seen in the current scan.
+   *
+   * If the current scan alone fills the table, new addresses aren't remembered and are reported each time.
+   *
+   * @return Whether this is the first time the address has been seen in the current scan.
+   */
+  bool mark_seen(uint64_t address);
+
+  /// Whether the address has been seen in the current scan.
+  bool seen_in_current_scan(uint64_t address) const;
+
+  size_t size() const;
+
+ protected:
+  static const uint64_t ADDRESS_MASK = 0xFFFFFFFFFFFFULL;
+
+  static size_t hash_(uint64_t address);
+  /// Find the slot holding the address or the empty slot where it would be inserted.
+  size_t find_(uint64_t address) const;
+  uint16_t age_(size_t index) const;
+  /// Remove the entry at index, shifting back following entries of the probe sequence.
+  void erase_(size_t index);
+  /// Remove all entries at least max_age scans old.
+  void evict_(uint16_t max_age);
+
+  /// The address in the lower 48 bits and the scan generation it was last seen in the upper 16 bits, 0 if empty.
+  uint64_t entries_[CAPACITY]{};
+  uint16_t generation_{1};
+  size_t size_{0};
+};
+
+ESPHOME_NAMESPACE_END
+
+#endif  // USE_ESP32_BLE_TRACKER
+
+#endif  // ESPHOME_ESP32_BLE_MAC_TABLE_H
@@ -3,6 +3,7 @@
 #ifdef USE_ESP32_BLE_TRACKER
 
 #include "esphome/esp32_ble_tracker.h"
+#include "esphome/esp32_ble_decoders.h"
 #include <nvs_flash.h>
 #include <freertos/FreeRTOSConfig.h>
 #include <esp_bt_main.h>
@@ -10,6 +11,7 @@
 #include <freertos/task.h>
 #include <esp_gap_ble_api.h>
 #include <esp_bt_defs.h>
+#include <algorithm>
 #include "esphome/log.h"
 
 ESPHOME_NAMESPACE_BEGIN
@@ -36,6 +38,7 @@ ESP32BLEPresenceDevice *ESP32BLETracker::make_presence_sensor(const std::string
   uint64_t addr = ble_addr_to_uint64(address.cbegin());
   auto *dev = new ESP32BLEPresenceDevice(name, addr);
   this->presence_sensors_.push_back(dev);
+  this->listeners_[addr].presence_sensors.push_back(dev);
   return dev;
 }
 
@@ -43,6 +46,7 @@ ESP32BLERSSISensor *ESP32BLETracker::make_rssi_sensor(const std::string &name, s
   uint64_t addr = ble_addr_to_uint64(address.cbegin());
   auto *dev = new ESP32BLERSSISensor(this, name, addr);
   this->rssi_sensors_.push_back(dev);
+  this->listeners_[addr].rssi_sensors.push_back(dev);
   return dev;
 }
 
@@ -50,11 +54,100 @@ XiaomiDevice *ESP32BLETracker::make_xiaomi_device(std::array<uint8_t, 6> address
   uint64_t addr = ble_addr_to_uint64(address.cbegin());
   auto *dev = new XiaomiDevice(this, addr);
   this->xiaomi_devices_.push_back(dev);
+  if (this->xiaomi_decoder_ == nullptr) {
+    this->xiaomi_decoder_ = new XiaomiDecoder();
+    this->register_service_data_decoder(XiaomiDecoder::SERVICE_UUID, this->xiaomi_decoder_);
+  }
+  this->xiaomi_decoder_->add_device(dev);
+  return dev;
+}
+
+RuuviDevice *ESP32BLETracker::make_ruuvi_device(std::array<uint8_t, 6> address) {
+  auto *dev = new RuuviDevice(this, ble_addr_to_uint64(address.cbegin()));
+  if (this->ruuvi_decoder_ == nullptr) {
+    this->ruuvi_decoder_ = new RuuviDecoder();
+    this->register_manufacturer_decoder(RuuviDecoder::COMPANY_ID, this->ruuvi_decoder_);
+  }
+  this->ruuvi_decoder_->add_device(dev);
+  return dev;
+}
+
+ESP32BLEIBeaconPresence *ESP32BLETracker::make_ibeacon_presence_sensor(const std::string &name,
+                                                                       std::array<uint8_t, 16> uuid, int32_t major,
+                                                                       int32_t minor) {
+  auto *dev = new ESP32BLEIBeaconPresence(name, uuid, major, minor);
+  if (this->ibeacon_decoder_ == nullptr) {
+    this->ibeacon_decoder_ = new IBeaconDecoder();
+    this->register_manufacturer_decoder(IBeaconDecoder::COMPANY_ID, this->ibeacon_decoder_);
+  }
+  this->ibeacon_decoder_->add_presence_sensor(dev);
+  return dev;
+}
+
+EddystoneDevice *ESP32BLETracker::make_eddystone_device(std::array<uint8_t, 6> address) {
+  auto *dev = new EddystoneDevice(this, ble_addr_to_uint64(address.cbegin()));
+  if (this->eddystone_decoder_ == nullptr) {
+    this->eddystone_decoder_ = new EddystoneDecoder();
+    this->register_service_data_decoder(EddystoneDecoder::SERVICE_UUID, this->eddystone_decoder_);
+  }
+  this->eddystone_decoder_->add_device(dev);
   return dev;
 }
 
+enum ESPBTDecoderKey {
+  DECODER_KEY_MANUFACTURER = 1,
+  DECODER_KEY_SERVICE_DATA = 2,
+};
+
+void ESP32BLETracker::register_manufacturer_decoder(uint16_t company_id, ESPBTAdvDecoder *decoder) {
+  this->register_decoder_((DECODER_KEY_MANUFACTURER << 16) | company_id, decoder);
+}
+void ESP32BLETracker::register_service_data_decoder(uint16_t uuid, ESPBTAdvDecoder *decoder) {
+  this->register_decoder_((DECODER_KEY_SERVICE_DATA << 16) | uuid, decoder);
+}
+void ESP32BLETracker::register_decoder_(uint32_t key, ESPBTAdvDecoder *decoder) {
+  this->decoders_[key].push_back(decoder);
+  if (std::find(this->decoder_list_.begin(), this->decoder_list_.end(), decoder) == this->decoder_list_.end())
+    this->decoder_list_.push_back(decoder);
+}
+void ESP32BLETracker::dispatch_decoders_(const ESPBTDevice &device) {
+  if (this->decoders_.empty())
+    return;
+
+  const ESPBTDataView &adv_data = device.get_adv_data_view();
+  ESPBTAdvParser parser(adv_data.data, adv_data.length);
+  ESPBTAdvRecord record{};
+  while (parser.next(&record)) {
+    uint32_t key;
+    if (record.type == ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE && record.data.length >= 2) {
+      key = DECODER_KEY_MANUFACTURER << 16;
+    } else if (record.type == ESP_BLE_AD_TYPE_SERVICE_DATA && record.data.length >= 2) {
+      key = DECODER_KEY_SERVICE_DATA << 16;
+    } else {
+      continue;
+    }
+    // Company IDs and 16-bit UUIDs are little endian
+    key |= uint16_t(record.data.data[0]) | (uint16_t(record.data.data[1]) << 8);
+
+    auto it = this->decoders_.find(key);
+    if (it == this->decoders_.end())
+      continue;
+    const ESPBTDataView payload{record.data.data + 2, uint8_t(record.data.length - 2)};
+    for (auto *decoder : it->second)
+      decoder->decode(device, payload);
+  }
+}
+
+void ESPBTAdvDecoder::on_scan_start() {}
+void ESPBTAdvDecoder::dump_config() {}
+
 void ESP32BLETracker::setup() {
   global_esp32_ble_tracker = this;
+  if (this->xiaomi_decoder_ == nullptr) {
+    // Always decode Xiaomi sensors so that their MAC addresses and values show up in the logs
+    this->xiaomi_decoder_ = new XiaomiDecoder();
+    this->register_service_data_decoder(XiaomiDecoder::SERVICE_UUID, this->xiaomi_decoder_);
+  }
   this->scan_result_lock_ = xSemaphoreCreateMutex();
   this->scan_end_lock_ = xSemaphoreCreateMutex();
 
@@ -83,12 +176,17 @@ void ESP32BLETracker::loop() {
       ESPBTDevice device;
       device.parse_scan_rst(this->scan_result_buffer_[i]);
 
-      this->parse_rssi_sensors_(device);
-      this->parse_xiaomi_sensors_(device);
+      const Listeners *listeners = nullptr;
+      auto it = this->listeners_.find(device.address_uint64());
+      if (it != this->listeners_.end())
+        listeners = &it->second;
+
+      this->parse_rssi_sensors_(device, listeners);
+      this->dispatch_decoders_(device);
 
       if (this->parse_already_discovered_(device))
         continue;
-      this->parse_presence_sensors_(device);
+      this->parse_presence_sensors_(device, listeners);
     }
 
     if (xSemaphoreTake(this->scan_result_lock_, 10L / portTICK_PERIOD_MS)) {
@@ -164,10 +262,12 @@ void ESP32BLETracker::start_scan(bool first) {
 
   ESP_LOGD(TAG, "Starting scan...");
   for (auto *device : this->presence_sensors_) {
-    if (!this->has_already_discovered_(device->address_))
+    if (!this->discovered_.seen_in_current_scan(device->address_))
       device->publish_state(false);
   }
-  this->already_discovered_.clear();
+  this->discovered_.next_scan();
+  for (auto *decoder : this->decoder_list_)
+    decoder->on_scan_start();
 
   this->scan_params_.scan_type = BLE_SCAN_TYPE_ACTIVE;
   this->scan_params_.own_addr_type = BLE_ADDR_TYPE_PUBLIC;
@@ -221,211 +321,19 @@ void ESP32BLETracker::gap_scan_result(const esp_ble_gap_cb_param_t::ble_scan_res
   }
 }
 
-bool ESP32BLETracker::has_already_discovered_(uint64_t address) {
-  for (auto addr : this->already_discovered_) {
-    if (addr == address) {
-      return true;
-    }
-  }
-  return false;
-}
-
-void ESP32BLETracker::parse_rssi_sensors_(const ESPBTDevice &device) {
-  const uint64_t address = device.address_uint64();
-  int rssi = device.get_rssi();
-  for (auto *dev : this->rssi_sensors_) {
-    if (dev->address_ == address)
-      dev->publish_state(rssi);
-  }
-}
-
-enum XiaomiDataType {
-  XIAOMI_NO_DATA = 0,
-  XIAOMI_TEMPERATURE_HUMIDITY,
-  XIAOMI_TEMPERATURE,
-  XIAOMI_HUMIDITY,
-  XIAOMI_BATTERY_LEVEL,
-  XIAOMI_CONDUCTIVITY,
-  XIAOMI_ILLUMINANCE,
-  XIAOMI_MOISTURE,
-};
-
-XiaomiDataType parse_xiaomi(uint8_t data_type, const uint8_t *data, uint8_t data_length, float *data1, float *data2) {
-  switch (data_type) {
-    case 0x0D: {  // temperature+humidity, 4 bytes, 16-bit signed integer (LE) each, 0.1 °C, 0.1 %
-      if (data_length != 4)
-        return XIAOMI_NO_DATA;
-      const int16_t temperature = uint16_t(data[0]) | (uint16_t(data[1]) << 8);
-      const int16_t humidity = uint16_t(data[2]) | (uint16_t(data[3]) << 8);
-      *data1 = temperature / 10.0f;
-      *data2 = humidity / 10.0f;
-      return XIAOMI_TEMPERATURE_HUMIDITY;
-    }
-    case 0x0A: {  // battery, 1 byte, 8-bit unsigned integer, 1 %
-      if (data_length != 1)
-        return XIAOMI_NO_DATA;
-      *data1 = data[0];
-      return XIAOMI_BATTERY_LEVEL;
-    }
-    case 0x06: {  // humidity, 2 bytes, 16-bit signed integer (LE), 0.1 %
-      if (data_length != 2)
-        return XIAOMI_NO_DATA;
-      const int16_t humidity = uint16_t(data[0]) | (uint16_t(data[1]) << 8);
-      *data1 = humidity / 10.0f;
-      return XIAOMI_HUMIDITY;
-    }
-    case 0x04: {  // temperature, 2 bytes, 16-bit signed integer (LE), 0.1 °C
-      if (data_length != 2)
-        return XIAOMI_NO_DATA;
-      const int16_t temperature = uint16_t(data[0]) | (uint16_t(data[1]) << 8);
-      *data1 = temperature / 10.0f;
-      return XIAOMI_TEMPERATURE;
-    }
-    case 0x09: {  // conductivity, 2 bytes, 16-bit unsigned integer (LE), 1 µS/cm
-      if (data_length != 2)
-        return XIAOMI_NO_DATA;
-      const uint16_t conductivity = uint16_t(data[0]) | (uint16_t(data[1]) << 8);
-      *data1 = conductivity;
-      return XIAOMI_CONDUCTIVITY;
-    }
-    case 0x07: {  // illuminance, 3 bytes, 24-bit unsigned integer (LE), 1 lx
-      if (data_length != 3)
-        return XIAOMI_NO_DATA;
-      const uint32_t illuminance = uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16);
-      *data1 = illuminance;
-      return XIAOMI_ILLUMINANCE;
-    }
-    case 0x08: {  // soil moisture, 1 byte, 8-bit unsigned integer, 1 %
-      if (data_length != 1)
-        return XIAOMI_NO_DATA;
-      *data1 = data[0];
-      return XIAOMI_MOISTURE;
-    }
-    default:
-      return XIAOMI_NO_DATA;
-  }
-}
-
-void ESP32BLETracker::parse_xiaomi_sensors_(const ESPBTDevice &device) {
-  const uint64_t address = device.address_uint64();
-
-  if (!device.get_service_data_uuid().has_value()) {
-    ESP_LOGVV(TAG, "Xiaomi no service data");
-    return;
-  }
-
-  if (!device.get_service_data_uuid()->contains(0x95, 0xFE)) {
-    ESP_LOGVV(TAG, "Xiaomi no service data UUID magic bytes");
-    return;
-  }
-
-  const auto *raw = reinterpret_cast<const uint8_t *>(device.get_service_data().data());
-
-  if (device.get_service_data().size() < 14) {
-    ESP_LOGVV(TAG, "Xiaomi service data too short!");
-    return;
-  }
-
-  bool is_mijia = (raw[1] & 0x20) == 0x20 && raw[2] == 0xAA && raw[3] == 0x01;
-  bool is_miflora = (raw[1] & 0x20) == 0x20 && raw[2] == 0x98 && raw[3] == 0x00;
-
-  if (!is_mijia && !is_miflora) {
-    ESP_LOGVV(TAG, "Xiaomi no magic bytes");
-    return;
-  }
-
-  const char *type = is_mijia ? "MiJia" : "MiFlora";
-  uint8_t raw_offset = is_mijia ? 11 : 12;
-
-  const uint8_t raw_type = raw[raw_offset];
-  const uint8_t data_length = raw[raw_offset + 2];
-  const uint8_t *data = &raw[raw_offset + 3];
-  const uint8_t expected_length = data_length + raw_offset + 3;
-  const uint8_t actual_length = device.get_service_data().size();
-  if (expected_length != actual_length) {
-    ESP_LOGV(TAG, "Xiaomi %s data length mismatch (%u != %d)", type, expected_length, actual_length);
-    return;
-  }
-  float data1, data2;
-  XiaomiDataType data_type = parse_xiaomi(raw_type, data, data_length, &data1, &data2);
-  if (data_type == XIAOMI_NO_DATA)
+void ESP32BLETracker::parse_rssi_sensors_(const ESPBTDevice &device, const Listeners *listeners) {
+  if (listeners == nullptr)
     return;
-
-  std::string address_str = device.address_str();
-  switch (data_type) {
-    case XIAOMI_TEMPERATURE_HUMIDITY:
-      ESP_LOGD(TAG, "Xiaomi %s %s Got temperature=%.1f°C, humidity=%.1f%%", type, address_str.c_str(), data1, data2);
-      break;
-    case XIAOMI_TEMPERATURE:
-      ESP_LOGD(TAG, "Xiaomi %s %s Got temperature=%.1f°C", type, address_str.c_str(), data1);
-      break;
-    case XIAOMI_HUMIDITY:
-      ESP_LOGD(TAG, "Xiaomi %s %s Got humidity=%.1f%%", type, address_str.c_str(), data1);
-      break;
-    case XIAOMI_BATTERY_LEVEL:
-      ESP_LOGD(TAG, "Xiaomi %s %s Got battery level=%.0f%%", type, address_str.c_str(), data1);
-      break;
-    case XIAOMI_MOISTURE:
-      ESP_LOGD(TAG, "Xiaomi %s %s Got moisture=%.0f%%", type, address_str.c_str(), data1);
-      break;
-    case XIAOMI_ILLUMINANCE:
-      ESP_LOGD(TAG, "Xiaomi %s %s Got illuminance=%.0flx", type, address_str.c_str(), data1);
-      break;
-    case XIAOMI_CONDUCTIVITY:
-      ESP_LOGD(TAG, "Xiaomi %s %s Got soil conductivity=%.0fµS/cm", type, address_str.c_str(), data1);
-      break;
-    default:
-      break;
-  }
-
-  for (auto *dev : this->xiaomi_devices_) {
-    if (dev->address_ == address) {
-      switch (data_type) {
-        case XIAOMI_TEMPERATURE_HUMIDITY:
-          if (dev->get_temperature_sensor() != nullptr)
-            dev->get_temperature_sensor()->publish_state(data1);
-          if (dev->get_humidity_sensor() != nullptr)
-            dev->get_humidity_sensor()->publish_state(data2);
-          break;
-        case XIAOMI_HUMIDITY:
-          if (dev->get_humidity_sensor() != nullptr)
-            dev->get_humidity_sensor()->publish_state(data1);
-          break;
-        case XIAOMI_BATTERY_LEVEL:
-          if (dev->get_battery_level_sensor() != nullptr)
-            dev->get_battery_level_sensor()->publish_state(data1);
-          break;
-        case XIAOMI_TEMPERATURE:
-          if (dev->get_temperature_sensor() != nullptr)
-            dev->get_temperature_sensor()->publish_state(data1);
-          break;
-        case XIAOMI_MOISTURE:
-          if (dev->get_moisture_sensor() != nullptr)
-            dev->get_moisture_sensor()->publish_state(data1);
-          break;
-        case XIAOMI_ILLUMINANCE:
-          if (dev->get_illuminance_sensor() != nullptr)
-            dev->get_illuminance_sensor()->publish_state(data1);
-          break;
-        case XIAOMI_CONDUCTIVITY:
-          if (dev->get_conductivity_sensor() != nullptr)
-            dev->get_conductivity_sensor()->publish_state(data1);
-          break;
-        default:
-          break;
-      }
-    }
-  }
+  int rssi = device.get_rssi();
+  for (auto *dev : listeners->rssi_sensors)
+    dev->publish_state(rssi);
 }
 
 bool ESP32BLETracker::parse_already_discovered_(const ESPBTDevice &device) {
-  const uint64_t address = device.address_uint64();
-  // O(N^2), but won't be called that often anyway and this is probably better with memory allocation
-  if (this->has_already_discovered_(address)) {
+  if (!this->discovered_.mark_seen(device.address_uint64())) {
     ESP_LOGV(TAG, "Already discovered device %s", device.address_str().c_str());
     return true;
   }
-  this->already_discovered_.push_back(address);
 
 #ifdef ESPHOME_LOG_HAS_DEBUG
   ESP_LOGD(TAG, "Found device %s RSSI=%d", device.address_str().c_str(), device.get_rssi());
@@ -450,7 +358,7 @@ bool ESP32BLETracker::parse_already_discovered_(const ESPBTDevice &device) {
   }
 
   ESP_LOGD(TAG, "  Address Type: %s", address_type_s);
-  if (!device.get_name().empty())
+  if (!device.get_name_view().empty())
     ESP_LOGD(TAG, "  Name: '%s'", device.get_name().c_str());
   if (device.get_tx_power().has_value()) {
     ESP_LOGD(TAG, "  TX Power: %d", *device.get_tx_power());
@@ -460,12 +368,11 @@ bool ESP32BLETracker::parse_already_discovered_(const ESPBTDevice &device) {
   return false;
 }
 
-void ESP32BLETracker::parse_presence_sensors_(const ESPBTDevice &device) {
-  const uint64_t address = device.address_uint64();
-  for (auto *dev : this->presence_sensors_) {
-    if (dev->address_ == address)
-      dev->publish_state(true);
-  }
+void ESP32BLETracker::parse_presence_sensors_(const ESPBTDevice &device, const Listeners *listeners) {
+  if (listeners == nullptr)
+    return;
+  for (auto *dev : listeners->presence_sensors)
+    dev->publish_state(true);
 }
 
 ESPBTUUID::ESPBTUUID() : uuid_() {}
@@ -488,6 +395,23 @@ ESPBTUUID ESPBTUUID::from_raw(const uint8_t *data) {
     ret.uuid_.uuid.uuid128[i] = data[i];
   return ret;
 }
+ESPBTAdvParser::ESPBTAdvParser(const uint8_t *payload, uint8_t length) : payload_(payload), length_(length) {}
+bool ESPBTAdvParser::next(ESPBTAdvRecord *record) {
+  if (this->offset_ + 2 > this->length_)
+    return false;
+  const uint8_t field_length = this->payload_[this->offset_];  // First byte is length of adv record
+  if (field_length == 0 || this->offset_ + 1 + field_length > this->length_) {
+    this->offset_ = this->length_;
+    return false;
+  }
+  // first byte of adv record is adv record type
+  record->type = this->payload_[this->offset_ + 1];
+  record->data.data = &this->payload_[this->offset_ + 2];
+  record->data.length = field_length - 1;
+  this->offset_ += 1 + field_length;
+  return true;
+}
+
 bool ESPBTUUID::contains(uint8_t data1, uint8_t data2) const {
   if (this->uuid_.len == ESP_UUID_LEN_16) {
     return (this->uuid_.uuid.uuid16 >> 8) == data2 || (this->uuid_.uuid.uuid16 & 0xFF) == data1;
@@ -554,7 +478,7 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
             this->address_[2], this->address_[3], this->address_[4], this->address_[5], address_type);
 
   ESP_LOGVV(TAG, "  RSSI: %d", this->rssi_);
-  ESP_LOGVV(TAG, "  Name: %s", this->name_.c_str());
+  ESP_LOGVV(TAG, "  Name: %s", this->get_name().c_str());
   if (this->tx_power_.has_value()) {
     ESP_LOGVV(TAG, "  TX Power: %d", *this->tx_power_);
   }
@@ -564,11 +488,11 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
   if (this->ad_flag_.has_value()) {
     ESP_LOGVV(TAG, "  Ad Flag: %u", *this->ad_flag_);
   }
-  for (auto uuid : this->service_uuids_) {
+  for (auto uuid : this->get_service_uuids()) {
     ESP_LOGVV(TAG, "  Service UUID: %s", uuid.to_string().c_str());
   }
-  ESP_LOGVV(TAG, "  Manufacturer data: '%s'", this->manufacturer_data_.c_str());
-  ESP_LOGVV(TAG, "  Service data: '%s'", this->service_data_.c_str());
+  ESP_LOGVV(TAG, "  Manufacturer data: '%s'", this->get_manufacturer_data().c_str());
+  ESP_LOGVV(TAG, "  Service data: '%s'", this->get_service_data().c_str());
 
   if (this->service_data_uuid_.has_value()) {
     ESP_LOGVV(TAG, "  Service Data UUID: %s", this->service_data_uuid_->to_string().c_str());
@@ -586,94 +510,84 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
   ESP_LOGVV(TAG, "Adv data: %s (%u bytes)", buffer, param.adv_data_len);
 #endif
 }
-void ESPBTDevice::parse_adv(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
-  size_t offset = 0;
-  const uint8_t *payload = param.ble_adv;
-  uint8_t len = param.adv_data_len;
-
-  while (offset + 2 < len) {
-    const uint8_t field_length = payload[offset++];  // First byte is length of adv record
-    if (field_length == 0)
-      break;
-
-    // first byte of adv record is adv record type
-    const uint8_t record_type = payload[offset++];
-    const uint8_t *record = &payload[offset];
-    const uint8_t record_length = field_length - 1;
-    offset += record_length;
+static uint16_t ble_read_uint16(const uint8_t *data) { return uint16_t(data[0]) | (uint16_t(data[1]) << 8); }
+static uint32_t ble_read_uint32(const uint8_t *data) {
+  return uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+}
 
-    switch (record_type) {
+void ESPBTDevice::parse_adv(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
+  // The copies belong to the previous scan result
+  this->cached_ = 0;
+  this->adv_data_.data = param.ble_adv;
+  this->adv_data_.length = param.adv_data_len;
+
+  ESPBTAdvParser parser(param.ble_adv, param.adv_data_len);
+  ESPBTAdvRecord record{};
+  while (parser.next(&record)) {
+    const uint8_t *data = record.data.data;
+    const uint8_t length = record.data.length;
+    switch (record.type) {
       case ESP_BLE_AD_TYPE_NAME_CMPL: {
-        this->name_ = std::string(reinterpret_cast<const char *>(record), record_length);
+        this->name_ = record.data;
         break;
       }
       case ESP_BLE_AD_TYPE_TX_PWR: {
-        this->tx_power_ = *payload;
+        if (length >= 1)
+          this->tx_power_ = int8_t(data[0]);
         break;
       }
       case ESP_BLE_AD_TYPE_APPEARANCE: {
-        this->appearance_ = *reinterpret_cast<const uint16_t *>(record);
+        if (length >= 2)
+          this->appearance_ = ble_read_uint16(data);
         break;
       }
       case ESP_BLE_AD_TYPE_FLAG: {
-        this->ad_flag_ = *record;
+        if (length >= 1)
+          this->ad_flag_ = data[0];
         break;
       }
       case ESP_BLE_AD_TYPE_16SRV_CMPL:
-      case ESP_BLE_AD_TYPE_16SRV_PART: {
-        for (uint8_t i = 0; i < record_length / 2; i++) {
-          this->service_uuids_.push_back(ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record + 2 * i)));
-        }
-        break;
-      }
+      case ESP_BLE_AD_TYPE_16SRV_PART:
       case ESP_BLE_AD_TYPE_32SRV_CMPL:
-      case ESP_BLE_AD_TYPE_32SRV_PART: {
-        for (uint8_t i = 0; i < record_length / 4; i++) {
-          this->service_uuids_.push_back(ESPBTUUID::from_uint32(*reinterpret_cast<const uint32_t *>(record + 4 * i)));
-        }
-        break;
-      }
+      case ESP_BLE_AD_TYPE_32SRV_PART:
       case ESP_BLE_AD_TYPE_128SRV_CMPL:
       case ESP_BLE_AD_TYPE_128SRV_PART: {
-        this->service_uuids_.push_back(ESPBTUUID::from_raw(record));
+        // Only decoded on demand, see get_service_uuids()
         break;
       }
       case ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE: {
-        this->manufacturer_data_ = std::string(reinterpret_cast<const char *>(record), record_length);
+        this->manufacturer_data_ = record.data;
         break;
       }
       case ESP_BLE_AD_TYPE_SERVICE_DATA: {
-        if (record_length < 2) {
+        if (length < 2) {
           ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_SERVICE_DATA");
           break;
         }
-        this->service_data_uuid_ = ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record));
-        if (record_length > 2)
-          this->service_data_ = std::string(reinterpret_cast<const char *>(record + 2), record_length - 2UL);
+        this->service_data_uuid_ = ESPBTUUID::from_uint16(ble_read_uint16(data));
+        this->service_data_ = ESPBTDataView{data + 2, uint8_t(length - 2)};
         break;
       }
       case ESP_BLE_AD_TYPE_32SERVICE_DATA: {
-        if (record_length < 4) {
+        if (length < 4) {
           ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_32SERVICE_DATA");
           break;
         }
-        this->service_data_uuid_ = ESPBTUUID::from_uint32(*reinterpret_cast<const uint32_t *>(record));
-        if (record_length > 4)
-          this->service_data_ = std::string(reinterpret_cast<const char *>(record + 4), record_length - 4UL);
+        this->service_data_uuid_ = ESPBTUUID::from_uint32(ble_read_uint32(data));
+        this->service_data_ = ESPBTDataView{data + 4, uint8_t(length - 4)};
         break;
       }
       case ESP_BLE_AD_TYPE_128SERVICE_DATA: {
-        if (record_length < 16) {
+        if (length < 16) {
           ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_128SERVICE_DATA");
           break;
         }
-        this->service_data_uuid_ = ESPBTUUID::from_raw(record);
-        if (record_length > 16)
-          this->service_data_ = std::string(reinterpret_cast<const char *>(record + 16), record_length - 16UL);
+        this->service_data_uuid_ = ESPBTUUID::from_raw(data);
+        this->service_data_ = ESPBTDataView{data + 16, uint8_t(length - 16)};
         break;
       }
       default: {
-        ESP_LOGV(TAG, "Unhandled type: advType: 0x%02x", record_type);
+        ESP_LOGV(TAG, "Unhandled type: advType: 0x%02x", record.type);
         break;
       }
     }
@@ -688,14 +602,68 @@ std::string ESPBTDevice::address_str() const {
 uint64_t ESPBTDevice::address_uint64() const { return ble_addr_to_uint64(this->address_); }
 esp_ble_addr_type_t ESPBTDevice::get_address_type() const { return this->address_type_; }
 int ESPBTDevice::get_rssi() const { return this->rssi_; }
-const std::string &ESPBTDevice::get_name() const { return this->name_; }
+const std::string &ESPBTDevice::get_name() const {
+  if ((this->cached_ & CACHED_NAME) == 0) {
+    this->name_str_ = this->name_.str();
+    this->cached_ |= CACHED_NAME;
+  }
+  return this->name_str_;
+}
 const optional<int8_t> &ESPBTDevice::get_tx_power() const { return this->tx_power_; }
 const optional<uint16_t> &ESPBTDevice::get_appearance() const { return this->appearance_; }
 const optional<uint8_t> &ESPBTDevice::get_ad_flag() const { return this->ad_flag_; }
-const std::vector<ESPBTUUID> &ESPBTDevice::get_service_uuids() const { return this->service_uuids_; }
-const std::string &ESPBTDevice::get_manufacturer_data() const { return this->manufacturer_data_; }
-const std::string &ESPBTDevice::get_service_data() const { return this->service_data_; }
+const std::vector<ESPBTUUID> &ESPBTDevice::get_service_uuids() const {
+  if (this->cached_ & CACHED_SERVICE_UUIDS)
+    return this->service_uuids_;
+  this->cached_ |= CACHED_SERVICE_UUIDS;
+  auto &uuids = this->service_uuids_;
+  uuids.clear();
+  ESPBTAdvParser parser(this->adv_data_.data, this->adv_data_.length);
+  ESPBTAdvRecord record{};
+  while (parser.next(&record)) {
+    const uint8_t *data = record.data.data;
+    const uint8_t length = record.data.length;
+    switch (record.type) {
+      case ESP_BLE_AD_TYPE_16SRV_CMPL:
+      case ESP_BLE_AD_TYPE_16SRV_PART:
+        for (uint8_t i = 0; i < length / 2; i++)
+          uuids.push_back(ESPBTUUID::from_uint16(ble_read_uint16(data + 2 * i)));
+        break;
+      case ESP_BLE_AD_TYPE_32SRV_CMPL:
+      case ESP_BLE_AD_TYPE_32SRV_PART:
+        for (uint8_t i = 0; i < length / 4; i++)
+          uuids.push_back(ESPBTUUID::from_uint32(ble_read_uint32(data + 4 * i)));
+        break;
+      case ESP_BLE_AD_TYPE_128SRV_CMPL:
+      case ESP_BLE_AD_TYPE_128SRV_PART:
+        if (length >= 16)
+          uuids.push_back(ESPBTUUID::from_raw(data));
+        break;
+      default:
+        break;
+    }
+  }
+  return uuids;
+}
+const std::string &ESPBTDevice::get_manufacturer_data() const {
+  if ((this->cached_ & CACHED_MANUFACTURER_DATA) == 0) {
+    this->manufacturer_data_str_ = this->manufacturer_data_.str();
+    this->cached_ |= CACHED_MANUFACTURER_DATA;
+  }
+  return this->manufacturer_data_str_;
+}
+const std::string &ESPBTDevice::get_service_data() const {
+  if ((this->cached_ & CACHED_SERVICE_DATA) == 0) {
+    this->service_data_str_ = this->service_data_.str();
+    this->cached_ |= CACHED_SERVICE_DATA;
+  }
+  return this->service_data_str_;
+}
 const optional<ESPBTUUID> &ESPBTDevice::get_service_data_uuid() const { return this->service_data_uuid_; }
+const ESPBTDataView &ESPBTDevice::get_name_view() const { return this->name_; }
+const ESPBTDataView &ESPBTDevice::get_manufacturer_data_view() const { return this->manufacturer_data_; }
+const ESPBTDataView &ESPBTDevice::get_service_data_view() const { return this->service_data_; }
+const ESPBTDataView &ESPBTDevice::get_adv_data_view() const { return this->adv_data_; }
 
 void ESP32BLETracker::set_scan_interval(uint32_t scan_interval) { this->scan_interval_ = scan_interval; }
 uint32_t ESP32BLETracker::get_scan_interval() const { return this->scan_interval_; }
@@ -717,6 +685,8 @@ void ESP32BLETracker::dump_config() {
     LOG_SENSOR("    ", "Conductivity ", child->get_conductivity_sensor());
     LOG_SENSOR("    ", "Battery Level ", child->get_battery_level_sensor());
   }
+  for (auto *decoder : this->decoder_list_)
+    decoder->dump_config();
 }
 
 std::string ESP32BLERSSISensor::unit_of_measurement() { return "dB"; }
@@ -736,6 +706,7 @@ uint32_t XiaomiDevice::update_interval() const {
   return this->parent_->get_scan_interval() * 2000;
 }
 std::string XiaomiDevice::unique_id() const { return uint64_to_string(this->address_); }
+uint64_t XiaomiDevice::get_address() const { return this->address_; }
 
 ESP32BLEPresenceDevice::ESP32BLEPresenceDevice(const std::string &name, uint64_t address)
     : BinarySensor(name), address_(address) {}
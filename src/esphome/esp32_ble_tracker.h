@@ -8,9 +8,11 @@
 #include "esphome/component.h"
 #include "esphome/binary_sensor/binary_sensor.h"
 #include "esphome/sensor/sensor.h"
+#include "esphome/esp32_ble_mac_table.h"
 
 #include <string>
 #include <array>
+#include <unordered_map>
 #include <esp_gap_ble_api.h>
 #include <esp_bt_defs.h>
 
@@ -19,7 +21,38 @@ ESPHOME_NAMESPACE_BEGIN
 class ESP32BLEPresenceDevice;
 class ESP32BLERSSISensor;
 class XiaomiDevice;
+class XiaomiDecoder;
+class RuuviDevice;
+class RuuviDecoder;
+class ESP32BLEIBeaconPresence;
+class IBeaconDecoder;
+class EddystoneDevice;
+class EddystoneDecoder;
 class ESPBTDevice;
+struct ESPBTDataView;
+
+/** Base class for decoders of BLE advertisement payloads.
+ *
+ * A decoder is registered with the tracker for a manufacturer company ID or a 16-bit service data UUID and
+ * is then called for each advertisement containing a matching record, see
+ * ESP32BLETracker::register_manufacturer_decoder and ESP32BLETracker::register_service_data_decoder.
+ */
+class ESPBTAdvDecoder {
+ public:
+  /** Decode the payload of a matching record.
+   *
+   * @param device The scan result, for example for the MAC address and RSSI.
+   * @param data A view of the manufacturer data without the company ID or the service data without the
+   *             UUID. Only valid during this call.
+   */
+  virtual void decode(const ESPBTDevice &device, const ESPBTDataView &data) = 0;
+
+  /// Called at the start of each scan, for example to mark devices that weren't seen as absent.
+  virtual void on_scan_start();
+
+  /// Log the devices this decoder handles, called from ESP32BLETracker::dump_config.
+  virtual void dump_config();
+};
 
 /** The ESP32BLETracker class is a hub for all ESP32 Bluetooth Low Energy devices.
  *
@@ -72,6 +105,29 @@ class ESP32BLETracker : public Component {
 
   XiaomiDevice *make_xiaomi_device(std::array<uint8_t, 6> address);
 
+  /// Create a device for RuuviTag advertisements (data formats 3 and 5).
+  RuuviDevice *make_ruuvi_device(std::array<uint8_t, 6> address);
+
+  /** Create a binary sensor that is on when an iBeacon with the given proximity UUID was seen during the
+   * last scan. Unlike make_presence_sensor this also works for devices with random MAC addresses.
+   *
+   * @param name The name of the binary sensor.
+   * @param uuid The proximity UUID of the beacon.
+   * @param major The major number to match, or -1 for any.
+   * @param minor The minor number to match, or -1 for any.
+   */
+  ESP32BLEIBeaconPresence *make_ibeacon_presence_sensor(const std::string &name, std::array<uint8_t, 16> uuid,
+                                                        int32_t major = -1, int32_t minor = -1);
+
+  /// Create a device for the telemetry (TLM) frames of an Eddystone beacon.
+  EddystoneDevice *make_eddystone_device(std::array<uint8_t, 6> address);
+
+  /// Register a decoder for manufacturer specific data with the given company ID.
+  void register_manufacturer_decoder(uint16_t company_id, ESPBTAdvDecoder *decoder);
+
+  /// Register a decoder for service data with the given 16-bit service UUID.
+  void register_service_data_decoder(uint16_t uuid, ESPBTAdvDecoder *decoder);
+
   /** Set the number of seconds (!) that a single BLE scan should take.
    *
    * This parameter is useful when adjusting how long it should take for a bluetooth device
@@ -105,20 +161,37 @@ class ESP32BLETracker : public Component {
   /// Called when a `ESP_GAP_BLE_SCAN_START_COMPLETE_EVT` event is received.
   void gap_scan_start_complete(const esp_ble_gap_cb_param_t::ble_scan_start_cmpl_evt_param &param);
 
-  void parse_presence_sensors_(const ESPBTDevice &device);
-  void parse_rssi_sensors_(const ESPBTDevice &device);
-  void parse_xiaomi_sensors_(const ESPBTDevice &device);
+  /// All devices registered for a MAC address.
+  struct Listeners {
+    std::vector<ESP32BLEPresenceDevice *> presence_sensors;
+    std::vector<ESP32BLERSSISensor *> rssi_sensors;
+  };
+
+  void parse_presence_sensors_(const ESPBTDevice &device, const Listeners *listeners);
+  void parse_rssi_sensors_(const ESPBTDevice &device, const Listeners *listeners);
+  /// Hand all manufacturer and service data records of the scan result to the registered decoders.
+  void dispatch_decoders_(const ESPBTDevice &device);
+  void register_decoder_(uint32_t key, ESPBTAdvDecoder *decoder);
 
   bool parse_already_discovered_(const ESPBTDevice &device);
-  bool has_already_discovered_(uint64_t address);
 
-  /// An array of MAC addresses discovered during this scan. Used to mark registered devices as undiscovered.
-  std::vector<uint64_t> already_discovered_;
+  /// The MAC addresses discovered recently. Used to mark registered devices as undiscovered.
+  ESPBTMacTable discovered_;
 
   /// An array of registered devices to track
   std::vector<ESP32BLEPresenceDevice *> presence_sensors_;
   std::vector<ESP32BLERSSISensor *> rssi_sensors_;
   std::vector<XiaomiDevice *> xiaomi_devices_;
+  /// The registered devices by MAC address, so that each scan result is only dispatched to its own listeners.
+  std::unordered_map<uint64_t, Listeners> listeners_;
+  /// The registered decoders by DECODER_KEY_* << 16 | company ID or service UUID.
+  std::unordered_map<uint32_t, std::vector<ESPBTAdvDecoder *>> decoders_;
+  /// Each registered decoder once.
+  std::vector<ESPBTAdvDecoder *> decoder_list_;
+  XiaomiDecoder *xiaomi_decoder_{nullptr};
+  RuuviDecoder *ruuvi_decoder_{nullptr};
+  IBeaconDecoder *ibeacon_decoder_{nullptr};
+  EddystoneDecoder *eddystone_decoder_{nullptr};
   /// A structure holding the ESP BLE scan parameters.
   esp_ble_scan_params_t scan_params_;
   /// The interval in seconds to perform scans.
@@ -189,6 +262,8 @@ class XiaomiDevice {
  public:
   XiaomiDevice(ESP32BLETracker *parent, uint64_t address);
 
+  uint64_t get_address() const;
+
   XiaomiSensor *get_temperature_sensor() const;
   XiaomiSensor *get_humidity_sensor() const;
   XiaomiSensor *get_moisture_sensor() const;
@@ -237,6 +312,44 @@ class ESPBTUUID {
   esp_bt_uuid_t uuid_;
 };
 
+/// A view of a part of the raw advertisement data of a scan result.
+struct ESPBTDataView {
+  ESPBTDataView() = default;
+  ESPBTDataView(const uint8_t *data, uint8_t length) : data(data), length(length) {}
+
+  const uint8_t *data{nullptr};
+  uint8_t length{0};
+
+  bool empty() const { return this->length == 0; }
+  std::string str() const { return std::string(reinterpret_cast<const char *>(this->data), this->length); }
+};
+
+/// A single AD structure of the advertisement data.
+struct ESPBTAdvRecord {
+  uint8_t type;
+  ESPBTDataView data;
+};
+
+/// Iterates over the AD structures of raw advertisement data without copying it.
+class ESPBTAdvParser {
+ public:
+  ESPBTAdvParser(const uint8_t *payload, uint8_t length);
+
+  /// Read the next AD structure into record, returns false at the end of the data.
+  bool next(ESPBTAdvRecord *record);
+
+ protected:
+  const uint8_t *payload_;
+  uint8_t length_;
+  uint8_t offset_{0};
+};
+
+/** A parsed BLE scan result.
+ *
+ * The data views point into the scan result passed to parse_scan_rst(), so a device must not outlive it.
+ * The *_view getters don't allocate. The std::string and std::vector getters copy the data on first use
+ * and keep the copy for the lifetime of the device.
+ */
 class ESPBTDevice {
  public:
   void parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
@@ -258,20 +371,40 @@ class ESPBTDevice {
   const std::string &get_service_data() const;
   const optional<ESPBTUUID> &get_service_data_uuid() const;
 
+  const ESPBTDataView &get_name_view() const;
+  const ESPBTDataView &get_manufacturer_data_view() const;
+  /// The service data without the service UUID.
+  const ESPBTDataView &get_service_data_view() const;
+  /// The raw advertisement data.
+  const ESPBTDataView &get_adv_data_view() const;
+
  protected:
   esp_bd_addr_t address_{
       0,
   };
   esp_ble_addr_type_t address_type_{BLE_ADDR_TYPE_PUBLIC};
   int rssi_{0};
-  std::string name_{};
+  ESPBTDataView adv_data_{};
+  ESPBTDataView name_{};
   optional<int8_t> tx_power_{};
   optional<uint16_t> appearance_{};
   optional<uint8_t> ad_flag_{};
-  std::vector<ESPBTUUID> service_uuids_;
-  std::string manufacturer_data_{};
-  std::string service_data_{};
+  ESPBTDataView manufacturer_data_{};
+  ESPBTDataView service_data_{};
   optional<ESPBTUUID> service_data_uuid_{};
+
+  enum CachedField : uint8_t {
+    CACHED_NAME = 1 << 0,
+    CACHED_SERVICE_UUIDS = 1 << 1,
+    CACHED_MANUFACTURER_DATA = 1 << 2,
+    CACHED_SERVICE_DATA = 1 << 3,
+  };
+  /// Which of the copies below have been made, see CachedField.
+  mutable uint8_t cached_{0};
+  mutable std::string name_str_{};
+  mutable std::vector<ESPBTUUID> service_uuids_{};
+  mutable std::string manufacturer_data_str_{};
+  mutable std::string service_data_str_{};
 };
 
 extern ESP32BLETracker *global_esp32_ble_tracker;
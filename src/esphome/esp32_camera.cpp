@@ -13,6 +13,10 @@ void ESP32Camera::setup() {
   global_esp32_camera = this;
 
   this->last_update_ = millis();
+  if (this->config_.fb_count > 1 && !psramFound()) {
+    ESP_LOGW(TAG, "Multiple frame buffers require PSRAM, using a single frame buffer.");
+    this->config_.fb_count = 1;
+  }
   esp_err_t err = esp_camera_init(&this->config_);
   if (err != ESP_OK) {
     ESP_LOGE(TAG, "esp_camera_init failed: %s", esp_err_to_name(err));
@@ -28,8 +32,8 @@ void ESP32Camera::setup() {
   s->set_brightness(s, this->brightness_);
   s->set_saturation(s, this->saturation_);
   s->set_colorbar(s, this->test_pattern_);
-  this->framebuffer_get_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
-  this->framebuffer_return_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
+  this->framebuffer_get_queue_ = xQueueCreate(this->config_.fb_count, sizeof(camera_fb_t *));
+  this->framebuffer_return_queue_ = xQueueCreate(this->config_.fb_count, sizeof(camera_fb_t *));
   xTaskCreatePinnedToCore(&ESP32Camera::framebuffer_task,
                           "framebuffer_task",  // name
                           1024,                // stack size
@@ -96,7 +100,7 @@ void ESP32Camera::dump_config() {
   sensor_t *s = esp_camera_sensor_get();
   auto st = s->status;
   ESP_LOGCONFIG(TAG, "  JPEG Quality: %u", st.quality);
-  // ESP_LOGCONFIG(TAG, "  Framebuffer Count: %u", conf.fb_count);
+  ESP_LOGCONFIG(TAG, "  Framebuffer Count: %u", conf.fb_count);
   ESP_LOGCONFIG(TAG, "  Contrast: %d", st.contrast);
   ESP_LOGCONFIG(TAG, "  Brightness: %d", st.brightness);
   ESP_LOGCONFIG(TAG, "  Saturation: %d", st.saturation);
@@ -121,53 +125,64 @@ void ESP32Camera::dump_config() {
   ESP_LOGCONFIG(TAG, "  Test Pattern: %s", YESNO(st.colorbar));
 }
 void ESP32Camera::loop() {
-  // check if we can return the image
-  if (this->can_return_image_()) {
-    // return image
-    auto *fb = this->current_image_->get_raw_buffer();
-    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
-    this->current_image_.reset();
-  }
-
   // Check if we should fetch a new image
   if (!this->has_requested_image_())
     return;
-  if (this->current_image_.use_count() > 1) {
-    // image is still in use
-    return;
-  }
   const uint32_t now = millis();
   if (now - this->last_update_ <= this->max_update_interval_)
     return;
 
-  // request new image
-  camera_fb_t *fb;
-  if (xQueueReceive(this->framebuffer_get_queue_, &fb, 0L) != pdTRUE) {
+  // request new image, if multiple frames are ready only the newest one is used
+  camera_fb_t *fb = nullptr;
+  camera_fb_t *next;
+  while (xQueueReceive(this->framebuffer_get_queue_, &next, 0L) == pdTRUE) {
+    if (fb != nullptr) {
+      xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+      this->dropped_frames_++;
+    }
+    fb = next;
+    if (fb == nullptr) {
+      ESP_LOGW(TAG, "Got invalid frame from camera!");
+      xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+      return;
+    }
+  }
+  if (fb == nullptr) {
     // no frame ready
     ESP_LOGVV(TAG, "No frame ready");
     return;
   }
 
-  if (fb == nullptr) {
-    ESP_LOGW(TAG, "Got invalid frame from camera!");
-    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
-    return;
-  }
-  this->current_image_ = std::make_shared<CameraImage>(fb);
+  // The image returns the frame buffer once all consumers are done with it
+  auto image = std::make_shared<CameraImage>(fb, this->framebuffer_return_queue_);
 
-  ESP_LOGD(TAG, "Got Image: %p len=%u width=%u height=%u format=%u", fb->buf, fb->len, fb->width, fb->height,
-           fb->format);
-  this->new_image_callback_.call(this->current_image_);
+  ESP_LOGD(TAG, "Got Image: %p len=%u width=%u height=%u format=%u dropped=%u", fb->buf, fb->len, fb->width,
+           fb->height, fb->format, this->dropped_frames_);
+  this->new_image_callback_.call(image);
   this->last_update_ = now;
   this->single_requester_ = false;
 }
 void ESP32Camera::framebuffer_task(void *pv) {
+  const uint8_t fb_count = global_esp32_camera->config_.fb_count;
+  uint8_t in_flight = 0;
+  camera_fb_t *framebuffer;
   while (true) {
-    camera_fb_t *framebuffer = esp_camera_fb_get();
-    xQueueSend(global_esp32_camera->framebuffer_get_queue_, &framebuffer, portMAX_DELAY);
-    // return is no-op for config with 1 fb
-    xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, portMAX_DELAY);
-    esp_camera_fb_return(framebuffer);
+    if (in_flight < fb_count) {
+      // Hand back everything that's done, then capture into a free frame buffer
+      while (xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, 0L) == pdTRUE) {
+        esp_camera_fb_return(framebuffer);
+        in_flight--;
+      }
+      framebuffer = esp_camera_fb_get();
+      xQueueSend(global_esp32_camera->framebuffer_get_queue_, &framebuffer, portMAX_DELAY);
+      in_flight++;
+    } else {
+      // All frame buffers are in use, wait until one is returned.
+      // return is no-op for config with 1 fb
+      xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, portMAX_DELAY);
+      esp_camera_fb_return(framebuffer);
+      in_flight--;
+    }
   }
 }
 ESP32Camera::ESP32Camera(const std::string &name) : Nameable(name) {
@@ -179,7 +194,7 @@ ESP32Camera::ESP32Camera(const std::string &name) : Nameable(name) {
   this->config_.pixel_format = PIXFORMAT_JPEG;
   this->config_.frame_size = FRAMESIZE_VGA;  // 640x480
   this->config_.jpeg_quality = 10;
-  this->config_.fb_count = 1;
+  this->config_.fb_count = 2;
 
   global_esp32_camera = this;
 }
@@ -272,7 +287,8 @@ bool ESP32Camera::has_requested_image_() const {
 
   return false;
 }
-bool ESP32Camera::can_return_image_() const { return this->current_image_.use_count() == 1; }
+uint32_t ESP32Camera::get_dropped_frames() const { return this->dropped_frames_; }
+void ESP32Camera::set_frame_buffer_count(uint8_t frame_buffer_count) { this->config_.fb_count = frame_buffer_count; }
 void ESP32Camera::set_max_update_interval(uint32_t max_update_interval) {
   this->max_update_interval_ = max_update_interval;
 }
@@ -300,7 +316,13 @@ uint8_t *CameraImageReader::peek_data_buffer() { return this->image_->get_data_b
 camera_fb_t *CameraImage::get_raw_buffer() { return this->buffer_; }
 uint8_t *CameraImage::get_data_buffer() { return this->buffer_->buf; }
 size_t CameraImage::get_data_length() { return this->buffer_->len; }
-CameraImage::CameraImage(camera_fb_t *buffer) : buffer_(buffer) {}
+uint32_t CameraImage::get_timestamp() const { return this->timestamp_; }
+CameraImage::CameraImage(camera_fb_t *buffer, QueueHandle_t return_queue)
+    : buffer_(buffer), return_queue_(return_queue), timestamp_(millis()) {}
+CameraImage::~CameraImage() {
+  // The queue holds as many entries as there are frame buffers, so this never blocks
+  xQueueSend(this->return_queue_, &this->buffer_, portMAX_DELAY);
+}
 
 ESPHOME_NAMESPACE_END
 
@@ -12,15 +12,27 @@ ESPHOME_NAMESPACE_BEGIN
 
 class ESP32Camera;
 
+/** A captured frame, shared between all consumers through a std::shared_ptr.
+ *
+ * The frame buffer is handed back to the camera once the last reference is gone, so a slow consumer only holds
+ * on to its own frame and doesn't stop the camera from capturing into the other frame buffers.
+ */
 class CameraImage {
  public:
-  CameraImage(camera_fb_t *buffer);
+  CameraImage(camera_fb_t *buffer, QueueHandle_t return_queue);
+  CameraImage(const CameraImage &) = delete;
+  CameraImage &operator=(const CameraImage &) = delete;
+  ~CameraImage();
   camera_fb_t *get_raw_buffer();
   uint8_t *get_data_buffer();
   size_t get_data_length();
+  /// The time (in ms) the frame was received from the camera.
+  uint32_t get_timestamp() const;
 
  protected:
   camera_fb_t *buffer_;
+  QueueHandle_t return_queue_;
+  uint32_t timestamp_;
 };
 
 class CameraImageReader {
@@ -71,6 +83,11 @@ class ESP32Camera : public Component, public Nameable {
   void set_max_update_interval(uint32_t max_update_interval);
   void set_idle_update_interval(uint32_t idle_update_interval);
   void set_test_pattern(bool test_pattern);
+  /** Set the number of frame buffers. Defaults to 2, more than 1 requires PSRAM.
+   *
+   * With more than one frame buffer the camera keeps capturing while consumers still hold on to older frames.
+   */
+  void set_frame_buffer_count(uint8_t frame_buffer_count);
   void setup() override;
   void loop() override;
   void dump_config() override;
@@ -79,10 +96,12 @@ class ESP32Camera : public Component, public Nameable {
   void request_stream();
   void request_image();
 
+  /// The number of captured frames that were dropped because a newer frame was already available.
+  uint32_t get_dropped_frames() const;
+
  protected:
   uint32_t hash_base() override;
   bool has_requested_image_() const;
-  bool can_return_image_() const;
 
   static void framebuffer_task(void *pv);
 
@@ -95,7 +114,6 @@ class ESP32Camera : public Component, public Nameable {
   bool test_pattern_{false};
 
   esp_err_t init_error_{ESP_OK};
-  std::shared_ptr<CameraImage> current_image_;
   uint32_t last_stream_request_{0};
   bool single_requester_{false};
   QueueHandle_t framebuffer_get_queue_;
@@ -104,6 +122,7 @@ class ESP32Camera : public Component, public Nameable {
   uint32_t max_update_interval_{1000};
   uint32_t idle_update_interval_{15000};
   uint32_t last_update_{0};
+  uint32_t dropped_frames_{0};
 };
 
 extern ESP32Camera *global_esp32_camera;
@@ -10,51 +10,51 @@ ESPHOME_NAMESPACE_BEGIN
 const uint8_t ONE_WIRE_ROM_SELECT = 0x55;
 const int ONE_WIRE_ROM_SEARCH = 0xF0;
 
-ESPOneWire::ESPOneWire(GPIOPin *pin) : pin_(pin) {}
+ESPOneWire::ESPOneWire(GPIOPin *pin) : pin_(pin), fast_pin_(pin) {}
 
 bool HOT ESPOneWire::reset() {
   uint8_t retries = 125;
 
-  // Wait for communication to clear
+  // Wait for communication to clear. This also sets up the pull-up, afterwards only the output driver is switched.
   this->pin_->pin_mode(INPUT_PULLUP);
   do {
     if (--retries == 0)
       return false;
     delayMicroseconds(2);
-  } while (!this->pin_->digital_read());
+  } while (!this->fast_pin_.digital_read());
 
   // Send 480µs LOW TX reset pulse
-  this->pin_->pin_mode(OUTPUT);
-  this->pin_->digital_write(false);
+  this->fast_pin_.digital_write(false);
+  this->fast_pin_.set_output_enabled(true);
   delayMicroseconds(480);
 
   // Switch into RX mode, letting the pin float
-  this->pin_->pin_mode(INPUT_PULLUP);
+  this->fast_pin_.set_output_enabled(false);
   // after 15µs-60µs wait time, slave pulls low for 60µs-240µs
   // let's have 70µs just in case
   delayMicroseconds(70);
 
-  bool r = !this->pin_->digital_read();
+  bool r = !this->fast_pin_.digital_read();
   delayMicroseconds(410);
   return r;
 }
 
 void HOT ESPOneWire::write_bit(bool bit) {
   // Initiate write/read by pulling low.
-  this->pin_->pin_mode(OUTPUT);
-  this->pin_->digital_write(false);
+  this->fast_pin_.digital_write(false);
+  this->fast_pin_.set_output_enabled(true);
 
   // bus sampled within 15µs and 60µs after pulling LOW.
   if (bit) {
     // pull high/release within 15µs
     delayMicroseconds(10);
-    this->pin_->digital_write(true);
+    this->fast_pin_.digital_write(true);
     // in total minimum of 60µs long
     delayMicroseconds(55);
   } else {
     // continue pulling LOW for at least 60µs
     delayMicroseconds(65);
-    this->pin_->digital_write(true);
+    this->fast_pin_.digital_write(true);
     // grace period, 1µs recovery time
     delayMicroseconds(5);
   }
@@ -62,15 +62,15 @@ void HOT ESPOneWire::write_bit(bool bit) {
 
 bool HOT ESPOneWire::read_bit() {
   // Initiate read slot by pulling LOW for at least 1µs
-  this->pin_->pin_mode(OUTPUT);
-  this->pin_->digital_write(false);
+  this->fast_pin_.digital_write(false);
+  this->fast_pin_.set_output_enabled(true);
   delayMicroseconds(3);
 
   // release bus, we have to sample within 15µs of pulling low
-  this->pin_->pin_mode(INPUT_PULLUP);
+  this->fast_pin_.set_output_enabled(false);
   delayMicroseconds(10);
 
-  bool r = this->pin_->digital_read();
+  bool r = this->fast_pin_.digital_read();
   // read time slot at least 60µs long + 1µs recovery time between slots
   delayMicroseconds(53);
   return r;
@@ -157,7 +157,7 @@ uint64_t HOT ESPOneWire::search() {
       if (!branch) {
         last_zero = id_bit_number;
         if (last_zero < 9) {
-          this->last_discrepancy_ = last_zero;
+          this->last_family_discrepancy_ = last_zero;
         }
       }
     }
@@ -213,6 +213,112 @@ GPIOPin *ESPOneWire::get_pin() { return this->pin_; }
 
 uint8_t *ESPOneWire::rom_number8_() { return reinterpret_cast<uint8_t *>(&this->rom_number_); }
 
+ESPOneWireEngine::ESPOneWireEngine(ESPOneWire *one_wire) : one_wire_(one_wire) {}
+
+ESPOneWireEngine::Operation &ESPOneWireEngine::push_(OperationType type) {
+  this->operations_.emplace_back();
+  Operation &op = this->operations_.back();
+  op.type = type;
+  op.value = 0;
+  op.data = nullptr;
+  op.delay = 0;
+  return op;
+}
+void ESPOneWireEngine::queue_reset() { this->push_(OperationType::RESET); }
+void ESPOneWireEngine::queue_skip() { this->queue_write8(0xCC); }
+void ESPOneWireEngine::queue_select(uint64_t address) {
+  this->queue_write8(ONE_WIRE_ROM_SELECT);
+  for (uint8_t i = 0; i < 8; i++)
+    this->queue_write8(uint8_t(address >> (i * 8)));
+}
+void ESPOneWireEngine::queue_write8(uint8_t value) { this->push_(OperationType::WRITE).value = value; }
+void ESPOneWireEngine::queue_read(uint8_t *data, uint8_t length) {
+  if (length == 0)
+    return;
+  Operation &op = this->push_(OperationType::READ);
+  op.data = data;
+  op.value = length;
+}
+void ESPOneWireEngine::queue_delay(uint32_t ms) { this->push_(OperationType::DELAY).delay = ms; }
+void ESPOneWireEngine::queue_end_transaction(std::function<void(bool)> &&callback) {
+  this->push_(OperationType::END).callback = std::move(callback);
+}
+void ESPOneWireEngine::process(uint32_t budget_us) {
+  const uint32_t start = micros();
+  while (!this->operations_.empty()) {
+    if (!this->step_())
+      return;
+    if (micros() - start >= budget_us)
+      return;
+  }
+}
+bool HOT ESPOneWireEngine::step_() {
+  Operation &op = this->operations_.front();
+  switch (op.type) {
+    case OperationType::RESET:
+      if (!this->failed_) {
+        disable_interrupts();
+        bool presence = this->one_wire_->reset();
+        enable_interrupts();
+        this->failed_ = !presence;
+      }
+      break;
+    case OperationType::WRITE:
+      if (!this->failed_) {
+        for (uint8_t i = 0; i < 8; i++) {
+          disable_interrupts();
+          this->one_wire_->write_bit(bool((1u << i) & op.value));
+          enable_interrupts();
+        }
+      }
+      break;
+    case OperationType::READ:
+      if (!this->failed_) {
+        uint8_t value = 0;
+        for (uint8_t i = 0; i < 8; i++) {
+          disable_interrupts();
+          value |= uint8_t(this->one_wire_->read_bit()) << i;
+          enable_interrupts();
+        }
+        op.data[this->read_progress_] = value;
+        if (++this->read_progress_ < op.value)
+          return true;
+      }
+      this->read_progress_ = 0;
+      break;
+    case OperationType::DELAY:
+      if (!this->failed_) {
+        if (!this->delay_started_) {
+          this->delay_started_ = true;
+          this->delay_start_ = millis();
+        }
+        if (millis() - this->delay_start_ < op.delay)
+          return false;
+        this->delay_started_ = false;
+      }
+      break;
+    case OperationType::END: {
+      auto callback = std::move(op.callback);
+      const bool success = !this->failed_;
+      this->failed_ = false;
+      this->operations_.pop_front();
+      // The callback may queue or clear operations.
+      if (callback)
+        callback(success);
+      return true;
+    }
+  }
+  this->operations_.pop_front();
+  return true;
+}
+void ESPOneWireEngine::clear() {
+  this->operations_.clear();
+  this->read_progress_ = 0;
+  this->delay_started_ = false;
+  this->failed_ = false;
+}
+bool ESPOneWireEngine::is_idle() const { return this->operations_.empty(); }
+
 ESPHOME_NAMESPACE_END
 
 #endif  // USE_ONE_WIRE
@@ -6,6 +6,8 @@
 #ifdef USE_ONE_WIRE
 
 #include "esphome/esphal.h"
+#include <deque>
+#include <functional>
 #include <vector>
 
 ESPHOME_NAMESPACE_BEGIN
@@ -71,12 +73,75 @@ class ESPOneWire {
   inline uint8_t *rom_number8_();
 
   GPIOPin *pin_;
+  FastGPIOPin fast_pin_;
   uint8_t last_discrepancy_{0};
   uint8_t last_family_discrepancy_{0};
   bool last_device_flag_{false};
   uint64_t rom_number_{0};
 };
 
+/** Runs queued 1-Wire transactions as a state machine, so that talking to many devices doesn't block the main loop.
+ *
+ * Operations are executed from process() (call it from the owner's loop()) until a time budget is used up. Interrupts
+ * are only disabled for one bit slot or reset pulse at a time, the bus is fine with longer gaps between slots.
+ *
+ * A transaction is a sequence of operations terminated by queue_end_transaction(). If a reset isn't answered with a
+ * presence pulse, the rest of the transaction is skipped and the callback is called with false.
+ */
+class ESPOneWireEngine {
+ public:
+  explicit ESPOneWireEngine(ESPOneWire *one_wire);
+
+  void queue_reset();
+  void queue_skip();
+  void queue_select(uint64_t address);
+  void queue_write8(uint8_t value);
+  /// Read length bytes into data, which must stay valid until the transaction has ended.
+  void queue_read(uint8_t *data, uint8_t length);
+  /// Leave the bus idle for the given time, for example while a conversion is running.
+  void queue_delay(uint32_t ms);
+  /// End the current transaction, the callback receives whether all resets were answered.
+  void queue_end_transaction(std::function<void(bool)> &&callback);
+
+  /// Run queued operations for about budget_us microseconds (at least one operation is run).
+  void process(uint32_t budget_us = 2000);
+
+  /// Drop all queued operations without calling their callbacks.
+  void clear();
+
+  bool is_idle() const;
+
+ protected:
+  enum class OperationType : uint8_t {
+    RESET,
+    WRITE,
+    READ,
+    DELAY,
+    END,
+  };
+
+  struct Operation {
+    OperationType type;
+    uint8_t value;
+    uint8_t *data;
+    uint32_t delay;
+    std::function<void(bool)> callback;
+  };
+
+  Operation &push_(OperationType type);
+  /// Run the front operation, returns false if it's waiting for time to pass.
+  bool step_();
+
+  ESPOneWire *one_wire_;
+  std::deque<Operation> operations_;
+  /// Bytes of the front READ operation that have already been read.
+  uint8_t read_progress_{0};
+  uint32_t delay_start_{0};
+  bool delay_started_{false};
+  /// Whether a reset of the current transaction has failed.
+  bool failed_{false};
+};
+
 ESPHOME_NAMESPACE_END
 
 #endif  // USE_ONE_WIRE
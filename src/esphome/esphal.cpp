@@ -2,6 +2,8 @@
 #include "esphome/helpers.h"
 #include "esphome/log.h"
 
+#include <utility>
+
 #ifdef ARDUINO_ARCH_ESP8266
 extern "C" {
 typedef struct {        // NOLINT
@@ -16,8 +18,6 @@ void ICACHE_RAM_ATTR __attachInterruptArg(uint8_t pin, void (*)(void *), void *f
 
 ESPHOME_NAMESPACE_BEGIN
 
-static const char *TAG = "esphal";
-
 GPIOPin::GPIOPin(uint8_t pin, uint8_t mode, bool inverted)
     : pin_(pin),
       mode_(mode),
@@ -116,6 +116,7 @@ unsigned char GPIOPin::get_pin() const { return this->pin_; }
 unsigned char GPIOPin::get_mode() const { return this->mode_; }
 
 bool GPIOPin::is_inverted() const { return this->inverted_; }
+bool GPIOPin::is_internal() const { return true; }
 void GPIOPin::setup() { this->pin_mode(this->mode_); }
 bool ICACHE_RAM_ATTR HOT GPIOPin::digital_read() {
   return bool((*this->gpio_read_) & this->gpio_mask_) != this->inverted_;
@@ -257,6 +258,38 @@ void GPIOPin::attach_interrupt_(void (*func)(void *), void *arg, int mode) const
 #endif
 }
 
+FastGPIOPin::FastGPIOPin(GPIOPin *pin) : pin_(pin) {
+  if (!pin->is_internal())
+    return;
+  const uint8_t num = pin->get_pin();
+#ifdef ARDUINO_ARCH_ESP8266
+  this->read_ = num < 16 ? &GPI : &GP16I;
+  this->mask_ = num < 16 ? (1UL << num) : 1;
+  // GPIO16 has no set/clear registers, writing it needs a read-modify-write.
+  this->fast_write_ = num < 16;
+  this->high_ = &GPOS;
+  this->low_ = &GPOC;
+  this->enable_set_ = &GPES;
+  this->enable_clear_ = &GPEC;
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  this->read_ = num < 32 ? &GPIO.in : &GPIO.in1.val;
+  this->mask_ = num < 32 ? (1UL << num) : (1UL << (num - 32));
+  this->fast_write_ = true;
+  this->high_ = num < 32 ? &GPIO.out_w1ts : &GPIO.out1_w1ts.val;
+  this->low_ = num < 32 ? &GPIO.out_w1tc : &GPIO.out1_w1tc.val;
+  this->enable_set_ = num < 32 ? &GPIO.enable_w1ts : &GPIO.enable1_w1ts.val;
+  this->enable_clear_ = num < 32 ? &GPIO.enable_w1tc : &GPIO.enable1_w1tc.val;
+#endif
+  this->fast_read_ = true;
+  if (pin->is_inverted()) {
+    std::swap(this->high_, this->low_);
+    this->read_invert_ = this->mask_;
+  }
+}
+GPIOPin *FastGPIOPin::get_pin() const { return this->pin_; }
+bool FastGPIOPin::is_fast() const { return this->fast_write_; }
+
 ISRInternalGPIOPin *GPIOPin::to_isr() const {
   return new ISRInternalGPIOPin(this->pin_,
 #ifdef ARDUINO_ARCH_ESP32
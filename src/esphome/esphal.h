@@ -87,6 +87,8 @@ class GPIOPin {
   uint8_t get_mode() const;
   /// Return whether this pin shall be treated as inverted. (for example active-low)
   bool is_inverted() const;
+  /// Return whether this is a GPIO of the ESP itself (and not for example of an I/O expander).
+  virtual bool is_internal() const;
 
   template<typename T> void attach_interrupt(void (*func)(T *), T *arg, int mode) const;
 
@@ -128,6 +130,66 @@ class GPIOInputPin : public GPIOPin {
   GPIOInputPin(uint8_t pin, uint8_t mode = INPUT, bool inverted = false);  // NOLINT
 };
 
+/** A non-virtual handle to a GPIOPin for bit-banged protocols.
+ *
+ * The register addresses and masks of the pin are looked up once at construction, with the pin inversion already
+ * folded in, so each read or write is a single register access that can be inlined (and is safe to use from ISRs).
+ * Pins that can't be accessed like this (pins of I/O expanders, writing GPIO16 on the ESP8266) transparently
+ * fall back to the virtual methods of the GPIOPin.
+ *
+ * The pin is not set up by this class, call GPIOPin::setup() before using it.
+ */
+class FastGPIOPin {
+ public:
+  FastGPIOPin() = default;
+  explicit FastGPIOPin(GPIOPin *pin);
+
+  bool digital_read() const {
+    if (!this->fast_read_)
+      return this->pin_->digital_read();
+    return ((*this->read_) ^ this->read_invert_) & this->mask_;
+  }
+  void digital_write(bool value) const {
+    if (!this->fast_write_) {
+      this->pin_->digital_write(value);
+      return;
+    }
+    *(value ? this->high_ : this->low_) = this->mask_;
+  }
+
+  /** Enable or disable the output driver, without changing the level or pull resistors.
+   *
+   * This is for open-drain style buses like 1-Wire: after the pin has been set to INPUT_PULLUP once with
+   * GPIOPin::pin_mode, this switches between driving the last written level and floating with the pull-up.
+   * The fallback path does the same with pin_mode(OUTPUT) and pin_mode(INPUT_PULLUP).
+   */
+  void set_output_enabled(bool enabled) const {
+    if (!this->fast_write_) {
+      this->pin_->pin_mode(enabled ? OUTPUT : INPUT_PULLUP);
+      return;
+    }
+    *(enabled ? this->enable_set_ : this->enable_clear_) = this->mask_;
+  }
+
+  GPIOPin *get_pin() const;
+  /// Whether writes go straight to the GPIO registers.
+  bool is_fast() const;
+
+ protected:
+  GPIOPin *pin_{nullptr};
+  bool fast_read_{false};
+  bool fast_write_{false};
+  /// The registers that set/clear the output to the logical high/low level.
+  volatile uint32_t *high_{nullptr};
+  volatile uint32_t *low_{nullptr};
+  volatile uint32_t *enable_set_{nullptr};
+  volatile uint32_t *enable_clear_{nullptr};
+  volatile uint32_t *read_{nullptr};
+  uint32_t mask_{0};
+  /// mask_ if the pin is inverted, XORed into each read.
+  uint32_t read_invert_{0};
+};
+
 template<typename T> void GPIOPin::attach_interrupt(void (*func)(T *), T *arg, int mode) const {
   this->attach_interrupt_(reinterpret_cast<void (*)(void *)>(func), arg, mode);
 }
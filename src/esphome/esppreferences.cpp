@@ -4,6 +4,7 @@
 
 #include "esphome/log.h"
 #include "esphome/helpers.h"
+#include "esphome/esppreferences_log.h"
 
 #ifdef USE_ESP8266_PREFERENCES_FLASH
 extern "C" {
@@ -66,6 +67,8 @@ static inline bool esp_rtc_user_mem_read(uint32_t index, uint32_t *dest) {
 }
 
 #ifdef USE_ESP8266_PREFERENCES_FLASH
+/// One bit per RTC user memory word that changed since the last flush.
+static uint32_t esp8266_dirty_words[ESP_RTC_USER_MEM_SIZE_WORDS / 32] = {};
 static bool esp8266_preferences_modified = false;
 #endif
 
@@ -80,6 +83,7 @@ static inline bool esp_rtc_user_mem_write(uint32_t index, uint32_t value) {
   auto *ptr = &ESP_RTC_USER_MEM[index];
 #ifdef USE_ESP8266_PREFERENCES_FLASH
   if (*ptr != value) {
+    esp8266_dirty_words[index / 32] |= 1UL << (index % 32);
     esp8266_preferences_modified = true;
   }
 #endif
@@ -93,33 +97,111 @@ extern "C" uint32_t _SPIFFS_end;
 static const uint32_t get_esp8266_flash_sector() { return (uint32_t(&_SPIFFS_end) - 0x40200000) / SPI_FLASH_SEC_SIZE; }
 static const uint32_t get_esp8266_flash_address() { return get_esp8266_flash_sector() * SPI_FLASH_SEC_SIZE; }
 
-static void load_esp8266_flash() {
-  ESP_LOGVV(TAG, "Loading preferences from flash...");
+class ESP8266PreferenceFlash : public ESPPreferenceFlash {
+ public:
+  explicit ESP8266PreferenceFlash(uint32_t first_sector) : first_sector_(first_sector) {}
+  bool read(uint8_t sector, uint32_t offset, uint32_t *data, size_t words) override {
+    disable_interrupts();
+    auto res = spi_flash_read(this->get_address_(sector) + offset, data, words * 4);
+    enable_interrupts();
+    return res == SPI_FLASH_RESULT_OK;
+  }
+  bool write(uint8_t sector, uint32_t offset, const uint32_t *data, size_t words) override {
+    disable_interrupts();
+    auto res = spi_flash_write(this->get_address_(sector) + offset, const_cast<uint32_t *>(data), words * 4);
+    enable_interrupts();
+    return res == SPI_FLASH_RESULT_OK;
+  }
+  bool erase(uint8_t sector) override {
+    disable_interrupts();
+    auto res = spi_flash_erase_sector(this->first_sector_ + sector);
+    enable_interrupts();
+    return res == SPI_FLASH_RESULT_OK;
+  }
+
+ protected:
+  uint32_t get_address_(uint8_t sector) const { return (this->first_sector_ + sector) * SPI_FLASH_SEC_SIZE; }
+
+  uint32_t first_sector_;
+};
+
+static ESPPreferenceLog *esp8266_preference_log = nullptr;
+
+static void read_esp8266_flash_image() {
   disable_interrupts();
   spi_flash_read(get_esp8266_flash_address(), ESP_RTC_USER_MEM, ESP_RTC_USER_MEM_SIZE_BYTES);
   enable_interrupts();
 }
-static void save_esp8266_flash() {
-  if (!esp8266_preferences_modified)
-    return;
 
-  ESP_LOGVV(TAG, "Saving preferences to flash...");
-  disable_interrupts();
-  auto erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
-  if (erase_res != SPI_FLASH_RESULT_OK) {
-    enable_interrupts();
-    ESP_LOGV(TAG, "Erase ESP8266 flash failed!");
+static void load_esp8266_flash(uint8_t sectors) {
+  ESP_LOGVV(TAG, "Loading preferences from flash...");
+  if (sectors < ESPPreferenceLog::MIN_SECTORS) {
+    // A log needs a second sector to move to, keep erasing and rewriting the single sector.
+    read_esp8266_flash_image();
     return;
   }
 
-  auto write_res = spi_flash_write(get_esp8266_flash_address(), ESP_RTC_USER_MEM, ESP_RTC_USER_MEM_SIZE_BYTES);
-  enable_interrupts();
-  if (write_res != SPI_FLASH_RESULT_OK) {
-    ESP_LOGV(TAG, "Write ESP8266 flash failed!");
+  const uint32_t first_sector = get_esp8266_flash_sector() + 1 - sectors;
+  ESP_LOGW(TAG, "Preferences use %u flash sectors, the last %u sectors of the SPIFFS area (0x%08X-0x%08X) "
+                "will be overwritten!",
+           sectors, sectors - 1, first_sector * SPI_FLASH_SEC_SIZE, get_esp8266_flash_address() - 1);
+  auto *flash = new ESP8266PreferenceFlash(first_sector);
+  esp8266_preference_log = new ESPPreferenceLog(flash, sectors, ESP_RTC_USER_MEM, ESP_RTC_USER_MEM_SIZE_WORDS);
+  if (esp8266_preference_log->load())
     return;
+
+  // No log yet, fall back to the plain image that older versions wrote to the last sector.
+  // The first flush will start a log in the first sector.
+  ESP_LOGV(TAG, "No preference log found, reading plain image.");
+  read_esp8266_flash_image();
+}
+static bool write_esp8266_flash_image() {
+  disable_interrupts();
+  auto res = spi_flash_erase_sector(get_esp8266_flash_sector());
+  if (res == SPI_FLASH_RESULT_OK)
+    res = spi_flash_write(get_esp8266_flash_address(), ESP_RTC_USER_MEM, ESP_RTC_USER_MEM_SIZE_BYTES);
+  enable_interrupts();
+  return res == SPI_FLASH_RESULT_OK;
+}
+static bool append_esp8266_flash_log() {
+  // Append one record per run of changed words
+  bool success = true;
+  uint32_t run_start = 0;
+  uint32_t run_length = 0;
+  for (uint32_t i = 0; i <= ESP_RTC_USER_MEM_SIZE_WORDS; i++) {
+    const bool dirty = i < ESP_RTC_USER_MEM_SIZE_WORDS && (esp8266_dirty_words[i / 32] & (1UL << (i % 32)));
+    if (dirty) {
+      if (run_length == 0)
+        run_start = i;
+      run_length++;
+    } else if (run_length != 0) {
+      if (!esp8266_preference_log->append(run_start, run_length))
+        success = false;
+      run_length = 0;
+    }
+  }
+  return success;
+}
+static bool save_esp8266_flash() {
+  if (!esp8266_preferences_modified)
+    return true;
+
+  ESP_LOGVV(TAG, "Saving preferences to flash...");
+  bool success;
+  if (esp8266_preference_log == nullptr) {
+    success = write_esp8266_flash_image();
+  } else {
+    success = append_esp8266_flash_log();
+  }
+  if (!success) {
+    ESP_LOGV(TAG, "Writing ESP8266 preferences to flash failed!");
+    return false;
   }
 
+  for (auto &word : esp8266_dirty_words)
+    word = 0;
   esp8266_preferences_modified = false;
+  return true;
 }
 #endif
 
@@ -130,7 +212,9 @@ bool ESPPreferenceObject::save_internal_() {
   }
 
 #ifdef USE_ESP8266_PREFERENCES_FLASH
-  save_esp8266_flash();
+  // The flash write is deferred, see ESPPreferences::set_flush_interval
+  if (esp8266_preferences_modified)
+    global_preferences.mark_dirty_();
 #endif
   return true;
 }
@@ -149,8 +233,9 @@ ESPPreferences::ESPPreferences()
 
 void ESPPreferences::begin(const std::string &name) {
 #ifdef USE_ESP8266_PREFERENCES_FLASH
-  load_esp8266_flash();
+  load_esp8266_flash(this->flash_sectors_);
 #endif
+  this->register_flush_hook_();
 }
 
 ESPPreferenceObject ESPPreferences::make_preference(size_t length, uint32_t type) {
@@ -184,21 +269,50 @@ ESPPreferenceObject ESPPreferences::make_preference(size_t length, uint32_t type
 }
 void ESPPreferences::prevent_write(bool prevent) { this->prevent_write_ = prevent; }
 bool ESPPreferences::is_prevent_write() { return this->prevent_write_; }
+#ifdef USE_ESP8266_PREFERENCES_FLASH
+void ESPPreferences::set_flash_sectors(uint8_t flash_sectors) { this->flash_sectors_ = flash_sectors; }
+#endif
+bool ESPPreferences::flush() {
+  if (!this->dirty_)
+    return true;
+  this->dirty_ = false;
+#ifdef USE_ESP8266_PREFERENCES_FLASH
+  if (!save_esp8266_flash()) {
+    // Try again after the next interval
+    this->mark_dirty_();
+    return false;
+  }
+#endif
+  return true;
+}
 #endif
 
 #ifdef ARDUINO_ARCH_ESP32
 bool ESPPreferenceObject::save_internal_() {
-  char key[32];
-  sprintf(key, "%u", this->rtc_offset_);
-  uint32_t len = (this->length_words_ + 1) * 4;
-  size_t ret = global_preferences.preferences_.putBytes(key, this->data_, len);
-  if (ret != len) {
-    ESP_LOGV(TAG, "putBytes failed!");
-    return false;
+  // Only buffer the data here, the NVS write is deferred, see ESPPreferences::set_flush_interval
+  const uint32_t *begin = this->data_;
+  const uint32_t *end = this->data_ + this->length_words_ + 1;
+  bool found = false;
+  for (auto &pending : global_preferences.pending_) {
+    if (pending.key == this->rtc_offset_) {
+      pending.data.assign(begin, end);
+      found = true;
+      break;
+    }
   }
+  if (!found)
+    global_preferences.pending_.push_back(ESPPreferences::PendingWrite{this->rtc_offset_, {begin, end}});
+  global_preferences.mark_dirty_();
   return true;
 }
 bool ESPPreferenceObject::load_internal_() {
+  for (auto &pending : global_preferences.pending_) {
+    if (pending.key == this->rtc_offset_) {
+      std::copy(pending.data.begin(), pending.data.end(), this->data_);
+      return true;
+    }
+  }
+
   char key[32];
   sprintf(key, "%u", this->rtc_offset_);
   uint32_t len = (this->length_words_ + 1) * 4;
@@ -214,6 +328,7 @@ void ESPPreferences::begin(const std::string &name) {
   const std::string key = truncate_string(name, 15);
   ESP_LOGV(TAG, "Opening preferences with key '%s'", key.c_str());
   this->preferences_.begin(key.c_str());
+  this->register_flush_hook_();
 }
 
 ESPPreferenceObject ESPPreferences::make_preference(size_t length, uint32_t type) {
@@ -221,7 +336,46 @@ ESPPreferenceObject ESPPreferences::make_preference(size_t length, uint32_t type
   this->current_offset_++;
   return pref;
 }
+bool ESPPreferences::flush() {
+  if (!this->dirty_)
+    return true;
+  this->dirty_ = false;
+
+  ESP_LOGVV(TAG, "Committing %u preferences...", this->pending_.size());
+  bool success = true;
+  for (auto &pending : this->pending_) {
+    char key[32];
+    sprintf(key, "%u", pending.key);
+    uint32_t len = pending.data.size() * 4;
+    size_t ret = this->preferences_.putBytes(key, pending.data.data(), len);
+    if (ret != len) {
+      ESP_LOGV(TAG, "putBytes failed!");
+      success = false;
+    }
+  }
+  this->pending_.clear();
+  return success;
+}
 #endif
+void ESPPreferences::set_flush_interval(uint32_t flush_interval) { this->flush_interval_ = flush_interval; }
+void ESPPreferences::mark_dirty_() {
+  if (!this->dirty_) {
+    this->dirty_ = true;
+    this->dirty_since_ = millis();
+  }
+  if (this->flush_interval_ == 0)
+    this->flush();
+}
+void ESPPreferences::loop() {
+  if (this->dirty_ && millis() - this->dirty_since_ >= this->flush_interval_)
+    this->flush();
+}
+void ESPPreferences::register_flush_hook_() {
+  if (this->hook_registered_)
+    return;
+  this->hook_registered_ = true;
+  add_shutdown_hook([this](const char *cause) { this->flush(); });
+}
 uint32_t ESPPreferenceObject::calculate_crc_() const {
   uint32_t crc = this->type_;
   for (size_t i = 0; i < this->length_words_; i++) {
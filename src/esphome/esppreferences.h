@@ -2,6 +2,7 @@
 #define ESPHOME_ESPPREFERENCES_H
 
 #include <string>
+#include <vector>
 
 #ifdef ARDUINO_ARCH_ESP32
 #include <Preferences.h>
@@ -44,6 +45,22 @@ class ESPPreferences {
   ESPPreferenceObject make_preference(size_t length, uint32_t type);
   template<typename T> ESPPreferenceObject make_preference(uint32_t type);
 
+  /** Set how long saved preferences are collected before they're committed to flash together.
+   *
+   * Saving a preference only writes RTC memory (ESP8266) or a RAM buffer (ESP32), the slow flash write happens
+   * at most once per interval from loop(), and always in the shutdown hooks. Defaults to 1000ms, 0 commits
+   * on every save.
+   *
+   * @param flush_interval The commit interval in milliseconds.
+   */
+  void set_flush_interval(uint32_t flush_interval);
+
+  /// Commit all pending preferences to flash now.
+  bool flush();
+
+  /// Called by the application each loop iteration to commit pending preferences once the interval is over.
+  void loop();
+
 #ifdef ARDUINO_ARCH_ESP8266
   /** On the ESP8266, we can't override the first 128 bytes during OTA uploads
    * as the eboot parameters are stored there. Writing there during an OTA upload
@@ -54,17 +71,47 @@ class ESPPreferences {
    */
   void prevent_write(bool prevent);
   bool is_prevent_write();
+
+#ifdef USE_ESP8266_PREFERENCES_FLASH
+  /** Set the number of flash sectors the preference log rotates through. Defaults to 1.
+   *
+   * With a single sector, the sector after the SPIFFS area is erased and rewritten on each flush like in
+   * older versions. With 2 or more sectors, changes are appended to a log instead; the additional sectors are
+   * taken from the end of the SPIFFS area (a warning is logged at boot). More sectors spread the erase cycles.
+   * Must be called before begin().
+   */
+  void set_flash_sectors(uint8_t flash_sectors);
+#endif
 #endif
 
  protected:
   friend ESPPreferenceObject;
 
+  /// Remember that something needs to be committed, starting the flush interval.
+  void mark_dirty_();
+  /// Make sure pending preferences are committed before a reboot or deep sleep.
+  void register_flush_hook_();
+
   uint32_t current_offset_;
+  uint32_t flush_interval_{1000};
+  bool dirty_{false};
+  uint32_t dirty_since_{0};
+  bool hook_registered_{false};
 #ifdef ARDUINO_ARCH_ESP32
+  struct PendingWrite {
+    uint32_t key;
+    std::vector<uint32_t> data;
+  };
+
   Preferences preferences_;
+  /// Saved but not yet committed preferences, at most one per key.
+  std::vector<PendingWrite> pending_;
 #endif
 #ifdef ARDUINO_ARCH_ESP8266
   bool prevent_write_{false};
+#ifdef USE_ESP8266_PREFERENCES_FLASH
+  uint8_t flash_sectors_{1};
+#endif
 #endif
 };
 
@@ -0,0 +1,170 @@
+#include "esphome/esppreferences_log.h"
+
+#ifdef USE_ESP8266_PREFERENCES_FLASH
+
+#include <vector>
+
+ESPHOME_NAMESPACE_BEGIN
+
+ESPPreferenceLog::ESPPreferenceLog(ESPPreferenceFlash *flash, uint8_t sector_count, uint32_t *image,
+                                   uint16_t image_words)
+    : flash_(flash), sector_count_(sector_count), image_(image), image_words_(image_words) {}
+
+uint32_t ESPPreferenceLog::crc_(uint32_t header, const uint32_t *data, size_t words) {
+  uint32_t crc = 2166136261UL ^ header;
+  for (size_t i = 0; i < words; i++) {
+    crc *= 16777619UL;
+    crc ^= data[i];
+  }
+  return crc;
+}
+
+bool ESPPreferenceLog::load() {
+  std::vector<uint32_t> headers(this->sector_count_);
+  std::vector<bool> tried(this->sector_count_, false);
+  bool any_header = false;
+  for (uint8_t i = 0; i < this->sector_count_; i++) {
+    if (!this->flash_->read(i, 0, &headers[i], 1) || (headers[i] >> 24) != SECTOR_MAGIC) {
+      tried[i] = true;
+      continue;
+    }
+    uint32_t sequence = headers[i] & 0xFFFFFF;
+    if (!any_header || sequence >= this->sequence_) {
+      any_header = true;
+      // Make sure the next compaction creates the newest sector, even if this one turns out to be broken.
+      this->sequence_ = sequence;
+      this->active_sector_ = i;
+    }
+  }
+
+  while (true) {
+    // Try the newest sector that hasn't been tried yet
+    int newest = -1;
+    for (uint8_t i = 0; i < this->sector_count_; i++) {
+      if (!tried[i] && (newest == -1 || (headers[i] & 0xFFFFFF) > (headers[newest] & 0xFFFFFF)))
+        newest = i;
+    }
+    if (newest == -1) {
+      if (!any_header)
+        // No log at all: make the first compaction use sector 0 and keep the last sector intact.
+        this->active_sector_ = this->sector_count_ - 1;
+      return false;
+    }
+    tried[newest] = true;
+    if (this->replay_(newest))
+      return true;
+  }
+}
+
+bool ESPPreferenceLog::replay_(uint8_t sector) {
+  std::vector<uint32_t> buffer;
+  uint32_t offset = 4;
+  bool first = true;
+  bool torn = false;
+
+  while (offset + 8 <= SECTOR_SIZE) {
+    uint32_t header;
+    if (!this->flash_->read(sector, offset, &header, 1)) {
+      torn = true;
+      break;
+    }
+    if (header == ERASED)
+      // End of the log, we can append here
+      break;
+
+    const uint16_t rec_offset = (header >> 12) & 0xFFF;
+    const uint16_t rec_length = header & 0xFFF;
+    const uint32_t rec_size = (rec_length + 2) * 4;
+    if ((header >> 24) != RECORD_MAGIC || rec_offset + rec_length > this->image_words_ ||
+        offset + rec_size > SECTOR_SIZE) {
+      torn = true;
+      break;
+    }
+    // The first record of each sector must be a snapshot of the whole image.
+    if (first && (rec_offset != 0 || rec_length != this->image_words_))
+      return false;
+
+    buffer.resize(rec_length + 1);
+    if (!this->flash_->read(sector, offset + 4, buffer.data(), rec_length + 1) ||
+        crc_(header, buffer.data(), rec_length) != buffer[rec_length]) {
+      if (first)
+        return false;
+      torn = true;
+      break;
+    }
+
+    // Copy word by word, the image may live in memory that only supports 32-bit accesses.
+    for (uint16_t i = 0; i < rec_length; i++)
+      this->image_[rec_offset + i] = buffer[i];
+    offset += rec_size;
+    first = false;
+  }
+
+  if (first)
+    return false;
+
+  this->active_sector_ = sector;
+  this->write_offset_ = offset;
+  this->needs_compact_ = torn;
+  return true;
+}
+
+uint32_t ESPPreferenceLog::record_size_(uint16_t length) { return (uint32_t(length) + 2) * 4; }
+
+bool ESPPreferenceLog::write_record_(uint8_t sector, uint32_t position, uint16_t offset, uint16_t length) {
+  if (position + record_size_(length) > SECTOR_SIZE)
+    return false;
+
+  std::vector<uint32_t> buffer(length + 2);
+  buffer[0] = (RECORD_MAGIC << 24) | (uint32_t(offset) << 12) | length;
+  for (uint16_t i = 0; i < length; i++)
+    buffer[i + 1] = this->image_[offset + i];
+  buffer[length + 1] = crc_(buffer[0], &buffer[1], length);
+
+  return this->flash_->write(sector, position, buffer.data(), buffer.size());
+}
+
+bool ESPPreferenceLog::append(uint16_t offset, uint16_t length) {
+  if (!this->needs_compact_ && this->write_offset_ + record_size_(length) <= SECTOR_SIZE) {
+    if (this->write_record_(this->active_sector_, this->write_offset_, offset, length)) {
+      this->write_offset_ += record_size_(length);
+      return true;
+    }
+    // We don't know how much of the record made it to flash.
+    this->needs_compact_ = true;
+  }
+  // The snapshot at the start of the new sector contains this range too.
+  return this->compact();
+}
+
+bool ESPPreferenceLog::compact() {
+  if (this->sector_count_ < MIN_SECTORS)
+    return false;
+
+  // The active sector stays untouched (and stays the one that's loaded) until the new sector has its header.
+  // If anything fails, the changes that triggered this compaction are only in the image, so the next append
+  // has to compact again instead of appending a record that depends on them.
+  this->needs_compact_ = true;
+  const uint8_t next = (this->active_sector_ + 1) % this->sector_count_;
+  if (!this->flash_->erase(next))
+    return false;
+  if (!this->write_record_(next, 4, 0, this->image_words_))
+    return false;
+
+  // Write the header last, a sector without a header is ignored when loading.
+  const uint32_t header = (SECTOR_MAGIC << 24) | ((this->sequence_ + 1) & 0xFFFFFF);
+  if (!this->flash_->write(next, 0, &header, 1))
+    return false;
+
+  this->active_sector_ = next;
+  this->write_offset_ = 4 + record_size_(this->image_words_);
+  this->sequence_++;
+  this->needs_compact_ = false;
+  return true;
+}
+
+uint32_t ESPPreferenceLog::get_free_space() const { return SECTOR_SIZE - this->write_offset_; }
+
+ESPHOME_NAMESPACE_END
+
+#endif  // USE_ESP8266_PREFERENCES_FLASH
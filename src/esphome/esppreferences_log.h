@@ -0,0 +1,96 @@
+#ifndef ESPHOME_ESPPREFERENCES_LOG_H
+#define ESPHOME_ESPPREFERENCES_LOG_H
+
+#include "esphome/defines.h"
+
+#ifdef USE_ESP8266_PREFERENCES_FLASH
+
+#include <cstdint>
+#include <cstddef>
+
+ESPHOME_NAMESPACE_BEGIN
+
+/// Access to the flash sectors of a ESPPreferenceLog. Implemented on top of spi_flash or a simulated image.
+class ESPPreferenceFlash {
+ public:
+  static const uint32_t SECTOR_SIZE = 4096;
+
+  /// Read words from the sector with the given index (0 to sector count - 1) at a byte offset.
+  virtual bool read(uint8_t sector, uint32_t offset, uint32_t *data, size_t words) = 0;
+  /// Write words to an erased part of a sector at a byte offset.
+  virtual bool write(uint8_t sector, uint32_t offset, const uint32_t *data, size_t words) = 0;
+  /// Erase a whole sector (all bits set to 1).
+  virtual bool erase(uint8_t sector) = 0;
+};
+
+/** A log-structured, wear-levelled store for an image of words (the RTC user memory on the ESP8266).
+ *
+ * Instead of erasing and rewriting a sector for each change, changed word ranges are appended as records to the
+ * active sector. Only once that sector is full the log moves on to the next sector of a ring of sectors,
+ * which starts with a snapshot of the whole image; this is the only time a sector is erased.
+ *
+ * Layout (all words little endian):
+ *  - sector header: SECTOR_MAGIC << 24 | sequence (24 bits), the newest sector has the highest sequence
+ *  - records: RECORD_MAGIC << 24 | offset << 12 | length, then length data words, then a CRC word
+ *
+ * Erased flash reads as 0xFFFFFFFF which ends the log of a sector. A record with an invalid CRC (for example
+ * after a power loss during a write) also ends it, and forces the next append to start a new sector.
+ *
+ * At least 2 sectors are required: the active sector stays valid until the snapshot and header of the next one
+ * have been written, so a power loss at any point keeps the last committed image.
+ */
+class ESPPreferenceLog {
+ public:
+  ESPPreferenceLog(ESPPreferenceFlash *flash, uint8_t sector_count, uint32_t *image, uint16_t image_words);
+
+  static const uint8_t MIN_SECTORS = 2;
+
+  /** Load the image from the newest sector with a valid snapshot and replay its records.
+   *
+   * @return Whether a valid log was found. If not, the image is left untouched and the first compaction
+   *         starts the log in sector 0, so the last sector (where older versions kept a plain image) stays
+   *         intact until the log is complete.
+   */
+  bool load();
+
+  /// Append a record for the image words [offset, offset + length), starting a new sector if required.
+  bool append(uint16_t offset, uint16_t length);
+
+  /// Move on to the next sector and write a snapshot of the whole image to it. The active sector only changes
+  /// once the new sector is complete.
+  bool compact();
+
+  /// The number of bytes left in the active sector.
+  uint32_t get_free_space() const;
+
+ protected:
+  static const uint32_t SECTOR_SIZE = ESPPreferenceFlash::SECTOR_SIZE;
+  static const uint32_t SECTOR_MAGIC = 0xE5;
+  static const uint32_t RECORD_MAGIC = 0xA5;
+  static const uint32_t ERASED = 0xFFFFFFFF;
+
+  static uint32_t crc_(uint32_t header, const uint32_t *data, size_t words);
+
+  /// Replay the records of a sector, returns false if it doesn't start with a valid snapshot.
+  bool replay_(uint8_t sector);
+  /// Write a record for the image words [offset, offset + length) at a byte position of a sector.
+  bool write_record_(uint8_t sector, uint32_t position, uint16_t offset, uint16_t length);
+  static uint32_t record_size_(uint16_t length);
+
+  ESPPreferenceFlash *flash_;
+  uint8_t sector_count_;
+  uint32_t *image_;
+  uint16_t image_words_;
+  uint8_t active_sector_{0};
+  uint32_t sequence_{0};
+  /// Byte offset of the next record in the active sector
+  uint32_t write_offset_{0};
+  /// Whether the active sector can't be appended to (no valid log or a torn record).
+  bool needs_compact_{true};
+};
+
+ESPHOME_NAMESPACE_END
+
+#endif  // USE_ESP8266_PREFERENCES_FLASH
+
+#endif  // ESPHOME_ESPPREFERENCES_LOG_H
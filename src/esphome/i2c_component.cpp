@@ -175,6 +175,100 @@ bool I2CComponent::write_byte(uint8_t address, uint8_t a_register, uint8_t data)
 bool I2CComponent::write_byte_16(uint8_t address, uint8_t a_register, uint16_t data) {
   return this->write_bytes_16(address, a_register, &data, 1);
 }
+void I2CComponent::submit(I2CTransaction &&transaction) {
+  PendingTransaction pending;
+  pending.transaction = std::move(transaction);
+  pending.submitted = millis();
+  pending.written = 0;
+  pending.converting = false;
+  this->transactions_.push_back(std::move(pending));
+}
+void I2CComponent::submit_read(uint8_t address, uint8_t a_register, uint8_t len, uint32_t conversion,
+                               I2CTransaction::callback_t &&callback) {
+  I2CTransaction transaction;
+  transaction.address = address;
+  transaction.write.push_back(a_register);
+  transaction.conversion = conversion;
+  transaction.read_length = len;
+  transaction.callback = std::move(callback);
+  this->submit(std::move(transaction));
+}
+void I2CComponent::submit_write(uint8_t address, uint8_t a_register, const uint8_t *data, uint8_t len,
+                                I2CTransaction::callback_t &&callback) {
+  I2CTransaction transaction;
+  transaction.address = address;
+  transaction.write.reserve(len + 1);
+  transaction.write.push_back(a_register);
+  transaction.write.insert(transaction.write.end(), data, data + len);
+  transaction.conversion = 0;
+  transaction.read_length = 0;
+  transaction.callback = std::move(callback);
+  this->submit(std::move(transaction));
+}
+void I2CComponent::set_transaction_timeout(uint32_t transaction_timeout) {
+  this->transaction_timeout_ = transaction_timeout;
+}
+void I2CComponent::loop() {
+  std::vector<uint8_t> data;
+  for (size_t i = 0; i < this->transactions_.size();) {
+    bool success = false;
+    if (!this->step_(this->transactions_[i], data, success)) {
+      i++;
+      continue;
+    }
+
+    // Remove the transaction before calling back, the callback may submit new transactions.
+    auto callback = std::move(this->transactions_[i].transaction.callback);
+    this->transactions_.erase(this->transactions_.begin() + i);
+    if (callback)
+      callback(success, data.data());
+  }
+}
+bool I2CComponent::step_(PendingTransaction &pending, std::vector<uint8_t> &data, bool &success) {
+  const I2CTransaction &transaction = pending.transaction;
+  const uint32_t now = millis();
+  if (pending.converting) {
+    if (now - pending.written < transaction.conversion)
+      return false;
+    data.resize(transaction.read_length);
+    success = this->raw_receive(transaction.address, data.data(), transaction.read_length);
+    return true;
+  }
+
+  if (now - pending.submitted > this->transaction_timeout_) {
+    ESP_LOGW(TAG, "Transaction for address 0x%02X timed out", transaction.address);
+    return true;
+  }
+  const size_t index = &pending - this->transactions_.data();
+  if (this->is_address_busy_(transaction.address, index))
+    return false;
+
+  if (!transaction.write.empty()) {
+    this->raw_begin_transmission(transaction.address);
+    this->raw_write(transaction.address, transaction.write.data(), transaction.write.size());
+    if (!this->raw_end_transmission(transaction.address))
+      return true;
+  }
+  if (transaction.read_length == 0) {
+    success = true;
+    return true;
+  }
+  if (transaction.conversion == 0) {
+    data.resize(transaction.read_length);
+    success = this->raw_receive(transaction.address, data.data(), transaction.read_length);
+    return true;
+  }
+  pending.converting = true;
+  pending.written = now;
+  return false;
+}
+bool I2CComponent::is_address_busy_(uint8_t address, size_t index) const {
+  for (size_t i = 0; i < index; i++) {
+    if (this->transactions_[i].transaction.address == address)
+      return true;
+  }
+  return false;
+}
 
 I2CDevice::I2CDevice(I2CComponent *parent, uint8_t address) : address_(address), parent_(parent) {}
 
@@ -203,6 +297,14 @@ bool I2CDevice::write_bytes_16(uint8_t a_register, const uint16_t *data, uint8_t
 bool I2CDevice::write_byte_16(uint8_t a_register, uint16_t data) {  // NOLINT
   return this->parent_->write_byte_16(this->address_, a_register, data);
 }
+void I2CDevice::submit_read(uint8_t a_register, uint8_t len, uint32_t conversion,  // NOLINT
+                            I2CTransaction::callback_t &&callback) {
+  this->parent_->submit_read(this->address_, a_register, len, conversion, std::move(callback));
+}
+void I2CDevice::submit_write(uint8_t a_register, const uint8_t *data, uint8_t len,  // NOLINT
+                             I2CTransaction::callback_t &&callback) {
+  this->parent_->submit_write(this->address_, a_register, data, len, std::move(callback));
+}
 void I2CDevice::set_parent(I2CComponent *parent) { this->parent_ = parent; }
 
 #ifdef ARDUINO_ARCH_ESP32
@@ -7,11 +7,28 @@
 
 #include "esphome/component.h"
 #include <Wire.h>
+#include <functional>
+#include <vector>
 
 ESPHOME_NAMESPACE_BEGIN
 
 #define LOG_I2C_DEVICE(this) ESP_LOGCONFIG(TAG, "  Address: 0x%02X", this->address_);
 
+/// A queued i2c transaction, see I2CComponent::submit.
+struct I2CTransaction {
+  using callback_t = std::function<void(bool success, const uint8_t *data)>;
+
+  uint8_t address;
+  /// The bytes written in one transmission (usually the register followed by data). May be empty for a pure read.
+  std::vector<uint8_t> write;
+  /// The time in ms between writing and reading. The bus is used for other transactions in the meantime.
+  uint32_t conversion;
+  /// The number of bytes to read after writing, 0 for a write-only transaction.
+  uint8_t read_length;
+  /// Called with whether all bus operations succeeded and the read_length bytes that were read.
+  callback_t callback;
+};
+
 /** The I2CComponent is the base of ESPHome's i2c communication.
  *
  * It handles setting up the bus (with pins, clock frequency) and provides nice helper functions to
@@ -94,6 +111,25 @@ class I2CComponent : public Component {
   /// Write a single 16-bit word of data into the specified register of address. Return true if successful.
   bool write_byte_16(uint8_t address, uint8_t a_register, uint16_t data);
 
+  /** Queue a transaction, it is run from loop() without blocking the caller.
+   *
+   * Transactions for the same address are run in the order they were submitted, a transaction waiting for its
+   * conversion time only delays transactions for the same address. A transaction that can't be started within the
+   * transaction timeout fails.
+   */
+  void submit(I2CTransaction &&transaction);
+
+  /// Queue reading len bytes from a register, with conversion ms between writing the register and reading.
+  void submit_read(uint8_t address, uint8_t a_register, uint8_t len, uint32_t conversion,
+                   I2CTransaction::callback_t &&callback);
+
+  /// Queue writing len bytes to a register. The data is copied.
+  void submit_write(uint8_t address, uint8_t a_register, const uint8_t *data, uint8_t len,
+                    I2CTransaction::callback_t &&callback = nullptr);
+
+  /// Set the time in ms a queued transaction may wait before it fails, defaults to 1000ms.
+  void set_transaction_timeout(uint32_t transaction_timeout);
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Begin a write transmission to an address.
@@ -125,10 +161,27 @@ class I2CComponent : public Component {
   /// Setup the i2c. bus
   void setup() override;
   void dump_config() override;
+  /// Run the queued transactions.
+  void loop() override;
   /// Set a very high setup priority to make sure it's loaded before all other hardware.
   float get_setup_priority() const override;
 
  protected:
+  struct PendingTransaction {
+    I2CTransaction transaction;
+    uint32_t submitted;
+    /// The time the write part was done, only valid if converting is true.
+    uint32_t written;
+    bool converting;
+  };
+
+  /// Whether a transaction before index is queued for the address.
+  bool is_address_busy_(uint8_t address, size_t index) const;
+  /// Run the next step of a transaction. Returns true if it's done, success is then set.
+  bool step_(PendingTransaction &pending, std::vector<uint8_t> &data, bool &success);
+
+  std::vector<PendingTransaction> transactions_;
+  uint32_t transaction_timeout_{1000};
   TwoWire *wire_;
   uint8_t sda_pin_;
   uint8_t scl_pin_;
@@ -210,6 +263,13 @@ class I2CDevice {
   /// Write a single 16-bit word of data into the specified register. Return true if successful.
   bool write_byte_16(uint8_t a_register, uint16_t data);  // NOLINT
 
+  /// Queue reading len bytes from a register without blocking, see I2CComponent::submit_read.
+  void submit_read(uint8_t a_register, uint8_t len, uint32_t conversion, I2CTransaction::callback_t &&callback);
+
+  /// Queue writing len bytes to a register without blocking, see I2CComponent::submit_write.
+  void submit_write(uint8_t a_register, const uint8_t *data, uint8_t len,
+                    I2CTransaction::callback_t &&callback = nullptr);
+
   uint8_t address_;
   I2CComponent *parent_;
 };
@@ -26,38 +26,94 @@ void MCP23017::setup() {
     return;
   }
 
-  // all pins input
-  this->write_reg_(MCP23017_IODIRA, 0xFF);
-  this->write_reg_(MCP23017_IODIRB, 0xFF);
+  if (this->interrupt_pin_ != nullptr) {
+    this->interrupt_pin_->setup();
+    // MIRROR: INTA and INTB are both driven by changes on either side
+    this->write_reg_(MCP23017_IOCONA, iocon | 0x40);
+  }
+
+  // all pins input, bring the shadow registers in sync with the chip
+  this->write_reg_pair_(MCP23017_IODIRA, this->iodir_);
+  this->write_reg_pair_(MCP23017_GPPUA, this->gppu_);
+  this->write_reg_pair_(MCP23017_OLATA, this->olat_);
+
+  // Don't lose the outputs of a batch that is still open on shutdown.
+  add_shutdown_hook([this](const char *cause) {
+    if (this->output_dirty_)
+      this->write_outputs_();
+  });
+}
+void MCP23017::loop() {
+  if (this->output_dirty_ && this->batch_depth_ == 0)
+    this->write_outputs_();
+
+  // INT is active low and stays asserted until GPIO is read, so checking its level is enough.
+  if (this->interrupt_pin_ == nullptr || !this->interrupt_pin_->digital_read())
+    this->input_valid_ = false;
+}
+void MCP23017::dump_config() {
+  ESP_LOGCONFIG(TAG, "MCP23017:");
+  LOG_I2C_DEVICE(this);
+  LOG_PIN("  Interrupt Pin: ", this->interrupt_pin_);
+  if (this->is_failed()) {
+    ESP_LOGE(TAG, "Communication with MCP23017 failed!");
+  }
+}
+void MCP23017::set_interrupt_pin(const GPIOInputPin &interrupt_pin) { this->interrupt_pin_ = interrupt_pin.copy(); }
+void MCP23017::begin_batch() { this->batch_depth_++; }
+void MCP23017::commit_batch() {
+  if (this->batch_depth_ == 0 || --this->batch_depth_ != 0)
+    return;
+  if (this->output_dirty_)
+    this->write_outputs_();
 }
 bool MCP23017::digital_read(uint8_t pin) {
-  uint8_t bit = pin % 8;
-  uint8_t reg_addr = pin < 8 ? MCP23017_GPIOA : MCP23017_GPIOB;
-  uint8_t value = 0;
-  this->read_reg_(reg_addr, &value);
-  return value & (1 << bit);
+  if (!this->input_valid_) {
+    // GPIOA and GPIOB in one burst
+    uint8_t data[2];
+    if (!this->is_failed() && this->read_bytes(MCP23017_GPIOA, data, 2)) {
+      this->gpio_ = data[0] | (uint16_t(data[1]) << 8);
+      this->input_valid_ = true;
+      this->status_clear_warning();
+    } else {
+      // Keep returning the last known state, but make the failure visible
+      this->status_set_warning();
+    }
+  }
+  return this->gpio_ & (1 << pin);
 }
 void MCP23017::digital_write(uint8_t pin, bool value) {
-  uint8_t reg_addr = pin < 8 ? MCP23017_OLATA : MCP23017_OLATB;
-  this->update_reg_(pin, value, reg_addr);
+  if (value)
+    this->olat_ |= 1 << pin;
+  else
+    this->olat_ &= ~(1 << pin);
+  this->output_dirty_ = true;
+  if (this->batch_depth_ == 0)
+    this->write_outputs_();
 }
 void MCP23017::pin_mode(uint8_t pin, uint8_t mode) {
-  uint8_t iodir = pin < 8 ? MCP23017_IODIRA : MCP23017_IODIRB;
-  uint8_t gppu = pin < 8 ? MCP23017_GPPUA : MCP23017_GPPUB;
+  const uint16_t mask = 1 << pin;
   switch (mode) {
     case MCP23017_INPUT:
-      this->update_reg_(pin, true, iodir);
+      this->iodir_ |= mask;
+      this->gppu_ &= ~mask;
       break;
     case MCP23017_INPUT_PULLUP:
-      this->update_reg_(pin, true, iodir);
-      this->update_reg_(pin, true, gppu);
+      this->iodir_ |= mask;
+      this->gppu_ |= mask;
       break;
     case MCP23017_OUTPUT:
-      this->update_reg_(pin, false, iodir);
+      this->iodir_ &= ~mask;
       break;
     default:
-      break;
+      return;
   }
+  this->write_reg_pair_(MCP23017_IODIRA, this->iodir_);
+  this->write_reg_pair_(MCP23017_GPPUA, this->gppu_);
+  if (this->interrupt_pin_ != nullptr)
+    // Signal changes on all input pins
+    this->write_reg_pair_(MCP23017_GPINTENA, this->iodir_);
+  this->input_valid_ = false;
 }
 float MCP23017::get_setup_priority() const { return setup_priority::HARDWARE; }
 bool MCP23017::read_reg_(uint8_t reg, uint8_t *value) {
@@ -72,34 +128,24 @@ bool MCP23017::write_reg_(uint8_t reg, uint8_t value) {
 
   return this->write_byte(reg, value);
 }
-void MCP23017::update_reg_(uint8_t pin, bool pin_value, uint8_t reg_addr) {
-  uint8_t bit = pin % 8;
-  uint8_t reg_value = 0;
-  if (reg_addr == MCP23017_OLATA) {
-    reg_value = this->olat_a_;
-  } else if (reg_addr == MCP23017_OLATB) {
-    reg_value = this->olat_b_;
-  } else {
-    this->read_reg_(reg_addr, &reg_value);
+void MCP23017::write_outputs_() {
+  if (this->write_reg_pair_(MCP23017_OLATA, this->olat_)) {
+    this->output_dirty_ = false;
   }
+}
+bool MCP23017::write_reg_pair_(uint8_t reg_a, uint16_t value) {
+  if (this->is_failed())
+    return false;
 
-  if (pin_value)
-    reg_value |= 1 << bit;
-  else
-    reg_value &= ~(1 << bit);
-
-  this->write_reg_(reg_addr, reg_value);
-
-  if (reg_addr == MCP23017_OLATA) {
-    this->olat_a_ = reg_value;
-  } else if (reg_addr == MCP23017_OLATB) {
-    this->olat_b_ = reg_value;
-  }
+  // With IOCON.BANK=0 the B register directly follows the A register
+  uint8_t data[2] = {uint8_t(value & 0xFF), uint8_t(value >> 8)};
+  return this->write_bytes(reg_a, data, 2);
 }
 
 MCP23017GPIOInputPin::MCP23017GPIOInputPin(MCP23017 *parent, uint8_t pin, uint8_t mode, bool inverted)
     : GPIOInputPin(pin, mode, inverted), parent_(parent) {}
 GPIOPin *MCP23017GPIOInputPin::copy() const { return new MCP23017GPIOInputPin(*this); }
+bool MCP23017GPIOInputPin::is_internal() const { return false; }
 void MCP23017GPIOInputPin::setup() { this->pin_mode(this->mode_); }
 void MCP23017GPIOInputPin::pin_mode(uint8_t mode) { this->parent_->pin_mode(this->pin_, mode); }
 bool MCP23017GPIOInputPin::digital_read() { return this->parent_->digital_read(this->pin_) != this->inverted_; }
@@ -109,6 +155,7 @@ void MCP23017GPIOInputPin::digital_write(bool value) {
 MCP23017GPIOOutputPin::MCP23017GPIOOutputPin(MCP23017 *parent, uint8_t pin, uint8_t mode, bool inverted)
     : GPIOOutputPin(pin, mode, inverted), parent_(parent) {}
 GPIOPin *MCP23017GPIOOutputPin::copy() const { return new MCP23017GPIOOutputPin(*this); }
+bool MCP23017GPIOOutputPin::is_internal() const { return false; }
 void MCP23017GPIOOutputPin::setup() { this->pin_mode(this->mode_); }
 void MCP23017GPIOOutputPin::pin_mode(uint8_t mode) { this->parent_->pin_mode(this->pin_, mode); }
 bool MCP23017GPIOOutputPin::digital_read() { return this->parent_->digital_read(this->pin_) != this->inverted_; }
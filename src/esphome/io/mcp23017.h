@@ -58,9 +58,31 @@ class MCP23017 : public Component, public I2CDevice {
 
   MCP23017GPIOOutputPin make_output_pin(uint8_t pin, bool inverted = false);
 
+  /** Set the pin the INTA output of the MCP23017 is connected to (INTA and INTB are mirrored).
+   *
+   * Without it, the inputs are read at most once per loop cycle. With it, they're only read again after
+   * the MCP23017 signals a change on an input pin.
+   */
+  void set_interrupt_pin(const GPIOInputPin &interrupt_pin);
+
+  /** Hold back output writes until commit_batch(), so that several pins change in a single bus transfer.
+   *
+   * By default every digital_write() is written to the bus right away, which keeps pulses and writes from
+   * shutdown hooks working. Batches can be nested, only the outermost commit_batch() writes the outputs.
+   * The pins never batch on their own, lambdas and custom components that set several pins of this expander at
+   * once (for example a relay board) wrap their writes in a batch.
+   */
+  void begin_batch();
+  void commit_batch();
+
   void setup() override;
+  /// Retry failed output writes and invalidate the cached inputs.
+  void loop() override;
+  void dump_config() override;
 
+  /// Read the value of a pin, from the cached inputs if they're still valid.
   bool digital_read(uint8_t pin);
+  /// Write the value of a pin, held back until commit_batch() inside a batch.
   void digital_write(uint8_t pin, bool value);
   void pin_mode(uint8_t pin, uint8_t mode);
 
@@ -71,11 +93,23 @@ class MCP23017 : public Component, public I2CDevice {
   bool read_reg_(uint8_t reg, uint8_t *value);
   // write a value to a given register
   bool write_reg_(uint8_t reg, uint8_t value);
-  // update registers with given pin value.
-  void update_reg_(uint8_t pin, bool pin_value, uint8_t reg_a);
-
-  uint8_t olat_a_{0x00};
-  uint8_t olat_b_{0x00};
+  // write the A and B register of a pair in one transmission (value of A in the lower byte)
+  bool write_reg_pair_(uint8_t reg_a, uint16_t value);
+  /// Write olat_ to the chip.
+  void write_outputs_();
+
+  // Shadow registers, pin 0-7 are the lower byte (A side), 8-15 the upper byte (B side)
+  uint16_t iodir_{0xFFFF};
+  uint16_t gppu_{0x0000};
+  uint16_t olat_{0x0000};
+  uint16_t gpio_{0x0000};
+  GPIOPin *interrupt_pin_{nullptr};
+  /// Whether gpio_ is up to date.
+  bool input_valid_{false};
+  /// Whether olat_ has changed since it was last written.
+  bool output_dirty_{false};
+  /// The nesting depth of begin_batch().
+  uint8_t batch_depth_{0};
 };
 
 class MCP23017GPIOInputPin : public GPIOInputPin {
@@ -88,6 +122,7 @@ class MCP23017GPIOInputPin : public GPIOInputPin {
   void pin_mode(uint8_t mode) override;
   bool digital_read() override;
   void digital_write(bool value) override;
+  bool is_internal() const override;
 
  protected:
   MCP23017 *parent_;
@@ -103,6 +138,7 @@ class MCP23017GPIOOutputPin : public GPIOOutputPin {
   void pin_mode(uint8_t mode) override;
   bool digital_read() override;
   void digital_write(bool value) override;
+  bool is_internal() const override;
 
  protected:
   MCP23017 *parent_;
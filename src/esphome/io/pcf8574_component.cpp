@@ -28,19 +28,48 @@ void PCF8574Component::setup() {
     return;
   }
 
+  if (this->interrupt_pin_ != nullptr)
+    this->interrupt_pin_->setup();
+
   this->write_gpio_();
   this->read_gpio_();
+
+  // Don't lose the outputs of a batch that is still open on shutdown.
+  add_shutdown_hook([this](const char *cause) {
+    if (this->output_dirty_)
+      this->write_gpio_();
+  });
+}
+void PCF8574Component::loop() {
+  if (this->output_dirty_ && this->batch_depth_ == 0)
+    this->write_gpio_();
+
+  // INT is active low and stays asserted until the port is read, so checking its level is enough.
+  if (this->interrupt_pin_ == nullptr || !this->interrupt_pin_->digital_read())
+    this->input_valid_ = false;
+}
+void PCF8574Component::set_interrupt_pin(const GPIOInputPin &interrupt_pin) {
+  this->interrupt_pin_ = interrupt_pin.copy();
+}
+void PCF8574Component::begin_batch() { this->batch_depth_++; }
+void PCF8574Component::commit_batch() {
+  if (this->batch_depth_ == 0 || --this->batch_depth_ != 0)
+    return;
+  if (this->output_dirty_)
+    this->write_gpio_();
 }
 void PCF8574Component::dump_config() {
   ESP_LOGCONFIG(TAG, "PCF8574:");
   ESP_LOGCONFIG(TAG, "    Address: 0x%02X", this->address_);
   ESP_LOGCONFIG(TAG, "    Is PCF8575: %s", YESNO(this->pcf8575_));
+  LOG_PIN("    Interrupt Pin: ", this->interrupt_pin_);
   if (this->is_failed()) {
     ESP_LOGE(TAG, "Communication with PCF8574 failed!");
   }
 }
 bool PCF8574Component::digital_read(uint8_t pin) {
-  this->read_gpio_();
+  if (!this->input_valid_)
+    this->read_gpio_();
   return this->input_mask_ & (1 << pin);
 }
 void PCF8574Component::digital_write(uint8_t pin, bool value) {
@@ -50,7 +79,9 @@ void PCF8574Component::digital_write(uint8_t pin, bool value) {
     this->port_mask_ &= ~(1 << pin);
   }
 
-  this->write_gpio_();
+  this->output_dirty_ = true;
+  if (this->batch_depth_ == 0)
+    this->write_gpio_();
 }
 void PCF8574Component::pin_mode(uint8_t pin, uint8_t mode) {
   switch (mode) {
@@ -90,6 +121,7 @@ bool PCF8574Component::read_gpio_() {
     this->input_mask_ = data;
   }
 
+  this->input_valid_ = true;
   this->status_clear_warning();
   return true;
 }
@@ -111,6 +143,7 @@ bool PCF8574Component::write_gpio_() {
     this->status_set_warning();
     return false;
   }
+  this->output_dirty_ = false;
   this->status_clear_warning();
   return true;
 }
@@ -130,6 +163,7 @@ void PCF8574GPIOInputPin::digital_write(bool value) {
 PCF8574GPIOInputPin::PCF8574GPIOInputPin(PCF8574Component *parent, uint8_t pin, uint8_t mode, bool inverted)
     : GPIOInputPin(pin, mode, inverted), parent_(parent) {}
 GPIOPin *PCF8574GPIOInputPin::copy() const { return new PCF8574GPIOInputPin(*this); }
+bool PCF8574GPIOInputPin::is_internal() const { return false; }
 void PCF8574GPIOInputPin::pin_mode(uint8_t mode) { this->parent_->pin_mode(this->pin_, mode); }
 
 void PCF8574GPIOOutputPin::setup() { this->pin_mode(this->mode_); }
@@ -140,6 +174,7 @@ void PCF8574GPIOOutputPin::digital_write(bool value) {
 PCF8574GPIOOutputPin::PCF8574GPIOOutputPin(PCF8574Component *parent, uint8_t pin, uint8_t mode, bool inverted)
     : GPIOOutputPin(pin, mode, inverted), parent_(parent) {}
 GPIOPin *PCF8574GPIOOutputPin::copy() const { return new PCF8574GPIOOutputPin(*this); }
+bool PCF8574GPIOOutputPin::is_internal() const { return false; }
 void PCF8574GPIOOutputPin::pin_mode(uint8_t mode) { this->parent_->pin_mode(this->pin_, mode); }
 
 }  // namespace io
@@ -52,13 +52,32 @@ class PCF8574Component : public Component, public I2CDevice {
    */
   PCF8574GPIOOutputPin make_output_pin(uint8_t pin, bool inverted = false);
 
+  /** Set the pin the INT output of the PCF8574 is connected to.
+   *
+   * Without it, the inputs are read at most once per loop cycle. With it, they're only read again after
+   * the PCF8574 signals a change.
+   */
+  void set_interrupt_pin(const GPIOInputPin &interrupt_pin);
+
+  /** Hold back output writes until commit_batch(), so that several pins change in a single bus transfer.
+   *
+   * By default every digital_write() is written to the bus right away, which keeps pulses and writes from
+   * shutdown hooks working. Batches can be nested, only the outermost commit_batch() writes the outputs.
+   * The pins never batch on their own, lambdas and custom components that set several pins of this expander at
+   * once (for example a relay board) wrap their writes in a batch.
+   */
+  void begin_batch();
+  void commit_batch();
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Check i2c availability and setup masks
   void setup() override;
-  /// Helper function to read the value of a pin.
+  /// Retry failed output writes and invalidate the cached inputs.
+  void loop() override;
+  /// Helper function to read the value of a pin, from the cached inputs if they're still valid.
   bool digital_read(uint8_t pin);
-  /// Helper function to write the value of a pin.
+  /// Helper function to write the value of a pin, held back until commit_batch() inside a batch.
   void digital_write(uint8_t pin, bool value);
   /// Helper function to set the pin mode of a pin.
   void pin_mode(uint8_t pin, uint8_t mode);
@@ -76,6 +95,13 @@ class PCF8574Component : public Component, public I2CDevice {
   uint16_t input_mask_{0x00};
   uint16_t port_mask_{0x00};
   bool pcf8575_;  ///< TRUE->16-channel PCF8575, FALSE->8-channel PCF8574
+  GPIOPin *interrupt_pin_{nullptr};
+  /// Whether input_mask_ is up to date.
+  bool input_valid_{false};
+  /// Whether port_mask_ has changed since it was last written.
+  bool output_dirty_{false};
+  /// The nesting depth of begin_batch().
+  uint8_t batch_depth_{0};
 };
 
 /// Helper class to expose a PCF8574 pin as an internal input GPIO pin.
@@ -89,6 +115,7 @@ class PCF8574GPIOInputPin : public GPIOInputPin {
   void pin_mode(uint8_t mode) override;
   bool digital_read() override;
   void digital_write(bool value) override;
+  bool is_internal() const override;
 
  protected:
   PCF8574Component *parent_;
@@ -105,6 +132,7 @@ class PCF8574GPIOOutputPin : public GPIOOutputPin {
   void pin_mode(uint8_t mode) override;
   bool digital_read() override;
   void digital_write(bool value) override;
+  bool is_internal() const override;
 
  protected:
   PCF8574Component *parent_;
@@ -41,8 +41,10 @@ LightTraits CWWWLightOutput::get_traits() {
 void CWWWLightOutput::write_state(LightState *state) {
   float cold_white, warm_white;
   state->current_values_as_cwww(this->cold_white_mireds_, this->warm_white_mireds_, &cold_white, &warm_white);
+  output::OutputFrame::begin();
   this->cold_white_->set_level(cold_white);
   this->warm_white_->set_level(warm_white);
+  output::OutputFrame::commit();
 }
 CWWWLightOutput::CWWWLightOutput(float cold_white_mireds, float warm_white_mireds, FloatOutput *cold_white,
                                  FloatOutput *warm_white)
@@ -55,9 +57,11 @@ LightTraits RGBLightOutput::get_traits() { return {true, true, false, false}; }
 void RGBLightOutput::write_state(LightState *state) {
   float red, green, blue;
   state->current_values_as_rgb(&red, &green, &blue);
+  output::OutputFrame::begin();
   this->red_->set_level(red);
   this->green_->set_level(green);
   this->blue_->set_level(blue);
+  output::OutputFrame::commit();
 }
 RGBLightOutput::RGBLightOutput(FloatOutput *red, FloatOutput *green, FloatOutput *blue)
     : red_(red), green_(green), blue_(blue) {}
@@ -66,10 +70,12 @@ LightTraits RGBWLightOutput::get_traits() { return {true, true, true, false}; }
 void RGBWLightOutput::write_state(LightState *state) {
   float red, green, blue, white;
   state->current_values_as_rgbw(&red, &green, &blue, &white);
+  output::OutputFrame::begin();
   this->red_->set_level(red);
   this->green_->set_level(green);
   this->blue_->set_level(blue);
   this->white_->set_level(white);
+  output::OutputFrame::commit();
 }
 RGBWLightOutput::RGBWLightOutput(FloatOutput *red, FloatOutput *green, FloatOutput *blue, FloatOutput *white)
     : red_(red), green_(green), blue_(blue), white_(white) {}
@@ -84,11 +90,13 @@ void RGBWWLightOutput::write_state(LightState *state) {
   float red, green, blue, cold_white, warm_white;
   state->current_values_as_rgbww(this->cold_white_mireds_, this->warm_white_mireds_, &red, &green, &blue, &cold_white,
                                  &warm_white);
+  output::OutputFrame::begin();
   this->red_->set_level(red);
   this->green_->set_level(green);
   this->blue_->set_level(blue);
   this->cold_white_->set_level(cold_white);
   this->warm_white_->set_level(warm_white);
+  output::OutputFrame::commit();
 }
 RGBWWLightOutput::RGBWWLightOutput(float cold_white_mireds, float warm_white_mireds, FloatOutput *red,
                                    FloatOutput *green, FloatOutput *blue, FloatOutput *cold_white,
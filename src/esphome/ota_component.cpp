@@ -3,6 +3,7 @@
 #ifdef USE_OTA
 
 #include "esphome/ota_component.h"
+#include "esphome/ota_delta.h"
 #include "esphome/log.h"
 #include "esphome/esppreferences.h"
 #include "esphome/helpers.h"
@@ -10,9 +11,12 @@
 #include "esphome/util.h"
 
 #include <cstdio>
+#include <memory>
 #include <MD5Builder.h>
 #ifdef ARDUINO_ARCH_ESP32
 #include <Update.h>
+#include <esp_ota_ops.h>
+#include <rom/miniz.h>
 #endif
 #include <StreamString.h>
 
@@ -22,6 +26,110 @@ static const char *TAG = "ota";
 
 uint8_t OTA_VERSION_1_0 = 1;
 
+#ifdef ARDUINO_ARCH_ESP8266
+// Inflating needs a 32KiB dictionary, that doesn't fit next to the Updater buffer on the ESP8266.
+static const uint8_t OTA_SUPPORTED_FEATURES = OTA_FEATURE_PIPELINED | OTA_FEATURE_DELTA;
+/// Receive chunk size, a multiple of the flash sector size isn't possible with the ESP8266 heap.
+static const uint16_t OTA_CHUNK_SIZE = 2048;
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+static const uint8_t OTA_SUPPORTED_FEATURES = OTA_FEATURE_PIPELINED | OTA_FEATURE_DEFLATE | OTA_FEATURE_DELTA;
+/// Receive chunk size, one flash sector.
+static const uint16_t OTA_CHUNK_SIZE = 4096;
+
+/// Streaming zlib decompression using the miniz inflater in the ESP32 ROM.
+class OTAInflater {
+ public:
+  explicit OTAInflater(OTADeltaPatcher::write_output_t &&write_output) : write_output_(std::move(write_output)) {
+    tinfl_init(&this->decompressor_);
+  }
+
+  /// Decompress data and pass the output on. Returns false on a corrupt stream or write error.
+  bool write(const uint8_t *data, size_t len) {
+    while (true) {
+      size_t in_bytes = len;
+      size_t out_bytes = TINFL_LZ_DICT_SIZE - this->dict_offset_;
+      tinfl_status status = tinfl_decompress(&this->decompressor_, data, &in_bytes, this->dict_,
+                                             this->dict_ + this->dict_offset_, &out_bytes,
+                                             TINFL_FLAG_PARSE_ZLIB_HEADER | TINFL_FLAG_HAS_MORE_INPUT);
+      data += in_bytes;
+      len -= in_bytes;
+
+      if (out_bytes != 0) {
+        if (!this->write_output_(this->dict_ + this->dict_offset_, out_bytes))
+          return false;
+        this->dict_offset_ = (this->dict_offset_ + out_bytes) & (TINFL_LZ_DICT_SIZE - 1);
+      }
+
+      if (status < TINFL_STATUS_DONE) {
+        ESP_LOGW(TAG, "Decompressing image failed: %d", status);
+        return false;
+      }
+      if (status == TINFL_STATUS_DONE)
+        return true;
+      // Stop once all input is consumed and the dictionary wasn't filled (no more output pending).
+      if (len == 0 && status != TINFL_STATUS_HAS_MORE_OUTPUT)
+        return true;
+    }
+  }
+
+ protected:
+  OTADeltaPatcher::write_output_t write_output_;
+  tinfl_decompressor decompressor_;
+  uint8_t dict_[TINFL_LZ_DICT_SIZE];
+  size_t dict_offset_{0};
+};
+#endif
+
+static bool ota_write_image(const uint8_t *data, size_t len) {
+  return Update.write(const_cast<uint8_t *>(data), len) == len;
+}
+
+/// The size of the running image, patches are applied against it.
+static uint32_t ota_get_base_size() { return ESP.getSketchSize(); }
+
+/// Read from the running image.
+static bool ota_read_base(uint32_t offset, uint8_t *data, size_t len) {
+#ifdef ARDUINO_ARCH_ESP8266
+  // The running image starts at the beginning of the flash, which can only be read in aligned words.
+  uint32_t words[16];
+  while (len > 0) {
+    const uint32_t aligned = offset & ~3UL;
+    const size_t skip = offset - aligned;
+    const size_t n = std::min(len, sizeof(words) - skip);
+    if (!ESP.flashRead(aligned, words, (skip + n + 3) & ~3UL))
+      return false;
+    memcpy(data, reinterpret_cast<uint8_t *>(words) + skip, n);
+    offset += n;
+    data += n;
+    len -= n;
+  }
+  return true;
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  return esp_partition_read(esp_ota_get_running_partition(), offset, data, len) == ESP_OK;
+#endif
+}
+
+/// The MD5 of the running image as 32 hex characters.
+static std::string ota_get_base_md5() {
+  MD5Builder md5_builder{};
+  md5_builder.begin();
+  const uint32_t size = ota_get_base_size();
+  uint8_t block[256];
+  for (uint32_t offset = 0; offset < size; offset += sizeof(block)) {
+    const size_t n = std::min(size - offset, uint32_t(sizeof(block)));
+    if (!ota_read_base(offset, block, n))
+      return "";
+    md5_builder.add(block, n);
+    feed_wdt();
+  }
+  md5_builder.calculate();
+  char md5[33];
+  md5_builder.getChars(md5);
+  return md5;
+}
+
 void OTAComponent::setup() {
   this->server_ = new WiFiServer(this->port_);
   this->server_->begin();
@@ -64,11 +172,19 @@ void OTAComponent::handle_() {
   bool update_started = false;
   uint32_t total = 0;
   uint32_t last_progress = 0;
-  uint8_t buf[1024];
+  uint8_t buf[128];
   char *sbuf = reinterpret_cast<char *>(buf);
   uint32_t ota_size;
+  uint32_t stream_size;
   uint8_t ota_features;
-  (void) ota_features;
+  std::string base_md5;
+  std::unique_ptr<uint8_t[]> chunk;
+  std::unique_ptr<OTADeltaPatcher> patcher;
+  OTADeltaPatcher::write_output_t write_output = ota_write_image;
+  OTAResponseTypes write_error_code = OTA_RESPONSE_ERROR_WRITING_FLASH;
+#ifdef ARDUINO_ARCH_ESP32
+  std::unique_ptr<OTAInflater> inflater;
+#endif
 
   if (!this->client_.connected()) {
     this->client_ = this->server_->available();
@@ -100,6 +216,8 @@ void OTAComponent::handle_() {
 
   // Send OK and version - 2 bytes
   this->client_.write(OTA_RESPONSE_OK);
+  // Stay at version 1.0 so that existing uploaders keep working, the extensions are negotiated with the
+  // features byte only. Clients that don't know about them send 0 and get the plain 1.0 exchange.
   this->client_.write(OTA_VERSION_1_0);
 
   // Read features - 1 byte
@@ -113,6 +231,15 @@ void OTAComponent::handle_() {
   // Acknowledge header - 1 byte
   this->client_.write(OTA_RESPONSE_HEADER_OK);
 
+  if (ota_features != 0) {
+    // Send accepted features - 1 byte and chunk size - 2 bytes MSB first
+    ota_features &= OTA_SUPPORTED_FEATURES;
+    buf[0] = ota_features;
+    buf[1] = OTA_CHUNK_SIZE >> 8;
+    buf[2] = OTA_CHUNK_SIZE & 0xFF;
+    this->client_.write(buf, 3);
+  }
+
   if (!this->password_.empty()) {
     this->client_.write(OTA_RESPONSE_REQUEST_AUTH);
     MD5Builder md5_builder{};
@@ -172,6 +299,17 @@ void OTAComponent::handle_() {
   // Acknowledge auth OK - 1 byte
   this->client_.write(OTA_RESPONSE_AUTH_OK);
 
+  if (ota_features & OTA_FEATURE_DELTA) {
+    // Send running image MD5, 32 bytes hex MD5
+    base_md5 = ota_get_base_md5();
+    ESP_LOGV(TAG, "Running image MD5 is %s", base_md5.c_str());
+    if (base_md5.size() != 32 ||
+        this->client_.write(reinterpret_cast<const uint8_t *>(base_md5.c_str()), 32) != 32) {
+      ESP_LOGW(TAG, "Writing running image MD5 failed!");
+      goto error;
+    }
+  }
+
   // Read size, 4 bytes MSB first
   if (!this->wait_receive_(buf, 4)) {
     ESP_LOGW(TAG, "Reading size failed!");
@@ -184,6 +322,36 @@ void OTAComponent::handle_() {
   }
   ESP_LOGV(TAG, "OTA size is %u bytes", ota_size);
 
+  stream_size = ota_size;
+  if (ota_features & (OTA_FEATURE_DEFLATE | OTA_FEATURE_DELTA)) {
+    // Read payload size, 4 bytes MSB first
+    if (!this->wait_receive_(buf, 4)) {
+      ESP_LOGW(TAG, "Reading payload size failed!");
+      goto error;
+    }
+    stream_size = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+      stream_size <<= 8;
+      stream_size |= buf[i];
+    }
+    ESP_LOGV(TAG, "OTA payload size is %u bytes", stream_size);
+  }
+
+  if (ota_features & OTA_FEATURE_DELTA) {
+    // Read payload type, 1 byte
+    if (!this->wait_receive_(buf, 1)) {
+      ESP_LOGW(TAG, "Reading payload type failed!");
+      goto error;
+    }
+    if (buf[0] == 1) {
+      ESP_LOGD(TAG, "Applying patch against running image %s", base_md5.c_str());
+      patcher.reset(new OTADeltaPatcher(base_md5, ota_get_base_size(), ota_read_base, ota_write_image));
+      OTADeltaPatcher *patcher_ptr = patcher.get();
+      write_output = [patcher_ptr](const uint8_t *data, size_t len) { return patcher_ptr->write(data, len); };
+      write_error_code = OTA_RESPONSE_ERROR_DELTA;
+    }
+  }
+
 #ifdef ARDUINO_ARCH_ESP8266
   global_preferences.prevent_write(true);
 #endif
@@ -233,30 +401,68 @@ void OTAComponent::handle_() {
   ESP_LOGV(TAG, "Update: Binary MD5 is %s", sbuf);
   Update.setMD5(sbuf);
 
+  chunk.reset(new uint8_t[OTA_CHUNK_SIZE]);
+#ifdef ARDUINO_ARCH_ESP32
+  if (ota_features & OTA_FEATURE_DEFLATE) {
+    inflater.reset(new OTAInflater(OTADeltaPatcher::write_output_t(write_output)));
+    if (!patcher)
+      write_error_code = OTA_RESPONSE_ERROR_DECOMPRESSION;
+  }
+#endif
+
   // Acknowledge MD5 OK - 1 byte
   this->client_.write(OTA_RESPONSE_BIN_MD5_OK);
 
-  while (!Update.isFinished()) {
-    size_t available = this->wait_receive_(buf, 0);
-    if (!available) {
-      goto error;
+  while (total < stream_size) {
+    // Fill a whole chunk before writing, so that the flash is written in large blocks. In pipelined mode the
+    // client has already sent the next chunk, which the TCP stack receives while this one is written.
+    const size_t len = std::min(stream_size - total, uint32_t(OTA_CHUNK_SIZE));
+    for (size_t received = 0; received < len;) {
+      size_t available = this->wait_receive_(chunk.get() + received, 0, true, len - received);
+      if (!available) {
+        goto error;
+      }
+      received += available;
     }
 
-    uint32_t written = Update.write(buf, available);
-    if (written != available) {
-      ESP_LOGW(TAG, "Error writing binary data to flash: %u != %zu!", written, available);
-      error_code = OTA_RESPONSE_ERROR_WRITING_FLASH;
+    bool written;
+#ifdef ARDUINO_ARCH_ESP32
+    if (inflater) {
+      written = inflater->write(chunk.get(), len);
+    } else
+#endif
+    {
+      written = write_output(chunk.get(), len);
+    }
+    if (!written) {
+      ESP_LOGW(TAG, "Error writing binary data to flash!");
+      error_code = write_error_code;
       goto error;
     }
-    total += written;
+    total += len;
+
+    if (ota_features & OTA_FEATURE_PIPELINED) {
+      // Acknowledge chunk written - 1 byte
+      this->client_.write(OTA_RESPONSE_CHUNK_OK);
+    }
 
     uint32_t now = millis();
     if (now - last_progress > 1000) {
       last_progress = now;
-      float percentage = (total * 100.0f) / ota_size;
+      float percentage = (total * 100.0f) / stream_size;
       ESP_LOGD(TAG, "OTA in progress: %0.1f%%", percentage);
     }
   }
+  if (patcher && !patcher->is_finished()) {
+    ESP_LOGW(TAG, "Patch ended early!");
+    error_code = OTA_RESPONSE_ERROR_DELTA;
+    goto error;
+  }
+  chunk.reset();
+  patcher.reset();
+#ifdef ARDUINO_ARCH_ESP32
+  inflater.reset();
+#endif
 
   // Acknowledge receive OK - 1 byte
   this->client_.write(OTA_RESPONSE_RECEIVE_OK);
@@ -314,7 +520,7 @@ error:
 #endif
 }
 
-size_t OTAComponent::wait_receive_(uint8_t *buf, size_t bytes, bool check_disconnected) {
+size_t OTAComponent::wait_receive_(uint8_t *buf, size_t bytes, bool check_disconnected, size_t max_bytes) {
   size_t available = 0;
   uint32_t start = millis();
   do {
@@ -338,7 +544,7 @@ size_t OTAComponent::wait_receive_(uint8_t *buf, size_t bytes, bool check_discon
   } while (bytes == 0 ? available == 0 : available < bytes);
 
   if (bytes == 0)
-    bytes = std::min(available, size_t(1024));
+    bytes = std::min(available, max_bytes);
 
   bool success = false;
   for (uint32_t i = 0; !success && i < 100; i++) {
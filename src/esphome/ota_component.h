@@ -29,6 +29,7 @@ enum OTAResponseTypes {
   OTA_RESPONSE_BIN_MD5_OK = 67,
   OTA_RESPONSE_RECEIVE_OK = 68,
   OTA_RESPONSE_UPDATE_END_OK = 69,
+  OTA_RESPONSE_CHUNK_OK = 70,
 
   OTA_RESPONSE_ERROR_MAGIC = 128,
   OTA_RESPONSE_ERROR_UPDATE_PREPARE = 129,
@@ -40,9 +41,31 @@ enum OTAResponseTypes {
   OTA_RESPONSE_ERROR_WRONG_NEW_FLASH_CONFIG = 135,
   OTA_RESPONSE_ERROR_ESP8266_NOT_ENOUGH_SPACE = 136,
   OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE = 137,
+  OTA_RESPONSE_ERROR_DECOMPRESSION = 138,
+  OTA_RESPONSE_ERROR_DELTA = 139,
   OTA_RESPONSE_ERROR_UNKNOWN = 255,
 };
 
+/** Features the client can request with the features byte of the OTA header (version 1.0).
+ *
+ * If the client requests any feature, the header acknowledgement is followed by the features
+ * the node accepted (1 byte) and the receive chunk size (2 bytes, MSB first).
+ *
+ * If OTA_FEATURE_DEFLATE or OTA_FEATURE_DELTA is accepted, the size field is followed by the size of the
+ * payload as it is sent (4 bytes, MSB first). The size and MD5 always describe the new image.
+ */
+enum OTAFeatures : uint8_t {
+  /// The client keeps up to two chunks in flight and the node acknowledges each written chunk with
+  /// OTA_RESPONSE_CHUNK_OK, so that receiving the next chunk overlaps with writing the previous one to flash.
+  OTA_FEATURE_PIPELINED = 0x01,
+  /// The payload is sent as a zlib stream.
+  OTA_FEATURE_DEFLATE = 0x02,
+  /// The auth acknowledgement is followed by the MD5 of the running image (32 hex characters). After the payload
+  /// size, the client sends the payload type (1 byte): 0 for an image, 1 for a patch against the running image
+  /// (see OTADeltaPatcher).
+  OTA_FEATURE_DELTA = 0x04,
+};
+
 extern uint8_t OTA_VERSION_1_0;
 
 /// OTAComponent provides a simple way to integrate Over-the-Air updates into your app using ArduinoOTA.
@@ -96,7 +119,15 @@ class OTAComponent : public Component {
   uint32_t read_rtc_();
 
   void handle_();
-  size_t wait_receive_(uint8_t *buf, size_t bytes, bool check_disconnected = true);
+  /** Receive data from the OTA client, waiting up to 10s.
+   *
+   * @param buf The buffer to receive into.
+   * @param bytes The number of bytes to receive, or 0 to receive all available bytes up to max_bytes.
+   * @param check_disconnected Whether to stop if the client disconnected.
+   * @param max_bytes The maximum number of bytes if bytes is 0.
+   * @return The number of bytes received, 0 on error.
+   */
+  size_t wait_receive_(uint8_t *buf, size_t bytes, bool check_disconnected = true, size_t max_bytes = 1024);
 
   std::string password_;
 
@@ -0,0 +1,164 @@
+#include "esphome/defines.h"
+
+#ifdef USE_OTA
+
+#include "esphome/ota_delta.h"
+#include "esphome/log.h"
+
+#include <cstring>
+#include <algorithm>
+
+ESPHOME_NAMESPACE_BEGIN
+
+static const char *TAG = "ota.delta";
+
+static const char DELTA_MAGIC[4] = {'E', 'D', 'L', 'T'};
+/// Block size for reading the base image.
+static const size_t DELTA_BLOCK_SIZE = 256;
+
+OTADeltaPatcher::OTADeltaPatcher(std::string base_md5, uint32_t base_size, read_base_t read_base,
+                                 write_output_t write_output)
+    : base_md5_(std::move(base_md5)),
+      base_size_(base_size),
+      read_base_(std::move(read_base)),
+      write_output_(std::move(write_output)) {}
+
+bool OTADeltaPatcher::write(const uint8_t *data, size_t len) {
+  while (len > 0) {
+    switch (this->state_) {
+      case STATE_HEADER:
+      case STATE_OPCODE:
+      case STATE_ARGUMENTS: {
+        if (this->state_ == STATE_OPCODE) {
+          this->opcode_ = *data++;
+          len--;
+          this->buffer_len_ = 0;
+          switch (this->opcode_) {
+            case OP_END:
+              this->state_ = STATE_FINISHED;
+              continue;
+            case OP_COPY:
+            case OP_ADD:
+              this->buffer_needed_ = 8;
+              break;
+            case OP_INSERT:
+              this->buffer_needed_ = 4;
+              break;
+            default:
+              return this->fail_("Unknown opcode");
+          }
+          this->state_ = STATE_ARGUMENTS;
+          continue;
+        }
+
+        const size_t n = std::min(len, this->buffer_needed_ - this->buffer_len_);
+        memcpy(this->buffer_ + this->buffer_len_, data, n);
+        this->buffer_len_ += n;
+        data += n;
+        len -= n;
+        if (this->buffer_len_ < this->buffer_needed_)
+          break;
+
+        if (this->state_ == STATE_HEADER) {
+          if (!this->parse_header_())
+            return false;
+          this->state_ = STATE_OPCODE;
+        } else if (!this->parse_arguments_()) {
+          return false;
+        }
+        break;
+      }
+      case STATE_DATA: {
+        size_t n = std::min(len, size_t(this->remaining_));
+        if (this->opcode_ == OP_INSERT) {
+          if (!this->write_output_(data, n))
+            return this->fail_("Writing output failed");
+        } else {
+          // OP_ADD
+          uint8_t block[DELTA_BLOCK_SIZE];
+          n = std::min(n, DELTA_BLOCK_SIZE);
+          if (!this->read_base_(this->offset_, block, n))
+            return this->fail_("Reading base image failed");
+          for (size_t i = 0; i < n; i++)
+            block[i] += data[i];
+          if (!this->write_output_(block, n))
+            return this->fail_("Writing output failed");
+          this->offset_ += n;
+        }
+        data += n;
+        len -= n;
+        this->remaining_ -= n;
+        if (this->remaining_ == 0)
+          this->state_ = STATE_OPCODE;
+        break;
+      }
+      case STATE_FINISHED:
+        return this->fail_("Data after end of patch");
+      case STATE_FAILED:
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+bool OTADeltaPatcher::is_finished() const { return this->state_ == STATE_FINISHED; }
+
+bool OTADeltaPatcher::parse_header_() {
+  if (memcmp(this->buffer_, DELTA_MAGIC, sizeof(DELTA_MAGIC)) != 0)
+    return this->fail_("Invalid magic");
+  const char *md5 = reinterpret_cast<const char *>(this->buffer_ + 4);
+  if (this->base_md5_.size() != 32 || strncasecmp(md5, this->base_md5_.c_str(), 32) != 0)
+    return this->fail_("Patch was created for a different base image");
+  if (decode_uint32_(this->buffer_ + 36) != this->base_size_)
+    return this->fail_("Base image size does not match");
+  return true;
+}
+
+bool OTADeltaPatcher::parse_arguments_() {
+  if (this->opcode_ == OP_INSERT) {
+    this->remaining_ = decode_uint32_(this->buffer_);
+  } else {
+    this->offset_ = decode_uint32_(this->buffer_);
+    this->remaining_ = decode_uint32_(this->buffer_ + 4);
+    if (this->offset_ > this->base_size_ || this->remaining_ > this->base_size_ - this->offset_)
+      return this->fail_("Operation reads past the end of the base image");
+  }
+
+  if (this->opcode_ == OP_COPY) {
+    if (!this->copy_(this->offset_, this->remaining_))
+      return false;
+    this->state_ = STATE_OPCODE;
+  } else {
+    this->state_ = this->remaining_ == 0 ? STATE_OPCODE : STATE_DATA;
+  }
+  return true;
+}
+
+bool OTADeltaPatcher::copy_(uint32_t offset, uint32_t length) {
+  uint8_t block[DELTA_BLOCK_SIZE];
+  while (length > 0) {
+    const size_t n = std::min(size_t(length), DELTA_BLOCK_SIZE);
+    if (!this->read_base_(offset, block, n))
+      return this->fail_("Reading base image failed");
+    if (!this->write_output_(block, n))
+      return this->fail_("Writing output failed");
+    offset += n;
+    length -= n;
+  }
+  return true;
+}
+
+bool OTADeltaPatcher::fail_(const char *reason) {
+  ESP_LOGW(TAG, "Applying patch failed: %s", reason);
+  this->state_ = STATE_FAILED;
+  return false;
+}
+
+uint32_t OTADeltaPatcher::decode_uint32_(const uint8_t *data) {
+  return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | uint32_t(data[3]);
+}
+
+ESPHOME_NAMESPACE_END
+
+#endif  // USE_OTA
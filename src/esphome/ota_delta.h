@@ -0,0 +1,97 @@
+#ifndef ESPHOME_OTA_DELTA_H
+#define ESPHOME_OTA_DELTA_H
+
+#include "esphome/defines.h"
+
+#ifdef USE_OTA
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+ESPHOME_NAMESPACE_BEGIN
+
+/** Applies a delta patch against the running image as a stream, see OTA_FEATURE_DELTA.
+ *
+ * Patch format (integers are MSB first like the rest of the OTA protocol):
+ *  - header: "EDLT", the MD5 of the base image as 32 hex characters, the base image size (4 bytes)
+ *  - a sequence of operations, each a 1 byte opcode followed by its arguments:
+ *    - OP_COPY, offset (4 bytes), length (4 bytes): copy length bytes of the base image starting at offset
+ *    - OP_INSERT, length (4 bytes), then length bytes of new data
+ *    - OP_ADD, offset (4 bytes), length (4 bytes), then length bytes that are added (mod 256) to the base image
+ *      bytes starting at offset. Like bsdiff, this keeps the patch small for code that only moved.
+ *    - OP_END: the patch is complete
+ *
+ * The patcher only knows about the base image and the output through the read and write callbacks, so it
+ * doesn't depend on a flash implementation. The output is verified by Update with the MD5 of the new image.
+ *
+ * Patches are created on the host with scripts/ota_delta.py.
+ */
+class OTADeltaPatcher {
+ public:
+  using read_base_t = std::function<bool(uint32_t offset, uint8_t *data, size_t len)>;
+  using write_output_t = std::function<bool(const uint8_t *data, size_t len)>;
+
+  /** Construct the patcher.
+   *
+   * @param base_md5 The MD5 of the base image as 32 lowercase hex characters.
+   * @param base_size The size of the base image in bytes.
+   * @param read_base Reads from the base image.
+   * @param write_output Writes the next bytes of the new image.
+   */
+  OTADeltaPatcher(std::string base_md5, uint32_t base_size, read_base_t read_base, write_output_t write_output);
+
+  /// Feed the next bytes of the patch. Returns false if the patch is invalid or reading/writing failed.
+  bool write(const uint8_t *data, size_t len);
+
+  /// Whether the OP_END operation has been received.
+  bool is_finished() const;
+
+  static const uint8_t OP_END = 0x00;
+  static const uint8_t OP_COPY = 0x01;
+  static const uint8_t OP_INSERT = 0x02;
+  static const uint8_t OP_ADD = 0x03;
+
+ protected:
+  enum State {
+    STATE_HEADER = 0,
+    STATE_OPCODE,
+    STATE_ARGUMENTS,
+    STATE_DATA,
+    STATE_FINISHED,
+    STATE_FAILED,
+  };
+
+  static const size_t HEADER_SIZE = 4 + 32 + 4;
+
+  /// Handle the collected header or operation arguments in buffer_.
+  bool parse_header_();
+  bool parse_arguments_();
+  /// Copy length bytes of the base image to the output.
+  bool copy_(uint32_t offset, uint32_t length);
+  bool fail_(const char *reason);
+
+  static uint32_t decode_uint32_(const uint8_t *data);
+
+  std::string base_md5_;
+  uint32_t base_size_;
+  read_base_t read_base_;
+  write_output_t write_output_;
+
+  State state_{STATE_HEADER};
+  uint8_t opcode_{0};
+  /// Collects the header and operation arguments.
+  uint8_t buffer_[HEADER_SIZE];
+  size_t buffer_len_{0};
+  size_t buffer_needed_{HEADER_SIZE};
+  /// Base image offset and remaining length of the current OP_INSERT/OP_ADD data.
+  uint32_t offset_{0};
+  uint32_t remaining_{0};
+};
+
+ESPHOME_NAMESPACE_END
+
+#endif  // USE_OTA
+
+#endif  // ESPHOME_OTA_DELTA_H
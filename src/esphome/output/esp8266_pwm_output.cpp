@@ -38,17 +38,20 @@ void HOT ESP8266PWMOutput::write_state(float state) {
   }
 
   auto total_time_us = static_cast<uint32_t>(roundf(1e6f / this->frequency_));
-  auto duty_on = static_cast<uint32_t>(roundf(total_time_us * state));
-  uint32_t duty_off = total_time_us - duty_on;
-
-  if (duty_on == 0) {
+  this->duty_on_ = static_cast<uint32_t>(roundf(total_time_us * state));
+  this->duty_off_ = total_time_us - this->duty_on_;
+  if (!OutputFrame::defer(this))
+    this->flush_frame();
+}
+void HOT ESP8266PWMOutput::flush_frame() {
+  if (this->duty_on_ == 0) {
     stopWaveform(this->pin_.get_pin());
     this->pin_.digital_write(this->pin_.is_inverted());
-  } else if (duty_off == 0) {
+  } else if (this->duty_off_ == 0) {
     stopWaveform(this->pin_.get_pin());
     this->pin_.digital_write(!this->pin_.is_inverted());
   } else {
-    startWaveform(this->pin_.get_pin(), duty_on, duty_off, 0);
+    startWaveform(this->pin_.get_pin(), this->duty_on_, this->duty_off_, 0);
   }
 }
 float ESP8266PWMOutput::get_setup_priority() const { return setup_priority::HARDWARE; }
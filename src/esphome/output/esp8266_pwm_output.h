@@ -25,7 +25,7 @@ namespace output {
  * on at max. That is a known limitation, if it's a deal breaker, consider using the ESP32
  * instead - it up to 16 integrated hardware PWM channels.
  */
-class ESP8266PWMOutput : public FloatOutput, public Component {
+class ESP8266PWMOutput : public FloatOutput, public Component, public OutputFrameDriver {
  public:
   /// Construct the Software PWM output.
   explicit ESP8266PWMOutput(const GPIOOutputPin &pin);
@@ -40,13 +40,17 @@ class ESP8266PWMOutput : public FloatOutput, public Component {
   void dump_config() override;
   /// HARDWARE setup_priority
   float get_setup_priority() const override;
-  /// Override FloatOutput's write_state for analogWrite
+  /// Start the waveform held back during an OutputFrame.
+  void flush_frame() override;
 
  protected:
+  /// Override FloatOutput's write_state for analogWrite
   void write_state(float state) override;
 
   GPIOOutputPin pin_;
   float frequency_{1000.0};
+  uint32_t duty_on_{0};
+  uint32_t duty_off_{0};
 };
 
 }  // namespace output
@@ -47,6 +47,28 @@ void FloatOutput::set_level(float state) {
 
 void FloatOutput::write_state(bool state) { this->set_level(state != this->inverted_ ? 1.0f : 0.0f); }
 
+uint8_t OutputFrame::depth_ = 0;
+std::vector<OutputFrameDriver *> OutputFrame::drivers_;
+
+void OutputFrame::begin() { depth_++; }
+void OutputFrame::commit() {
+  if (depth_ == 0 || --depth_ != 0)
+    return;
+  for (auto *driver : drivers_)
+    driver->flush_frame();
+  drivers_.clear();
+}
+bool OutputFrame::defer(OutputFrameDriver *driver) {
+  if (depth_ == 0)
+    return false;
+  for (auto *it : drivers_) {
+    if (it == driver)
+      return true;
+  }
+  drivers_.push_back(driver);
+  return true;
+}
+
 }  // namespace output
 
 ESPHOME_NAMESPACE_END
@@ -8,6 +8,8 @@
 #include "esphome/output/binary_output.h"
 #include "esphome/component.h"
 
+#include <vector>
+
 ESPHOME_NAMESPACE_BEGIN
 
 namespace output {
@@ -77,6 +79,45 @@ class FloatOutput : public BinaryOutput {
   float min_power_{0.0f};
 };
 
+/// An output driver that can hold back level changes and apply them together, see OutputFrame.
+class OutputFrameDriver {
+ public:
+  /// Apply all levels that changed since the last flush.
+  virtual void flush_frame() = 0;
+};
+
+/** Groups the level changes of several outputs into a frame, which the drivers apply together.
+ *
+ * For example a RGB light sets its three outputs in a frame, so that a PWM chip gets all three channels in a
+ * single transfer right at commit() and no partial color is ever visible.
+ *
+ * ```cpp
+ * OutputFrame::begin();
+ * red->set_level(1.0f);
+ * green->set_level(0.5f);
+ * OutputFrame::commit();
+ * ```
+ *
+ * Frames can be nested, only the outermost commit() applies the levels. Outputs of drivers that don't support
+ * frames are still applied right away.
+ */
+class OutputFrame {
+ public:
+  static void begin();
+  static void commit();
+
+  /** Called by drivers when the level of one of their outputs changed.
+   *
+   * @return Whether a frame is open. If so, the driver is flushed on commit() and should hold back the change
+   *         until then.
+   */
+  static bool defer(OutputFrameDriver *driver);
+
+ protected:
+  static uint8_t depth_;
+  static std::vector<OutputFrameDriver *> drivers_;
+};
+
 template<typename... Ts> class SetLevelAction : public Action<Ts...> {
  public:
   SetLevelAction(FloatOutput *output);
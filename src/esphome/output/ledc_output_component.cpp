@@ -17,9 +17,11 @@ static const char *TAG = "output.ledc";
 void LEDCOutputComponent::write_state(float state) {
   const uint32_t max_duty = (uint32_t(1) << this->bit_depth_) - 1;
   const float duty_rounded = roundf(state * max_duty);
-  auto duty = static_cast<uint32_t>(duty_rounded);
-  ledcWrite(this->channel_, duty);
+  this->duty_ = static_cast<uint32_t>(duty_rounded);
+  if (!OutputFrame::defer(this))
+    this->flush_frame();
 }
+void LEDCOutputComponent::flush_frame() { ledcWrite(this->channel_, this->duty_); }
 
 void LEDCOutputComponent::setup() {
   ledcSetup(this->channel_, this->frequency_, this->bit_depth_);
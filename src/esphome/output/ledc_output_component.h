@@ -12,7 +12,7 @@ ESPHOME_NAMESPACE_BEGIN
 namespace output {
 
 /// ESP32 LEDC output component.
-class LEDCOutputComponent : public FloatOutput, public Component {
+class LEDCOutputComponent : public FloatOutput, public Component, public OutputFrameDriver {
  public:
   /// Construct a LEDCOutputComponent. The channel will be set using the next_ledc_channel global variable.
   explicit LEDCOutputComponent(uint8_t pin, float frequency = 1000.0f, uint8_t bit_depth = 12);
@@ -43,6 +43,8 @@ class LEDCOutputComponent : public FloatOutput, public Component {
 
   /// Override FloatOutput's write_state.
   void write_state(float adjusted_value) override;
+  /// Write the duty cycle held back during an OutputFrame.
+  void flush_frame() override;
 
   float get_frequency() const;
   uint8_t get_bit_depth() const;
@@ -54,6 +56,7 @@ class LEDCOutputComponent : public FloatOutput, public Component {
   uint8_t channel_;
   uint8_t bit_depth_;
   float frequency_;
+  uint32_t duty_{0};
 };
 
 extern uint8_t next_ledc_channel;
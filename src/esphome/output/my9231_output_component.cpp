@@ -49,6 +49,9 @@ void MY9231OutputComponent::setup() {
   this->pin_di_->digital_write(false);
   this->pin_dcki_->setup();
   this->pin_dcki_->digital_write(false);
+  this->dcki_state_ = false;
+  this->fast_di_ = FastGPIOPin(this->pin_di_);
+  this->fast_dcki_ = FastGPIOPin(this->pin_dcki_);
   this->pwm_amounts_.resize(this->num_channels_, 0);
   uint8_t command = 0;
   if (this->bit_depth_ <= 8) {
@@ -79,6 +82,7 @@ void MY9231OutputComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  Total number of channels: %u", this->num_channels_);
   ESP_LOGCONFIG(TAG, "  Number of chips: %u", this->num_chips_);
   ESP_LOGCONFIG(TAG, "  Bit depth: %u", this->bit_depth_);
+  ESP_LOGCONFIG(TAG, "  Fast Pins: %s", YESNO(this->fast_di_.is_fast() && this->fast_dcki_.is_fast()));
 }
 
 void MY9231OutputComponent::loop() {
@@ -94,6 +98,11 @@ void MY9231OutputComponent::loop() {
   this->update_ = false;
 }
 
+void MY9231OutputComponent::flush_frame() {
+  if (!this->is_failed())
+    this->loop();
+}
+
 MY9231OutputComponent::Channel *MY9231OutputComponent::create_channel(uint8_t channel,
                                                                       PowerSupplyComponent *power_supply,
                                                                       float max_power) {
@@ -144,18 +153,22 @@ void MY9231OutputComponent::init_chips_(uint8_t command) {
   this->send_di_pulses_(16);
 }
 
-void MY9231OutputComponent::write_word_(uint16_t value, uint8_t bits) {
-  for (uint8_t i = bits; i > 0; i--) {
-    this->pin_di_->digital_write(value & (1 << (i - 1)));
-    this->pin_dcki_->digital_write(!this->pin_dcki_->digital_read());
+void ICACHE_RAM_ATTR HOT MY9231OutputComponent::write_word_(uint16_t value, uint8_t bits) {
+  // The MY92xx latch DI on both edges of DCKI.
+  bool dcki = this->dcki_state_;
+  for (uint16_t bit = 1U << (bits - 1); bit != 0; bit >>= 1) {
+    this->fast_di_.digital_write(value & bit);
+    dcki = !dcki;
+    this->fast_dcki_.digital_write(dcki);
   }
+  this->dcki_state_ = dcki;
 }
 
-void MY9231OutputComponent::send_di_pulses_(uint8_t count) {
+void ICACHE_RAM_ATTR HOT MY9231OutputComponent::send_di_pulses_(uint8_t count) {
   delayMicroseconds(12);
   for (uint8_t i = 0; i < count; i++) {
-    this->pin_di_->digital_write(true);
-    this->pin_di_->digital_write(false);
+    this->fast_di_.digital_write(true);
+    this->fast_di_.digital_write(false);
   }
 }
 
@@ -165,6 +178,8 @@ MY9231OutputComponent::Channel::Channel(MY9231OutputComponent *parent, uint8_t c
 void MY9231OutputComponent::Channel::write_state(float state) {
   auto amount = uint16_t(state * this->parent_->get_max_amount());
   this->parent_->set_channel_value_(this->channel_, amount);
+  // Without a frame the loop sends the new values.
+  OutputFrame::defer(this->parent_);
 }
 
 }  // namespace output
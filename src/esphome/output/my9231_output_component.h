@@ -12,7 +12,7 @@ ESPHOME_NAMESPACE_BEGIN
 namespace output {
 
 /// MY9231 float output component.
-class MY9231OutputComponent : public Component {
+class MY9231OutputComponent : public Component, public OutputFrameDriver {
  public:
   class Channel;
   /** Construct the component.
@@ -62,6 +62,7 @@ class MY9231OutputComponent : public Component {
   float get_setup_priority() const override;
   /// Send new values if they were updated.
   void loop() override;
+  void flush_frame() override;
 
   class Channel : public FloatOutput {
    public:
@@ -87,6 +88,10 @@ class MY9231OutputComponent : public Component {
   uint8_t num_chips_;
   std::vector<uint16_t> pwm_amounts_;
   bool update_;
+  FastGPIOPin fast_di_;
+  FastGPIOPin fast_dcki_;
+  /// The current (logical) level of DCKI, each data bit toggles it.
+  bool dcki_state_{false};
 };
 
 }  // namespace output
@@ -10,6 +10,8 @@
 
 #include "esphome/log.h"
 
+#include <cstring>
+
 ESPHOME_NAMESPACE_BEGIN
 
 namespace output {
@@ -26,6 +28,7 @@ static const uint8_t PCA9685_REGISTER_SOFTWARE_RESET = 0x06;
 static const uint8_t PCA9685_REGISTER_MODE1 = 0x00;
 static const uint8_t PCA9685_REGISTER_MODE2 = 0x01;
 static const uint8_t PCA9685_REGISTER_LED0 = 0x06;
+static const uint8_t PCA9685_REGISTER_ALL_LED = 0xFA;
 static const uint8_t PCA9685_REGISTER_PRE_SCALE = 0xFE;
 
 static const uint8_t PCA9685_MODE1_RESTART = 0b10000000;
@@ -36,13 +39,15 @@ static const uint16_t PCA9685_PWM_FULL = 4096;
 
 static const uint8_t PCA9685_ADDRESS = 0x40;
 
+/// The Wire buffer is 32 bytes, which fits the register address and the registers of 7 channels.
+static const uint8_t PCA9685_MAX_BURST_CHANNELS = 7;
+
 PCA9685OutputComponent::PCA9685OutputComponent(I2CComponent *parent, float frequency, uint8_t mode)
     : I2CDevice(parent, PCA9685_ADDRESS),
       frequency_(frequency),
       mode_(mode),
       min_channel_(0xFF),
-      max_channel_(0x00),
-      update_(true) {
+      max_channel_(0x00) {
   for (uint16_t &pwm_amount : this->pwm_amounts_)
     pwm_amount = 0;
 }
@@ -107,51 +112,102 @@ void PCA9685OutputComponent::dump_config() {
   }
 }
 
+void PCA9685OutputComponent::encode_channel_(uint8_t channel, uint8_t *data) {
+  const uint16_t num_channels = this->max_channel_ - this->min_channel_ + 1;
+  uint16_t phase_begin = uint16_t(channel - this->min_channel_) / num_channels * 4096;
+  uint16_t phase_end;
+  uint16_t amount = this->pwm_amounts_[channel];
+  if (amount == 0) {
+    phase_end = 4096;
+  } else if (amount >= 4096) {
+    phase_begin = 4096;
+    phase_end = 0;
+  } else {
+    phase_end = phase_begin + amount;
+    if (phase_end >= 4096)
+      phase_end -= 4096;
+  }
+
+  ESP_LOGVV(TAG, "Channel %02u: amount=%04u phase_begin=%04u phase_end=%04u", channel, amount, phase_begin, phase_end);
+
+  data[0] = phase_begin & 0xFF;
+  data[1] = (phase_begin >> 8) & 0xFF;
+  data[2] = phase_end & 0xFF;
+  data[3] = (phase_end >> 8) & 0xFF;
+}
+
 void PCA9685OutputComponent::loop() {
-  if (this->min_channel_ == 0xFF || !this->update_)
+  if (this->dirty_channels_ == 0)
     return;
 
-  const uint16_t num_channels = this->max_channel_ - this->min_channel_ + 1;
-  for (uint8_t channel = this->min_channel_; channel <= this->max_channel_; channel++) {
-    uint16_t phase_begin = uint16_t(channel - this->min_channel_) / num_channels * 4096;
-    uint16_t phase_end;
-    uint16_t amount = this->pwm_amounts_[channel];
-    if (amount == 0) {
-      phase_end = 4096;
-    } else if (amount >= 4096) {
-      phase_begin = 4096;
-      phase_end = 0;
-    } else {
-      phase_end = phase_begin + amount;
-      if (phase_end >= 4096)
-        phase_end -= 4096;
+  if (this->used_channels_ == 0xFFFF) {
+    // All channels are ours, if they all have the same registers a single write to ALL_LED is enough.
+    uint8_t first[4];
+    this->encode_channel_(0, first);
+    bool all_equal = true;
+    for (uint8_t channel = 1; channel < 16 && all_equal; channel++) {
+      uint8_t data[4];
+      this->encode_channel_(channel, data);
+      all_equal = memcmp(first, data, 4) == 0;
+    }
+    if (all_equal) {
+      if (!this->write_bytes(PCA9685_REGISTER_ALL_LED, first, 4)) {
+        this->status_set_warning();
+        return;
+      }
+      this->status_clear_warning();
+      this->dirty_channels_ = 0;
+      return;
+    }
+  }
+
+  // Write the dirty channels in auto-increment bursts. A single clean channel between dirty ones is rewritten
+  // as part of the burst, that's cheaper than starting a new transaction.
+  uint8_t channel = 0;
+  while (channel < 16) {
+    if ((this->dirty_channels_ & (1 << channel)) == 0) {
+      channel++;
+      continue;
     }
 
-    ESP_LOGVV(TAG, "Channel %02u: amount=%04u phase_begin=%04u phase_end=%04u", channel, amount, phase_begin,
-              phase_end);
+    uint8_t end = channel + 1;
+    while (end < 16 && end - channel < PCA9685_MAX_BURST_CHANNELS) {
+      if (this->dirty_channels_ & (1 << end)) {
+        end++;
+      } else if (end + 1 < 16 && end + 1 - channel < PCA9685_MAX_BURST_CHANNELS &&
+                 (this->used_channels_ & (1 << end)) && (this->dirty_channels_ & (1 << (end + 1)))) {
+        end += 2;
+      } else {
+        break;
+      }
+    }
 
-    uint8_t data[4];
-    data[0] = phase_begin & 0xFF;
-    data[1] = (phase_begin >> 8) & 0xFF;
-    data[2] = phase_end & 0xFF;
-    data[3] = (phase_end >> 8) & 0xFF;
+    uint8_t data[4 * PCA9685_MAX_BURST_CHANNELS];
+    for (uint8_t i = channel; i < end; i++)
+      this->encode_channel_(i, data + 4 * (i - channel));
 
-    uint8_t reg = PCA9685_REGISTER_LED0 + 4 * channel;
-    if (!this->write_bytes(reg, data, 4)) {
+    const uint8_t reg = PCA9685_REGISTER_LED0 + 4 * channel;
+    if (!this->write_bytes(reg, data, 4 * (end - channel))) {
       this->status_set_warning();
       return;
     }
+    this->dirty_channels_ &= ~(((1UL << end) - 1) & ~((1UL << channel) - 1));
+    channel = end;
   }
 
   this->status_clear_warning();
-  this->update_ = false;
+}
+
+void PCA9685OutputComponent::flush_frame() {
+  if (!this->is_failed())
+    this->loop();
 }
 
 float PCA9685OutputComponent::get_setup_priority() const { return setup_priority::HARDWARE; }
 
 void PCA9685OutputComponent::set_channel_value_(uint8_t channel, uint16_t value) {
   if (this->pwm_amounts_[channel] != value)
-    this->update_ = true;
+    this->dirty_channels_ |= 1 << channel;
   this->pwm_amounts_[channel] = value;
 }
 
@@ -160,6 +216,8 @@ PCA9685OutputComponent::Channel *PCA9685OutputComponent::create_channel(uint8_t
                                                                         float max_power) {
   this->min_channel_ = std::min(this->min_channel_, channel);
   this->max_channel_ = std::max(this->max_channel_, channel);
+  this->used_channels_ |= 1 << channel;
+  this->dirty_channels_ |= 1 << channel;
   auto *c = new Channel(this, channel);
   c->set_power_supply(power_supply);
   c->set_max_power(max_power);
@@ -179,6 +237,8 @@ void PCA9685OutputComponent::Channel::write_state(float state) {
   const float duty_rounded = roundf(state * max_duty);
   auto duty = static_cast<uint16_t>(duty_rounded);
   this->parent_->set_channel_value_(this->channel_, duty);
+  // Without a frame the loop sends the new values.
+  OutputFrame::defer(this->parent_);
 }
 
 }  // namespace output
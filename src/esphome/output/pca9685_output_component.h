@@ -23,7 +23,7 @@ extern const uint8_t PCA9685_MODE_OUTNE_LOW;  // Similarly, sets channel output
                                               // high-impedance state
 
 /// PCA9685 float output component.
-class PCA9685OutputComponent : public Component, public I2CDevice {
+class PCA9685OutputComponent : public Component, public I2CDevice, public OutputFrameDriver {
  public:
   class Channel;
   /** Construct the component.
@@ -61,6 +61,7 @@ class PCA9685OutputComponent : public Component, public I2CDevice {
   float get_setup_priority() const override;
   /// Send new values if they were updated.
   void loop() override;
+  void flush_frame() override;
 
   class Channel : public FloatOutput {
    public:
@@ -75,6 +76,8 @@ class PCA9685OutputComponent : public Component, public I2CDevice {
 
  protected:
   void set_channel_value_(uint8_t channel, uint16_t value);
+  /// Encode the ON/OFF registers of a channel into 4 bytes.
+  void encode_channel_(uint8_t channel, uint8_t *data);
 
   float frequency_;
   uint8_t mode_;
@@ -82,7 +85,10 @@ class PCA9685OutputComponent : public Component, public I2CDevice {
   uint8_t min_channel_;
   uint8_t max_channel_;
   uint16_t pwm_amounts_[16];
-  bool update_;
+  /// Bitmask of the channels that have been created.
+  uint16_t used_channels_{0};
+  /// Bitmask of the channels whose value hasn't been sent yet.
+  uint16_t dirty_channels_{0};
 };
 
 }  // namespace output
@@ -22,6 +22,7 @@ static const uint32_t BIT_HIGH_US = 525;
 JVCTransmitter::JVCTransmitter(const std::string &name, uint32_t data) : RemoteTransmitter(name), data_(data) {}
 
 void JVCTransmitter::to_data(RemoteTransmitData *data) { encode_jvc(data, this->data_); }
+bool JVCTransmitter::is_cacheable() const { return true; }
 
 void encode_jvc(RemoteTransmitData *data, uint32_t jvc_data) {
   data->set_carrier_frequency(38000);
@@ -72,6 +73,18 @@ bool JVCReceiver::matches(RemoteReceiveData *data) {
 
   return this->data_ == decode.data;
 }
+bool JVCReceiver::get_code(RemoteCode *code) {
+  *code = RemoteCode{REMOTE_PROTOCOL_JVC, 0, NBITS, this->data_};
+  return true;
+}
+bool JVCReceiver::decode_code(RemoteReceiveData *data, RemoteCode *code) {
+  auto decode = decode_jvc(data);
+  if (!decode.valid)
+    return false;
+
+  *code = RemoteCode{REMOTE_PROTOCOL_JVC, 0, NBITS, decode.data};
+  return true;
+}
 
 bool JVCDumper::dump(RemoteReceiveData *data) {
   auto decode = decode_jvc(data);
@@ -38,6 +38,7 @@ void LGTransmitter::to_data(RemoteTransmitData *data) {
 
   data->mark(BIT_HIGH_US);
 }
+bool LGTransmitter::is_cacheable() const { return true; }
 
 void encode_lg(RemoteTransmitData *data, uint32_t lg_data, uint8_t nbits) {
   data->set_carrier_frequency(38000);
@@ -91,6 +92,18 @@ bool LGReceiver::matches(RemoteReceiveData *data) {
 
   return this->data_ == res.data && this->nbits_ == res.nbits;
 }
+bool LGReceiver::get_code(RemoteCode *code) {
+  *code = RemoteCode{REMOTE_PROTOCOL_LG, 0, this->nbits_, this->data_};
+  return true;
+}
+bool LGReceiver::decode_code(RemoteReceiveData *data, RemoteCode *code) {
+  auto decode = decode_lg(data);
+  if (!decode.valid)
+    return false;
+
+  *code = RemoteCode{REMOTE_PROTOCOL_LG, 0, decode.nbits, decode.data};
+  return true;
+}
 
 bool LGDumper::dump(RemoteReceiveData *data) {
   auto res = decode_lg(data);
@@ -44,6 +44,7 @@ void encode_nec(RemoteTransmitData *data, uint16_t address, uint16_t command) {
 NECTransmitter::NECTransmitter(const std::string &name, uint16_t address, uint16_t command)
     : RemoteTransmitter(name), address_(address), command_(command) {}
 void NECTransmitter::to_data(RemoteTransmitData *data) { encode_nec(data, this->address_, this->command_); }
+bool NECTransmitter::is_cacheable() const { return true; }
 #endif
 
 #ifdef USE_REMOTE_RECEIVER
@@ -89,6 +90,18 @@ bool NECReceiver::matches(RemoteReceiveData *data) {
 
   return this->address_ == decode.address && this->command_ == decode.command;
 }
+bool NECReceiver::get_code(RemoteCode *code) {
+  *code = RemoteCode{REMOTE_PROTOCOL_NEC, 0, this->address_, this->command_};
+  return true;
+}
+bool NECReceiver::decode_code(RemoteReceiveData *data, RemoteCode *code) {
+  auto decode = decode_nec(data);
+  if (!decode.valid)
+    return false;
+
+  *code = RemoteCode{REMOTE_PROTOCOL_NEC, 0, decode.address, decode.command};
+  return true;
+}
 bool NECDumper::dump(RemoteReceiveData *data) {
   auto decode = decode_nec(data);
   if (!decode.valid)
@@ -21,6 +21,7 @@ static const uint32_t BIT_ONE_LOW_US = 1244;
 
 #ifdef USE_REMOTE_TRANSMITTER
 void PanasonicTransmitter::to_data(RemoteTransmitData *data) { encode_panasonic(data, this->address_, this->command_); }
+bool PanasonicTransmitter::is_cacheable() const { return true; }
 
 PanasonicTransmitter::PanasonicTransmitter(const std::string &name, uint16_t address, uint32_t command)
     : RemoteTransmitter(name), address_(address), command_(command) {}
@@ -87,6 +88,18 @@ bool PanasonicReceiver::matches(RemoteReceiveData *data) {
 
   return decode.valid && this->address_ == decode.address && this->command_ == decode.command;
 }
+bool PanasonicReceiver::get_code(RemoteCode *code) {
+  *code = RemoteCode{REMOTE_PROTOCOL_PANASONIC, 0, this->address_, this->command_};
+  return true;
+}
+bool PanasonicReceiver::decode_code(RemoteReceiveData *data, RemoteCode *code) {
+  auto decode = decode_panasonic(data);
+  if (!decode.valid)
+    return false;
+
+  *code = RemoteCode{REMOTE_PROTOCOL_PANASONIC, 0, decode.address, decode.command};
+  return true;
+}
 PanasonicReceiver::PanasonicReceiver(const std::string &name, uint16_t address, uint32_t command)
     : RemoteReceiver(name), address_(address), command_(command) {}
 
@@ -19,6 +19,9 @@ class PanasonicTransmitter : public RemoteTransmitter {
 
   void to_data(RemoteTransmitData *data) override;
 
+  /// The code is fixed, so the encoded waveform can be cached.
+  bool is_cacheable() const override;
+
  protected:
   uint16_t address_;
   uint32_t command_;
@@ -34,6 +37,9 @@ class PanasonicReceiver : public RemoteReceiver {
  public:
   PanasonicReceiver(const std::string &name, uint16_t address, uint32_t command);
 
+  bool get_code(RemoteCode *code) override;
+  bool decode_code(RemoteReceiveData *data, RemoteCode *code) override;
+
  protected:
   bool matches(RemoteReceiveData *data) override;
 
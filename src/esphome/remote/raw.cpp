@@ -27,6 +27,7 @@ void RawTransmitter::to_data(RemoteTransmitData *data) {
   }
   data->set_carrier_frequency(this->carrier_frequency_);
 }
+bool RawTransmitter::is_cacheable() const { return true; }
 RawTransmitter::RawTransmitter(const std::string &name, const int32_t *data, size_t len, uint32_t carrier_frequency)
     : RemoteTransmitter(name), data_(data), len_(len), carrier_frequency_(carrier_frequency) {}
 #endif
@@ -19,6 +19,9 @@ class RawTransmitter : public RemoteTransmitter {
 
   void to_data(RemoteTransmitData *data) override;
 
+  /// The code is fixed, so the encoded waveform can be cached.
+  bool is_cacheable() const override;
+
  protected:
   const int32_t *data_;
   size_t len_;
@@ -85,6 +85,18 @@ bool RC5Receiver::matches(RemoteReceiveData *data) {
 
   return this->address_ == res.address && this->command_ == res.command;
 }
+bool RC5Receiver::get_code(RemoteCode *code) {
+  *code = RemoteCode{REMOTE_PROTOCOL_RC5, 0, this->address_, this->command_};
+  return true;
+}
+bool RC5Receiver::decode_code(RemoteReceiveData *data, RemoteCode *code) {
+  auto decode = decode_rc5(data);
+  if (!decode.valid)
+    return false;
+
+  *code = RemoteCode{REMOTE_PROTOCOL_RC5, 0, decode.address, decode.command};
+  return true;
+}
 
 bool RC5Dumper::dump(RemoteReceiveData *data) {
   auto res = decode_rc5(data);
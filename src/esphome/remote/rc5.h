@@ -35,6 +35,9 @@ class RC5Receiver : public RemoteReceiver {
  public:
   RC5Receiver(const std::string &name, uint8_t address, uint8_t command);
 
+  bool get_code(RemoteCode *code) override;
+  bool decode_code(RemoteReceiveData *data, RemoteCode *code) override;
+
  protected:
   bool matches(RemoteReceiveData *data) override;
 
@@ -20,6 +20,7 @@ RCSwitchRawTransmitter::RCSwitchRawTransmitter(const std::string &name, RCSwitch
 void RCSwitchRawTransmitter::to_data(RemoteTransmitData *data) {
   this->protocol_.transmit(data, this->code_, this->nbits_);
 }
+bool RCSwitchRawTransmitter::is_cacheable() const { return true; }
 
 void encode_rc_switch_raw(RemoteTransmitData *data, uint32_t code, uint8_t nbits, RCSwitchProtocol protocol) {
   protocol.transmit(data, code, nbits);
@@ -146,6 +147,19 @@ bool RCSwitchRawReceiver::matches(RemoteReceiveData *data) {
 
   return decoded_nbits == this->nbits_ && decoded_code == this->code_;
 }
+bool RCSwitchRawReceiver::get_code(RemoteCode *code) {
+  *code = RemoteCode{REMOTE_PROTOCOL_RC_SWITCH, this->protocol_.get_variant(), this->nbits_, this->code_};
+  return true;
+}
+bool RCSwitchRawReceiver::decode_code(RemoteReceiveData *data, RemoteCode *code) {
+  uint32_t decoded_code;
+  uint8_t decoded_nbits;
+  if (!this->protocol_.decode(data, &decoded_code, &decoded_nbits))
+    return false;
+
+  *code = RemoteCode{REMOTE_PROTOCOL_RC_SWITCH, this->protocol_.get_variant(), decoded_nbits, decoded_code};
+  return true;
+}
 RCSwitchTypeAReceiver::RCSwitchTypeAReceiver(const std::string &name, RCSwitchProtocol a_protocol, uint8_t switch_group,
                                              uint8_t switch_device, bool state)
     : RCSwitchRawReceiver(name, a_protocol, 0, 0) {
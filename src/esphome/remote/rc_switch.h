@@ -20,6 +20,9 @@ class RCSwitchRawTransmitter : public RemoteTransmitter {
 
   void to_data(RemoteTransmitData *data) override;
 
+  /// The code is fixed, so the encoded waveform can be cached.
+  bool is_cacheable() const override;
+
  protected:
   RCSwitchProtocol protocol_;
   uint32_t code_;
@@ -87,6 +90,9 @@ class RCSwitchRawReceiver : public RemoteReceiver {
  public:
   RCSwitchRawReceiver(const std::string &name, RCSwitchProtocol a_protocol, uint32_t code, uint8_t nbits);
 
+  bool get_code(RemoteCode *code) override;
+  bool decode_code(RemoteReceiveData *data, RemoteCode *code) override;
+
  protected:
   bool matches(RemoteReceiveData *data) override;
 
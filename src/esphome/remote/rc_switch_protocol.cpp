@@ -28,6 +28,16 @@ RCSwitchProtocol::RCSwitchProtocol(uint32_t sync_high, uint32_t sync_low, uint32
       one_low_(one_low),
       inverted_(inverted) {}
 
+uint32_t RCSwitchProtocol::get_variant() const {
+  uint32_t hash = 2166136261UL;
+  for (uint32_t value : {this->sync_high_, this->sync_low_, this->zero_high_, this->zero_low_, this->one_high_,
+                         this->one_low_, uint32_t(this->inverted_)}) {
+    hash *= 16777619UL;
+    hash ^= value;
+  }
+  return hash;
+}
+
 #ifdef USE_REMOTE_TRANSMITTER
 void RCSwitchProtocol::one(RemoteTransmitData *data) const {
   if (!this->inverted_) {
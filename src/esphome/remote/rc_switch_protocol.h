@@ -39,6 +39,9 @@ class RCSwitchProtocol {
   bool decode(RemoteReceiveData *data, uint32_t *out_data, uint8_t *out_nbits) const;
 #endif
 
+  /// Get a value that identifies these timings, two protocols with the same variant decode frames identically.
+  uint32_t get_variant() const;
+
   static void simple_code_to_tristate(uint16_t code, uint8_t nbits, uint32_t *out_code);
 
   static void type_a_code(uint8_t switch_group, uint8_t switch_device, bool state, uint32_t *out_code,
@@ -25,6 +25,9 @@ static const char *TAG = "remote.receiver";
 
 RemoteReceiveData::RemoteReceiveData(RemoteReceiverComponent *parent, std::vector<int32_t> *data)
     : parent_(parent), data_(data) {}
+RemoteReceiveData::RemoteReceiveData(RemoteReceiverComponent *parent, const volatile uint16_t *ring,
+                                     uint32_t ring_size, uint32_t start, uint32_t length)
+    : parent_(parent), ring_(ring), ring_size_(ring_size), ring_start_(start), ring_length_(length) {}
 
 uint32_t RemoteReceiveData::lower_bound_(uint32_t length) {
   return uint32_t(100 - this->parent_->tolerance_) * length / 100U;
@@ -83,9 +86,23 @@ bool RemoteReceiveData::peek_space_at_least(uint32_t length, uint32_t offset) {
   return value <= 0 && lo <= -value;
 }
 int32_t RemoteReceiveData::operator[](uint32_t index) const { return this->pos(index); }
-int32_t RemoteReceiveData::pos(uint32_t index) const { return (*this->data_)[index]; }
+int32_t RemoteReceiveData::pos(uint32_t index) const {
+  if (this->data_ != nullptr)
+    return (*this->data_)[index];
+  if (index >= this->ring_length_)
+    // The implicit idle space that ended the frame
+    return -int32_t(this->parent_->idle_us_);
+  uint32_t at = this->ring_start_ + index;
+  if (at >= this->ring_size_)
+    at -= this->ring_size_;
+  return RemoteReceiverComponentStore::item_to_value(this->ring_[at]);
+}
 
-int32_t RemoteReceiveData::size() const { return this->data_->size(); }
+int32_t RemoteReceiveData::size() const {
+  if (this->data_ != nullptr)
+    return this->data_->size();
+  return this->ring_length_ + 1;
+}
 JVCDecodeData RemoteReceiveData::decode_jvc() { return remote::decode_jvc(this); }
 LGDecodeData RemoteReceiveData::decode_lg() { return remote::decode_lg(this); }
 NECDecodeData RemoteReceiveData::decode_nec() { return remote::decode_nec(this); }
@@ -93,6 +110,15 @@ PanasonicDecodeData RemoteReceiveData::decode_panasonic() { return remote::decod
 SamsungDecodeData RemoteReceiveData::decode_samsung() { return remote::decode_samsung(this); }
 SonyDecodeData RemoteReceiveData::decode_sony() { return remote::decode_sony(this); }
 
+const uint16_t RemoteReceiverComponentStore::ITEM_MARK;
+const uint16_t RemoteReceiverComponentStore::ITEM_DURATION_MASK;
+const uint16_t RemoteReceiverComponentStore::ITEM_OVERFLOW;
+
+int32_t RemoteReceiverComponentStore::item_to_value(uint16_t item) {
+  const int32_t duration = item & ITEM_DURATION_MASK;
+  return (item & ITEM_MARK) ? duration : -duration;
+}
+
 RemoteReceiverComponent::RemoteReceiverComponent(GPIOPin *pin) : RemoteControlComponentBase(pin) {}
 
 float RemoteReceiverComponent::get_setup_priority() const { return setup_priority::HARDWARE_LATE; }
@@ -248,19 +274,35 @@ void RemoteReceiverComponent::decode_rmt_(rmt_item32_t *item, size_t len) {
 
 void ICACHE_RAM_ATTR HOT RemoteReceiverComponentStore::gpio_intr(RemoteReceiverComponentStore *arg) {
   const uint32_t now = micros();
-  // If the lhs is 1 (rising edge) we should write to an uneven index and vice versa
-  const uint32_t next = (arg->buffer_write_at + 1) % arg->buffer_size;
-  if (uint32_t(arg->pin->digital_read()) != next % 2)
+  const bool level = arg->pin->digital_read();
+  if (level == arg->last_level)
+    // Missed an edge or the previous one was filtered out, wait for the level to change
     return;
-  const uint32_t last_change = arg->buffer[arg->buffer_write_at];
-  if (now - last_change <= arg->filter_us)
+  const uint32_t duration = now - arg->last_edge_us;
+  if (duration <= arg->filter_us)
     return;
 
-  arg->buffer[arg->buffer_write_at = next] = now;
-
+  const uint32_t write_at = arg->buffer_write_at;
+  uint32_t next = write_at + 1;
+  if (next == arg->buffer_size)
+    next = 0;
   if (next == arg->buffer_read_at) {
+    // Keep following the line while the ring is full, so that the levels after the overflow are measured correctly
     arg->overflow = true;
+    arg->last_edge_us = now;
+    arg->last_level = level;
+    return;
   }
+
+  // The item describes the level before this edge
+  uint16_t item = duration >= ITEM_OVERFLOW ? ITEM_OVERFLOW : uint16_t(duration);
+  if (!level)
+    item |= ITEM_MARK;
+  arg->buffer[write_at] = item;
+  arg->last_edge_us = now;
+  arg->last_level = level;
+  // Publish the item only after it has been written
+  arg->buffer_write_at = next;
 }
 
 void RemoteReceiverComponent::setup() {
@@ -272,20 +314,10 @@ void RemoteReceiverComponent::setup() {
   s.buffer_size = this->buffer_size_;
 
   this->high_freq_.start();
-  if (s.buffer_size % 2 != 0) {
-    // Make sure divisible by two. This way, we know that every 0bxxx0 index is a space and every 0bxxx1 index is a mark
-    s.buffer_size++;
-  }
-  s.buffer = new uint32_t[s.buffer_size];
-  // First index is a space.
-  if (this->pin_->digital_read()) {
-    s.buffer_write_at = s.buffer_read_at = 1;
-    s.buffer[1] = 0;
-    s.buffer[0] = 0;
-  } else {
-    s.buffer_write_at = s.buffer_read_at = 0;
-    s.buffer[0] = 0;
-  }
+  s.buffer = new uint16_t[s.buffer_size];
+  s.buffer_write_at = s.buffer_read_at = 0;
+  s.last_level = this->pin_->digital_read();
+  s.last_edge_us = micros();
   this->pin_->attach_interrupt(RemoteReceiverComponentStore::gpio_intr, &this->store_, CHANGE);
 }
 void RemoteReceiverComponent::dump_config() {
@@ -314,54 +346,65 @@ void RemoteReceiverComponent::loop() {
     return;
   }
 
-  // copy write at to local variables, as it's volatile
+  // Read the write position before the items it publishes
   const uint32_t write_at = s.buffer_write_at;
-  const uint32_t dist = (s.buffer_size + write_at - s.buffer_read_at) % s.buffer_size;
-  // signals must at least one rising and one leading edge
-  if (dist <= 1)
+  const uint32_t read_at = s.buffer_read_at;
+  if (write_at == read_at)
     return;
-  const uint32_t now = micros();
-  if (now - s.buffer[write_at] < this->idle_us_)
-    // The last change was fewer than the configured idle time ago.
-    // TODO: Handle case when loop() is not called quickly enough to catch idle
+  if (micros() - s.last_edge_us < this->idle_us_)
+    // The last change was fewer than the configured idle time ago, the frame is not complete yet.
     return;
 
-  ESP_LOGVV(TAG, "read_at=%u write_at=%u dist=%u now=%u end=%u", s.buffer_read_at, write_at, dist, now,
-            s.buffer[write_at]);
-
-  // Skip first value, it's from the previous idle level
-  s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
-  uint32_t prev = s.buffer_read_at;
-  s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
-  const uint32_t reserve_size = 1 + (s.buffer_size + write_at - s.buffer_read_at) % s.buffer_size;
-  this->temp_.clear();
-  this->temp_.reserve(reserve_size);
-  int32_t multiplier = s.buffer_read_at % 2 == 0 ? 1 : -1;
-
-  for (uint32_t i = 0; prev != write_at; i++) {
-    int32_t delta = s.buffer[s.buffer_read_at] - s.buffer[prev];
-    if (uint32_t(delta) >= this->idle_us_) {
-      // already found a space longer than idle. There must have been two pulses
-      break;
+  ESP_LOGVV(TAG, "read_at=%u write_at=%u", read_at, write_at);
+
+  // Everything up to write_at is complete. Levels longer than the idle time separate frames; if loop() was not
+  // called quickly enough there may be several of them.
+  uint32_t frame_start = read_at;
+  uint32_t frame_length = 0;
+  for (uint32_t i = read_at; i != write_at;) {
+    const uint16_t item = s.buffer[i];
+    if (++i == s.buffer_size)
+      i = 0;
+    const uint16_t duration = item & RemoteReceiverComponentStore::ITEM_DURATION_MASK;
+    if (duration == RemoteReceiverComponentStore::ITEM_OVERFLOW || duration >= this->idle_us_) {
+      this->process_ring_frame_(frame_start, frame_length);
+      frame_start = i;
+      frame_length = 0;
+    } else {
+      frame_length++;
     }
-
-    ESP_LOGVV(TAG, "  i=%u buffer[%u]=%u - buffer[%u]=%u -> %d", i, s.buffer_read_at, s.buffer[s.buffer_read_at], prev,
-              s.buffer[prev], multiplier * delta);
-    this->temp_.push_back(multiplier * delta);
-    prev = s.buffer_read_at;
-    s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
-    multiplier *= -1;
   }
-  s.buffer_read_at = (s.buffer_size + s.buffer_read_at - 1) % s.buffer_size;
-  this->temp_.push_back(this->idle_us_ * multiplier);
+  this->process_ring_frame_(frame_start, frame_length);
 
-  RemoteReceiveData data(this, &this->temp_);
+  // Hand the slots back to the ISR only after they have been decoded
+  s.buffer_read_at = write_at;
+}
+void RemoteReceiverComponent::process_ring_frame_(uint32_t start, uint32_t length) {
+  // signals must at least one rising and one leading edge
+  if (length <= 1)
+    return;
+  RemoteReceiveData data(this, this->store_.buffer, this->store_.buffer_size, start, length);
   this->process_(&data);
 }
 #endif
 
 RemoteReceiver *RemoteReceiverComponent::add_decoder(RemoteReceiver *decoder) {
   this->decoders_.push_back(decoder);
+
+  RemoteCode code{};
+  if (!decoder->get_code(&code)) {
+    this->unclassified_decoders_.push_back(decoder);
+    return decoder;
+  }
+
+  this->code_table_.insert(std::make_pair(code.hash(), std::make_pair(code, decoder)));
+  for (auto *classifier : this->classifiers_) {
+    RemoteCode other{};
+    classifier->get_code(&other);
+    if (other.same_decoder(code))
+      return decoder;
+  }
+  this->classifiers_.push_back(decoder);
   return decoder;
 }
 void RemoteReceiverComponent::add_dumper(RemoteReceiveDumper *dumper) { this->dumpers_.push_back(dumper); }
@@ -371,7 +414,23 @@ void RemoteReceiverComponent::set_filter_us(uint8_t filter_us) { this->filter_us
 void RemoteReceiverComponent::set_idle_us(uint32_t idle_us) { this->idle_us_ = idle_us; }
 void RemoteReceiverComponent::process_(RemoteReceiveData *data) {
   bool found_decoder = false;
-  for (auto *decoder : this->decoders_) {
+  // Decode the frame once per protocol and look up the receivers waiting for the result
+  for (auto *classifier : this->classifiers_) {
+    RemoteCode code{};
+    data->reset_index();
+    if (!classifier->decode_code(data, &code))
+      continue;
+
+    auto range = this->code_table_.equal_range(code.hash());
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second.first == code) {
+        it->second.second->publish_received();
+        found_decoder = true;
+      }
+    }
+  }
+
+  for (auto *decoder : this->unclassified_decoders_) {
     if (decoder->process(data))
       found_decoder = true;
   }
@@ -400,13 +459,33 @@ RemoteReceiver::RemoteReceiver(const std::string &name) : BinarySensor(name) {}
 bool RemoteReceiver::process(RemoteReceiveData *data) {
   data->reset_index();
   if (this->matches(data)) {
-    this->publish_state(true);
-    yield();
-    this->publish_state(false);
+    this->publish_received();
     return true;
   }
   return false;
 }
+void RemoteReceiver::publish_received() {
+  this->publish_state(true);
+  yield();
+  this->publish_state(false);
+}
+bool RemoteReceiver::get_code(RemoteCode *code) { return false; }
+bool RemoteReceiver::decode_code(RemoteReceiveData *data, RemoteCode *code) { return false; }
+
+bool RemoteCode::operator==(const RemoteCode &rhs) const {
+  return this->same_decoder(rhs) && this->address == rhs.address && this->command == rhs.command;
+}
+bool RemoteCode::same_decoder(const RemoteCode &other) const {
+  return this->protocol == other.protocol && this->variant == other.variant;
+}
+uint32_t RemoteCode::hash() const {
+  uint32_t hash = 2166136261UL;
+  for (uint32_t value : {uint32_t(this->protocol), this->variant, this->address, this->command}) {
+    hash *= 16777619UL;
+    hash ^= value;
+  }
+  return hash;
+}
 bool RemoteReceiveDumper::is_secondary() { return false; }
 
 bool RemoteReceiveDumper::process(RemoteReceiveData *data) {
@@ -10,6 +10,8 @@
 #include "esphome/switch_/switch.h"
 #include "esphome/binary_sensor/binary_sensor.h"
 
+#include <unordered_map>
+
 ESPHOME_NAMESPACE_BEGIN
 
 namespace remote {
@@ -56,9 +58,49 @@ struct RC5DecodeData {
   uint8_t command;
 };
 
+/// The protocols a received frame can be classified as.
+enum RemoteProtocol : uint8_t {
+  REMOTE_PROTOCOL_JVC = 0,
+  REMOTE_PROTOCOL_LG,
+  REMOTE_PROTOCOL_NEC,
+  REMOTE_PROTOCOL_PANASONIC,
+  REMOTE_PROTOCOL_SAMSUNG,
+  REMOTE_PROTOCOL_SONY,
+  REMOTE_PROTOCOL_RC5,
+  REMOTE_PROTOCOL_RC_SWITCH,
+};
+
+/** A received frame decoded into a protocol-independent (protocol, address, command) tuple.
+ *
+ * Protocols without an address field (JVC, LG, Samsung, Sony, RC Switch) store the number of bits
+ * in address instead, so that codes of different lengths never compare equal.
+ */
+struct RemoteCode {
+  RemoteProtocol protocol;
+  /// Distinguishes timings of one protocol that decode the same frame differently (RC Switch), otherwise 0.
+  uint32_t variant;
+  uint32_t address;
+  uint32_t command;
+
+  bool operator==(const RemoteCode &rhs) const;
+  /// Whether this code comes from the same decoder as other, i.e. same protocol and variant.
+  bool same_decoder(const RemoteCode &other) const;
+  uint32_t hash() const;
+};
+
 class RemoteReceiveData {
  public:
   RemoteReceiveData(RemoteReceiverComponent *parent, std::vector<int32_t> *data);
+  /** Decode a frame directly from a ring of RemoteReceiverComponentStore items, without copying it.
+   *
+   * @param parent The receiver component.
+   * @param ring The ring buffer.
+   * @param ring_size The number of items in the ring buffer.
+   * @param start The index of the first item of the frame in the ring.
+   * @param length The number of items in the frame. The frame is followed by an implicit idle space.
+   */
+  RemoteReceiveData(RemoteReceiverComponent *parent, const volatile uint16_t *ring, uint32_t ring_size,
+                    uint32_t start, uint32_t length);
 
   bool peek_mark(uint32_t length, uint32_t offset = 0);
 
@@ -99,7 +141,11 @@ class RemoteReceiveData {
 
   RemoteReceiverComponent *parent_;
   uint32_t index_{0};
-  std::vector<int32_t> *data_;
+  std::vector<int32_t> *data_{nullptr};
+  const volatile uint16_t *ring_{nullptr};
+  uint32_t ring_size_{0};
+  uint32_t ring_start_{0};
+  uint32_t ring_length_{0};
 };
 
 class RemoteReceiver : public binary_sensor::BinarySensor {
@@ -108,6 +154,28 @@ class RemoteReceiver : public binary_sensor::BinarySensor {
 
   bool process(RemoteReceiveData *data);
 
+  /// Publish a short ON pulse, signalling that this receiver's code was received.
+  void publish_received();
+
+  /** Get the code this receiver is waiting for.
+   *
+   * Receivers that can describe their code as a RemoteCode are not asked to parse each frame with matches().
+   * Instead, the receiver component decodes each frame once per protocol with decode_code() and looks up the
+   * result in a table of expected codes.
+   *
+   * @param code The code to fill.
+   * @return Whether this receiver can be matched through a RemoteCode. Defaults to false.
+   */
+  virtual bool get_code(RemoteCode *code);
+
+  /** Decode the frame with the protocol (and variant) returned by get_code().
+   *
+   * @param data The received frame, the caller resets its index.
+   * @param code The code to fill.
+   * @return Whether the frame is a valid frame of this protocol.
+   */
+  virtual bool decode_code(RemoteReceiveData *data, RemoteCode *code);
+
  protected:
   virtual bool matches(RemoteReceiveData *data) = 0;
 };
@@ -121,18 +189,39 @@ class RemoteReceiveDumper {
   virtual bool is_secondary();
 };
 
+/** Single-producer single-consumer ring of edge durations, filled by the pin interrupt.
+ *
+ * Each item is the duration of one completed level in microseconds (lower 15 bits) together with the level
+ * itself (ITEM_MARK set for a mark, i.e. a logical HIGH). Durations that don't fit into 15 bits are saturated to
+ * ITEM_OVERFLOW, which always ends a frame.
+ *
+ * Memory ordering contract: the ISR (producer) is the only writer of buffer_write_at and of the slots in
+ * [buffer_write_at, buffer_read_at), loop() (consumer) is the only writer of buffer_read_at. The producer writes a
+ * slot before publishing it by advancing buffer_write_at, the consumer only hands slots back by advancing
+ * buffer_read_at after it has decoded them. All shared fields are volatile, so the compiler keeps these accesses in
+ * program order; the ESP8266 is single core so no hardware barriers are required.
+ */
 struct RemoteReceiverComponentStore {
   static void gpio_intr(RemoteReceiverComponentStore *arg);
 
-  /// Stores the time (in micros) that the leading/falling edge happened at
-  ///  * An even index means a falling edge appeared at the time stored at the index
-  ///  * An uneven index means a rising edge appeared at the time stored at the index
-  volatile uint32_t *buffer{nullptr};
-  /// The position last written to
-  volatile uint32_t buffer_write_at;
-  /// The position last read from
-  uint32_t buffer_read_at{0};
-  bool overflow{false};
+  static const uint16_t ITEM_MARK = 0x8000;
+  static const uint16_t ITEM_DURATION_MASK = 0x7FFF;
+  static const uint16_t ITEM_OVERFLOW = ITEM_DURATION_MASK;
+
+  /// Decode an item into the signed representation used by RemoteReceiveData (positive for marks).
+  static int32_t item_to_value(uint16_t item);
+
+  /// The ring of level durations, see above.
+  volatile uint16_t *buffer{nullptr};
+  /// The position the next item will be written to
+  volatile uint32_t buffer_write_at{0};
+  /// The position the next item will be read from
+  volatile uint32_t buffer_read_at{0};
+  volatile bool overflow{false};
+  /// The time (in micros) of the last accepted edge
+  volatile uint32_t last_edge_us{0};
+  /// The level after the last accepted edge
+  volatile bool last_level{false};
   uint32_t buffer_size{1000};
   uint8_t filter_us{10};
   ISRInternalGPIOPin *pin;
@@ -160,6 +249,11 @@ class RemoteReceiverComponent : public RemoteControlComponentBase, public Compon
 
   void process_(RemoteReceiveData *data);
 
+#ifdef ARDUINO_ARCH_ESP8266
+  /// Decode the frame of length items starting at start in the store's ring.
+  void process_ring_frame_(uint32_t start, uint32_t length);
+#endif
+
 #ifdef ARDUINO_ARCH_ESP32
   void decode_rmt_(rmt_item32_t *item, size_t len);
 #endif
@@ -183,7 +277,15 @@ class RemoteReceiverComponent : public RemoteControlComponentBase, public Compon
   std::vector<RemoteReceiveDumper *> dumpers_{};
   uint8_t filter_us_{10};
   uint32_t idle_us_{10000};
+#ifdef ARDUINO_ARCH_ESP32
   std::vector<int32_t> temp_;
+#endif
+  /// One receiver per distinct (protocol, variant), used to decode each frame once per protocol.
+  std::vector<RemoteReceiver *> classifiers_{};
+  /// The expected codes of all receivers that support get_code(), keyed by RemoteCode::hash().
+  std::unordered_multimap<uint32_t, std::pair<RemoteCode, RemoteReceiver *>> code_table_{};
+  /// Receivers that can only be matched by running matches() on the frame.
+  std::vector<RemoteReceiver *> unclassified_decoders_{};
 };
 
 }  // namespace remote
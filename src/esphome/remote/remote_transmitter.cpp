@@ -51,7 +51,10 @@ void RemoteTransmitter::set_parent(RemoteTransmitterComponent *parent) { this->p
 void RemoteTransmitter::set_repeat(uint32_t send_times, uint32_t send_wait) {
   this->send_times_ = send_times;
   this->send_wait_ = send_wait;
+  // The cached RMT items contain the repeats
+  this->cache_valid_ = false;
 }
+bool RemoteTransmitter::is_cacheable() const { return false; }
 void RemoteTransmitter::write_state(bool state) {
   if (!state) {
     this->publish_state(false);
@@ -68,7 +71,10 @@ uint32_t RemoteTransmitter::get_send_wait() const { return this->send_wait_; }
 RemoteTransmitterComponent::RemoteTransmitterComponent(GPIOPin *pin) : RemoteControlComponentBase(pin) {}
 float RemoteTransmitterComponent::get_setup_priority() const { return setup_priority::HARDWARE_LATE; }
 #ifdef ARDUINO_ARCH_ESP32
-void RemoteTransmitterComponent::setup() {}
+void RemoteTransmitterComponent::setup() {
+  for (auto *transmitter : this->transmitters_)
+    this->encode_transmitter_(transmitter);
+}
 
 void RemoteTransmitterComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Remote Transmitter...");
@@ -134,21 +140,14 @@ void RemoteTransmitterComponent::configure_rmt() {
   }
 }
 
-void RemoteTransmitterComponent::send_(RemoteTransmitData *data, uint32_t send_times, uint32_t send_wait) {
-  if (this->is_failed())
-    return;
-
-  if (this->current_carrier_frequency_ != data->get_carrier_frequency()) {
-    this->current_carrier_frequency_ = data->get_carrier_frequency();
-    this->configure_rmt();
-  }
-
-  this->rmt_temp_.clear();
-  this->rmt_temp_.reserve((data->get_data().size() + 1) / 2);
+void RemoteTransmitterComponent::encode_rmt_(RemoteTransmitData *data, uint32_t send_times, uint32_t send_wait,
+                                             std::vector<rmt_item32_t> *items) {
+  items->clear();
+  items->reserve(send_times * (data->get_data().size() + 2) / 2);
   uint32_t rmt_i = 0;
   rmt_item32_t rmt_item;
 
-  for (int32_t val : data->get_data()) {
+  auto add_value = [this, items, &rmt_i, &rmt_item](int32_t val) {
     bool level = val >= 0;
     if (!level)
       val = -val;
@@ -164,38 +163,58 @@ void RemoteTransmitterComponent::send_(RemoteTransmitData *data, uint32_t send_t
       } else {
         rmt_item.level1 = static_cast<uint32_t>(level);
         rmt_item.duration1 = static_cast<uint32_t>(item);
-        this->rmt_temp_.push_back(rmt_item);
+        items->push_back(rmt_item);
       }
       rmt_i++;
     } while (val != 0);
+  };
+
+  for (uint32_t i = 0; i < send_times; i++) {
+    for (int32_t val : data->get_data())
+      add_value(val);
+    if (i + 1 < send_times && send_wait != 0)
+      add_value(-int32_t(send_wait));
   }
 
   if (rmt_i % 2 == 1) {
     rmt_item.level1 = 0;
     rmt_item.duration1 = 0;
-    this->rmt_temp_.push_back(rmt_item);
+    items->push_back(rmt_item);
+  }
+}
+
+void RemoteTransmitterComponent::transmit_rmt_(uint32_t carrier_frequency, const std::vector<rmt_item32_t> &items) {
+  if (this->is_failed())
+    return;
+
+  if (this->current_carrier_frequency_ != carrier_frequency) {
+    this->current_carrier_frequency_ = carrier_frequency;
+    this->configure_rmt();
   }
 
-  for (uint16_t i = 0; i < send_times; i++) {
-    esp_err_t error = rmt_write_items(this->channel_, this->rmt_temp_.data(), this->rmt_temp_.size(), true);
-    if (error != ESP_OK) {
-      ESP_LOGW(TAG, "rmt_write_items failed: %s", esp_err_to_name(error));
-      this->status_set_warning();
-    } else {
-      this->status_clear_warning();
-    }
-    if (i + 1 < send_times) {
-      delay(send_wait / 1000UL);
-      delayMicroseconds(send_wait % 1000UL);
-    }
+  esp_err_t error = rmt_write_items(this->channel_, items.data(), items.size(), true);
+  if (error != ESP_OK) {
+    ESP_LOGW(TAG, "rmt_write_items failed: %s", esp_err_to_name(error));
+    this->status_set_warning();
+  } else {
+    this->status_clear_warning();
   }
 }
+
+void RemoteTransmitterComponent::send_(RemoteTransmitData *data, uint32_t send_times, uint32_t send_wait) {
+  // Repeats are sent as one RMT sequence, with the wait time encoded as a space.
+  this->encode_rmt_(data, send_times, send_wait, &this->rmt_temp_);
+  this->transmit_rmt_(data->get_carrier_frequency(), this->rmt_temp_);
+}
 #endif  // ARDUINO_ARCH_ESP32
 
 #ifdef ARDUINO_ARCH_ESP8266
 void RemoteTransmitterComponent::setup() {
   this->pin_->setup();
   this->pin_->digital_write(false);
+
+  for (auto *transmitter : this->transmitters_)
+    this->encode_transmitter_(transmitter);
 }
 
 void RemoteTransmitterComponent::dump_config() {
@@ -290,12 +309,46 @@ RemoteTransmitterComponent::TransmitCall RemoteTransmitterComponent::transmit()
 void RemoteTransmitterComponent::deferred_send(RemoteTransmitter *a_switch) {
   this->defer([this, a_switch]() {
     a_switch->publish_state(true);
-    this->temp_.reset();
-    a_switch->to_data(&this->temp_);
-    this->send_(&this->temp_, a_switch->get_send_times(), a_switch->get_send_wait());
+    this->send_transmitter_(a_switch);
     a_switch->publish_state(false);
   });
 }
+void RemoteTransmitterComponent::encode_transmitter_(RemoteTransmitter *transmitter) {
+  if (!transmitter->is_cacheable())
+    return;
+
+#ifdef ARDUINO_ARCH_ESP8266
+  transmitter->cache_.reset();
+  transmitter->to_data(&transmitter->cache_);
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  // Only the RMT items are kept, the intermediate data goes through temp_.
+  this->temp_.reset();
+  transmitter->to_data(&this->temp_);
+  this->encode_rmt_(&this->temp_, transmitter->get_send_times(), transmitter->get_send_wait(),
+                    &transmitter->rmt_cache_);
+  transmitter->cache_carrier_frequency_ = this->temp_.get_carrier_frequency();
+#endif
+  transmitter->cache_valid_ = true;
+}
+void RemoteTransmitterComponent::send_transmitter_(RemoteTransmitter *transmitter) {
+  if (!transmitter->is_cacheable()) {
+    this->temp_.reset();
+    transmitter->to_data(&this->temp_);
+    this->send_(&this->temp_, transmitter->get_send_times(), transmitter->get_send_wait());
+    return;
+  }
+
+  if (!transmitter->cache_valid_)
+    this->encode_transmitter_(transmitter);
+
+#ifdef ARDUINO_ARCH_ESP32
+  this->transmit_rmt_(transmitter->cache_carrier_frequency_, transmitter->rmt_cache_);
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  this->send_(&transmitter->cache_, transmitter->get_send_times(), transmitter->get_send_wait());
+#endif
+}
 
 void RemoteTransmitterComponent::TransmitCall::perform() {
   this->parent_->send_(&this->parent_->temp_, this->send_times_, this->send_wait_);
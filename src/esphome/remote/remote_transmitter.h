@@ -57,12 +57,32 @@ class RemoteTransmitter : public switch_::Switch {
   uint32_t get_send_times() const;
   uint32_t get_send_wait() const;
 
+  /** Whether to_data() always produces the same waveform.
+   *
+   * If so, the parent encodes the waveform once (already converted into RMT items with all repeats on ESP32)
+   * and sends the cached buffer every time this switch is turned on. Defaults to false, so that transmitters
+   * with state between transmissions (like RC5's toggle bit, counters or lambdas) are encoded each time. Override
+   * this to return true for transmitters with a fixed code.
+   */
+  virtual bool is_cacheable() const;
+
  protected:
+  friend RemoteTransmitterComponent;
+
   void write_state(bool state) override;
 
   RemoteTransmitterComponent *parent_;
   uint32_t send_times_{1};  ///< How many times to send the data
   uint32_t send_wait_{0};   ///< How many microseconds to wait between repeats.
+  bool cache_valid_{false};
+#ifdef ARDUINO_ARCH_ESP8266
+  RemoteTransmitData cache_;
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  /// The RMT items including all repeats, and the carrier frequency they were encoded for.
+  std::vector<rmt_item32_t> rmt_cache_;
+  uint32_t cache_carrier_frequency_{0};
+#endif
 };
 
 class RemoteTransmitterComponent : public RemoteControlComponentBase, public Component {
@@ -128,6 +148,12 @@ class RemoteTransmitterComponent : public RemoteControlComponentBase, public Com
 
   void send_(RemoteTransmitData *data, uint32_t send_times, uint32_t send_wait);
 
+  /// Send the code of a transmitter switch, from its cache if possible.
+  void send_transmitter_(RemoteTransmitter *transmitter);
+
+  /// Fill the cache of a cacheable transmitter.
+  void encode_transmitter_(RemoteTransmitter *transmitter);
+
 #ifdef ARDUINO_ARCH_ESP8266
   void calculate_on_off_time_(uint32_t carrier_frequency, uint32_t *on_time_period, uint32_t *off_time_period);
 
@@ -137,6 +163,12 @@ class RemoteTransmitterComponent : public RemoteControlComponentBase, public Com
 #endif
 
 #ifdef ARDUINO_ARCH_ESP32
+  /// Convert data, repeated send_times times with send_wait us in between, into RMT items.
+  void encode_rmt_(RemoteTransmitData *data, uint32_t send_times, uint32_t send_wait,
+                   std::vector<rmt_item32_t> *items);
+
+  void transmit_rmt_(uint32_t carrier_frequency, const std::vector<rmt_item32_t> &items);
+
   void configure_rmt();
   uint32_t current_carrier_frequency_{UINT32_MAX};
   bool initialized_{false};
@@ -26,6 +26,7 @@ static const uint32_t FOOTER_LOW_US = 560;
 SamsungTransmitter::SamsungTransmitter(const std::string &name, uint32_t data) : RemoteTransmitter(name), data_(data) {}
 
 void SamsungTransmitter::to_data(RemoteTransmitData *data) { encode_samsung(data, this->data_); }
+bool SamsungTransmitter::is_cacheable() const { return true; }
 
 void encode_samsung(RemoteTransmitData *data, uint32_t samsung_data) {
   data->set_carrier_frequency(38000);
@@ -76,6 +77,18 @@ bool SamsungReceiver::matches(RemoteReceiveData *data) {
 
   return this->data_ == decode.data;
 }
+bool SamsungReceiver::get_code(RemoteCode *code) {
+  *code = RemoteCode{REMOTE_PROTOCOL_SAMSUNG, 0, NBITS, this->data_};
+  return true;
+}
+bool SamsungReceiver::decode_code(RemoteReceiveData *data, RemoteCode *code) {
+  auto decode = decode_samsung(data);
+  if (!decode.valid)
+    return false;
+
+  *code = RemoteCode{REMOTE_PROTOCOL_SAMSUNG, 0, NBITS, decode.data};
+  return true;
+}
 
 bool SamsungDumper::dump(RemoteReceiveData *data) {
   auto decode = decode_samsung(data);
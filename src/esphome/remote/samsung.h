@@ -19,6 +19,9 @@ class SamsungTransmitter : public RemoteTransmitter {
 
   void to_data(RemoteTransmitData *data) override;
 
+  /// The code is fixed, so the encoded waveform can be cached.
+  bool is_cacheable() const override;
+
  protected:
   uint32_t data_;
 };
@@ -33,6 +36,9 @@ class SamsungReceiver : public RemoteReceiver {
  public:
   SamsungReceiver(const std::string &name, uint32_t data);
 
+  bool get_code(RemoteCode *code) override;
+  bool decode_code(RemoteReceiveData *data, RemoteCode *code) override;
+
  protected:
   bool matches(RemoteReceiveData *data) override;
 
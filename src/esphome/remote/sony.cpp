@@ -21,6 +21,7 @@ static const uint32_t BIT_LOW_US = 600;
 SonyTransmitter::SonyTransmitter(const std::string &name, uint32_t data, uint8_t nbits)
     : RemoteTransmitter(name), data_(data), nbits_(nbits) {}
 void SonyTransmitter::to_data(RemoteTransmitData *data) { encode_sony(data, this->data_, this->nbits_); }
+bool SonyTransmitter::is_cacheable() const { return true; }
 
 void encode_sony(RemoteTransmitData *data, uint32_t sony_data, uint8_t nbits) {
   data->set_carrier_frequency(40000);
@@ -80,6 +81,18 @@ bool SonyReceiver::matches(RemoteReceiveData *data) {
   auto decode = decode_sony(data);
   return decode.valid && this->data_ == decode.data && this->nbits_ == decode.nbits;
 }
+bool SonyReceiver::get_code(RemoteCode *code) {
+  *code = RemoteCode{REMOTE_PROTOCOL_SONY, 0, this->nbits_, this->data_};
+  return true;
+}
+bool SonyReceiver::decode_code(RemoteReceiveData *data, RemoteCode *code) {
+  auto decode = decode_sony(data);
+  if (!decode.valid)
+    return false;
+
+  *code = RemoteCode{REMOTE_PROTOCOL_SONY, 0, decode.nbits, decode.data};
+  return true;
+}
 
 bool SonyDumper::dump(RemoteReceiveData *data) {
   auto decode = decode_sony(data);
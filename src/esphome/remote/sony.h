@@ -19,6 +19,9 @@ class SonyTransmitter : public RemoteTransmitter {
 
   void to_data(RemoteTransmitData *data) override;
 
+  /// The code is fixed, so the encoded waveform can be cached.
+  bool is_cacheable() const override;
+
  protected:
   uint32_t data_;
   uint8_t nbits_;
@@ -34,6 +37,9 @@ class SonyReceiver : public RemoteReceiver {
  public:
   SonyReceiver(const std::string &name, uint32_t data, uint8_t nbits);
 
+  bool get_code(RemoteCode *code) override;
+  bool decode_code(RemoteReceiveData *data, RemoteCode *code) override;
+
  protected:
   bool matches(RemoteReceiveData *data) override;
 
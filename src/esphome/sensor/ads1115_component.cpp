@@ -5,6 +5,8 @@
 #include "esphome/log.h"
 #include "esphome/sensor/ads1115_component.h"
 
+#include <algorithm>
+
 ESPHOME_NAMESPACE_BEGIN
 
 namespace sensor {
@@ -62,6 +64,7 @@ void ADS1115Component::setup() {
     this->mark_failed();
     return;
   }
+  this->config_ = config;
   for (auto *sensor : this->sensors_) {
     this->set_interval(sensor->get_name(), sensor->update_interval(),
                        [this, sensor] { this->request_measurement_(sensor); });
@@ -82,11 +85,16 @@ void ADS1115Component::dump_config() {
 }
 float ADS1115Component::get_setup_priority() const { return setup_priority::HARDWARE_LATE; }
 void ADS1115Component::request_measurement_(ADS1115Sensor *sensor) {
-  uint16_t config;
-  if (!this->read_byte_16(ADS1115_REGISTER_CONFIG, &config)) {
-    this->status_set_warning();
+  if (this->measuring_) {
+    // Only one conversion can run at a time
+    if (std::find(this->pending_sensors_.begin(), this->pending_sensors_.end(), sensor) ==
+        this->pending_sensors_.end())
+      this->pending_sensors_.push_back(sensor);
     return;
   }
+  this->measuring_ = true;
+
+  uint16_t config = this->config_;
   // Multiplexer
   //        0bxBBBxxxxxxxxxxxx
   config &= 0b1000111111111111;
@@ -99,50 +107,63 @@ void ADS1115Component::request_measurement_(ADS1115Sensor *sensor) {
   // Start conversion
   config |= 0b1000000000000000;
 
-  if (!this->write_byte_16(ADS1115_REGISTER_CONFIG, config)) {
-    this->status_set_warning();
-    return;
-  }
-
-  // about 1.6 ms with 860 samples per second
-  delay(2);
-
-  uint32_t start = millis();
-  while (this->read_byte_16(ADS1115_REGISTER_CONFIG, &config) && (config >> 15) == 0) {
-    if (millis() - start > 100) {
-      ESP_LOGW(TAG, "Reading ADS1115 timed out");
-      this->status_set_warning();
+  uint8_t data[2] = {uint8_t(config >> 8), uint8_t(config & 0xFF)};
+  this->submit_write(ADS1115_REGISTER_CONFIG, data, 2, [this, sensor](bool success, const uint8_t *) {
+    if (!success) {
+      this->finish_measurement_(false);
+      return;
+    }
+    this->measurement_start_ = millis();
+    // about 1.6 ms with 860 samples per second
+    this->poll_conversion_(sensor, 2);
+  });
+}
+void ADS1115Component::poll_conversion_(ADS1115Sensor *sensor, uint32_t wait) {
+  this->submit_read(ADS1115_REGISTER_CONFIG, 2, wait, [this, sensor](bool success, const uint8_t *data) {
+    if (!success) {
+      this->finish_measurement_(false);
+      return;
+    }
+    if ((data[0] >> 7) == 0) {
+      if (millis() - this->measurement_start_ > 100) {
+        ESP_LOGW(TAG, "Reading ADS1115 timed out");
+        this->finish_measurement_(false);
+        return;
+      }
+      this->poll_conversion_(sensor, 1);
       return;
     }
-    yield();
-  }
-
-  uint16_t raw_conversion;
-  if (!this->read_byte_16(ADS1115_REGISTER_CONVERSION, &raw_conversion)) {
-    this->status_set_warning();
-    return;
-  }
-  auto signed_conversion = static_cast<int16_t>(raw_conversion);
 
+    this->submit_read(ADS1115_REGISTER_CONVERSION, 2, 0, [this, sensor](bool success, const uint8_t *data) {
+      if (!success) {
+        this->finish_measurement_(false);
+        return;
+      }
+      this->publish_conversion_(sensor, static_cast<int16_t>((uint16_t(data[0]) << 8) | data[1]));
+      this->finish_measurement_(true);
+    });
+  });
+}
+void ADS1115Component::publish_conversion_(ADS1115Sensor *sensor, int16_t conversion) {
   float millivolts;
   switch (sensor->get_gain()) {
     case ADS1115_GAIN_6P144:
-      millivolts = signed_conversion * 0.187500f;
+      millivolts = conversion * 0.187500f;
       break;
     case ADS1115_GAIN_4P096:
-      millivolts = signed_conversion * 0.125000f;
+      millivolts = conversion * 0.125000f;
       break;
     case ADS1115_GAIN_2P048:
-      millivolts = signed_conversion * 0.062500f;
+      millivolts = conversion * 0.062500f;
       break;
     case ADS1115_GAIN_1P024:
-      millivolts = signed_conversion * 0.031250f;
+      millivolts = conversion * 0.031250f;
       break;
     case ADS1115_GAIN_0P512:
-      millivolts = signed_conversion * 0.015625f;
+      millivolts = conversion * 0.015625f;
       break;
     case ADS1115_GAIN_0P256:
-      millivolts = signed_conversion * 0.007813f;
+      millivolts = conversion * 0.007813f;
       break;
     default:
       millivolts = NAN;
@@ -151,7 +172,19 @@ void ADS1115Component::request_measurement_(ADS1115Sensor *sensor) {
   float v = millivolts / 1000.0f;
   ESP_LOGD(TAG, "'%s': Got Voltage=%fV", sensor->get_name().c_str(), v);
   sensor->publish_state(v);
-  this->status_clear_warning();
+}
+void ADS1115Component::finish_measurement_(bool success) {
+  if (success) {
+    this->status_clear_warning();
+  } else {
+    this->status_set_warning();
+  }
+  this->measuring_ = false;
+  if (!this->pending_sensors_.empty()) {
+    ADS1115Sensor *next = this->pending_sensors_.front();
+    this->pending_sensors_.erase(this->pending_sensors_.begin());
+    this->request_measurement_(next);
+  }
 }
 
 ADS1115Sensor *ADS1115Component::get_sensor(const std::string &name, ADS1115Multiplexer multiplexer, ADS1115Gain gain,
@@ -65,10 +65,20 @@ class ADS1115Component : public Component, public I2CDevice {
   float get_setup_priority() const override;
 
  protected:
-  /// Helper method to request a measurement from a sensor.
+  /// Helper method to request a measurement from a sensor, queued if another measurement is still running.
   void request_measurement_(ADS1115Sensor *sensor);
+  /// Wait for the conversion to be done and read it out.
+  void poll_conversion_(ADS1115Sensor *sensor, uint32_t wait);
+  void publish_conversion_(ADS1115Sensor *sensor, int16_t conversion);
+  /// End the running measurement and start the next queued one.
+  void finish_measurement_(bool success);
 
   std::vector<ADS1115Sensor *> sensors_;
+  /// The config register as written in setup, each measurement only changes multiplexer and gain.
+  uint16_t config_{0};
+  bool measuring_{false};
+  uint32_t measurement_start_{0};
+  std::vector<ADS1115Sensor *> pending_sensors_;
 };
 
 /// Internal holder class that is in instance of Sensor so that the hub can create individual sensors.
@@ -193,38 +193,46 @@ void BME280Component::update() {
   meas_register |= (this->temperature_oversampling_ & 0b111) << 5;
   meas_register |= (this->pressure_oversampling_ & 0b111) << 2;
   meas_register |= 0b01;  // Forced mode
-  if (!this->write_byte(BME280_REGISTER_CONTROL, meas_register)) {
-    this->status_set_warning();
-    return;
-  }
 
   float meas_time = 1;
   meas_time += 2.3f * oversampling_to_time(this->temperature_oversampling_);
   meas_time += 2.3f * oversampling_to_time(this->pressure_oversampling_) + 0.575f;
   meas_time += 2.3f * oversampling_to_time(this->humidity_oversampling_) + 0.575f;
 
-  this->set_timeout("data", uint32_t(ceilf(meas_time)), [this]() {
-    int32_t t_fine = 0;
-    float temperature = this->read_temperature_(&t_fine);
-    if (isnan(temperature)) {
-      ESP_LOGW(TAG, "Invalid temperature, cannot read pressure & humidity values.");
+  this->submit_write(BME280_REGISTER_CONTROL, &meas_register, 1, [this, meas_time](bool success, const uint8_t *) {
+    if (!success) {
       this->status_set_warning();
       return;
     }
-    float pressure = this->read_pressure_(t_fine);
-    float humidity = this->read_humidity_(t_fine);
-
-    ESP_LOGD(TAG, "Got temperature=%.1f°C pressure=%.1fhPa humidity=%.1f%%", temperature, pressure, humidity);
-    this->temperature_sensor_->publish_state(temperature);
-    this->pressure_sensor_->publish_state(pressure);
-    this->humidity_sensor_->publish_state(humidity);
-    this->status_clear_warning();
+    // Read pressure, temperature and humidity in one burst once the conversion is done, the bus is free meanwhile.
+    this->submit_read(BME280_REGISTER_PRESSUREDATA, 8, uint32_t(ceilf(meas_time)),
+                      [this](bool success, const uint8_t *data) {
+                        if (!success) {
+                          this->status_set_warning();
+                          return;
+                        }
+                        this->publish_data_(data);
+                      });
   });
 }
-float BME280Component::read_temperature_(int32_t *t_fine) {
-  uint8_t data[3];
-  if (!this->read_bytes(BME280_REGISTER_TEMPDATA, data, 3))
-    return NAN;
+void BME280Component::publish_data_(const uint8_t *data) {
+  int32_t t_fine = 0;
+  float temperature = this->read_temperature_(data + BME280_REGISTER_TEMPDATA - BME280_REGISTER_PRESSUREDATA, &t_fine);
+  if (isnan(temperature)) {
+    ESP_LOGW(TAG, "Invalid temperature, cannot read pressure & humidity values.");
+    this->status_set_warning();
+    return;
+  }
+  float pressure = this->read_pressure_(data, t_fine);
+  float humidity = this->read_humidity_(data + BME280_REGISTER_HUMIDDATA - BME280_REGISTER_PRESSUREDATA, t_fine);
+
+  ESP_LOGD(TAG, "Got temperature=%.1f°C pressure=%.1fhPa humidity=%.1f%%", temperature, pressure, humidity);
+  this->temperature_sensor_->publish_state(temperature);
+  this->pressure_sensor_->publish_state(pressure);
+  this->humidity_sensor_->publish_state(humidity);
+  this->status_clear_warning();
+}
+float BME280Component::read_temperature_(const uint8_t *data, int32_t *t_fine) {
   int32_t adc = ((data[0] & 0xFF) << 16) | ((data[1] & 0xFF) << 8) | (data[2] & 0xFF);
   adc >>= 4;
   if (adc == 0x80000)
@@ -243,10 +251,7 @@ float BME280Component::read_temperature_(int32_t *t_fine) {
   return temperature / 100.0f;
 }
 
-float BME280Component::read_pressure_(int32_t t_fine) {
-  uint8_t data[3];
-  if (!this->read_bytes(BME280_REGISTER_PRESSUREDATA, data, 3))
-    return NAN;
+float BME280Component::read_pressure_(const uint8_t *data, int32_t t_fine) {
   int32_t adc = ((data[0] & 0xFF) << 16) | ((data[1] & 0xFF) << 8) | (data[2] & 0xFF);
   adc >>= 4;
   if (adc == 0x80000)
@@ -282,9 +287,9 @@ float BME280Component::read_pressure_(int32_t t_fine) {
   return (p / 256.0f) / 100.0f;
 }
 
-float BME280Component::read_humidity_(int32_t t_fine) {
-  uint16_t raw_adc;
-  if (!this->read_byte_16(BME280_REGISTER_HUMIDDATA, &raw_adc) || raw_adc == 0x8000)
+float BME280Component::read_humidity_(const uint8_t *data, int32_t t_fine) {
+  uint16_t raw_adc = combine_bytes(data[0], data[1]);
+  if (raw_adc == 0x8000)
     return NAN;
 
   int32_t adc = raw_adc;
@@ -93,12 +93,14 @@ class BME280Component : public PollingComponent, public I2CDevice {
   void update() override;
 
  protected:
+  /// Publish the values from a burst read of the data registers (0xF7 to 0xFE).
+  void publish_data_(const uint8_t *data);
   /// Read the temperature value and store the calculated ambient temperature in t_fine.
-  float read_temperature_(int32_t *t_fine);
+  float read_temperature_(const uint8_t *data, int32_t *t_fine);
   /// Read the pressure value in hPa using the provided t_fine value.
-  float read_pressure_(int32_t t_fine);
+  float read_pressure_(const uint8_t *data, int32_t t_fine);
   /// Read the humidity value in % using the provided t_fine value.
-  float read_humidity_(int32_t t_fine);
+  float read_humidity_(const uint8_t *data, int32_t t_fine);
   uint8_t read_u8_(uint8_t a_register);
   uint16_t read_u16_le_(uint8_t a_register);
   int16_t read_s16_le_(uint8_t a_register);
@@ -11,71 +11,40 @@ namespace sensor {
 
 static const char *TAG = "sensor.cse7766";
 
-void CSE7766Component::loop() {
-  const uint32_t now = millis();
-  if (now - this->last_transmission_ >= 500) {
-    // last transmission too long ago. Reset RX index.
-    this->raw_data_index_ = 0;
-  }
-
-  if (this->available() == 0)
-    return;
+static UARTFrameSpec cse7766_frame_spec() {
+  UARTFrameSpec spec;
+  // The first header byte depends on the state of the chip, so look for the second one
+  spec.header = {0x5A};
+  spec.header_offset = 1;
+  spec.length = 24;
+  spec.max_length = 24;
+  spec.checksum = UART_FRAME_CHECKSUM_SUM8;
+  spec.checksum_start = 2;
+  return spec;
+}
 
-  this->last_transmission_ = now;
-  while (this->available() != 0) {
-    this->read_byte(&this->raw_data_[this->raw_data_index_]);
-    if (!this->check_byte_()) {
-      this->raw_data_index_ = 0;
+void CSE7766Component::loop() {
+  this->frame_reader_.read([this](const uint8_t *data, size_t len) {
+    uint8_t header1 = data[0];
+    if (header1 != 0x55 && (header1 & 0xF0) != 0xF0 && header1 != 0xAA) {
+      ESP_LOGV(TAG, "Invalid Header 1 Start: 0x%02X!", header1);
       this->status_set_warning();
+      return;
     }
-
-    if (this->raw_data_index_ == 23) {
-      this->parse_data_();
-      this->status_clear_warning();
-    }
-
-    this->raw_data_index_ = (this->raw_data_index_ + 1) % 24;
-  }
+    this->parse_data_(data);
+    this->status_clear_warning();
+  });
 }
 float CSE7766Component::get_setup_priority() const { return setup_priority::HARDWARE_LATE; }
 
-bool CSE7766Component::check_byte_() {
-  uint8_t index = this->raw_data_index_;
-  uint8_t byte = this->raw_data_[index];
-  if (index == 0) {
-    return !((byte != 0x55) && ((byte & 0xF0) != 0xF0) && (byte != 0xAA));
-  }
-
-  if (index == 1) {
-    if (byte != 0x5A) {
-      ESP_LOGV(TAG, "Invalid Header 2 Start: 0x%02X!", byte);
-      return false;
-    }
-    return true;
-  }
-
-  if (index == 23) {
-    uint8_t checksum = 0;
-    for (uint8_t i = 2; i < 23; i++)
-      checksum += this->raw_data_[i];
-
-    if (checksum != this->raw_data_[23]) {
-      ESP_LOGW(TAG, "Invalid checksum from CSE7766: 0x%02X != 0x%02X", checksum, this->raw_data_[23]);
-      return false;
-    }
-    return true;
-  }
-
-  return true;
-}
-void CSE7766Component::parse_data_() {
+void CSE7766Component::parse_data_(const uint8_t *raw_data) {
   ESP_LOGVV(TAG, "CSE7766 Data: ");
   for (uint8_t i = 0; i < 23; i++) {
-    ESP_LOGVV(TAG, "  i=%u: 0b" BYTE_TO_BINARY_PATTERN " (0x%02X)", i, BYTE_TO_BINARY(this->raw_data_[i]),
-              this->raw_data_[i]);
+    ESP_LOGVV(TAG, "  i=%u: 0b" BYTE_TO_BINARY_PATTERN " (0x%02X)", i, BYTE_TO_BINARY(raw_data[i]),
+              raw_data[i]);
   }
 
-  uint8_t header1 = this->raw_data_[0];
+  uint8_t header1 = raw_data[0];
   if (header1 == 0xAA) {
     ESP_LOGW(TAG, "CSE7766 not calibrated!");
     return;
@@ -87,14 +56,14 @@ void CSE7766Component::parse_data_() {
     return;
   }
 
-  uint32_t voltage_calib = this->get_24_bit_uint_(2);
-  uint32_t voltage_cycle = this->get_24_bit_uint_(5);
-  uint32_t current_calib = this->get_24_bit_uint_(8);
-  uint32_t current_cycle = this->get_24_bit_uint_(11);
-  uint32_t power_calib = this->get_24_bit_uint_(14);
-  uint32_t power_cycle = this->get_24_bit_uint_(17);
+  uint32_t voltage_calib = this->get_24_bit_uint_(raw_data, 2);
+  uint32_t voltage_cycle = this->get_24_bit_uint_(raw_data, 5);
+  uint32_t current_calib = this->get_24_bit_uint_(raw_data, 8);
+  uint32_t current_cycle = this->get_24_bit_uint_(raw_data, 11);
+  uint32_t power_calib = this->get_24_bit_uint_(raw_data, 14);
+  uint32_t power_cycle = this->get_24_bit_uint_(raw_data, 17);
 
-  uint8_t adj = this->raw_data_[20];
+  uint8_t adj = raw_data[20];
 
   bool power_ok = true;
   bool voltage_ok = true;
@@ -166,13 +135,13 @@ void CSE7766Component::update() {
   this->current_counts_ = 0;
 }
 
-uint32_t CSE7766Component::get_24_bit_uint_(uint8_t start_index) {
-  return (uint32_t(this->raw_data_[start_index]) << 16) | (uint32_t(this->raw_data_[start_index + 1]) << 8) |
-         uint32_t(this->raw_data_[start_index + 2]);
+uint32_t CSE7766Component::get_24_bit_uint_(const uint8_t *raw_data, uint8_t start_index) {
+  return (uint32_t(raw_data[start_index]) << 16) | (uint32_t(raw_data[start_index + 1]) << 8) |
+         uint32_t(raw_data[start_index + 2]);
 }
 
 CSE7766Component::CSE7766Component(UARTComponent *parent, uint32_t update_interval)
-    : UARTDevice(parent), PollingComponent(update_interval) {}
+    : UARTDevice(parent), PollingComponent(update_interval), frame_reader_(parent, cse7766_frame_spec()) {}
 CSE7766VoltageSensor *CSE7766Component::make_voltage_sensor(const std::string &name) {
   return this->voltage_sensor_ = new CSE7766VoltageSensor(name);
 }
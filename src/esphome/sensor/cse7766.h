@@ -34,13 +34,10 @@ class CSE7766Component : public PollingComponent, public UARTDevice {
   void dump_config() override;
 
  protected:
-  bool check_byte_();
-  void parse_data_();
-  uint32_t get_24_bit_uint_(uint8_t start_index);
+  void parse_data_(const uint8_t *raw_data);
+  uint32_t get_24_bit_uint_(const uint8_t *raw_data, uint8_t start_index);
 
-  uint8_t raw_data_[24];
-  uint8_t raw_data_index_{0};
-  uint32_t last_transmission_{0};
+  UARTFrameReader frame_reader_;
   CSE7766VoltageSensor *voltage_sensor_{nullptr};
   CSE7766CurrentSensor *current_sensor_{nullptr};
   CSE7766PowerSensor *power_sensor_{nullptr};
@@ -41,6 +41,7 @@ uint16_t DallasTemperatureSensor::millis_to_wait_for_conversion() const {
 void DallasComponent::set_one_wire(ESPOneWire *one_wire) { this->one_wire_ = one_wire; }
 void DallasComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up DallasComponent...");
+  this->engine_ = new ESPOneWireEngine(this->one_wire_);
 
   yield();
   disable_interrupts();
@@ -120,32 +121,42 @@ DallasTemperatureSensor *DallasComponent::get_sensor_by_index(const std::string
   return s;
 }
 void DallasComponent::update() {
-  this->status_clear_warning();
-
-  disable_interrupts();
-  bool result;
-  if (!this->one_wire_->reset()) {
-    result = false;
-  } else {
-    result = true;
-    this->one_wire_->skip();
-    this->one_wire_->write8(DALLAS_COMMAND_START_CONVERSION);
-  }
-  enable_interrupts();
-
-  if (!result) {
-    ESP_LOGE(TAG, "Requesting conversion failed");
+  if (!this->engine_->is_idle()) {
+    ESP_LOGW(TAG, "Previous update is still in progress, skipping this one");
     this->status_set_warning();
     return;
   }
+  this->status_clear_warning();
+
+  // All sensors convert at the same time, then all scratch pads are read in one batch.
+  this->engine_->queue_reset();
+  this->engine_->queue_skip();
+  this->engine_->queue_write8(DALLAS_COMMAND_START_CONVERSION);
+  this->engine_->queue_end_transaction([this](bool success) {
+    if (!success) {
+      ESP_LOGE(TAG, "Requesting conversion failed");
+      this->status_set_warning();
+      this->engine_->clear();
+    }
+  });
+
+  uint16_t wait = 0;
+  for (auto *sensor : this->sensors_)
+    wait = std::max(wait, sensor->millis_to_wait_for_conversion());
+  this->engine_->queue_delay(wait);
 
   for (auto *sensor : this->sensors_) {
-    this->set_timeout(sensor->get_address_name(), sensor->millis_to_wait_for_conversion(), [this, sensor] {
-      disable_interrupts();
-      bool res = sensor->read_scratch_pad();
-      enable_interrupts();
+    if (sensor->get_address() == 0)
+      // Not found by index
+      continue;
 
-      if (!res) {
+    this->engine_->queue_reset();
+    this->engine_->queue_select(sensor->get_address());
+    this->engine_->queue_write8(DALLAS_COMMAND_READ_SCRATCH_PAD);
+    this->engine_->queue_read(sensor->scratch_pad_, sizeof(sensor->scratch_pad_));
+    this->engine_->queue_end_transaction([this, sensor](bool success) {
+      if (!success) {
+        ESP_LOGW(TAG, "'%s': Reading scratchpad failed: reset", sensor->get_name().c_str());
         this->status_set_warning();
         return;
       }
@@ -160,6 +171,7 @@ void DallasComponent::update() {
     });
   }
 }
+void DallasComponent::loop() { this->engine_->process(); }
 DallasComponent::DallasComponent(ESPOneWire *one_wire, uint32_t update_interval)
     : PollingComponent(update_interval), one_wire_(one_wire) {}
 ESPOneWire *DallasComponent::get_one_wire() const { return this->one_wire_; }
@@ -54,11 +54,14 @@ class DallasComponent : public PollingComponent {
   float get_setup_priority() const override;
 
   void update() override;
+  /// Run the queued 1-Wire operations of the current update.
+  void loop() override;
 
   ESPOneWire *get_one_wire() const;
 
  protected:
   ESPOneWire *one_wire_;
+  ESPOneWireEngine *engine_{nullptr};
   std::vector<DallasTemperatureSensor *> sensors_;
   std::vector<uint64_t> found_sensors_;
 };
@@ -104,6 +107,8 @@ class DallasTemperatureSensor : public EmptyPollingParentSensor<1, ICON_EMPTY, U
   std::string unique_id() override;
 
  protected:
+  friend DallasComponent;
+
   uint64_t address_;
   optional<uint8_t> index_;
 
@@ -15,6 +15,8 @@ void HX711Sensor::setup() {
   ESP_LOGCONFIG(TAG, "Setting up HX711 '%s'...", this->name_.c_str());
   this->sck_pin_->setup();
   this->dout_pin_->setup();
+  this->fast_dout_ = FastGPIOPin(this->dout_pin_);
+  this->fast_sck_ = FastGPIOPin(this->sck_pin_);
 
   // Read sensor once without publishing to set the gain
   this->read_sensor_(nullptr);
@@ -35,7 +37,7 @@ void HX711Sensor::update() {
   }
 }
 bool HX711Sensor::read_sensor_(uint32_t *result) {
-  if (this->dout_pin_->digital_read()) {
+  if (this->fast_dout_.digital_read()) {
     ESP_LOGW(TAG, "HX711 is not ready for new measurements yet!");
     this->status_set_warning();
     return false;
@@ -45,17 +47,19 @@ bool HX711Sensor::read_sensor_(uint32_t *result) {
   uint32_t data = 0;
 
   for (uint8_t i = 0; i < 24; i++) {
-    this->sck_pin_->digital_write(true);
+    this->fast_sck_.digital_write(true);
     delayMicroseconds(1);
-    data |= uint32_t(this->dout_pin_->digital_read()) << (24 - i);
-    this->sck_pin_->digital_write(false);
+    data |= uint32_t(this->fast_dout_.digital_read()) << (24 - i);
+    this->fast_sck_.digital_write(false);
     delayMicroseconds(1);
   }
 
-  // Cycle clock pin for gain setting
+  // Cycle clock pin for gain setting, PD_SCK has to be high for at least 0.2µs
   for (uint8_t i = 0; i < this->gain_; i++) {
-    this->sck_pin_->digital_write(true);
-    this->sck_pin_->digital_write(false);
+    this->fast_sck_.digital_write(true);
+    delayMicroseconds(1);
+    this->fast_sck_.digital_write(false);
+    delayMicroseconds(1);
   }
 
   data ^= 0x800000;
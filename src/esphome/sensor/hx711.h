@@ -37,6 +37,8 @@ class HX711Sensor : public PollingSensorComponent {
 
   GPIOPin *dout_pin_;
   GPIOPin *sck_pin_;
+  FastGPIOPin fast_dout_;
+  FastGPIOPin fast_sck_;
   HX711Gain gain_{HX711_GAIN_128};
 };
 
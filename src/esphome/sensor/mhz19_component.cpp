@@ -14,8 +14,21 @@ static const uint8_t MHZ19_REQUEST_LENGTH = 8;
 static const uint8_t MHZ19_RESPONSE_LENGTH = 9;
 static const uint8_t MHZ19_COMMAND_GET_PPM[] = {0xFF, 0x01, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00};
 
+static UARTFrameSpec mhz19_frame_spec() {
+  UARTFrameSpec spec;
+  spec.header = {0xFF, 0x86};
+  spec.length = MHZ19_RESPONSE_LENGTH;
+  spec.max_length = MHZ19_RESPONSE_LENGTH;
+  spec.checksum = UART_FRAME_CHECKSUM_NEG_SUM8;
+  spec.checksum_start = 1;
+  return spec;
+}
+
 MHZ19Component::MHZ19Component(UARTComponent *parent, const std::string &co2_name, uint32_t update_interval)
-    : PollingComponent(update_interval), UARTDevice(parent), co2_sensor_(new MHZ19CO2Sensor(co2_name, this)) {}
+    : PollingComponent(update_interval),
+      UARTDevice(parent),
+      frame_reader_(parent, mhz19_frame_spec()),
+      co2_sensor_(new MHZ19CO2Sensor(co2_name, this)) {}
 uint8_t mhz19_checksum(const uint8_t *command) {
   uint8_t sum = 0;
   for (uint8_t i = 1; i < MHZ19_REQUEST_LENGTH; i++) {
@@ -25,26 +38,21 @@ uint8_t mhz19_checksum(const uint8_t *command) {
 }
 
 void MHZ19Component::update() {
-  uint8_t response[MHZ19_RESPONSE_LENGTH];
-  if (!this->mhz19_write_command_(MHZ19_COMMAND_GET_PPM, response)) {
+  if (this->response_pending_) {
     ESP_LOGW(TAG, "Reading data from MHZ19 failed!");
     this->status_set_warning();
-    return;
-  }
-
-  if (response[0] != 0xFF || response[1] != 0x86) {
-    ESP_LOGW(TAG, "Invalid preamble from MHZ19!");
-    this->status_set_warning();
-    return;
-  }
-
-  uint8_t checksum = mhz19_checksum(response);
-  if (response[8] != checksum) {
-    ESP_LOGW(TAG, "MHZ19 Checksum doesn't match: 0x%02X!=0x%02X", response[8], checksum);
-    this->status_set_warning();
-    return;
   }
 
+  // The response is read in loop(), without waiting for it here.
+  this->frame_reader_.reset();
+  this->mhz19_write_command_(MHZ19_COMMAND_GET_PPM);
+  this->response_pending_ = true;
+}
+void MHZ19Component::loop() {
+  this->frame_reader_.read([this](const uint8_t *data, size_t len) { this->parse_response_(data); });
+}
+void MHZ19Component::parse_response_(const uint8_t *response) {
+  this->response_pending_ = false;
   this->status_clear_warning();
   const uint16_t ppm = (uint16_t(response[2]) << 8) | response[3];
   const int temp = int(response[4]) - 40;
@@ -56,17 +64,10 @@ void MHZ19Component::update() {
     this->temperature_sensor_->publish_state(temp);
 }
 
-bool MHZ19Component::mhz19_write_command_(const uint8_t *command, uint8_t *response) {
+void MHZ19Component::mhz19_write_command_(const uint8_t *command) {
   this->flush();
   this->write_array(command, MHZ19_REQUEST_LENGTH);
   this->write_byte(mhz19_checksum(command));
-
-  if (response == nullptr)
-    return true;
-
-  bool ret = this->read_array(response, MHZ19_RESPONSE_LENGTH);
-  this->flush();
-  return ret;
 }
 MHZ19TemperatureSensor *MHZ19Component::make_temperature_sensor(const std::string &name) {
   return this->temperature_sensor_ = new MHZ19TemperatureSensor(name, this);
@@ -23,14 +23,20 @@ class MHZ19Component : public PollingComponent, public UARTDevice {
   float get_setup_priority() const override;
 
   void update() override;
+  /// Read the response to the last request.
+  void loop() override;
   void dump_config() override;
 
   MHZ19TemperatureSensor *make_temperature_sensor(const std::string &name);
   MHZ19CO2Sensor *get_co2_sensor() const;
 
  protected:
-  bool mhz19_write_command_(const uint8_t *command, uint8_t *response);
+  void mhz19_write_command_(const uint8_t *command);
+  void parse_response_(const uint8_t *response);
 
+  UARTFrameReader frame_reader_;
+  /// Whether the response to the last request hasn't been received yet.
+  bool response_pending_{false};
   MHZ19TemperatureSensor *temperature_sensor_{nullptr};
   MHZ19CO2Sensor *co2_sensor_;
 };
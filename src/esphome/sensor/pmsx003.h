@@ -63,13 +63,10 @@ class PMSX003Component : public UARTDevice, public Component {
   PMSX003Sensor *make_formaldehyde_sensor(const std::string &name);
 
  protected:
-  optional<bool> check_byte_();
-  void parse_data_();
-  uint16_t get_16_bit_uint_(uint8_t start_index);
+  void parse_data_(const uint8_t *data, size_t len);
+  uint16_t get_16_bit_uint_(const uint8_t *data, uint8_t start_index);
 
-  uint8_t data_[64];
-  uint8_t data_index_{0};
-  uint32_t last_transmission_{0};
+  UARTFrameReader frame_reader_;
   const PMSX003Type type_;
   PMSX003Sensor *pm_1_0_sensor_{nullptr};
   PMSX003Sensor *pm_2_5_sensor_{nullptr};
@@ -35,8 +35,22 @@ static const uint8_t SDS011_MODE_REPORT_QUERY = 0x01;
 static const uint8_t SDS011_MODE_SLEEP = 0x00;
 static const uint8_t SDS011_MODE_WORK = 0x01;
 
+static UARTFrameSpec sds011_frame_spec() {
+  UARTFrameSpec spec;
+  spec.header = {SDS011_MSG_HEAD, SDS011_COMMAND_ID_DATA};
+  spec.length = SDS011_MSG_RESPONSE_LENGTH;
+  // checksum is over the data bytes
+  spec.checksum = UART_FRAME_CHECKSUM_SUM8;
+  spec.checksum_start = 2;
+  spec.trailer = {SDS011_MSG_TAIL};
+  return spec;
+}
+
 SDS011Component::SDS011Component(UARTComponent *parent, uint8_t update_interval_min, bool rx_mode_only)
-    : UARTDevice(parent), update_interval_min_(update_interval_min), rx_mode_only_(rx_mode_only) {}
+    : UARTDevice(parent),
+      frame_reader_(parent, sds011_frame_spec()),
+      update_interval_min_(update_interval_min),
+      rx_mode_only_(rx_mode_only) {}
 
 void SDS011Component::setup() {
   if (this->rx_mode_only_) {
@@ -69,34 +83,7 @@ void SDS011Component::dump_config() {
 }
 
 void SDS011Component::loop() {
-  const uint32_t now = millis();
-  if ((now - this->last_transmission_ >= 500) && this->data_index_) {
-    // last transmission too long ago. Reset RX index.
-    ESP_LOGV(TAG, "Last transmission too long ago. Reset RX index.");
-    this->data_index_ = 0;
-  }
-
-  if (this->available() == 0) {
-    return;
-  }
-
-  this->last_transmission_ = now;
-  while (this->available() != 0) {
-    this->read_byte(&this->data_[this->data_index_]);
-    auto check = this->check_byte_();
-    if (!check.has_value()) {
-      // finished
-      this->parse_data_();
-      this->data_index_ = 0;
-    } else if (!*check) {
-      // wrong data
-      ESP_LOGV(TAG, "Byte %i of received data frame is invalid.", this->data_index_);
-      this->data_index_ = 0;
-    } else {
-      // next byte
-      this->data_index_++;
-    }
-  }
+  this->frame_reader_.read([this](const uint8_t *data, size_t len) { this->parse_data_(data); });
 }
 
 SDS011Sensor *SDS011Component::make_pm_2_5_sensor(const std::string &name) {
@@ -130,45 +117,10 @@ uint8_t SDS011Component::sds011_checksum_(const uint8_t *command_data, uint8_t l
   return sum;
 }
 
-optional<bool> SDS011Component::check_byte_() const {
-  uint8_t index = this->data_index_;
-  uint8_t byte = this->data_[index];
-
-  if (index == 0) {
-    return byte == SDS011_MSG_HEAD;
-  }
-
-  if (index == 1) {
-    return byte == SDS011_COMMAND_ID_DATA;
-  }
-
-  if ((index >= 2) && (index <= 7)) {
-    return true;
-  }
-
-  if (index == 8) {
-    // checksum is without checksum bytes
-    uint8_t checksum = sds011_checksum_(this->data_ + 2, SDS011_DATA_RESPONSE_LENGTH);
-    if (checksum != byte) {
-      ESP_LOGW(TAG, "SDS011 Checksum doesn't match: 0x%02X!=0x%02X", byte, checksum);
-      return false;
-    }
-    return true;
-  }
-
-  if (index == 9) {
-    if (byte != SDS011_MSG_TAIL) {
-      return false;
-    }
-  }
-
-  return {};
-}
-
-void SDS011Component::parse_data_() {
+void SDS011Component::parse_data_(const uint8_t *data) {
   this->status_clear_warning();
-  const float pm_2_5_concentration = this->get_16_bit_uint_(2) / 10.0f;
-  const float pm_10_0_concentration = this->get_16_bit_uint_(4) / 10.0f;
+  const float pm_2_5_concentration = this->get_16_bit_uint_(data, 2) / 10.0f;
+  const float pm_10_0_concentration = this->get_16_bit_uint_(data, 4) / 10.0f;
 
   ESP_LOGD(TAG, "Got PM2.5 Concentration: %.1f µg/m³, PM10.0 Concentration: %.1f µg/m³", pm_2_5_concentration,
            pm_10_0_concentration);
@@ -184,8 +136,8 @@ void SDS011Component::parse_data_() {
   }
 }
 
-uint16_t SDS011Component::get_16_bit_uint_(uint8_t start_index) const {
-  return (uint16_t(this->data_[start_index + 1]) << 8) | uint16_t(this->data_[start_index]);
+uint16_t SDS011Component::get_16_bit_uint_(const uint8_t *data, uint8_t start_index) const {
+  return (uint16_t(data[start_index + 1]) << 8) | uint16_t(data[start_index]);
 }
 void SDS011Component::set_update_interval_min(uint8_t update_interval_min) {
   this->update_interval_min_ = update_interval_min;
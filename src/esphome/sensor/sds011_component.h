@@ -44,16 +44,13 @@ class SDS011Component : public Component, public UARTDevice {
  protected:
   void sds011_write_command_(const uint8_t *command);
   uint8_t sds011_checksum_(const uint8_t *command_data, uint8_t length) const;
-  optional<bool> check_byte_() const;
-  void parse_data_();
-  uint16_t get_16_bit_uint_(uint8_t start_index) const;
+  void parse_data_(const uint8_t *data);
+  uint16_t get_16_bit_uint_(const uint8_t *data, uint8_t start_index) const;
 
   SDS011Sensor *pm_2_5_sensor_{nullptr};
   SDS011Sensor *pm_10_0_sensor_{nullptr};
 
-  uint8_t data_[10];
-  uint8_t data_index_{0};
-  uint32_t last_transmission_{0};
+  UARTFrameReader frame_reader_;
   uint8_t update_interval_min_;
 
   bool rx_mode_only_;
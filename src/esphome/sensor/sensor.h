@@ -308,6 +308,7 @@ template<typename... Ts> class SensorInRangeCondition : public Condition<Ts...>
   void set_min(float min);
   void set_max(float max);
   bool check(Ts... x) override;
+  bool subscribe(std::function<void()> &&callback) override;
 
  protected:
   Sensor *parent_;
@@ -354,6 +355,10 @@ template<typename... Ts> SensorInRangeCondition<Ts...> *Sensor::make_sensor_in_r
 template<typename... Ts> SensorInRangeCondition<Ts...>::SensorInRangeCondition(Sensor *parent) : parent_(parent) {}
 template<typename... Ts> void SensorInRangeCondition<Ts...>::set_min(float min) { this->min_ = min; }
 template<typename... Ts> void SensorInRangeCondition<Ts...>::set_max(float max) { this->max_ = max; }
+template<typename... Ts> bool SensorInRangeCondition<Ts...>::subscribe(std::function<void()> &&callback) {
+  this->parent_->add_on_state_callback([callback](float state) { callback(); });
+  return true;
+}
 template<typename... Ts> bool SensorInRangeCondition<Ts...>::check(Ts... x) {
   const float state = this->parent_->state;
   if (isnan(this->min_)) {
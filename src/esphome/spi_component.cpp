@@ -6,48 +6,77 @@
 #include "esphome/log.h"
 #include "esphome/helpers.h"
 
+#include <cstring>
+
 ESPHOME_NAMESPACE_BEGIN
 
 static const char *TAG = "spi";
 
+/// Whether a bus already uses the SPI peripheral, the other buses are bit-banged.
+static bool hw_spi_claimed = false;
+
+#ifdef ARDUINO_ARCH_ESP8266
+/// The only pins of the HSPI signals.
+static const uint8_t HSPI_CLK_PIN = 14;
+static const uint8_t HSPI_MISO_PIN = 12;
+static const uint8_t HSPI_MOSI_PIN = 13;
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+/// The pins SPIClass::begin() routes MISO and MOSI to if they're not given.
+static const int8_t VSPI_DEFAULT_MISO_PIN = 19;
+static const int8_t VSPI_DEFAULT_MOSI_PIN = 23;
+#endif
+
 SPIComponent::SPIComponent(GPIOPin *clk, GPIOPin *miso, GPIOPin *mosi) : clk_(clk), miso_(miso), mosi_(mosi) {}
 
 void ICACHE_RAM_ATTR HOT SPIComponent::write_byte(uint8_t data) {
+  if (this->hw_spi_ != nullptr) {
+    this->hw_spi_->transfer(data);
+    ESP_LOGVV(TAG, "    Wrote 0b" BYTE_TO_BINARY_PATTERN " (0x%02X)", BYTE_TO_BINARY(data), data);
+    return;
+  }
+
   uint8_t send_bits = data;
   if (this->msb_first_)
     send_bits = reverse_bits_8(data);
 
-  this->clk_->digital_write(true);
+  this->fast_clk_.digital_write(true);
   if (!this->high_speed_)
     delayMicroseconds(5);
 
   for (size_t i = 0; i < 8; i++) {
     if (!this->high_speed_)
       delayMicroseconds(5);
-    this->clk_->digital_write(false);
+    this->fast_clk_.digital_write(false);
 
     // sampling on leading edge
-    this->mosi_->digital_write(send_bits & (1 << i));
+    this->fast_mosi_.digital_write(send_bits & (1 << i));
     if (!this->high_speed_)
       delayMicroseconds(5);
-    this->clk_->digital_write(true);
+    this->fast_clk_.digital_write(true);
   }
 
   ESP_LOGVV(TAG, "    Wrote 0b" BYTE_TO_BINARY_PATTERN " (0x%02X)", BYTE_TO_BINARY(data), data);
 }
 
 uint8_t ICACHE_RAM_ATTR HOT SPIComponent::read_byte() {
-  this->clk_->digital_write(true);
-
   uint8_t data = 0;
+  if (this->hw_spi_ != nullptr) {
+    data = this->hw_spi_->transfer(0x00);
+    ESP_LOGVV(TAG, "    Received 0b" BYTE_TO_BINARY_PATTERN " (0x%02X)", BYTE_TO_BINARY(data), data);
+    return data;
+  }
+
+  this->fast_clk_.digital_write(true);
+
   for (size_t i = 0; i < 8; i++) {
     if (!this->high_speed_)
       delayMicroseconds(5);
-    data |= uint8_t(this->miso_->digital_read()) << i;
-    this->clk_->digital_write(false);
+    data |= uint8_t(this->fast_miso_.digital_read()) << i;
+    this->fast_clk_.digital_write(false);
     if (!this->high_speed_)
       delayMicroseconds(5);
-    this->clk_->digital_write(true);
+    this->fast_clk_.digital_write(true);
   }
 
   if (this->msb_first_) {
@@ -59,19 +88,35 @@ uint8_t ICACHE_RAM_ATTR HOT SPIComponent::read_byte() {
   return data;
 }
 void ICACHE_RAM_ATTR HOT SPIComponent::read_array(uint8_t *data, size_t length) {
+  if (this->hw_spi_ != nullptr) {
+    // Transfers are in place, clock out zeros.
+    memset(data, 0, length);
+    this->hw_spi_->transfer(data, length);
+    return;
+  }
   for (size_t i = 0; i < length; i++)
     data[i] = this->read_byte();
 }
 
 void ICACHE_RAM_ATTR HOT SPIComponent::write_array(uint8_t *data, size_t length) {
+  if (this->hw_spi_ != nullptr) {
+    // Sent through the FIFO of the peripheral in blocks of 64 bytes.
+    this->hw_spi_->writeBytes(data, length);
+    return;
+  }
   for (size_t i = 0; i < length; i++) {
     feed_wdt();
     this->write_byte(data[i]);
   }
 }
 
-void ICACHE_RAM_ATTR HOT SPIComponent::enable(GPIOPin *cs, bool msb_first, bool high_speed) {
+void ICACHE_RAM_ATTR HOT SPIComponent::enable(GPIOPin *cs, bool msb_first, bool high_speed, uint32_t data_rate,
+                                              uint8_t mode) {
   ESP_LOGVV(TAG, "Enabling SPI Chip on pin %u...", cs->get_pin());
+  if (this->hw_spi_ != nullptr) {
+    static const uint8_t SPI_MODES[] = {SPI_MODE0, SPI_MODE1, SPI_MODE2, SPI_MODE3};
+    this->hw_spi_->beginTransaction(SPISettings(data_rate, msb_first ? MSBFIRST : LSBFIRST, SPI_MODES[mode & 0x03]));
+  }
   cs->digital_write(false);
 
   this->active_cs_ = cs;
@@ -83,17 +128,46 @@ void ICACHE_RAM_ATTR HOT SPIComponent::disable() {
   ESP_LOGVV(TAG, "Disabling SPI Chip on pin %u...", this->active_cs_->get_pin());
   this->active_cs_->digital_write(true);
   this->active_cs_ = nullptr;
+  if (this->hw_spi_ != nullptr)
+    this->hw_spi_->endTransaction();
 }
 void SPIComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up SPI bus...");
+  if (this->can_use_hw_spi_()) {
+    hw_spi_claimed = true;
+    this->hw_spi_ = &SPI;
+#ifdef ARDUINO_ARCH_ESP8266
+    this->hw_spi_->begin();
+    // begin() takes all HSPI pins, give back the ones this bus doesn't use.
+    if (this->miso_ == nullptr)
+      pinMode(HSPI_MISO_PIN, INPUT);
+    if (this->mosi_ == nullptr)
+      pinMode(HSPI_MOSI_PIN, INPUT);
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+    int8_t miso = this->miso_ != nullptr ? this->miso_->get_pin() : -1;
+    int8_t mosi = this->mosi_ != nullptr ? this->mosi_->get_pin() : -1;
+    this->hw_spi_->begin(this->clk_->get_pin(), miso, mosi, -1);
+    // begin() routes missing signals to the default pins, detach them again.
+    if (miso == -1)
+      spiDetachMISO(this->hw_spi_->bus(), VSPI_DEFAULT_MISO_PIN);
+    if (mosi == -1)
+      spiDetachMOSI(this->hw_spi_->bus(), VSPI_DEFAULT_MOSI_PIN);
+#endif
+    return;
+  }
+
   this->clk_->setup();
   this->clk_->digital_write(true);
+  this->fast_clk_ = FastGPIOPin(this->clk_);
   if (this->miso_ != nullptr) {
     this->miso_->setup();
+    this->fast_miso_ = FastGPIOPin(this->miso_);
   }
   if (this->mosi_ != nullptr) {
     this->mosi_->setup();
     this->mosi_->digital_write(false);
+    this->fast_mosi_ = FastGPIOPin(this->mosi_);
   }
 }
 void SPIComponent::dump_config() {
@@ -101,14 +175,48 @@ void SPIComponent::dump_config() {
   LOG_PIN("  CLK Pin: ", this->clk_);
   LOG_PIN("  MISO Pin: ", this->miso_);
   LOG_PIN("  MOSI Pin: ", this->mosi_);
+  if (this->hw_spi_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Using hardware SPI interface.");
+  } else {
+    ESP_LOGCONFIG(TAG, "  Using software SPI (bit-banging).");
+  }
 }
 float SPIComponent::get_setup_priority() const { return setup_priority::PRE_HARDWARE; }
+bool SPIComponent::can_use_hw_spi_() {
+  if (hw_spi_claimed) {
+    ESP_LOGD(TAG, "The SPI peripheral is used by another bus.");
+    return false;
+  }
+  for (GPIOPin *pin : {this->clk_, this->miso_, this->mosi_}) {
+    if (pin != nullptr && (!pin->is_internal() || pin->is_inverted()))
+      return false;
+  }
+#ifdef ARDUINO_ARCH_ESP8266
+  // The HSPI signals can't be routed to other pins.
+  return this->clk_->get_pin() == HSPI_CLK_PIN && (this->miso_ == nullptr || this->miso_->get_pin() == HSPI_MISO_PIN) &&
+         (this->mosi_ == nullptr || this->mosi_->get_pin() == HSPI_MOSI_PIN);
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  // A missing signal is routed to its default pin until it's detached after begin(), that pin can't be in use by
+  // this bus.
+  for (GPIOPin *pin : {this->clk_, this->miso_, this->mosi_}) {
+    if (pin == nullptr)
+      continue;
+    if (this->miso_ == nullptr && pin->get_pin() == VSPI_DEFAULT_MISO_PIN)
+      return false;
+    if (this->mosi_ == nullptr && pin->get_pin() == VSPI_DEFAULT_MOSI_PIN)
+      return false;
+  }
+  // GPIO34-39 are input only
+  return this->clk_->get_pin() < 34 && (this->mosi_ == nullptr || this->mosi_->get_pin() < 34);
+#endif
+}
 void SPIComponent::set_miso(const GPIOInputPin &miso) { this->miso_ = miso.copy(); }
 void SPIComponent::set_mosi(const GPIOOutputPin &mosi) { this->mosi_ = mosi.copy(); }
 
 SPIDevice::SPIDevice(SPIComponent *parent, GPIOPin *cs) : parent_(parent), cs_(cs) {}
 void HOT SPIDevice::enable() {
-  this->parent_->enable(this->cs_, this->is_device_msb_first(), this->is_device_high_speed());
+  this->parent_->enable(this->cs_, this->msb_first_, this->high_speed_, this->data_rate_, this->mode_);
 }
 void HOT SPIDevice::disable() { this->parent_->disable(); }
 uint8_t HOT SPIDevice::read_byte() { return this->parent_->read_byte(); }
@@ -118,8 +226,14 @@ void HOT SPIDevice::write_array(uint8_t *data, size_t length) { this->parent_->w
 void SPIDevice::spi_setup() {
   this->cs_->setup();
   this->cs_->digital_write(true);
+  this->msb_first_ = this->is_device_msb_first();
+  this->high_speed_ = this->is_device_high_speed();
+  this->data_rate_ = this->get_device_data_rate();
+  this->mode_ = this->get_device_mode();
 }
 bool HOT SPIDevice::is_device_high_speed() { return false; }
+uint32_t SPIDevice::get_device_data_rate() { return this->is_device_high_speed() ? 8000000 : 1000000; }
+uint8_t SPIDevice::get_device_mode() { return 0; }
 
 ESPHOME_NAMESPACE_END
 
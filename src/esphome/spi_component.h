@@ -8,8 +8,17 @@
 #include "esphome/component.h"
 #include "esphome/esphal.h"
 
+#include <SPI.h>
+
 ESPHOME_NAMESPACE_BEGIN
 
+/** An SPI bus.
+ *
+ * If the pins can be routed to the SPI peripheral (any output pins on the ESP32, the HSPI pins CLK=GPIO14,
+ * MISO=GPIO12, MOSI=GPIO13 on the ESP8266) and none are inverted, the bus uses the hardware SPI with the clock
+ * and mode of each device. Otherwise it falls back to bit-banging the pins. There's only one SPI peripheral, only
+ * the first bus set up with suitable pins uses it.
+ */
 class SPIComponent : public Component {
  public:
   SPIComponent(GPIOPin *clk, GPIOPin *miso, GPIOPin *mosi);
@@ -26,7 +35,15 @@ class SPIComponent : public Component {
 
   void write_array(uint8_t *data, size_t length);
 
-  void enable(GPIOPin *cs, bool msb_first, bool high_speed);
+  /** Select a device and start a transaction with its settings.
+   *
+   * @param cs The chip select pin of the device.
+   * @param msb_first Whether the device expects the most significant bit first.
+   * @param high_speed Whether the bit-banged bus may skip its delays.
+   * @param data_rate The clock frequency of the hardware SPI in Hz.
+   * @param mode The SPI mode (clock polarity and phase) of the hardware SPI, from 0 to 3.
+   */
+  void enable(GPIOPin *cs, bool msb_first, bool high_speed, uint32_t data_rate = 1000000, uint8_t mode = 0);
 
   void disable();
 
@@ -37,18 +54,27 @@ class SPIComponent : public Component {
   void set_mosi(const GPIOOutputPin &mosi);
 
  protected:
+  /// Whether the pins can be used with the SPI peripheral.
+  bool can_use_hw_spi_();
+
   GPIOPin *clk_;
   GPIOPin *miso_;
   GPIOPin *mosi_;
+  FastGPIOPin fast_clk_;
+  FastGPIOPin fast_miso_;
+  FastGPIOPin fast_mosi_;
   GPIOPin *active_cs_{nullptr};
   bool msb_first_{true};
   bool high_speed_{false};
+  /// The SPI peripheral, or nullptr if the pins are bit-banged.
+  SPIClass *hw_spi_{nullptr};
 };
 
 class SPIDevice {
  public:
   SPIDevice(SPIComponent *parent, GPIOPin *cs);
 
+  /// Set up the CS pin and capture the SPI settings of the device.
   void spi_setup();
 
   void enable();
@@ -68,8 +94,18 @@ class SPIDevice {
 
   virtual bool is_device_high_speed();
 
+  /// The clock frequency in Hz when using the hardware SPI, defaults to 8MHz for high speed devices and 1MHz else.
+  virtual uint32_t get_device_data_rate();
+
+  /// The SPI mode (0-3) when using the hardware SPI, defaults to mode 0. The bit-banged bus always uses mode 3.
+  virtual uint8_t get_device_mode();
+
   SPIComponent *parent_;
   GPIOPin *cs_;
+  bool msb_first_{true};
+  bool high_speed_{false};
+  uint32_t data_rate_{1000000};
+  uint8_t mode_{0};
 };
 
 ESPHOME_NAMESPACE_END
@@ -21,6 +21,7 @@ void A4988::setup() {
   this->step_pin_->digital_write(false);
   this->dir_pin_->setup();
   this->dir_pin_->digital_write(false);
+  this->setup_step_timer_({this->step_pin_, this->dir_pin_});
 }
 void A4988::dump_config() {
   ESP_LOGCONFIG(TAG, "A4988:");
@@ -30,20 +31,16 @@ void A4988::dump_config() {
   LOG_STEPPER(this);
 }
 void A4988::loop() {
-  bool at_target = this->has_reached_target();
   if (this->sleep_pin_ != nullptr) {
-    this->sleep_pin_->digital_write(!at_target);
+    this->sleep_pin_->digital_write(!this->is_stopped_());
   }
-  if (at_target) {
-    this->high_freq_.stop();
-  } else {
+  if (this->loop_step_engine_()) {
     this->high_freq_.start();
+  } else {
+    this->high_freq_.stop();
   }
-
-  int32_t dir = this->should_step_();
-  if (dir == 0)
-    return;
-
+}
+void ICACHE_RAM_ATTR A4988::on_step_(int32_t dir) {
   this->dir_pin_->digital_write(dir == 1);
   this->step_pin_->digital_write(true);
   delayMicroseconds(5);
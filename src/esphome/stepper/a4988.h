@@ -23,6 +23,8 @@ class A4988 : public Stepper, public Component {
   float get_setup_priority() const override;
 
  protected:
+  void on_step_(int32_t dir) override;
+
   GPIOPin *step_pin_;
   GPIOPin *dir_pin_;
   GPIOPin *sleep_pin_{nullptr};
@@ -7,56 +7,232 @@
 #include "esphome/espmath.h"
 #include "esphome/helpers.h"
 
+#include <algorithm>
+
 ESPHOME_NAMESPACE_BEGIN
 
 namespace stepper {
 
 static const char *TAG = "stepper";
 
-void Stepper::calculate_speed_(uint32_t now) {
-  // delta t since last calculation in seconds
-  float dt = (now - this->last_calculation_) * 1e-6f;
-  this->last_calculation_ = now;
-  if (this->has_reached_target()) {
-    this->current_speed_ = 0.0f;
-    return;
+/// The step delays are in 1/16 µs.
+static const uint32_t DELAY_SHIFT = 4;
+/// The ramp is in 1/2^32 steps, so that deceleration steps don't accumulate rounding errors.
+static const uint32_t RAMP_SHIFT = 32;
+static const uint64_t RAMP_ONE = 1ULL << RAMP_SHIFT;
+static const uint64_t MAX_RAMP = 1ULL << (24 + RAMP_SHIFT);
+/// The acceleration/deceleration ratio is in 1/65536.
+static const uint32_t RATIO_SHIFT = 16;
+static const float MAX_RATIO = 32768.0f;
+/// Keep the delays small enough that 2 * delay + rest doesn't overflow.
+static const uint32_t MAX_DELAY = 1UL << 29;
+
+#ifdef ARDUINO_ARCH_ESP32
+/// The ESP32 has 4 hardware timers, each drives one stepper.
+static const uint8_t STEP_TIMER_COUNT = 4;
+static Stepper *step_timer_steppers[STEP_TIMER_COUNT] = {nullptr};
+#endif
+
+#ifdef ARDUINO_ARCH_ESP32
+static void ICACHE_RAM_ATTR step_timer_isr_0() { step_timer_steppers[0]->step_timer_isr(); }
+static void ICACHE_RAM_ATTR step_timer_isr_1() { step_timer_steppers[1]->step_timer_isr(); }
+static void ICACHE_RAM_ATTR step_timer_isr_2() { step_timer_steppers[2]->step_timer_isr(); }
+static void ICACHE_RAM_ATTR step_timer_isr_3() { step_timer_steppers[3]->step_timer_isr(); }
+static void (*const STEP_TIMER_ISRS[STEP_TIMER_COUNT])() = {step_timer_isr_0, step_timer_isr_1, step_timer_isr_2,
+                                                            step_timer_isr_3};
+#endif
+
+static uint32_t to_delay(float seconds) {
+  const float delay = seconds * (1e6f * (1 << DELAY_SHIFT));
+  if (delay >= MAX_DELAY)
+    return MAX_DELAY;
+  return delay < 1.0f ? 1 : uint32_t(delay);
+}
+
+void Stepper::compute_profile_() {
+  StepProfile profile;
+  // The first step uses the AVR446 correction factor 0.676 for the inaccuracy of the delay recurrence.
+  profile.first_delay = to_delay(0.676f * sqrtf(2.0f / this->acceleration_));
+  profile.min_delay = to_delay(1.0f / this->max_speed_);
+  // v^2 = 2 * a * n
+  const float cruise_ramp = this->max_speed_ * this->max_speed_ / (2.0f * this->acceleration_);
+  profile.cruise_ramp = cruise_ramp >= float(MAX_RAMP >> RAMP_SHIFT) ? MAX_RAMP : uint64_t(cruise_ramp * RAMP_ONE);
+  const float ratio = std::min(this->acceleration_ / this->deceleration_, MAX_RATIO);
+  profile.accel_decel_ratio = uint32_t(ratio * (1UL << RATIO_SHIFT));
+  profile.decel_accel_ratio = std::max<uint64_t>(1, uint64_t(RAMP_ONE / ratio));
+  profile.acceleration = this->acceleration_;
+
+  // The step interrupt can't see a half written profile, it takes over the new one at its next step.
+  disable_interrupts();
+  // The ramp counts acceleration steps, it's scaled for the new acceleration so that the speed doesn't change.
+  const float ramp_scale = std::min(this->profile_.acceleration / this->acceleration_, MAX_RATIO);
+  profile.ramp_scale = uint32_t(ramp_scale * (1UL << RATIO_SHIFT));
+  this->pending_profile_ = profile;
+  this->profile_pending_ = true;
+  enable_interrupts();
+}
+bool ICACHE_RAM_ATTR HOT Stepper::run_step_() {
+  if (this->profile_pending_) {
+    this->profile_ = this->pending_profile_;
+    this->profile_pending_ = false;
+    const uint64_t ramp = (this->ramp_ >> 24) * this->profile_.ramp_scale;
+    this->ramp_ = ramp >= (MAX_RAMP >> (24 - RATIO_SHIFT)) ? MAX_RAMP : ramp << (24 - RATIO_SHIFT);
+  }
+  if (this->pending_report_) {
+    this->current_position = this->reported_position_;
+    this->pending_report_ = false;
+  }
+
+  const int32_t target = this->target_position;
+  const bool start = this->delay_ == 0;
+  if (start) {
+    // Start from standstill
+    if (target == this->current_position)
+      return false;
+    this->direction_ = target > this->current_position ? 1 : -1;
+    this->ramp_ = 0;
+    this->delay_rest_ = 0;
+    this->delay_ = std::max(this->profile_.first_delay, this->profile_.min_delay);
+  }
+
+  this->current_position += this->direction_;
+  this->on_step_(this->direction_);
+
+  // The steps left in the current direction, negative if the target is behind us.
+  const int32_t left = (target - this->current_position) * this->direction_;
+  // v^2 / 2 * d, the distance needed to stop in 1/2^24 steps
+  const uint64_t stop_distance =
+      ((this->ramp_ >> 24) * this->profile_.accel_decel_ratio) >> (RAMP_SHIFT - 24 + RATIO_SHIFT - 24);
+  const uint64_t one_step = 1ULL << 24;
+
+  if (left == 0 && stop_distance <= one_step) {
+    // Arrived, the remaining speed is low enough to stop right away.
+    this->delay_ = 0;
+    return false;
   }
+  if (start && left > 0)
+    // The first delay is the one after the first step, the ramp starts with the second one.
+    return true;
 
-  int32_t num_steps = abs(int32_t(this->target_position) - int32_t(this->current_position));
-  // (v_0)^2 / 2*a
-  float v_squared = this->current_speed_ * this->current_speed_;
-  auto steps_to_decelerate = static_cast<int32_t>(v_squared / (2 * this->deceleration_));
-  if (num_steps <= steps_to_decelerate) {
-    // need to start decelerating
-    this->current_speed_ -= this->deceleration_ * dt;
+  int32_t n;
+  // The ramp is rounded down, so keep half a step of margin or the rounding can end the deceleration early.
+  const uint64_t brake_distance = stop_distance + one_step / 2;
+  if (left > 0 && brake_distance < uint64_t(left) * one_step) {
+    if (this->delay_ <= this->profile_.min_delay || this->ramp_ + RAMP_ONE >= this->profile_.cruise_ramp) {
+      // Cruise
+      this->delay_ = this->profile_.min_delay;
+      this->ramp_ = this->profile_.cruise_ramp;
+      return true;
+    }
+    const uint64_t accel_step = uint64_t(this->profile_.accel_decel_ratio) << (24 - RATIO_SHIFT);
+    if (brake_distance + accel_step >= uint64_t(left) * one_step)
+      // Another acceleration step would start the deceleration too late, keep the speed until it starts.
+      return true;
+    // Accelerate
+    this->ramp_ += RAMP_ONE;
+    n = this->ramp_ >> RAMP_SHIFT;
+  } else if (stop_distance >= one_step) {
+    // Decelerate, n counts the steps until standstill like in AVR446
+    n = -int32_t(stop_distance >> 24);
+    const uint64_t ratio = this->profile_.decel_accel_ratio;
+    this->ramp_ = this->ramp_ > ratio ? this->ramp_ - ratio : 0;
   } else {
-    // we can still accelerate
-    this->current_speed_ += this->acceleration_ * dt;
+    // Overshot the target and reached the minimum speed: start again in the other direction.
+    this->delay_ = 0;
+    return true;
   }
-  this->current_speed_ = clamp(0.0f, this->max_speed_, this->current_speed_);
+
+  const int32_t delay = this->delay_;
+  const int32_t num = 2 * delay + this->delay_rest_;
+  const int32_t den = 4 * n + 1;
+  const int32_t new_delay = delay - num / den;
+  this->delay_rest_ = num % den;
+  this->delay_ = clamp<int32_t>(this->profile_.min_delay, MAX_DELAY, new_delay);
+  return true;
 }
-int32_t Stepper::should_step_() {
-  uint32_t now = micros();
-  this->calculate_speed_(now);
-  if (this->current_speed_ == 0.0f)
-    return 0;
-
-  // assumes this method is called in a constant interval
-  uint32_t dt = now - this->last_step_;
-  if (dt >= (1 / this->current_speed_) * 1e6f) {
-    int32_t mag = this->target_position > this->current_position ? 1 : -1;
-    this->last_step_ = now;
-    this->current_position += mag;
-    return mag;
+void Stepper::setup_step_timer_(std::initializer_list<GPIOPin *> step_pins) {
+  this->compute_profile_();
+#ifdef ARDUINO_ARCH_ESP32
+  for (auto *pin : step_pins) {
+    if (!pin->is_internal()) {
+      // Pins of I/O expanders are written over I2C, which doesn't work from an interrupt.
+      ESP_LOGD(TAG, "Step pins aren't internal, generating steps from the main loop.");
+      return;
+    }
+  }
+  for (uint8_t i = 0; i < STEP_TIMER_COUNT; i++) {
+    if (step_timer_steppers[i] != nullptr)
+      continue;
+    step_timer_steppers[i] = this;
+    // 1 MHz
+    this->timer_ = timerBegin(i, 80, true);
+    timerAttachInterrupt(this->timer_, STEP_TIMER_ISRS[i], true);
+    return;
+  }
+  ESP_LOGW(TAG, "No hardware timer left, generating steps from the main loop.");
+#else
+  // timer1 of the ESP8266 is already used by analogWrite and Servo
+  ESP_LOGV(TAG, "Generating steps from the main loop.");
+#endif
+}
+void ICACHE_RAM_ATTR HOT Stepper::step_timer_isr() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (!this->run_step_()) {
+    timerAlarmDisable(this->timer_);
+    this->running_ = false;
+    return;
+  }
+  const uint32_t delay = this->delay_ != 0 ? this->delay_ : this->profile_.first_delay;
+  timerAlarmWrite(this->timer_, std::max<uint32_t>(delay >> DELAY_SHIFT, 1), true);
+#endif
+}
+bool Stepper::loop_step_engine_() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->timer_ != nullptr) {
+    if (!this->running_ && this->pending_report_) {
+      this->current_position = this->reported_position_;
+      this->pending_report_ = false;
+    }
+    if (!this->running_ && !this->has_reached_target()) {
+      this->running_ = true;
+      timerWrite(this->timer_, 0);
+      timerAlarmWrite(this->timer_, 1, true);
+      timerAlarmEnable(this->timer_);
+    }
+    return false;
   }
+#endif
+
+  if (this->is_stopped_() && !this->pending_report_)
+    return false;
 
-  return 0;
+  const uint32_t now = micros();
+  const uint32_t delay = this->delay_ != 0 ? this->delay_ : this->profile_.first_delay;
+  if (!this->running_ || now - this->last_step_ >= (delay >> DELAY_SHIFT)) {
+    this->last_step_ = now;
+    this->running_ = this->run_step_();
+  }
+  return true;
 }
+bool Stepper::is_stopped_() { return this->delay_ == 0 && this->has_reached_target(); }
 void Stepper::set_target(int32_t steps) { this->target_position = steps; }
-void Stepper::report_position(int32_t steps) { this->current_position = steps; }
-void Stepper::set_acceleration(float acceleration) { this->acceleration_ = acceleration; }
-void Stepper::set_deceleration(float deceleration) { this->deceleration_ = deceleration; }
-void Stepper::set_max_speed(float max_speed) { this->max_speed_ = max_speed; }
+void Stepper::report_position(int32_t steps) {
+  // Applied by the step engine, which is the only one that changes the position while the motor is running.
+  this->reported_position_ = steps;
+  this->pending_report_ = true;
+}
+void Stepper::set_acceleration(float acceleration) {
+  this->acceleration_ = acceleration;
+  this->compute_profile_();
+}
+void Stepper::set_deceleration(float deceleration) {
+  this->deceleration_ = deceleration;
+  this->compute_profile_();
+}
+void Stepper::set_max_speed(float max_speed) {
+  this->max_speed_ = max_speed;
+  this->compute_profile_();
+}
 bool Stepper::has_reached_target() { return this->current_position == this->target_position; }
 
 }  // namespace stepper
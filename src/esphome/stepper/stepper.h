@@ -20,6 +20,14 @@ template<typename... Ts> class ReportPositionAction;
   ESP_LOGCONFIG(TAG, "  Deceleration: %.0f steps/s^2", this->deceleration_); \
   ESP_LOGCONFIG(TAG, "  Max Speed: %.0f steps/s", this->max_speed_);
 
+/** Base class for steppers, generates the step timing.
+ *
+ * The speed profile is trapezoidal and computed with integers like in AVR446: each step delay is derived from
+ * the previous one, the float setters only precompute the constants of the profile. On the ESP32 the steps are
+ * generated from a hardware timer interrupt so that they don't depend on the main loop (if all step pins are
+ * internal pins), otherwise they're generated from loop(). The target and the profile can be changed at any time,
+ * the interrupt picks them up at the next step.
+ */
 class Stepper {
  public:
   void set_target(int32_t steps);
@@ -32,19 +40,74 @@ class Stepper {
   template<typename... Ts> SetTargetAction<Ts...> *make_set_target_action();
   template<typename... Ts> ReportPositionAction<Ts...> *make_report_position_action();
 
-  int32_t current_position{0};
-  int32_t target_position{0};
+  /// Called by the hardware timer interrupt.
+  void step_timer_isr();
+
+  volatile int32_t current_position{0};
+  volatile int32_t target_position{0};
 
  protected:
-  void calculate_speed_(uint32_t now);
-  int32_t should_step_();
+  /// Output a single step in the given direction (1 or -1). Called from the step interrupt, so it must be ISR-safe.
+  virtual void on_step_(int32_t dir) = 0;
+
+  /** Try to get a hardware timer for the steps, call this in setup().
+   *
+   * @param step_pins The pins on_step_() writes. The timer is only used if all of them are internal pins.
+   */
+  void setup_step_timer_(std::initializer_list<GPIOPin *> step_pins);
+  /** Run the step engine, call this in loop().
+   *
+   * @return Whether the main loop has to run at high frequency because it generates the steps.
+   */
+  bool loop_step_engine_();
+  /// Whether the motor is at the target and not moving anymore.
+  bool is_stopped_();
+
+  /// Compute the profile for the current settings, the step engine takes it over at the next step.
+  void compute_profile_();
+  /// Do the next step and compute the delay until the step after it. Returns false if the motor stopped.
+  bool run_step_();
 
   float acceleration_{1e6f};
   float deceleration_{1e6f};
-  float current_speed_{0.0f};
   float max_speed_{1e6f};
-  uint32_t last_calculation_{0};
+
+  /// The profile, in 1/16 µs for the delays and 1/2^32 steps for the ramp.
+  struct StepProfile {
+    /// The delay after the first step from standstill.
+    uint32_t first_delay;
+    /// The delay at max speed.
+    uint32_t min_delay;
+    /// The number of acceleration steps it takes to reach max speed.
+    uint64_t cruise_ramp;
+    /// acceleration / deceleration (in 1/65536) and deceleration / acceleration (in ramp units).
+    uint32_t accel_decel_ratio;
+    uint64_t decel_accel_ratio;
+    /// The acceleration of the profile and old / new acceleration (in 1/65536) to scale the ramp when it changes.
+    float acceleration;
+    uint32_t ramp_scale;
+  };
+  /// The profile the step engine uses, only changed by run_step_().
+  StepProfile profile_{};
+  /// A new profile from compute_profile_(), taken over by run_step_() at the next step.
+  StepProfile pending_profile_{};
+  volatile bool profile_pending_{false};
+
+  // The state of the step engine, only changed by run_step_() while it's running.
+  /// The delay until the next step, 0 when standing still.
+  volatile uint32_t delay_{0};
+  int32_t delay_rest_{0};
+  /// The number of acceleration steps that lead to the current speed.
+  uint64_t ramp_{0};
+  int32_t direction_{0};
+  volatile bool pending_report_{false};
+  int32_t reported_position_{0};
+  volatile bool running_{false};
+
   uint32_t last_step_{0};
+#ifdef ARDUINO_ARCH_ESP32
+  hw_timer_t *timer_{nullptr};
+#endif
 };
 
 template<typename... Ts> class SetTargetAction : public Action<Ts...> {
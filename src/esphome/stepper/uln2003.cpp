@@ -17,7 +17,9 @@ void ULN2003::setup() {
   this->pin_b_->setup();
   this->pin_c_->setup();
   this->pin_d_->setup();
-  this->loop();
+  if (!this->sleep_when_done_)
+    this->write_step_(this->current_uln_pos_);
+  this->setup_step_timer_({this->pin_a_, this->pin_b_, this->pin_c_, this->pin_d_});
 }
 void ULN2003::dump_config() {
   ESP_LOGCONFIG(TAG, "ULN2003:");
@@ -41,29 +43,25 @@ void ULN2003::dump_config() {
   ESP_LOGCONFIG(TAG, "  Step Mode: %s", step_mode_s);
 }
 void ULN2003::loop() {
-  bool at_target = this->has_reached_target();
-  if (at_target) {
-    this->high_freq_.stop();
-
-    if (this->sleep_when_done_) {
-      this->pin_a_->digital_write(false);
-      this->pin_b_->digital_write(false);
-      this->pin_c_->digital_write(false);
-      this->pin_d_->digital_write(false);
-      // do not write pos
-      return;
-    }
-  } else {
+  if (this->loop_step_engine_()) {
     this->high_freq_.start();
-
-    int dir = this->should_step_();
-    this->current_uln_pos_ += dir;
+  } else {
+    this->high_freq_.stop();
   }
 
+  if (this->sleep_when_done_ && this->is_stopped_()) {
+    this->pin_a_->digital_write(false);
+    this->pin_b_->digital_write(false);
+    this->pin_c_->digital_write(false);
+    this->pin_d_->digital_write(false);
+  }
+}
+void ICACHE_RAM_ATTR ULN2003::on_step_(int32_t dir) {
+  this->current_uln_pos_ += dir;
   this->write_step_(this->current_uln_pos_);
 }
 float ULN2003::get_setup_priority() const { return setup_priority::HARDWARE; }
-void ULN2003::write_step_(int32_t step) {
+void ICACHE_RAM_ATTR ULN2003::write_step_(int32_t step) {
   int32_t n = this->step_mode_ == ULN2003_STEP_MODE_HALF_STEP ? 8 : 4;
   auto i = static_cast<uint32_t>((step % n + n) % n);
   uint8_t res = 0;
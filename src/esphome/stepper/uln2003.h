@@ -30,6 +30,7 @@ class ULN2003 : public Stepper, public Component {
   void set_step_mode(ULN2003StepMode step_mode);
 
  protected:
+  void on_step_(int32_t dir) override;
   void write_step_(int32_t step);
 
   bool sleep_when_done_{false};
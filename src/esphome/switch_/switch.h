@@ -194,6 +194,7 @@ template<typename... Ts> class SwitchCondition : public Condition<Ts...> {
  public:
   SwitchCondition(Switch *parent, bool state);
   bool check(Ts... x) override;
+  bool subscribe(std::function<void()> &&callback) override;
 
  protected:
   Switch *parent_;
@@ -251,6 +252,10 @@ template<typename... Ts> TurnOnAction<Ts...> *Switch::make_turn_on_action() { re
 template<typename... Ts>
 SwitchCondition<Ts...>::SwitchCondition(Switch *parent, bool state) : parent_(parent), state_(state) {}
 template<typename... Ts> bool SwitchCondition<Ts...>::check(Ts... x) { return this->parent_->state == this->state_; }
+template<typename... Ts> bool SwitchCondition<Ts...>::subscribe(std::function<void()> &&callback) {
+  this->parent_->add_on_state_callback([callback](bool state) { callback(); });
+  return true;
+}
 
 template<typename... Ts> SwitchCondition<Ts...> *Switch::make_switch_is_on_condition() {
   return new SwitchCondition<Ts...>(this, true);
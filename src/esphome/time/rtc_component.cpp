@@ -5,6 +5,8 @@
 #include "esphome/log.h"
 #include "esphome/time/rtc_component.h"
 
+#include <sys/time.h>
+
 ESPHOME_NAMESPACE_BEGIN
 
 namespace time {
@@ -136,28 +138,191 @@ bool CronTrigger::matches(const ESPTime &time) {
   return time.is_valid() && this->seconds_[time.second] && this->minutes_[time.minute] && this->hours_[time.hour] &&
          this->days_of_month_[time.day_of_month] && this->months_[time.month] && this->days_of_week_[time.day_of_week];
 }
-void CronTrigger::loop() {
-  ESPTime time = this->rtc_->now();
-  if (!time.is_valid())
-    return;
+/// The maximum time the cron trigger sleeps, so that it notices when the clock is set.
+static const uint32_t CRON_MAX_SLEEP = 60000;
+/// How many years find_next looks ahead, the calendar repeats after 28 years.
+static const uint16_t CRON_SEARCH_YEARS = 29;
+
+/// The index of the first set bit at or after from, or -1.
+template<size_t N> static int next_bit(const std::bitset<N> &bits, int from) {
+  if (from >= int(N))
+    return -1;
+  const uint64_t rest = bits.to_ullong() >> from;
+  if (rest == 0)
+    return -1;
+  return from + __builtin_ctzll(rest);
+}
+static bool is_leap_year(int year) { return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0; }
+static int days_in_month(int year, int month) {
+  static const uint8_t DAYS_IN_MONTH[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  if (month == 2 && is_leap_year(year))
+    return 29;
+  return DAYS_IN_MONTH[month];
+}
+/// Seconds since 1970-01-01 00:00 of the date and time in local, ignoring the time zone.
+static int64_t wall_seconds(const struct tm &local) {
+  // Days from the civil date, with years starting in March so that the leap day is the last day of a year.
+  int year = local.tm_year + 1900;
+  const int month = local.tm_mon + 1;
+  if (month <= 2)
+    year--;
+  const int era = (year >= 0 ? year : year - 399) / 400;
+  const int year_of_era = year - era * 400;
+  const int day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + local.tm_mday - 1;
+  const int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  const int64_t days = int64_t(era) * 146097 + day_of_era - 719468;
+  return days * 86400 + local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec;
+}
+/// The offset of the local time zone to UTC at time t, in seconds.
+static int64_t utc_offset(time_t t) {
+  struct tm local;
+  ::localtime_r(&t, &local);
+  return wall_seconds(local) - t;
+}
+/** The first time after start and at most end at which the UTC offset isn't offset anymore, or end + 1.
+ *
+ * Offsets change at most twice a year and stay for months, so probing once a week can't miss a change that's
+ * reverted again. The exact second of the change is then found with a binary search.
+ */
+static time_t next_offset_change(time_t start, time_t end, int64_t offset) {
+  static const time_t PROBE_INTERVAL = 7 * 86400;
+  for (time_t probe = start; probe < end;) {
+    const time_t next = end - probe > PROBE_INTERVAL ? probe + PROBE_INTERVAL : end;
+    if (utc_offset(next) == offset) {
+      probe = next;
+      continue;
+    }
+    time_t same = probe, changed = next;
+    while (changed - same > 1) {
+      const time_t mid = same + (changed - same) / 2;
+      if (utc_offset(mid) == offset) {
+        same = mid;
+      } else {
+        changed = mid;
+      }
+    }
+    return changed;
+  }
+  return end + 1;
+}
+/// The day of the week of a date, sunday=1 like in ESPTime.
+static uint8_t day_of_week(int year, int month, int day) {
+  // Sakamoto's method
+  static const uint8_t OFFSETS[] = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+  if (month < 3)
+    year--;
+  return (year + year / 4 - year / 100 + year / 400 + OFFSETS[month - 1] + day) % 7 + 1;
+}
+
+bool CronTrigger::find_next_local_(struct tm &local) {
+  int year = local.tm_year + 1900, month = local.tm_mon + 1, day = local.tm_mday;
+  int hour = local.tm_hour, minute = local.tm_min, second = local.tm_sec;
+  const int end_year = year + CRON_SEARCH_YEARS;
 
-  if (this->last_check_.has_value()) {
-    if (*this->last_check_ >= time) {
-      // already handled this one
-      return;
+  // Each step either accepts a field or moves it to the next candidate and resets all smaller fields.
+  while (year < end_year) {
+    const int next_month = next_bit(this->months_, month);
+    if (next_month == -1) {
+      year++;
+      month = 1;
+      day = 1;
+      hour = minute = second = 0;
+      continue;
+    }
+    if (next_month != month) {
+      month = next_month;
+      day = 1;
+      hour = minute = second = 0;
     }
 
-    while (true) {
-      this->last_check_->increment_second();
-      if (*this->last_check_ >= time)
-        break;
+    const int next_day = next_bit(this->days_of_month_, day);
+    if (next_day == -1 || next_day > days_in_month(year, month)) {
+      month++;
+      day = 1;
+      hour = minute = second = 0;
+      continue;
+    }
+    if (next_day != day) {
+      day = next_day;
+      hour = minute = second = 0;
+    }
+    if (!this->days_of_week_[day_of_week(year, month, day)]) {
+      day++;
+      hour = minute = second = 0;
+      continue;
+    }
 
-      if (this->matches(*this->last_check_))
-        this->trigger();
+    const int next_hour = next_bit(this->hours_, hour);
+    if (next_hour == -1) {
+      day++;
+      hour = minute = second = 0;
+      continue;
+    }
+    if (next_hour != hour) {
+      hour = next_hour;
+      minute = second = 0;
     }
+
+    const int next_minute = next_bit(this->minutes_, minute);
+    if (next_minute == -1) {
+      hour++;
+      minute = second = 0;
+      continue;
+    }
+    if (next_minute != minute) {
+      minute = next_minute;
+      second = 0;
+    }
+
+    // Second 60 only exists as a leap second, which the clock never shows.
+    const int next_second = next_bit(this->seconds_, second);
+    if (next_second == -1 || next_second >= 60) {
+      minute++;
+      second = 0;
+      continue;
+    }
+
+    local.tm_sec = next_second;
+    local.tm_min = minute;
+    local.tm_hour = hour;
+    local.tm_mday = day;
+    local.tm_mon = month - 1;
+    local.tm_year = year - 1900;
+    return true;
   }
 
-  this->last_check_ = time;
+  return false;
+}
+optional<time_t> CronTrigger::find_next(time_t start) {
+  time_t t = start;
+  // Each iteration ends at a change of the UTC offset, of which there are two per year with daylight saving time.
+  for (int i = 0; i < 2 * CRON_SEARCH_YEARS + 2; i++) {
+    struct tm local;
+    ::localtime_r(&t, &local);
+    const int64_t wall = wall_seconds(local);
+    const int64_t offset = wall - t;
+    if (!this->find_next_local_(local))
+      return {};
+    // While the offset stays the same, the wall clock advances like the unix time.
+    const time_t candidate = t + time_t(wall_seconds(local) - wall);
+    const time_t change = next_offset_change(t, candidate, offset);
+    if (change > candidate)
+      return candidate;
+    // The wall clock jumps at the change (skipping or repeating local times), continue the search from there.
+    t = change;
+  }
+  return {};
+}
+void CronTrigger::setup() {
+  // Wait for the first loop, the time zone is only set up once the time component is set up.
+  this->set_timeout("cron", 0, [this]() { this->check_(); });
+}
+void CronTrigger::check_() {
+  ESPTime time = this->rtc_->now();
+  if (!time.is_valid()) {
+    this->set_timeout("cron", 1000, [this]() { this->check_(); });
+    return;
+  }
   if (!time.in_range()) {
     ESP_LOGW(TAG, "Time is out of range!");
     ESP_LOGD(TAG, "Second=%02u Minute=%02u Hour=%02u DayOfWeek=%u DayOfMonth=%u DayOfYear=%u Month=%u time=%ld",
@@ -165,8 +330,26 @@ void CronTrigger::loop() {
              time.time);
   }
 
-  if (this->matches(time))
+  // Recompute when the clock went backwards, otherwise matches before the old next fire time would be skipped.
+  if (!this->next_fire_.has_value() || time.time < this->last_check_)
+    this->next_fire_ = this->find_next(time.time);
+  this->last_check_ = time.time;
+
+  if (this->next_fire_.has_value() && time.time >= *this->next_fire_) {
+    // If the clock jumped over several matches, they're merged into this one.
     this->trigger();
+    this->next_fire_ = this->find_next(time.time + 1);
+  }
+
+  uint32_t sleep = CRON_MAX_SLEEP;
+  if (this->next_fire_.has_value()) {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    const int64_t remaining = int64_t(*this->next_fire_ - tv.tv_sec) * 1000 - tv.tv_usec / 1000;
+    if (remaining < int64_t(sleep))
+      sleep = remaining > 0 ? uint32_t(remaining) : 0;
+  }
+  this->set_timeout("cron", sleep, [this]() { this->check_(); });
 }
 CronTrigger::CronTrigger(RealTimeClockComponent *rtc) : rtc_(rtc) {}
 void CronTrigger::add_seconds(const std::vector<uint8_t> &seconds) {
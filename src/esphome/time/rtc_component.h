@@ -91,10 +91,26 @@ class CronTrigger : public Trigger<>, public Component {
   void add_day_of_week(uint8_t day_of_week);
   void add_days_of_week(const std::vector<uint8_t> &days_of_week);
   bool matches(const ESPTime &time);
-  void loop() override;
+
+  /** Compute the first unix time at or after start whose local time matches this trigger.
+   *
+   * The local time fields are walked from months down to seconds, skipping to the next set bit of each
+   * field instead of testing every second. Local times that are skipped or repeated when daylight saving
+   * time starts or ends are handled like the clock shows them: they don't match or match twice.
+   *
+   * @return The unix time of the match, or an empty optional if there's none in the next years.
+   */
+  optional<time_t> find_next(time_t start);
+
+  void setup() override;
   float get_setup_priority() const override;
 
  protected:
+  /// Trigger if the next fire time has been reached and sleep until the next one.
+  void check_();
+  /// Advance local to the first matching local time at or after it, regardless of the time zone.
+  bool find_next_local_(struct tm &local);
+
   std::bitset<61> seconds_;
   std::bitset<60> minutes_;
   std::bitset<24> hours_;
@@ -102,7 +118,9 @@ class CronTrigger : public Trigger<>, public Component {
   std::bitset<13> months_;
   std::bitset<8> days_of_week_;
   RealTimeClockComponent *rtc_;
-  optional<ESPTime> last_check_;
+  /// The unix time of the last check, to detect the clock going backwards.
+  time_t last_check_{0};
+  optional<time_t> next_fire_;
 };
 
 /// The RealTimeClock class exposes common timekeeping functions via the device's local real-time clock.
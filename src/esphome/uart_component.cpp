@@ -6,6 +6,8 @@
 #include "esphome/helpers.h"
 #include "esphome/log.h"
 
+#include <cstring>
+
 ESPHOME_NAMESPACE_BEGIN
 
 static const char *TAG = "uart";
@@ -247,35 +249,88 @@ void ESP8266SoftwareSerial::setup(int8_t tx_pin, int8_t rx_pin, uint32_t baud_ra
     this->tx_pin_ = GPIOOutputPin(tx_pin).copy();
     this->tx_pin_->setup();
     this->tx_pin_->digital_write(true);
+    this->fast_tx_ = FastGPIOPin(this->tx_pin_);
   }
   if (rx_pin != -1) {
     auto pin = GPIOInputPin(rx_pin);
     pin.setup();
     this->rx_pin_ = pin.to_isr();
     this->rx_buffer_ = new uint8_t[this->rx_buffer_size_];
-    pin.attach_interrupt(ESP8266SoftwareSerial::gpio_intr, this, FALLING);
+    this->edges_ = new uint32_t[EDGE_BUFFER_SIZE];
+    pin.attach_interrupt(ESP8266SoftwareSerial::gpio_intr, this, CHANGE);
   }
 }
 void ICACHE_RAM_ATTR ESP8266SoftwareSerial::gpio_intr(ESP8266SoftwareSerial *arg) {
-  uint32_t wait = arg->bit_time_ + arg->bit_time_ / 3 - 500;
-  const uint32_t start = ESP.getCycleCount();
-  uint8_t rec = 0;
-  // Manually unroll the loop
-  rec |= arg->read_bit_(&wait, start) << 0;
-  rec |= arg->read_bit_(&wait, start) << 1;
-  rec |= arg->read_bit_(&wait, start) << 2;
-  rec |= arg->read_bit_(&wait, start) << 3;
-  rec |= arg->read_bit_(&wait, start) << 4;
-  rec |= arg->read_bit_(&wait, start) << 5;
-  rec |= arg->read_bit_(&wait, start) << 6;
-  rec |= arg->read_bit_(&wait, start) << 7;
-  // Stop bit
-  arg->wait_(&wait, start);
+  arg->push_edge_(ESP.getCycleCount(), arg->rx_pin_->digital_read());
+}
+void ICACHE_RAM_ATTR ESP8266SoftwareSerial::push_edge_(uint32_t timestamp, bool level) {
+  const uint16_t head = this->edge_head_;
+  const uint16_t next = (head + 1) & (EDGE_BUFFER_SIZE - 1);
+  if (next == this->edge_tail_) {
+    this->edge_overflow_ = true;
+    return;
+  }
+  this->edges_[head] = (timestamp & ~1UL) | uint32_t(level);
+  // Publish the edge only after it has been written.
+  this->edge_head_ = next;
+}
+void ESP8266SoftwareSerial::decode_edges_(uint32_t now) {
+  if (this->edges_ == nullptr)
+    return;
+  if (this->edge_overflow_) {
+    ESP_LOGW(TAG, "Software serial RX edge buffer overflowed, data was lost!");
+    this->edge_overflow_ = false;
+    this->in_byte_ = false;
+  }
+  // The stop bit is sampled in its middle, 9.5 bit times after the start edge.
+  const uint32_t stop_sample = this->bit_time_ * 9 + this->bit_time_ / 2;
 
-  arg->rx_buffer_[arg->rx_in_pos_] = rec;
-  arg->rx_in_pos_ = (arg->rx_in_pos_ + 1) % arg->rx_buffer_size_;
-  // Clear RX pin so that the interrupt doesn't re-trigger right away again.
-  arg->rx_pin_->clear_interrupt();
+  while (true) {
+    const uint16_t tail = this->edge_tail_;
+    const bool has_edge = tail != this->edge_head_;
+    const uint32_t edge = has_edge ? this->edges_[tail] : 0;
+
+    if (!this->in_byte_) {
+      if (!has_edge)
+        return;
+      this->edge_tail_ = (tail + 1) & (EDGE_BUFFER_SIZE - 1);
+      if ((edge & 1) == 0) {
+        // Falling edge while idle: start bit
+        this->byte_start_ = edge;
+        this->in_byte_ = true;
+        this->rx_level_ = false;
+        this->rx_bits_ = 0;
+        this->rx_bit_count_ = 0;
+      }
+      continue;
+    }
+
+    const uint32_t end = has_edge ? edge - this->byte_start_ : now - this->byte_start_;
+    // Data bit i is sampled in its middle, (1.5 + i) bit times after the start edge. All sample points before
+    // the next edge (or now) have the current level.
+    while (this->rx_bit_count_ < 8 && this->bit_time_ * this->rx_bit_count_ + this->bit_time_ * 3 / 2 < end) {
+      this->rx_bits_ |= uint8_t(this->rx_level_) << this->rx_bit_count_;
+      this->rx_bit_count_++;
+    }
+    if (end >= stop_sample) {
+      this->finish_byte_();
+      continue;
+    }
+    if (!has_edge)
+      return;
+    this->rx_level_ = edge & 1;
+    this->edge_tail_ = (tail + 1) & (EDGE_BUFFER_SIZE - 1);
+  }
+}
+void ESP8266SoftwareSerial::finish_byte_() {
+  this->in_byte_ = false;
+  const size_t next = (this->rx_in_pos_ + 1) % this->rx_buffer_size_;
+  if (next == this->rx_out_pos_) {
+    ESP_LOGW(TAG, "Software serial RX buffer full, dropping byte!");
+    return;
+  }
+  this->rx_buffer_[this->rx_in_pos_] = this->rx_bits_;
+  this->rx_in_pos_ = next;
 }
 void ICACHE_RAM_ATTR HOT ESP8266SoftwareSerial::write_byte(uint8_t data) {
   if (this->tx_pin_ == nullptr) {
@@ -305,15 +360,12 @@ void ESP8266SoftwareSerial::wait_(uint32_t *wait, const uint32_t &start) {
     ;
   *wait += this->bit_time_;
 }
-bool ESP8266SoftwareSerial::read_bit_(uint32_t *wait, const uint32_t &start) {
-  this->wait_(wait, start);
-  return this->rx_pin_->digital_read();
-}
 void ESP8266SoftwareSerial::write_bit_(bool bit, uint32_t *wait, const uint32_t &start) {
-  this->tx_pin_->digital_write(bit);
+  this->fast_tx_.digital_write(bit);
   this->wait_(wait, start);
 }
 uint8_t ESP8266SoftwareSerial::read_byte() {
+  this->decode_edges_(ESP.getCycleCount());
   if (this->rx_in_pos_ == this->rx_out_pos_)
     return 0;
   uint8_t data = this->rx_buffer_[this->rx_out_pos_];
@@ -321,12 +373,18 @@ uint8_t ESP8266SoftwareSerial::read_byte() {
   return data;
 }
 uint8_t ESP8266SoftwareSerial::peek_byte() {
+  this->decode_edges_(ESP.getCycleCount());
   if (this->rx_in_pos_ == this->rx_out_pos_)
     return 0;
   return this->rx_buffer_[this->rx_out_pos_];
 }
-void ESP8266SoftwareSerial::flush() { this->rx_in_pos_ = this->rx_out_pos_ = 0; }
+void ESP8266SoftwareSerial::flush() {
+  this->edge_tail_ = this->edge_head_;
+  this->in_byte_ = false;
+  this->rx_in_pos_ = this->rx_out_pos_ = 0;
+}
 int ESP8266SoftwareSerial::available() {
+  this->decode_edges_(ESP.getCycleCount());
   int avail = int(this->rx_in_pos_) - int(this->rx_out_pos_);
   if (avail < 0)
     return avail + this->rx_buffer_size_;
@@ -366,6 +424,151 @@ size_t UARTDevice::write(uint8_t data) { return this->parent_->write(data); }
 int UARTDevice::read() { return this->parent_->read(); }
 int UARTDevice::peek() { return this->parent_->peek(); }
 
+UARTFrameReader::UARTFrameReader(UARTComponent *parent, UARTFrameSpec spec) : parent_(parent), spec_(std::move(spec)) {
+  // The buffer has to hold everything the reader waits for before it can drop a frame (the header, the length
+  // field or a whole fixed-size frame), otherwise it would wait for more data with a full buffer forever.
+  size_t min_length = this->spec_.header_offset + this->spec_.header.size();
+  if (this->spec_.length_offset < 0)
+    min_length = std::max(min_length, size_t(this->spec_.length));
+  else
+    min_length = std::max(min_length, size_t(this->spec_.length_offset) + 2);
+  if (this->spec_.max_length < min_length) {
+    ESP_LOGE(TAG, "Maximum frame length %u is shorter than the frame format, using %u", this->spec_.max_length,
+             unsigned(min_length));
+    this->spec_.max_length = min_length;
+  }
+  this->buffer_.resize(this->spec_.max_length);
+}
+void UARTFrameReader::read(const callback_t &callback) {
+  const uint32_t now = millis();
+  if (this->buffer_len_ != 0 && now - this->last_data_ >= this->spec_.timeout) {
+    ESP_LOGV(TAG, "Last transmission too long ago, dropping %u bytes.", this->buffer_len_);
+    this->reset();
+  }
+
+  int avail = this->parent_->available();
+  if (avail <= 0)
+    return;
+  this->last_data_ = now;
+
+  while (avail > 0) {
+    const size_t n = std::min(size_t(avail), this->buffer_.size() - this->buffer_len_);
+    if (n == 0)
+      // scan_() never leaves a full buffer behind, but don't spin if it did
+      break;
+    if (!this->parent_->read_array(this->buffer_.data() + this->buffer_len_, n))
+      return;
+    this->buffer_len_ += n;
+    avail -= n;
+    this->scan_(callback);
+  }
+}
+void UARTFrameReader::feed(const uint8_t *data, size_t len, const callback_t &callback) {
+  while (len > 0) {
+    const size_t n = std::min(len, this->buffer_.size() - this->buffer_len_);
+    memcpy(this->buffer_.data() + this->buffer_len_, data, n);
+    this->buffer_len_ += n;
+    data += n;
+    len -= n;
+    this->scan_(callback);
+  }
+}
+void UARTFrameReader::reset() { this->buffer_len_ = 0; }
+void UARTFrameReader::scan_(const callback_t &callback) {
+  const size_t header_end = this->spec_.header_offset + this->spec_.header.size();
+  while (this->buffer_len_ >= header_end) {
+    const uint8_t *start = this->buffer_.data() + this->spec_.header_offset;
+    auto *found = static_cast<const uint8_t *>(
+        memchr(start, this->spec_.header[0], this->buffer_len_ - this->spec_.header_offset));
+    if (found == nullptr) {
+      // Keep the bytes that could be before the header of the next frame
+      this->consume_(this->buffer_len_ - this->spec_.header_offset);
+      return;
+    }
+    this->consume_(found - start);
+    if (this->buffer_len_ < header_end)
+      return;
+
+    int len = 0;
+    if (memcmp(start, this->spec_.header.data(), this->spec_.header.size()) == 0)
+      len = this->frame_length_();
+    if (len < 0)
+      // Need more data
+      return;
+    if (len == 0) {
+      this->consume_(1);
+      continue;
+    }
+    if (this->buffer_len_ < size_t(len))
+      return;
+
+    if (!this->check_frame_(len)) {
+      this->consume_(1);
+      continue;
+    }
+    callback(this->buffer_.data(), len);
+    this->consume_(len);
+  }
+}
+int UARTFrameReader::frame_length_() const {
+  if (this->spec_.length_offset < 0)
+    return this->spec_.length;
+
+  if (this->buffer_len_ < size_t(this->spec_.length_offset) + 2)
+    return -1;
+  const uint8_t *field = this->buffer_.data() + this->spec_.length_offset;
+  const size_t len = this->spec_.length + ((uint16_t(field[0]) << 8) | field[1]);
+  const size_t min_len = this->spec_.length_offset + 2 + this->spec_.trailer.size();
+  if (len > this->spec_.max_length || len < min_len) {
+    ESP_LOGV(TAG, "Invalid frame length %u", len);
+    return 0;
+  }
+  return len;
+}
+bool UARTFrameReader::check_frame_(size_t len) const {
+  const uint8_t *frame = this->buffer_.data();
+  const size_t trailer_start = len - this->spec_.trailer.size();
+  if (memcmp(frame + trailer_start, this->spec_.trailer.data(), this->spec_.trailer.size()) != 0) {
+    ESP_LOGV(TAG, "Invalid frame trailer");
+    return false;
+  }
+
+  uint16_t expected;
+  uint16_t checksum = 0;
+  size_t checksum_pos;
+  switch (this->spec_.checksum) {
+    case UART_FRAME_CHECKSUM_SUM8:
+    case UART_FRAME_CHECKSUM_NEG_SUM8:
+      checksum_pos = trailer_start - 1;
+      for (size_t i = this->spec_.checksum_start; i < checksum_pos; i++)
+        checksum += frame[i];
+      if (this->spec_.checksum == UART_FRAME_CHECKSUM_NEG_SUM8)
+        checksum = -checksum;
+      checksum &= 0xFF;
+      expected = frame[checksum_pos];
+      break;
+    case UART_FRAME_CHECKSUM_SUM16:
+      checksum_pos = trailer_start - 2;
+      for (size_t i = this->spec_.checksum_start; i < checksum_pos; i++)
+        checksum += frame[i];
+      expected = (uint16_t(frame[checksum_pos]) << 8) | frame[checksum_pos + 1];
+      break;
+    case UART_FRAME_CHECKSUM_NONE:
+    default:
+      return true;
+  }
+
+  if (checksum != expected) {
+    ESP_LOGW(TAG, "Frame checksum doesn't match: 0x%02X!=0x%02X", checksum, expected);
+    return false;
+  }
+  return true;
+}
+void UARTFrameReader::consume_(size_t len) {
+  this->buffer_len_ -= len;
+  memmove(this->buffer_.data(), this->buffer_.data() + len, this->buffer_len_);
+}
+
 ESPHOME_NAMESPACE_END
 
 #endif  // USE_UART
@@ -6,11 +6,19 @@
 #ifdef USE_UART
 
 #include <HardwareSerial.h>
+#include <functional>
+#include <vector>
 #include "esphome/component.h"
 
 ESPHOME_NAMESPACE_BEGIN
 
 #ifdef ARDUINO_ARCH_ESP8266
+/** A software UART for the ESP8266.
+ *
+ * The RX interrupt fires on each edge and only records its timestamp (in CPU cycles) and the new level in a
+ * lock-free ring. The bytes are decoded from these edges outside of the interrupt when they are read, so the
+ * interrupt never blocks for a whole byte.
+ */
 class ESP8266SoftwareSerial {
  public:
   void setup(int8_t tx_pin, int8_t rx_pin, uint32_t baud_rate);
@@ -28,15 +36,38 @@ class ESP8266SoftwareSerial {
   static void gpio_intr(ESP8266SoftwareSerial *arg);
 
   inline void wait_(uint32_t *wait, const uint32_t &start);
-  inline bool read_bit_(uint32_t *wait, const uint32_t &start);
   inline void write_bit_(bool bit, uint32_t *wait, const uint32_t &start);
 
+  /// Record an edge, the lowest bit of the timestamp is replaced by the new level.
+  inline void push_edge_(uint32_t timestamp, bool level);
+  /// Decode all bytes that are complete at the given time from the recorded edges.
+  void decode_edges_(uint32_t now);
+  /// Finish the byte that is being decoded, the remaining bits have the current level.
+  void finish_byte_();
+
+  /// Must be a power of two. Each byte has at most 10 edges.
+  static const uint16_t EDGE_BUFFER_SIZE = 256;
+
   uint32_t bit_time_{0};
+  volatile uint32_t *edges_{nullptr};
+  volatile uint16_t edge_head_{0};
+  volatile uint16_t edge_tail_{0};
+  volatile bool edge_overflow_{false};
+  /// The start bit edge of the byte that is being decoded.
+  uint32_t byte_start_{0};
+  bool in_byte_{false};
+  /// The line level since the last edge of the current byte.
+  bool rx_level_{true};
+  /// The data bits that have been decoded so far and how many.
+  uint8_t rx_bits_{0};
+  uint8_t rx_bit_count_{0};
+  /// Decoded bytes, only accessed outside of the interrupt.
   uint8_t *rx_buffer_{nullptr};
   size_t rx_buffer_size_{64};
-  volatile size_t rx_in_pos_{0};
+  size_t rx_in_pos_{0};
   size_t rx_out_pos_{0};
   GPIOPin *tx_pin_{nullptr};
+  FastGPIOPin fast_tx_;
   ISRInternalGPIOPin *rx_pin_{nullptr};
 };
 #endif
@@ -90,6 +121,75 @@ class UARTComponent : public Component, public Stream {
 extern uint8_t next_uart_num;
 #endif
 
+enum UARTFrameChecksum {
+  UART_FRAME_CHECKSUM_NONE = 0,
+  /// 8-bit sum of the covered bytes.
+  UART_FRAME_CHECKSUM_SUM8,
+  /// Two's complement of the 8-bit sum of the covered bytes.
+  UART_FRAME_CHECKSUM_NEG_SUM8,
+  /// 16-bit sum of the covered bytes, stored MSB first.
+  UART_FRAME_CHECKSUM_SUM16,
+};
+
+/** Declarative description of the binary frames of a packet sensor, see UARTFrameReader.
+ *
+ * A frame contains the header at header_offset, optionally a 16-bit MSB first length field, a checksum over the
+ * bytes from checksum_start up to the checksum and finally the trailer.
+ */
+struct UARTFrameSpec {
+  /// The bytes every frame contains at header_offset, used to find the start of a frame.
+  std::vector<uint8_t> header;
+  uint8_t header_offset{0};
+  /// The total length of fixed-size frames. With a length field, the number of bytes the length doesn't include.
+  uint8_t length{0};
+  /// The offset of the 16-bit length field or -1 for fixed-size frames.
+  int8_t length_offset{-1};
+  /// The maximum total length of a frame, longer frames are dropped. Never less than a fixed-size frame.
+  uint8_t max_length{64};
+  UARTFrameChecksum checksum{UART_FRAME_CHECKSUM_NONE};
+  uint8_t checksum_start{0};
+  /// The bytes every frame ends with.
+  std::vector<uint8_t> trailer;
+  /// A partial frame is dropped if no new data arrives for this many ms.
+  uint32_t timeout{500};
+};
+
+/** Collects the bytes of a UART and splits them into frames as described by a UARTFrameSpec.
+ *
+ * Available bytes are read in bulk and the buffer is scanned for the header with memchr, so resynchronizing after
+ * garbage doesn't go through a state machine byte by byte. Only frames with a valid header, length, trailer and
+ * checksum are passed on.
+ */
+class UARTFrameReader {
+ public:
+  using callback_t = std::function<void(const uint8_t *frame, size_t len)>;
+
+  UARTFrameReader(UARTComponent *parent, UARTFrameSpec spec);
+
+  /// Read all available bytes and call callback for each complete frame. Call this from loop().
+  void read(const callback_t &callback);
+
+  /// Split bytes that didn't come from the UART (for example a captured stream) into frames.
+  void feed(const uint8_t *data, size_t len, const callback_t &callback);
+
+  /// Drop a partial frame.
+  void reset();
+
+ protected:
+  /// Find and pass on all complete frames in the buffer.
+  void scan_(const callback_t &callback);
+  /// The total length of the frame at the start of the buffer, 0 if invalid or -1 if more data is required.
+  int frame_length_() const;
+  bool check_frame_(size_t len) const;
+  void consume_(size_t len);
+
+  UARTComponent *parent_;
+  UARTFrameSpec spec_;
+  std::vector<uint8_t> buffer_;
+  size_t buffer_len_{0};
+  uint32_t last_data_{0};
+};
+
 class UARTDevice : public Stream {
  public:
   UARTDevice(UARTComponent *parent);
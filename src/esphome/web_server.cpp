@@ -16,23 +16,25 @@
 #endif
 
 #include <cstdlib>
+#include <cstring>
+#include <algorithm>
 
 ESPHOME_NAMESPACE_BEGIN
 
 static const char *TAG = "web_server";
 
-void write_row(AsyncResponseStream *stream, Nameable *obj, const std::string &klass, const std::string &action) {
-  stream->print("<tr class=\"");
-  stream->print(klass.c_str());
-  stream->print("\" id=\"");
-  stream->print(klass.c_str());
-  stream->print("-");
-  stream->print(obj->get_object_id().c_str());
-  stream->print("\"><td>");
-  stream->print(obj->get_name().c_str());
-  stream->print("</td><td></td><td>");
-  stream->print(action.c_str());
-  stream->print("</td>");
+void write_row(std::string &out, Nameable *obj, const std::string &klass, const std::string &action) {
+  out += "<tr class=\"";
+  out += klass;
+  out += "\" id=\"";
+  out += klass;
+  out += "-";
+  out += obj->get_object_id();
+  out += "\"><td>";
+  out += obj->get_name();
+  out += "</td><td></td><td>";
+  out += action;
+  out += "</td>";
 }
 
 UrlMatch match_url(const std::string &url, bool only_domain = false) {
@@ -63,9 +65,21 @@ UrlMatch match_url(const std::string &url, bool only_domain = false) {
 
 WebServer::WebServer(uint16_t port) : port_(port) {}
 
-void WebServer::set_css_url(const char *css_url) { this->css_url_ = css_url; }
-void WebServer::set_js_url(const char *js_url) { this->js_url_ = js_url; }
+void WebServer::set_css_url(const char *css_url) {
+  this->css_url_ = css_url;
+  this->invalidate_index();
+}
+void WebServer::set_js_url(const char *js_url) {
+  this->js_url_ = js_url;
+  this->invalidate_index();
+}
 void WebServer::set_port(uint16_t port) { this->port_ = port; }
+void WebServer::set_event_batch_size(uint8_t event_batch_size) { this->event_batch_size_ = event_batch_size; }
+void WebServer::add_asset(const char *path, const char *content_type, const uint8_t *data, size_t size,
+                          const char *etag) {
+  this->assets_.push_back(WebServerAsset{path, content_type, data, size, etag});
+}
+void WebServer::invalidate_index() { this->index_dirty_ = true; }
 
 void WebServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up web server...");
@@ -74,59 +88,237 @@ void WebServer::setup() {
   this->events_.onConnect([this](AsyncEventSourceClient *client) {
     // Configure reconnect timeout
     client->send("", "ping", millis(), 30000);
+    // The initial states are queued from loop(), so that several clients connecting at once
+    // only cause one set of state events.
+    this->initial_states_pending_ = true;
+  });
+
+  if (global_log_component != nullptr)
+    global_log_component->add_on_log_callback(
+        [this](int level, const char *tag, const char *message) { this->events_.send(message, "log", millis()); });
+  this->server_->addHandler(this);
+  this->server_->addHandler(&this->events_);
 
+  this->render_index_();
+  this->server_->begin();
+
+  this->set_interval(10000, [this]() { this->events_.send("", "ping", millis(), 30000); });
+}
+void WebServer::dump_config() {
+  ESP_LOGCONFIG(TAG, "Web Server:");
+  ESP_LOGCONFIG(TAG, "  Address: %s:%u", network_get_address().c_str(), this->port_);
+  for (auto &asset : this->assets_)
+    ESP_LOGCONFIG(TAG, "  Asset: %s (%u bytes)", asset.path, asset.size);
+}
+float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f; }
+
+void WebServer::loop() {
+  if (this->index_dirty_)
+    this->render_index_();
+
+  if (this->initial_states_pending_) {
+    this->initial_states_pending_ = false;
+    this->queue_all_states_();
+  }
+
+  if (this->state_queue_.empty())
+    return;
+
+  if (this->events_.count() == 0) {
+    // Nobody is listening, the next client will get all states on connect anyway.
+    this->state_queue_.clear();
+    return;
+  }
+
+  size_t count = std::min(this->state_queue_.size(), size_t(this->event_batch_size_));
+  for (size_t i = 0; i < count; i++) {
+    std::string json = this->queued_state_json_(this->state_queue_[i]);
+    this->events_.send(json.c_str(), "state");
+  }
+  this->state_queue_.erase(this->state_queue_.begin(), this->state_queue_.begin() + count);
+}
+
+void WebServer::queue_state_(WebServerDomain domain, Nameable *obj) {
+  if (obj->is_internal() || this->events_.count() == 0)
+    return;
+  for (auto &entry : this->state_queue_) {
+    if (entry.obj == obj)
+      // Already pending, the state is read when the queue is flushed.
+      return;
+  }
+  this->state_queue_.push_back(WebServerQueuedState{domain, obj});
+}
+
+void WebServer::queue_all_states_() {
 #ifdef USE_SENSOR
-    for (auto *obj : this->sensors_)
-      if (!obj->is_internal())
-        client->send(this->sensor_json(obj, obj->state).c_str(), "state");
+  for (auto *obj : this->sensors_)
+    this->queue_state_(WEB_SERVER_DOMAIN_SENSOR, obj);
 #endif
 
 #ifdef USE_SWITCH
-    for (auto *obj : this->switches_)
-      if (!obj->is_internal())
-        client->send(this->switch_json(obj, obj->state).c_str(), "state");
+  for (auto *obj : this->switches_)
+    this->queue_state_(WEB_SERVER_DOMAIN_SWITCH, obj);
 #endif
 
 #ifdef USE_BINARY_SENSOR
-    for (auto *obj : this->binary_sensors_)
-      if (!obj->is_internal())
-        client->send(this->binary_sensor_json(obj, obj->state).c_str(), "state");
+  for (auto *obj : this->binary_sensors_)
+    this->queue_state_(WEB_SERVER_DOMAIN_BINARY_SENSOR, obj);
 #endif
 
 #ifdef USE_FAN
-    for (auto *obj : this->fans_)
-      if (!obj->is_internal())
-        client->send(this->fan_json(obj).c_str(), "state");
+  for (auto *obj : this->fans_)
+    this->queue_state_(WEB_SERVER_DOMAIN_FAN, obj);
 #endif
 
 #ifdef USE_LIGHT
-    for (auto *obj : this->lights_)
-      if (!obj->is_internal())
-        client->send(this->light_json(obj).c_str(), "state");
+  for (auto *obj : this->lights_)
+    this->queue_state_(WEB_SERVER_DOMAIN_LIGHT, obj);
 #endif
 
 #ifdef USE_TEXT_SENSOR
-    for (auto *obj : this->text_sensors_)
-      if (!obj->is_internal())
-        client->send(this->text_sensor_json(obj, obj->state).c_str(), "state");
+  for (auto *obj : this->text_sensors_)
+    this->queue_state_(WEB_SERVER_DOMAIN_TEXT_SENSOR, obj);
 #endif
-  });
-
-  if (global_log_component != nullptr)
-    global_log_component->add_on_log_callback(
-        [this](int level, const char *tag, const char *message) { this->events_.send(message, "log", millis()); });
-  this->server_->addHandler(this);
-  this->server_->addHandler(&this->events_);
+}
 
-  this->server_->begin();
+std::string WebServer::queued_state_json_(const WebServerQueuedState &entry) {
+  switch (entry.domain) {
+#ifdef USE_SENSOR
+    case WEB_SERVER_DOMAIN_SENSOR: {
+      auto *obj = static_cast<sensor::Sensor *>(entry.obj);
+      return this->sensor_json(obj, obj->state);
+    }
+#endif
+#ifdef USE_SWITCH
+    case WEB_SERVER_DOMAIN_SWITCH: {
+      auto *obj = static_cast<switch_::Switch *>(entry.obj);
+      return this->switch_json(obj, obj->state);
+    }
+#endif
+#ifdef USE_BINARY_SENSOR
+    case WEB_SERVER_DOMAIN_BINARY_SENSOR: {
+      auto *obj = static_cast<binary_sensor::BinarySensor *>(entry.obj);
+      return this->binary_sensor_json(obj, obj->state);
+    }
+#endif
+#ifdef USE_FAN
+    case WEB_SERVER_DOMAIN_FAN:
+      return this->fan_json(static_cast<fan::FanState *>(entry.obj));
+#endif
+#ifdef USE_LIGHT
+    case WEB_SERVER_DOMAIN_LIGHT:
+      return this->light_json(static_cast<light::LightState *>(entry.obj));
+#endif
+#ifdef USE_TEXT_SENSOR
+    case WEB_SERVER_DOMAIN_TEXT_SENSOR: {
+      auto *obj = static_cast<text_sensor::TextSensor *>(entry.obj);
+      return this->text_sensor_json(obj, obj->state);
+    }
+#endif
+    default:
+      return "";
+  }
+}
 
-  this->set_interval(10000, [this]() { this->events_.send("", "ping", millis(), 30000); });
+static void write_snapshot_header(AsyncResponseStream *stream, WebServerDomain domain, Nameable *obj, uint8_t len) {
+  uint32_t key = obj->get_object_id_hash();
+  uint8_t header[6] = {
+      domain, uint8_t(key >> 0), uint8_t(key >> 8), uint8_t(key >> 16), uint8_t(key >> 24), len,
+  };
+  stream->write(header, sizeof(header));
 }
-void WebServer::dump_config() {
-  ESP_LOGCONFIG(TAG, "Web Server:");
-  ESP_LOGCONFIG(TAG, "  Address: %s:%u", network_get_address().c_str(), this->port_);
+
+static uint8_t snapshot_float_to_byte(float value) { return uint8_t(clamp(0.0f, 1.0f, value) * 255.0f); }
+
+/* Binary state snapshot format, all integers are little endian:
+ *
+ *  - uint8 version (currently 1)
+ *  - for each non-internal entity:
+ *    - uint8 domain (see WebServerDomain)
+ *    - uint32 object id hash (the same key the native API uses)
+ *    - uint8 payload length
+ *    - payload:
+ *      - sensor: float32 state
+ *      - switch, binary_sensor: uint8 state
+ *      - fan: uint8 state, uint8 speed, uint8 oscillating
+ *      - light: uint8 state, then brightness, red, green, blue, white as uint8 (0-255)
+ *      - text_sensor: the raw state, truncated to 255 bytes
+ */
+void WebServer::handle_states_request(AsyncWebServerRequest *request) {
+  AsyncResponseStream *stream = request->beginResponseStream("application/octet-stream");
+  stream->write(uint8_t(1));
+
+#ifdef USE_SENSOR
+  for (auto *obj : this->sensors_) {
+    if (obj->is_internal())
+      continue;
+    write_snapshot_header(stream, WEB_SERVER_DOMAIN_SENSOR, obj, sizeof(float));
+    float value = obj->state;
+    uint32_t raw;
+    memcpy(&raw, &value, sizeof(float));
+    uint8_t data[4] = {uint8_t(raw >> 0), uint8_t(raw >> 8), uint8_t(raw >> 16), uint8_t(raw >> 24)};
+    stream->write(data, sizeof(data));
+  }
+#endif
+
+#ifdef USE_SWITCH
+  for (auto *obj : this->switches_) {
+    if (obj->is_internal())
+      continue;
+    write_snapshot_header(stream, WEB_SERVER_DOMAIN_SWITCH, obj, 1);
+    stream->write(uint8_t(obj->state));
+  }
+#endif
+
+#ifdef USE_BINARY_SENSOR
+  for (auto *obj : this->binary_sensors_) {
+    if (obj->is_internal())
+      continue;
+    write_snapshot_header(stream, WEB_SERVER_DOMAIN_BINARY_SENSOR, obj, 1);
+    stream->write(uint8_t(obj->state));
+  }
+#endif
+
+#ifdef USE_FAN
+  for (auto *obj : this->fans_) {
+    if (obj->is_internal())
+      continue;
+    write_snapshot_header(stream, WEB_SERVER_DOMAIN_FAN, obj, 3);
+    uint8_t data[3] = {uint8_t(obj->state), uint8_t(obj->speed), uint8_t(obj->oscillating)};
+    stream->write(data, sizeof(data));
+  }
+#endif
+
+#ifdef USE_LIGHT
+  for (auto *obj : this->lights_) {
+    if (obj->is_internal())
+      continue;
+    write_snapshot_header(stream, WEB_SERVER_DOMAIN_LIGHT, obj, 6);
+    const auto &values = obj->remote_values;
+    uint8_t data[6] = {
+        uint8_t(values.is_on()),
+        snapshot_float_to_byte(values.get_brightness()),
+        snapshot_float_to_byte(values.get_red()),
+        snapshot_float_to_byte(values.get_green()),
+        snapshot_float_to_byte(values.get_blue()),
+        snapshot_float_to_byte(values.get_white()),
+    };
+    stream->write(data, sizeof(data));
+  }
+#endif
+
+#ifdef USE_TEXT_SENSOR
+  for (auto *obj : this->text_sensors_) {
+    if (obj->is_internal())
+      continue;
+    uint8_t len = std::min(obj->state.size(), size_t(255));
+    write_snapshot_header(stream, WEB_SERVER_DOMAIN_TEXT_SENSOR, obj, len);
+    stream->write(reinterpret_cast<const uint8_t *>(obj->state.data()), len);
+  }
+#endif
+
+  request->send(stream);
 }
-float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f; }
 
 void WebServer::handle_update_request(AsyncWebServerRequest *request) {
   AsyncWebServerResponse *response;
@@ -200,76 +392,126 @@ void WebServer::handleUpload(AsyncWebServerRequest *request, const String &filen
   }
 }
 
-void WebServer::handle_index_request(AsyncWebServerRequest *request) {
-  AsyncResponseStream *stream = request->beginResponseStream("text/html");
+bool WebServer::send_not_modified_(AsyncWebServerRequest *request, const String &etag) {
+  if (!request->hasHeader("If-None-Match") || request->header("If-None-Match") != etag)
+    return false;
+  AsyncWebServerResponse *response = request->beginResponse(304);
+  response->addHeader("ETag", etag);
+  request->send(response);
+  return true;
+}
+
+const WebServerAsset *WebServer::find_asset_(const String &url) const {
+  for (auto &asset : this->assets_) {
+    if (url == asset.path)
+      return &asset;
+  }
+  return nullptr;
+}
+
+void WebServer::render_index_() {
+  this->index_dirty_ = false;
+  auto index = std::make_shared<WebServerIndexPage>();
+  std::string &out = index->html;
   std::string title = App.get_name() + " Web Server";
-  stream->print(F("<!DOCTYPE html><html><head><meta charset=UTF-8><title>"));
-  stream->print(title.c_str());
-  stream->print(F("</title><link rel=\"stylesheet\" href=\""));
+  out += "<!DOCTYPE html><html><head><meta charset=UTF-8><title>";
+  out += title;
+  out += "</title><link rel=\"stylesheet\" href=\"";
   if (this->css_url_ != nullptr) {
-    stream->print(this->css_url_);
+    out += this->css_url_;
   } else {
-    stream->print(F("https://esphome.io/_static/webserver-v1.min.css"));
+    out += "https://esphome.io/_static/webserver-v1.min.css";
   }
-  stream->print(F("\"></head><body><article class=\"markdown-body\"><h1>"));
-  stream->print(title.c_str());
-  stream->print(F("</h1><h2>States</h2><table id=\"states\"><thead><tr><th>Name<th>State<th>Actions<tbody>"));
+  out += "\"></head><body><article class=\"markdown-body\"><h1>";
+  out += title;
+  out += "</h1><h2>States</h2><table id=\"states\"><thead><tr><th>Name<th>State<th>Actions<tbody>";
 
 #ifdef USE_SENSOR
   for (auto *obj : this->sensors_)
     if (!obj->is_internal())
-      write_row(stream, obj, "sensor", "");
+      write_row(out, obj, "sensor", "");
 #endif
 
 #ifdef USE_SWITCH
   for (auto *obj : this->switches_)
     if (!obj->is_internal())
-      write_row(stream, obj, "switch", "<button>Toggle</button>");
+      write_row(out, obj, "switch", "<button>Toggle</button>");
 #endif
 
 #ifdef USE_BINARY_SENSOR
   for (auto *obj : this->binary_sensors_)
     if (!obj->is_internal())
-      write_row(stream, obj, "binary_sensor", "");
+      write_row(out, obj, "binary_sensor", "");
 #endif
 
 #ifdef USE_FAN
   for (auto *obj : this->fans_)
     if (!obj->is_internal())
-      write_row(stream, obj, "fan", "<button>Toggle</button>");
+      write_row(out, obj, "fan", "<button>Toggle</button>");
 #endif
 
 #ifdef USE_LIGHT
   for (auto *obj : this->lights_)
     if (!obj->is_internal())
-      write_row(stream, obj, "light", "<button>Toggle</button>");
+      write_row(out, obj, "light", "<button>Toggle</button>");
 #endif
 
 #ifdef USE_TEXT_SENSOR
   for (auto *obj : this->text_sensors_)
     if (!obj->is_internal())
-      write_row(stream, obj, "text_sensor", "");
+      write_row(out, obj, "text_sensor", "");
 #endif
 
-  stream->print(F("</tbody></table><p>See <a href=\"https://esphome.io/web-api/index.html\">ESPHome Web API</a> for "
-                  "REST API documentation.</p>"
-                  "<h2>OTA Update</h2><form method='POST' action=\"/update\" enctype=\"multipart/form-data\"><input "
-                  "type=\"file\" name=\"update\"><input type=\"submit\" value=\"Update\"></form>"
-                  "<h2>Debug Log</h2><pre id=\"log\"></pre>"
-                  "<script src=\""));
+  out += "</tbody></table><p>See <a href=\"https://esphome.io/web-api/index.html\">ESPHome Web API</a> for "
+         "REST API documentation.</p>"
+         "<h2>OTA Update</h2><form method='POST' action=\"/update\" enctype=\"multipart/form-data\"><input "
+         "type=\"file\" name=\"update\"><input type=\"submit\" value=\"Update\"></form>"
+         "<h2>Debug Log</h2><pre id=\"log\"></pre>"
+         "<script src=\"";
   if (this->js_url_ != nullptr) {
-    stream->print(this->js_url_);
+    out += this->js_url_;
   } else {
-    stream->print(F("https://esphome.io/_static/webserver-v1.min.js"));
+    out += "https://esphome.io/_static/webserver-v1.min.js";
   }
-  stream->print(F("\"></script></article></body></html>"));
+  out += "\"></script></article></body></html>";
 
-  request->send(stream);
+  char etag[11];
+  snprintf(etag, sizeof(etag), "\"%08X\"", fnv1_hash(out));
+  index->etag = etag;
+  std::atomic_store(&this->index_cache_, std::shared_ptr<const WebServerIndexPage>(std::move(index)));
+}
+
+void WebServer::handle_index_request(AsyncWebServerRequest *request) {
+  // Send straight from the cache, the lambda keeps the rendered page alive until the response is done.
+  std::shared_ptr<const WebServerIndexPage> index = std::atomic_load(&this->index_cache_);
+  if (this->send_not_modified_(request, index->etag))
+    return;
+
+  AsyncWebServerResponse *response = request->beginResponse(
+      "text/html", index->html.size(), [index](uint8_t *buffer, size_t max_len, size_t offset) -> size_t {
+        size_t len = std::min(max_len, index->html.size() - offset);
+        memcpy(buffer, index->html.data() + offset, len);
+        return len;
+      });
+  response->addHeader("ETag", index->etag);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
+void WebServer::handle_asset_request(AsyncWebServerRequest *request, const WebServerAsset *asset) {
+  if (this->send_not_modified_(request, asset->etag))
+    return;
+
+  AsyncWebServerResponse *response = request->beginResponse_P(200, asset->content_type, asset->data, asset->size);
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("ETag", asset->etag);
+  response->addHeader("Cache-Control", "max-age=86400");
+  request->send(response);
 }
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  this->events_.send(this->sensor_json(obj, state).c_str(), "state");
+  this->queue_state_(WEB_SERVER_DOMAIN_SENSOR, obj);
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, UrlMatch match) {
   for (sensor::Sensor *obj : this->sensors_) {
@@ -297,7 +539,7 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value) {
 
 #ifdef USE_TEXT_SENSOR
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, std::string state) {
-  this->events_.send(this->text_sensor_json(obj, state).c_str(), "state");
+  this->queue_state_(WEB_SERVER_DOMAIN_TEXT_SENSOR, obj);
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, UrlMatch match) {
   for (text_sensor::TextSensor *obj : this->text_sensors_) {
@@ -322,7 +564,7 @@ std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std:
 
 #ifdef USE_SWITCH
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
-  this->events_.send(this->switch_json(obj, state).c_str(), "state");
+  this->queue_state_(WEB_SERVER_DOMAIN_SWITCH, obj);
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value) {
   return build_json([obj, value](JsonObject &root) {
@@ -361,9 +603,7 @@ void WebServer::handle_switch_request(AsyncWebServerRequest *request, UrlMatch m
 
 #ifdef USE_BINARY_SENSOR
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
-  if (obj->is_internal())
-    return;
-  this->events_.send(this->binary_sensor_json(obj, state).c_str(), "state");
+  this->queue_state_(WEB_SERVER_DOMAIN_BINARY_SENSOR, obj);
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value) {
   return build_json([obj, value](JsonObject &root) {
@@ -387,11 +627,7 @@ void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, Url
 #endif
 
 #ifdef USE_FAN
-void WebServer::on_fan_update(fan::FanState *obj) {
-  if (obj->is_internal())
-    return;
-  this->events_.send(this->fan_json(obj).c_str(), "state");
-}
+void WebServer::on_fan_update(fan::FanState *obj) { this->queue_state_(WEB_SERVER_DOMAIN_FAN, obj); }
 std::string WebServer::fan_json(fan::FanState *obj) {
   return build_json([obj](JsonObject &root) {
     root["id"] = "fan-" + obj->get_object_id();
@@ -466,11 +702,7 @@ void WebServer::handle_fan_request(AsyncWebServerRequest *request, UrlMatch matc
 #endif
 
 #ifdef USE_LIGHT
-void WebServer::on_light_update(light::LightState *obj) {
-  if (obj->is_internal())
-    return;
-  this->events_.send(this->light_json(obj).c_str(), "state");
-}
+void WebServer::on_light_update(light::LightState *obj) { this->queue_state_(WEB_SERVER_DOMAIN_LIGHT, obj); }
 void WebServer::handle_light_request(AsyncWebServerRequest *request, UrlMatch match) {
   for (light::LightState *obj : this->lights_) {
     if (obj->is_internal())
@@ -539,12 +771,18 @@ std::string WebServer::light_json(light::LightState *obj) {
 #endif
 
 bool WebServer::canHandle(AsyncWebServerRequest *request) {
-  if (request->url() == "/")
+  if (request->url() == "/" || (request->method() == HTTP_GET && this->find_asset_(request->url()) != nullptr)) {
+    // Headers are only kept if the handler asks for them
+    request->addInterestingHeader("If-None-Match");
     return true;
+  }
 
   if (request->url() == "/update" && request->method() == HTTP_POST)
     return true;
 
+  if (request->url() == "/states" && request->method() == HTTP_GET)
+    return true;
+
   UrlMatch match = match_url(request->url().c_str(), true);
   if (!match.valid)
     return false;
@@ -591,6 +829,17 @@ void WebServer::handleRequest(AsyncWebServerRequest *request) {
     return;
   }
 
+  if (request->url() == "/states") {
+    this->handle_states_request(request);
+    return;
+  }
+
+  const WebServerAsset *asset = this->find_asset_(request->url());
+  if (asset != nullptr) {
+    this->handle_asset_request(request, asset);
+    return;
+  }
+
   UrlMatch match = match_url(request->url().c_str());
 #ifdef USE_SENSOR
   if (match.domain == "sensor") {
@@ -9,6 +9,7 @@
 #include "esphome/controller.h"
 
 #include <vector>
+#include <memory>
 #include <ESPAsyncWebServer.h>
 
 ESPHOME_NAMESPACE_BEGIN
@@ -21,6 +22,37 @@ struct UrlMatch {
   bool valid;          ///< Whether this match is valid
 };
 
+/// The entity domains known to the event queue and the binary state snapshot.
+enum WebServerDomain : uint8_t {
+  WEB_SERVER_DOMAIN_SENSOR = 0,
+  WEB_SERVER_DOMAIN_SWITCH = 1,
+  WEB_SERVER_DOMAIN_BINARY_SENSOR = 2,
+  WEB_SERVER_DOMAIN_FAN = 3,
+  WEB_SERVER_DOMAIN_LIGHT = 4,
+  WEB_SERVER_DOMAIN_TEXT_SENSOR = 5,
+};
+
+/// Internal entry of the event queue. The state itself is read from the entity when the queue is flushed.
+struct WebServerQueuedState {
+  WebServerDomain domain;
+  Nameable *obj;
+};
+
+/// A static file that's embedded in flash and served by the web server.
+struct WebServerAsset {
+  const char *path;          ///< The URL the asset is served under, for example "/webserver.min.css"
+  const char *content_type;  ///< The MIME type of the (uncompressed) asset
+  const uint8_t *data;       ///< The gzip-compressed contents, stored in PROGMEM
+  size_t size;               ///< The length of data in bytes
+  const char *etag;          ///< The quoted entity tag of the asset, for example "\"5d41402a\""
+};
+
+/// The rendered index page, never changed once it's published.
+struct WebServerIndexPage {
+  std::string html;
+  String etag;
+};
+
 /** This class allows users to create a web server with their ESP nodes.
  *
  * Behind the scenes it's using AsyncWebServer to set up the server. It exposes 3 things:
@@ -29,6 +61,11 @@ struct UrlMatch {
  * all state updates in real time + the debug log. Lastly, there's an REST API available
  * under the '/light/...', '/sensor/...', ... URLs. A full documentation for this API
  * can be found under https://esphome.io/web-api/index.html.
+ *
+ * State updates are not sent to the event source immediately. Instead, each entity is put into a
+ * queue that holds at most one entry per entity (later updates of the same entity coalesce into
+ * the pending entry) and the queue is flushed in batches of set_event_batch_size() events per loop()
+ * iteration. A compact binary snapshot of all entity states is available under '/states'.
  */
 class WebServer : public StoringUpdateListenerController, public Component, public AsyncWebHandler {
  public:
@@ -52,6 +89,35 @@ class WebServer : public StoringUpdateListenerController, public Component, publ
   /// Set the web server port.
   void set_port(uint16_t port);
 
+  /** Set the maximum number of state events that are sent to the event source per loop() iteration.
+   * Defaults to 8.
+   *
+   * @param event_batch_size The number of queued states to flush per loop.
+   */
+  void set_event_batch_size(uint8_t event_batch_size);
+
+  /** Register a static asset that's served from flash.
+   *
+   * The data must already be gzip-compressed (this is done at build time by the code generator) and
+   * must stay valid for the lifetime of the web server. To serve the web interface without
+   * an internet connection, register the stylesheet and script and point set_css_url()/set_js_url()
+   * to the asset paths.
+   *
+   * @param path The URL path of the asset.
+   * @param content_type The MIME type of the uncompressed asset.
+   * @param data The gzip-compressed contents, in PROGMEM.
+   * @param size The length of data in bytes.
+   * @param etag The quoted entity tag of the contents.
+   */
+  void add_asset(const char *path, const char *content_type, const uint8_t *data, size_t size, const char *etag);
+
+  /** Render the cached index page again in the next loop().
+   *
+   * This is done automatically when the CSS/JS URL changes, call it manually (from the main loop) after
+   * renaming entities.
+   */
+  void invalidate_index();
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Setup the internal web server and register handlers.
@@ -59,6 +125,9 @@ class WebServer : public StoringUpdateListenerController, public Component, publ
 
   void dump_config() override;
 
+  /// Flush a batch of queued state events.
+  void loop() override;
+
   /// MQTT setup priority.
   float get_setup_priority() const override;
 
@@ -67,6 +136,12 @@ class WebServer : public StoringUpdateListenerController, public Component, publ
 
   void handle_update_request(AsyncWebServerRequest *request);
 
+  /// Handle a request for an asset registered with add_asset().
+  void handle_asset_request(AsyncWebServerRequest *request, const WebServerAsset *asset);
+
+  /// Handle a binary state snapshot request under '/states'.
+  void handle_states_request(AsyncWebServerRequest *request);
+
 #ifdef USE_SENSOR
   void on_sensor_update(sensor::Sensor *obj, float state) override;
   /// Handle a sensor request under '/sensor/<id>'.
@@ -136,6 +211,19 @@ class WebServer : public StoringUpdateListenerController, public Component, publ
   bool isRequestHandlerTrivial() override;
 
  protected:
+  /// Queue a state event for obj, coalescing it with an already pending event for the same entity.
+  void queue_state_(WebServerDomain domain, Nameable *obj);
+  /// Queue the states of all non-internal entities, used after a new client has connected.
+  void queue_all_states_();
+  /// Serialize the current state of a queued entity as JSON.
+  std::string queued_state_json_(const WebServerQueuedState &entry);
+  /// Render the index page and publish it in index_cache_.
+  void render_index_();
+  /// Find the registered asset for url, or nullptr.
+  const WebServerAsset *find_asset_(const String &url) const;
+  /// Send a body-less 304 response if the request's If-None-Match header matches etag.
+  bool send_not_modified_(AsyncWebServerRequest *request, const String &etag);
+
   uint16_t port_;
   AsyncWebServer *server_;
   AsyncEventSource events_{"/events"};
@@ -143,6 +231,17 @@ class WebServer : public StoringUpdateListenerController, public Component, publ
   const char *js_url_{nullptr};
   uint32_t last_ota_progress_{0};
   uint32_t ota_read_length_{0};
+  std::vector<WebServerQueuedState> state_queue_;
+  uint8_t event_batch_size_{8};
+  std::vector<WebServerAsset> assets_;
+  /** Only replaced in the main loop and read by the request handlers, which may run in another task, so it's
+   * always accessed with std::atomic_load/std::atomic_store. Shared so that a response that's still being sent
+   * keeps its page when a new one is published.
+   */
+  std::shared_ptr<const WebServerIndexPage> index_cache_;
+  bool index_dirty_{false};
+  /// Set from the async event source context when a client connects, consumed in loop().
+  volatile bool initial_states_pending_{false};
 };
 
 ESPHOME_NAMESPACE_END
@@ -0,0 +1,57 @@
+// Toggle and read rate of GPIOPin (virtual calls, inversion applied per access) and FastGPIOPin, with the GPIO
+// registers mapped to plain memory. The code under test is linked from esphal.cpp like on the device, so the
+// virtual calls aren't inlined.
+#include "test_helpers.h"
+#include "esphome/esphal.h"
+
+#include <chrono>
+
+using namespace esphome;
+
+static volatile uint32_t registers[0x800 / 4];
+static const uint32_t ITERATIONS = 20000000;
+
+template<typename F> static double ns_per_call(F f) {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / ITERATIONS;
+}
+
+static void bench(bool inverted) {
+  GPIOPin gpio_pin(5, OUTPUT, inverted);
+  // Through a base class pointer, like the drivers hold their pins.
+  GPIOPin *pin = &gpio_pin;
+  FastGPIOPin fast(pin);
+  EXPECT(fast.is_fast());
+
+  const double slow_write = ns_per_call([pin]() {
+    for (uint32_t i = 0; i < ITERATIONS; i++)
+      pin->digital_write(i & 1);
+  });
+  const double fast_write = ns_per_call([&fast]() {
+    for (uint32_t i = 0; i < ITERATIONS; i++)
+      fast.digital_write(i & 1);
+  });
+  uint32_t slow_high = 0, fast_high = 0;
+  const double slow_read = ns_per_call([pin, &slow_high]() {
+    for (uint32_t i = 0; i < ITERATIONS; i++)
+      slow_high += pin->digital_read();
+  });
+  const double fast_read = ns_per_call([&fast, &fast_high]() {
+    for (uint32_t i = 0; i < ITERATIONS; i++)
+      fast_high += fast.digital_read();
+  });
+  // Both read the same level.
+  EXPECT(slow_high == fast_high);
+
+  printf("  inverted=%d write: GPIOPin %.2f ns, FastGPIOPin %.2f ns\n", inverted, slow_write, fast_write);
+  printf("  inverted=%d read:  GPIOPin %.2f ns, FastGPIOPin %.2f ns\n", inverted, slow_read, fast_read);
+}
+
+int main() {
+  esp8266_test_registers = registers;
+  bench(false);
+  bench(true);
+  return test_result();
+}
@@ -0,0 +1,226 @@
+// Bus transactions of the MCP23017 and PCF8575 on a simulated bus, for a 16 key keypad read every loop cycle
+// and a 16 relay board that changes every loop cycle. The inputs are read with and without the cache of the
+// input registers (without, every digital_read() goes to the bus like before the cache), and with the INT pin
+// of the expander; the outputs are written through and in a batch. The bus time is for 100 kHz.
+#include "test_helpers.h"
+#include "i2c_sim.h"
+#include "esphome/io/mcp23017.h"
+#include "esphome/io/pcf8574_component.h"
+
+using namespace esphome;
+using namespace esphome::io;
+
+static const uint32_t LOOPS = 1000;
+static const uint32_t INPUT_CHANGES = 10;
+
+/// The INT output of an expander, low while a change of the inputs wasn't read yet.
+struct SimInterrupt {
+  bool pending{false};
+};
+
+class SimInterruptPin : public GPIOInputPin {
+ public:
+  explicit SimInterruptPin(SimInterrupt *interrupt) : GPIOInputPin(13), interrupt_(interrupt) {}
+  GPIOPin *copy() const override { return new SimInterruptPin(*this); }
+  void setup() override {}
+  bool digital_read() override { return !this->interrupt_->pending; }
+  bool is_internal() const override { return false; }
+
+ protected:
+  SimInterrupt *interrupt_;
+};
+
+/// An MCP23017 with IOCON.BANK=0, reading GPIOA or GPIOB clears the interrupt.
+class SimMCP23017 : public I2CSimDevice {
+ public:
+  explicit SimMCP23017(uint8_t address) : I2CSimDevice(address) {}
+  void set_inputs(uint16_t inputs) {
+    if (inputs != this->inputs()) {
+      this->registers[MCP23017_GPIOA] = inputs & 0xFF;
+      this->registers[MCP23017_GPIOB] = inputs >> 8;
+      this->interrupt.pending = true;
+    }
+  }
+  uint16_t inputs() const { return this->registers[MCP23017_GPIOA] | (this->registers[MCP23017_GPIOB] << 8); }
+  uint16_t outputs() const { return this->registers[MCP23017_OLATA] | (this->registers[MCP23017_OLATB] << 8); }
+  uint8_t read_register(uint8_t reg) override {
+    if (reg == MCP23017_GPIOA || reg == MCP23017_GPIOB)
+      this->interrupt.pending = false;
+    return I2CSimDevice::read_register(reg);
+  }
+
+  SimInterrupt interrupt;
+};
+
+/// A PCF8575: a transmission writes the port, a request reads the pins (low if the port drives them low).
+class SimPCF8575 : public TwoWireDevice {
+ public:
+  explicit SimPCF8575(uint8_t address) : address_(address) { Wire.devices[address] = this; }
+  ~SimPCF8575() override { Wire.devices[this->address_] = nullptr; }
+  bool on_transmission(const uint8_t *data, size_t len) override {
+    if (len >= 2)
+      this->port = data[0] | (uint16_t(data[1]) << 8);
+    return true;
+  }
+  bool on_request(uint8_t *data, size_t len) override {
+    const uint16_t pins = this->inputs & this->port;
+    for (size_t i = 0; i < len; i++)
+      data[i] = i == 0 ? pins & 0xFF : pins >> 8;
+    this->interrupt.pending = false;
+    return true;
+  }
+  void set_inputs(uint16_t value) {
+    if (value != this->inputs) {
+      this->inputs = value;
+      this->interrupt.pending = true;
+    }
+  }
+
+  uint16_t port{0xFFFF};
+  uint16_t inputs{0xFFFF};
+  SimInterrupt interrupt;
+
+ protected:
+  uint8_t address_;
+};
+
+class TestMCP23017 : public MCP23017 {
+ public:
+  using MCP23017::MCP23017;
+  using MCP23017::input_valid_;
+};
+
+class TestPCF8574 : public PCF8574Component {
+ public:
+  using PCF8574Component::PCF8574Component;
+  using PCF8574Component::input_valid_;
+};
+
+struct BusCount {
+  uint32_t transactions;
+  uint32_t bytes;
+};
+
+template<typename F> static BusCount count(F f) {
+  const uint32_t transactions = Wire.transmissions + Wire.requests;
+  const uint32_t bytes = Wire.bytes;
+  f();
+  return {Wire.transmissions + Wire.requests - transactions, Wire.bytes - bytes};
+}
+
+static void print(const char *name, const BusCount &bus_count) {
+  printf("  %-40s %6u transactions, %7.1f ms bus time per 1000 loops\n", name, bus_count.transactions,
+         bus_count.bytes * 9 / 100.0f);
+}
+
+/// The input levels of the loop, they change INPUT_CHANGES times over LOOPS.
+static uint16_t inputs_at(uint32_t loop) { return 0xF0F0 ^ (loop / (LOOPS / INPUT_CHANGES)) * 0x1111; }
+/// The relay pattern of the loop.
+static uint16_t outputs_at(uint32_t loop) { return (loop * 0x9E37) >> 3; }
+
+/// Read the 16 keys in each loop cycle, returns a checksum of the levels.
+template<typename E, typename S, typename P>
+static uint32_t read_keys(E &expander, S &chip, std::vector<P> &pins, bool cached) {
+  uint32_t sum = 0;
+  for (uint32_t loop = 0; loop < LOOPS; loop++) {
+    chip.set_inputs(inputs_at(loop));
+    expander.loop();
+    for (auto &pin : pins) {
+      if (!cached)
+        expander.input_valid_ = false;
+      sum = sum * 31 + pin.digital_read();
+    }
+  }
+  return sum;
+}
+
+/// Write the 16 relays in each loop cycle.
+template<typename E, typename P> static void write_relays(E &expander, std::vector<P> &pins, bool batch) {
+  for (uint32_t loop = 0; loop < LOOPS; loop++) {
+    if (batch)
+      expander.begin_batch();
+    for (uint8_t i = 0; i < 16; i++)
+      pins[i].digital_write((outputs_at(loop) >> i) & 1);
+    if (batch)
+      expander.commit_batch();
+    expander.loop();
+  }
+}
+
+static void bench_mcp23017() {
+  printf("MCP23017:\n");
+  I2CComponent bus(4, 5);
+  SimMCP23017 chip(0x20);
+  uint32_t sums[3];
+  for (int mode = 0; mode < 3; mode++) {
+    TestMCP23017 expander(&bus, 0x20);
+    if (mode == 2)
+      expander.set_interrupt_pin(SimInterruptPin(&chip.interrupt));
+    expander.setup();
+    std::vector<MCP23017GPIOInputPin> pins;
+    for (uint8_t i = 0; i < 16; i++) {
+      pins.push_back(expander.make_input_pin(i, MCP23017_INPUT_PULLUP));
+      pins.back().setup();
+    }
+    chip.set_inputs(0);
+    const char *names[3] = {"keypad, read per pin", "keypad, cached per loop", "keypad, cached until INT"};
+    print(names[mode], count([&]() { sums[mode] = read_keys(expander, chip, pins, mode != 0); }));
+  }
+  EXPECT(sums[0] == sums[1] && sums[1] == sums[2]);
+
+  uint16_t outputs[2];
+  for (int batch = 0; batch < 2; batch++) {
+    TestMCP23017 expander(&bus, 0x20);
+    expander.setup();
+    std::vector<MCP23017GPIOOutputPin> pins;
+    for (uint8_t i = 0; i < 16; i++) {
+      pins.push_back(expander.make_output_pin(i));
+      pins.back().setup();
+    }
+    print(batch ? "relays, batch" : "relays, write through", count([&]() { write_relays(expander, pins, batch); }));
+    outputs[batch] = chip.outputs();
+  }
+  EXPECT(outputs[0] == outputs_at(LOOPS - 1) && outputs[1] == outputs[0]);
+}
+
+static void bench_pcf8575() {
+  printf("PCF8575:\n");
+  I2CComponent bus(4, 5);
+  SimPCF8575 chip(0x21);
+  uint32_t sums[3];
+  for (int mode = 0; mode < 3; mode++) {
+    TestPCF8574 expander(&bus, 0x21, true);
+    if (mode == 2)
+      expander.set_interrupt_pin(SimInterruptPin(&chip.interrupt));
+    expander.setup();
+    std::vector<PCF8574GPIOInputPin> pins;
+    for (uint8_t i = 0; i < 16; i++) {
+      pins.push_back(expander.make_input_pin(i, PCF8574_INPUT_PULLUP));
+      pins.back().setup();
+    }
+    chip.set_inputs(0);
+    const char *names[3] = {"keypad, read per pin", "keypad, cached per loop", "keypad, cached until INT"};
+    print(names[mode], count([&]() { sums[mode] = read_keys(expander, chip, pins, mode != 0); }));
+  }
+  EXPECT(sums[0] == sums[1] && sums[1] == sums[2]);
+
+  uint16_t outputs[2];
+  for (int batch = 0; batch < 2; batch++) {
+    TestPCF8574 expander(&bus, 0x21, true);
+    expander.setup();
+    std::vector<PCF8574GPIOOutputPin> pins;
+    for (uint8_t i = 0; i < 16; i++) {
+      pins.push_back(expander.make_output_pin(i));
+      pins.back().setup();
+    }
+    print(batch ? "relays, batch" : "relays, write through", count([&]() { write_relays(expander, pins, batch); }));
+    outputs[batch] = chip.port;
+  }
+  EXPECT(outputs[0] == outputs_at(LOOPS - 1) && outputs[1] == outputs[0]);
+}
+
+int main() {
+  bench_mcp23017();
+  bench_pcf8575();
+  return test_result();
+}
@@ -0,0 +1,66 @@
+// Time to match a captured frame against the receivers of remote_captures.h: through the code table (each frame
+// decoded once per protocol) and by letting every receiver parse the frame, like before the table.
+#include "test_helpers.h"
+#include "esphome/remote/remote_receiver.h"
+#include "remote_captures.h"
+
+#include <chrono>
+
+using namespace esphome;
+
+static const uint32_t ITERATIONS = 20000;
+
+class TestReceiverComponent : public RemoteReceiverComponent {
+ public:
+  TestReceiverComponent() : RemoteReceiverComponent(new GPIOPin(14, INPUT)) {}
+
+  using RemoteReceiverComponent::process_;
+};
+
+template<typename F> static double us_per_call(F f) {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / ITERATIONS;
+}
+
+int main() {
+  TestReceiverComponent component;
+  const auto receivers = make_remote_receivers();
+  for (auto *receiver : receivers)
+    component.add_decoder(receiver);
+  uint32_t table_fired = 0, parse_fired = 0;
+  for (auto *receiver : receivers) {
+    receiver->add_on_state_callback([&table_fired](bool state) {
+      if (state)
+        table_fired++;
+    });
+  }
+  const auto reference = make_remote_receivers();
+  for (auto *receiver : reference) {
+    receiver->add_on_state_callback([&parse_fired](bool state) {
+      if (state)
+        parse_fired++;
+    });
+  }
+  printf("  %zu receivers\n", receivers.size());
+
+  for (const auto &capture : REMOTE_CAPTURES) {
+    std::vector<int32_t> frame(capture.data, capture.data + capture.size);
+    RemoteReceiveData data(&component, &frame);
+    const double table = us_per_call([&component, &data]() {
+      for (uint32_t i = 0; i < ITERATIONS; i++)
+        component.process_(&data);
+    });
+    const double parse = us_per_call([&reference, &data]() {
+      for (uint32_t i = 0; i < ITERATIONS; i++) {
+        for (auto *receiver : reference)
+          receiver->process(&data);
+      }
+    });
+    printf("  %-18s code table %6.2f us, every receiver %6.2f us\n", capture.name, table, parse);
+  }
+  // Both trigger the same receivers.
+  EXPECT(table_fired == parse_fired);
+  return test_result();
+}
@@ -0,0 +1,131 @@
+// Simulation of the ESP8266 GPIO registers for the host tests (x86-64 Linux only).
+//
+// The code under test writes the registers through pointers (FastGPIOPin keeps &GPOS etc.), so the writes can't
+// be intercepted in C++. Instead the register page is protected: each access faults, the handler allows it and
+// single-steps the instruction, then applies what the hardware does with the written value and protects the
+// page again. Writes to the set/clear registers change GPO and GPE, and each change of an output level is
+// recorded with the time of the simulated clock.
+#ifndef ESPHOME_TEST_GPIO_SIM_H
+#define ESPHOME_TEST_GPIO_SIM_H
+
+#if !defined(__x86_64__) || !defined(__linux__)
+#error "The GPIO simulation needs x86-64 Linux"
+#endif
+
+#include <csignal>
+#include <cstdint>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <vector>
+#include "Arduino.h"
+
+static const uint32_t GPIO_SIM_PAGE_SIZE = 4096;
+
+/// A change of an output level, pin 16 is GPIO16.
+struct GPIOSimEvent {
+  uint8_t pin;
+  bool level;
+  uint32_t time_us;
+};
+
+static std::vector<GPIOSimEvent> gpio_sim_events;
+static volatile uint32_t *gpio_sim_access = nullptr;
+static uint32_t gpio_sim_previous = 0;
+
+static inline uint32_t &gpio_sim_reg(uint32_t address) {
+  return const_cast<uint32_t &>(esp8266_test_registers[address / 4]);
+}
+static inline void gpio_sim_protect(bool protect) {
+  mprotect(const_cast<uint32_t *>(esp8266_test_registers), GPIO_SIM_PAGE_SIZE,
+           protect ? PROT_NONE : PROT_READ | PROT_WRITE);
+}
+static inline void gpio_sim_set_outputs(uint32_t outputs) {
+  const uint32_t changed = outputs ^ gpio_sim_reg(0x300);
+  for (uint8_t pin = 0; pin < 16; pin++) {
+    if (changed & (1UL << pin))
+      gpio_sim_events.push_back(GPIOSimEvent{pin, bool(outputs & (1UL << pin)), test_time_us});
+  }
+  gpio_sim_reg(0x300) = outputs;
+}
+
+/// Apply the access that just completed, the page is accessible.
+static inline void gpio_sim_apply() {
+  const uint32_t address = (gpio_sim_access - esp8266_test_registers) * 4;
+  const uint32_t value = *gpio_sim_access;
+  switch (address) {
+    case 0x304:  // GPOS
+      gpio_sim_set_outputs(gpio_sim_reg(0x300) | value);
+      break;
+    case 0x308:  // GPOC
+      gpio_sim_set_outputs(gpio_sim_reg(0x300) & ~value);
+      break;
+    case 0x300:  // GPO
+      // Plain writes of GPO, the new value is already in place.
+      if (value != gpio_sim_previous) {
+        gpio_sim_reg(0x300) = gpio_sim_previous;
+        gpio_sim_set_outputs(value);
+      }
+      break;
+    case 0x310:  // GPES
+      gpio_sim_reg(0x30C) |= value;
+      break;
+    case 0x314:  // GPEC
+      gpio_sim_reg(0x30C) &= ~value;
+      break;
+    case 0x768:  // GP16O
+      if ((value ^ gpio_sim_previous) & 1)
+        gpio_sim_events.push_back(GPIOSimEvent{16, bool(value & 1), test_time_us});
+      break;
+    default:
+      break;
+  }
+}
+
+static inline void gpio_sim_on_segv(int, siginfo_t *info, void *context) {
+  auto *address = reinterpret_cast<volatile uint32_t *>(reinterpret_cast<uintptr_t>(info->si_addr) & ~uintptr_t(3));
+  if (address < esp8266_test_registers || address >= esp8266_test_registers + GPIO_SIM_PAGE_SIZE / 4) {
+    // A real crash.
+    signal(SIGSEGV, SIG_DFL);
+    return;
+  }
+  gpio_sim_access = address;
+  gpio_sim_protect(false);
+  gpio_sim_previous = *address;
+  // Trap after the faulting instruction.
+  static_cast<ucontext_t *>(context)->uc_mcontext.gregs[REG_EFL] |= 0x100;
+}
+static inline void gpio_sim_on_trap(int, siginfo_t *, void *context) {
+  gpio_sim_apply();
+  gpio_sim_protect(true);
+  static_cast<ucontext_t *>(context)->uc_mcontext.gregs[REG_EFL] &= ~0x100;
+}
+
+/// Map a cleared register block and start simulating it.
+static inline void gpio_sim_begin() {
+  void *page = mmap(nullptr, GPIO_SIM_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  esp8266_test_registers = static_cast<volatile uint32_t *>(page);
+  struct sigaction action = {};
+  action.sa_flags = SA_SIGINFO;
+  action.sa_sigaction = gpio_sim_on_segv;
+  sigaction(SIGSEGV, &action, nullptr);
+  action.sa_sigaction = gpio_sim_on_trap;
+  sigaction(SIGTRAP, &action, nullptr);
+  gpio_sim_events.reserve(1 << 16);
+  gpio_sim_protect(true);
+}
+
+/// Read a register without going through the simulation.
+static inline uint32_t gpio_sim_peek(uint32_t address) {
+  gpio_sim_protect(false);
+  const uint32_t value = gpio_sim_reg(address);
+  gpio_sim_protect(true);
+  return value;
+}
+/// Set a register (for example the inputs in GPI) without going through the simulation.
+static inline void gpio_sim_poke(uint32_t address, uint32_t value) {
+  gpio_sim_protect(false);
+  gpio_sim_reg(address) = value;
+  gpio_sim_protect(true);
+}
+
+#endif  // ESPHOME_TEST_GPIO_SIM_H
@@ -0,0 +1,81 @@
+// Simulated i2c devices for the host tests, attached to the simulated bus of the TwoWire stub (stubs/Wire.h).
+//
+// I2CSimDevice is a register file with an auto-incrementing register pointer, which is how most i2c sensors and
+// expanders work: a transmission sets the pointer with its first byte and writes the rest, a request reads from
+// the pointer on. Every bus operation is recorded with the time of the simulated clock.
+#ifndef ESPHOME_TEST_I2C_SIM_H
+#define ESPHOME_TEST_I2C_SIM_H
+
+#include <vector>
+#include "Arduino.h"
+#include "Wire.h"
+
+/// A transmission to or a request from a device.
+struct I2CSimEvent {
+  uint8_t address;
+  bool read;
+  /// The register pointer at the start of the operation.
+  uint8_t reg;
+  /// The number of data bytes, without the register pointer of a transmission.
+  size_t len;
+  uint32_t time_us;
+};
+
+/// The operations of all simulated devices in order.
+static std::vector<I2CSimEvent> i2c_sim_events;
+
+class I2CSimDevice : public TwoWireDevice {
+ public:
+  explicit I2CSimDevice(uint8_t address) : address_(address) { Wire.devices[address] = this; }
+  ~I2CSimDevice() override {
+    if (Wire.devices[this->address_] == this)
+      Wire.devices[this->address_] = nullptr;
+  }
+
+  bool on_transmission(const uint8_t *data, size_t len) override {
+    if (len == 0)
+      // An address probe.
+      return !this->nack_address;
+    this->pointer_ = data[0];
+    i2c_sim_events.push_back({this->address_, false, this->pointer_, len - 1, test_time_us});
+    if (this->nack_address || this->nack_data)
+      return false;
+    for (size_t i = 1; i < len; i++)
+      this->write_register(this->pointer_++, data[i]);
+    return true;
+  }
+  bool on_request(uint8_t *data, size_t len) override {
+    i2c_sim_events.push_back({this->address_, true, this->pointer_, len, test_time_us});
+    if (this->nack_address)
+      return false;
+    for (size_t i = 0; i < len; i++)
+      data[i] = this->read_register(this->pointer_++);
+    return true;
+  }
+
+  /// A write of the master, stores the value by default.
+  virtual void write_register(uint8_t reg, uint8_t value) { this->registers[reg] = value; }
+  /// A read of the master, returns the stored value by default.
+  virtual uint8_t read_register(uint8_t reg) { return this->registers[reg]; }
+
+  uint8_t registers[256] = {};
+  /// NACK the address (a missing or hung device) or the data bytes of transmissions.
+  bool nack_address{false};
+  bool nack_data{false};
+
+ protected:
+  uint8_t address_;
+  uint8_t pointer_{0};
+};
+
+/// The operations on one address.
+static inline std::vector<I2CSimEvent> i2c_sim_events_for(uint8_t address) {
+  std::vector<I2CSimEvent> events;
+  for (const auto &event : i2c_sim_events) {
+    if (event.address == address)
+      events.push_back(event);
+  }
+  return events;
+}
+
+#endif  // ESPHOME_TEST_I2C_SIM_H
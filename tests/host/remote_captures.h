@@ -0,0 +1,157 @@
+// Raw timing captures of common remotes as a receiver reports them: IR demodulators stretch marks and shorten
+// spaces by about 60us, every level is off by up to 4% and rounded to 4us. Together with a configuration of
+// receivers for them and many codes that are never sent, as in a setup with dozens of buttons. RC5 is missing,
+// its decoder expects the two half bits of the same level as separate levels, which a receiver never reports. Used by
+// test_remote_replay and bench_remote_replay.
+#ifndef ESPHOME_TEST_REMOTE_CAPTURES_H
+#define ESPHOME_TEST_REMOTE_CAPTURES_H
+
+#include "esphome/remote/jvc.h"
+#include "esphome/remote/lg.h"
+#include "esphome/remote/nec.h"
+#include "esphome/remote/panasonic.h"
+#include "esphome/remote/raw.h"
+#include "esphome/remote/rc_switch.h"
+#include "esphome/remote/samsung.h"
+#include "esphome/remote/sony.h"
+
+#include <string>
+#include <vector>
+
+using namespace esphome::remote;
+
+// NEC_TV_POWER
+static const int32_t NEC_TV_POWER[] = {
+    9268, -4440, 620, -484, 636, -1588, 632, -484, 616, -504, 640, -492, 628, -516, 600, -512, 596, -500, 616, -480,
+    616, -488, 600, -496, 608, -480, 628, -500, 608, -1588, 632, -484, 616, -508, 628, -480, 596, -504, 632, -512,
+    632, -1572, 624, -520, 612, -512, 600, -504, 604, -508, 640, -484, 604, -520, 604, -520, 624, -480, 604, -1684,
+    604, -1576, 632, -492, 636, -1688, 600, -10000};
+// NEC_TV_VOLUME_UP
+static const int32_t NEC_TV_VOLUME_UP[] = {
+    9068, -4284, 604, -504, 628, -1620, 600, -492, 640, -504, 628, -492, 616, -512, 624, -492, 604, -496, 640, -488,
+    620, -520, 620, -476, 632, -500, 628, -516, 636, -1668, 612, -500, 632, -504, 624, -516, 600, -504, 600, -512,
+    624, -504, 624, -488, 640, -1608, 636, -484, 624, -504, 632, -500, 620, -492, 624, -500, 600, -484, 636, -496,
+    628, -1696, 608, -516, 600, -1572, 604, -10000};
+// NEC_LED_STRIP_RED
+static const int32_t NEC_LED_STRIP_RED[] = {
+    9268, -4544, 612, -484, 616, -500, 600, -504, 612, -480, 616, -524, 600, -504, 600, -504, 624, -520, 624, -1664,
+    628, -1632, 620, -1632, 604, -1608, 632, -1576, 640, -1580, 632, -1664, 616, -1592, 628, -1640, 620, -1672, 600,
+    -1664, 640, -520, 628, -516, 636, -508, 612, -520, 628, -492, 616, -480, 620, -496, 640, -512, 640, -1652, 604,
+    -1616, 608, -1608, 604, -1696, 608, -1612, 624, -10000};
+// LG_POWER
+static const int32_t LG_POWER[] = {
+    7772, -3968, 648, -1564, 664, -512, 648, -472, 644, -492, 672, -1588, 664, -492, 660, -476, 660, -472, 648,
+    -1596, 680, -1560, 668, -476, 648, -480, 640, -496, 676, -496, 660, -484, 668, -472, 640, -492, 680, -492, 644,
+    -512, 652, -484, 672, -504, 648, -1524, 652, -508, 680, -1580, 668, -476, 672, -508, 676, -508, 644, -1548, 636,
+    -10000};
+// SAMSUNG_POWER
+static const int32_t SAMSUNG_POWER[] = {
+    4596, -4356, 600, -1696, 620, -1632, 628, -1672, 640, -500, 640, -480, 624, -492, 616, -492, 632, -512, 628,
+    -1608, 636, -1672, 620, -1568, 616, -516, 604, -520, 604, -480, 636, -520, 604, -492, 640, -516, 612, -1636,
+    620, -520, 624, -508, 620, -480, 604, -496, 608, -484, 632, -500, 612, -1564, 612, -484, 616, -1564, 628, -1620,
+    616, -1596, 604, -1564, 624, -1672, 644, -1608, 600, -10000};
+// SONY_POWER_12
+static const int32_t SONY_POWER_12[] = {
+    2536, -556, 1232, -560, 656, -548, 1244, -544, 668, -552, 1252, -528, 664, -560, 652, -544, 1216, -560, 648,
+    -544, 644, -532, 644, -560, 640, -10000};
+// SONY_MUTE_15
+static const int32_t SONY_MUTE_15[] = {
+    2488, -528, 660, -552, 652, -540, 1304, -564, 680, -540, 1300, -528, 644, -520, 676, -552, 680, -544, 644, -536,
+    668, -536, 664, -532, 1232, -520, 1280, -520, 680, -544, 660, -10000};
+// PANASONIC_POWER
+static const int32_t PANASONIC_POWER[] = {
+    3440, -1628, 572, -344, 560, -1216, 560, -352, 576, -332, 568, -352, 548, -340, 580, -324, 552, -348, 556, -336,
+    576, -348, 548, -328, 564, -328, 560, -340, 560, -1196, 572, -352, 544, -328, 572, -340, 572, -344, 564, -352,
+    564, -344, 548, -336, 548, -356, 572, -332, 576, -1204, 564, -340, 572, -340, 580, -348, 560, -348, 552, -340,
+    556, -348, 568, -328, 552, -332, 564, -1160, 548, -356, 544, -1156, 580, -1184, 552, -1144, 556, -1168, 552,
+    -336, 552, -328, 572, -1156, 564, -328, 544, -1212, 560, -1140, 576, -1224, 564, -1192, 552, -352, 572, -1144,
+    572, -10000};
+// JVC_POWER
+static const int32_t JVC_POWER[] = {
+    8544, -4032, 564, -1704, 588, -1652, 568, -452, 592, -476, 568, -456, 584, -1612, 564, -456, 576, -1616, 600,
+    -1668, 576, -1600, 564, -1620, 580, -444, 592, -1632, 596, -480, 568, -484, 592, -448, 572, -10000};
+// RC_SWITCH_P1
+static const int32_t RC_SWITCH_P1[] = {
+    352, -1080, 360, -1028, 356, -1092, 1016, -360, 344, -1016, 1036, -348, 340, -1024, 356, -1012, 360, -1036,
+    1044, -360, 340, -1064, 1060, -360, 344, -1064, 1052, -356, 344, -1016, 1072, -356, 340, -1016, 1080, -348, 340,
+    -1076, 1060, -352, 356, -1060, 364, -1092, 360, -1064, 1020, -364, 352, -10000};
+// RC_SWITCH_P2
+static const int32_t RC_SWITCH_P2[] = {
+    628, -1272, 660, -1284, 632, -1308, 1268, -664, 632, -1260, 1268, -636, 652, -1308, 648, -1352, 644, -1320,
+    1292, -652, 652, -1336, 1344, -656, 632, -1280, 1296, -668, 660, -1312, 1336, -660, 668, -1304, 1336, -676, 664,
+    -1324, 1328, -652, 656, -1284, 660, -1308, 640, -1308, 1280, -640, 632, -10000};
+// RC_SWITCH_TYPE_A
+static const int32_t RC_SWITCH_TYPE_A[] = {
+    348, -1028, 348, -1060, 360, -1036, 1080, -356, 352, -1012, 1020, -352, 336, -1068, 344, -1048, 340, -1060,
+    1024, -356, 352, -1084, 1036, -352, 360, -1064, 1052, -344, 348, -1024, 360, -1080, 340, -1040, 364, -1056, 336,
+    -1092, 1016, -364, 348, -10000};
+
+struct RemoteCapture {
+  const char *name;
+  const int32_t *data;
+  size_t size;
+  /// The name of the receiver configured for the code.
+  const char *receiver;
+};
+#define REMOTE_CAPTURE(data, receiver) \
+  RemoteCapture { #data, data, sizeof(data) / sizeof(data[0]), receiver }
+
+static const RemoteCapture REMOTE_CAPTURES[] = {
+    REMOTE_CAPTURE(NEC_TV_POWER, "nec_tv_power"),
+    REMOTE_CAPTURE(NEC_TV_VOLUME_UP, "nec_tv_volume_up"),
+    REMOTE_CAPTURE(NEC_LED_STRIP_RED, "nec_led_strip_red"),
+    REMOTE_CAPTURE(LG_POWER, "lg_power"),
+    REMOTE_CAPTURE(SAMSUNG_POWER, "samsung_power"),
+    REMOTE_CAPTURE(SONY_POWER_12, "sony_power_12"),
+    REMOTE_CAPTURE(SONY_MUTE_15, "sony_mute_15"),
+    REMOTE_CAPTURE(PANASONIC_POWER, "panasonic_power"),
+    REMOTE_CAPTURE(JVC_POWER, "jvc_power"),
+    REMOTE_CAPTURE(RC_SWITCH_P1, "rc_switch_p1"),
+    REMOTE_CAPTURE(RC_SWITCH_P2, "rc_switch_p2"),
+    REMOTE_CAPTURE(RC_SWITCH_TYPE_A, "rc_switch_type_a"),
+};
+
+/// The header and the first address byte of the NEC TV remote, a receiver that can only be matched by parsing the
+/// frame.
+static const int32_t NEC_TV_ADDRESS[] = {9000, -4500, 560, -560, 560, -1690, 560, -560, 560, -560,
+                                         560,  -560,  560, -560, 560, -560, 560, -560};
+/// The same for another address.
+static const int32_t NEC_OTHER_ADDRESS[] = {9000, -4500, 560, -1690, 560, -560, 560, -1690, 560, -560,
+                                            560,  -560,  560, -560,  560, -560, 560, -560};
+
+/// Create the receivers for the captured codes, and decoys with codes that are close but never sent (the same
+/// protocol with another command, another number of bits or other timings).
+static std::vector<RemoteReceiver *> make_remote_receivers() {
+  std::vector<RemoteReceiver *> receivers = {
+      new NECReceiver("nec_tv_power", 0x4004, 0x100D),
+      new NECReceiver("nec_tv_volume_up", 0x4004, 0x0405),
+      new NECReceiver("nec_led_strip_red", 0x00FF, 0xE01F),
+      new LGReceiver("lg_power", 0x88C0051, 28),
+      new LGReceiver("decoy_lg_32", 0x88C0051, 32),
+      new SamsungReceiver("samsung_power", 0xE0E040BF),
+      new SamsungReceiver("decoy_samsung", 0xE0E0D02F),
+      new SonyReceiver("sony_power_12", 0xA90, 12),
+      new SonyReceiver("decoy_sony_15", 0xA90, 15),
+      new SonyReceiver("sony_mute_15", 0x140C, 15),
+      new PanasonicReceiver("panasonic_power", 0x4004, 0x0100BCBD),
+      new PanasonicReceiver("decoy_panasonic", 0x4004, 0x01000405),
+      new JVCReceiver("jvc_power", 0xC5E8),
+      new JVCReceiver("decoy_jvc", 0xC5E9),
+      new RCSwitchRawReceiver("rc_switch_p1", rc_switch_protocols[1], 0x145551, 24),
+      new RCSwitchRawReceiver("rc_switch_p2", rc_switch_protocols[2], 0x145551, 24),
+      new RCSwitchRawReceiver("decoy_rc_switch", rc_switch_protocols[1], 0x145554, 24),
+      new RCSwitchTypeAReceiver("rc_switch_type_a", rc_switch_protocols[1], 0b11001, 0b01000, true),
+      new RCSwitchTypeAReceiver("decoy_rc_switch_type_a", rc_switch_protocols[1], 0b11001, 0b01000, false),
+      new RawReceiver("nec_tv_address", NEC_TV_ADDRESS, sizeof(NEC_TV_ADDRESS) / sizeof(NEC_TV_ADDRESS[0])),
+      new RawReceiver("decoy_raw", NEC_OTHER_ADDRESS, sizeof(NEC_OTHER_ADDRESS) / sizeof(NEC_OTHER_ADDRESS[0])),
+  };
+  // The other buttons of the TV remote.
+  for (uint16_t i = 0; i < 24; i++)
+    receivers.push_back(new NECReceiver("decoy_nec_" + std::to_string(i), 0x4004, i * 0x0101));
+  return receivers;
+}
+
+/// The protocols (and RC Switch timings) of the receivers above that are matched through the code table.
+static const size_t REMOTE_CAPTURE_CLASSIFIERS = 8;
+
+#endif  // ESPHOME_TEST_REMOTE_CAPTURES_H
@@ -0,0 +1,84 @@
+// Minimal stand-in for the ESP8266 Arduino core, enough to compile the code under test on the host.
+// Functions are defined in stubs.cpp; the GPIO registers point to a simulated register block, see gpio_sim.h.
+#ifndef ESPHOME_TEST_ARDUINO_H
+#define ESPHOME_TEST_ARDUINO_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include "WString.h"
+
+#define ICACHE_RAM_ATTR
+#define PROGMEM
+#define F(x) x
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x00
+#define INPUT_PULLUP 0x02
+#define INPUT_PULLDOWN_16 0x04
+#define OUTPUT 0x01
+#define OUTPUT_OPEN_DRAIN 0x03
+#define WAKEUP_PULLUP 0x05
+#define WAKEUP_PULLDOWN 0x07
+#define SPECIAL 0xF8
+#define FUNCTION_0 0x08
+#define FUNCTION_1 0x18
+#define FUNCTION_2 0x28
+#define FUNCTION_3 0x38
+#define FUNCTION_4 0x48
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+#define PI 3.1415926535897932384626433832795
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+uint32_t micros();
+uint32_t millis();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void attachInterruptArg(uint8_t pin, void (*)(void *), void *arg, int mode);
+void detachInterrupt(uint8_t pin);
+uint8_t digitalPinToInterrupt(uint8_t pin);
+
+/// The simulated clock in microseconds. Tests advance it, delay() and delayMicroseconds() do too.
+extern uint32_t test_time_us;
+
+/// The simulated CPU cycle counter, tests advance it.
+extern uint32_t test_cycle_count;
+#define F_CPU 80000000L
+class EspClass {
+ public:
+  uint32_t getCycleCount() { return test_cycle_count; }
+};
+extern EspClass ESP;
+
+#define interrupts()
+#define noInterrupts()
+
+/// The simulated register block, see gpio_sim.h.
+extern volatile uint32_t *esp8266_test_registers;
+#define ESP8266_REG(addr) esp8266_test_registers[(addr) / 4]
+#define GPO ESP8266_REG(0x300)
+#define GPOS ESP8266_REG(0x304)
+#define GPOC ESP8266_REG(0x308)
+#define GPE ESP8266_REG(0x30C)
+#define GPES ESP8266_REG(0x310)
+#define GPEC ESP8266_REG(0x314)
+#define GPI ESP8266_REG(0x318)
+#define GP16O ESP8266_REG(0x768)
+#define GP16E ESP8266_REG(0x774)
+#define GP16I ESP8266_REG(0x78C)
+#define GPIO_STATUS_W1TC_ADDRESS 0x24
+#define GPIO_REG_WRITE(addr, val) (void) (val)
+
+#endif  // ESPHOME_TEST_ARDUINO_H
@@ -0,0 +1,23 @@
+// Declarations of the ArduinoJson types helpers.h refers to. The host tests don't serialize JSON, so nothing is
+// implemented.
+#ifndef ESPHOME_TEST_ARDUINOJSON_H
+#define ESPHOME_TEST_ARDUINOJSON_H
+
+#include <cstddef>
+
+namespace ArduinoJson {
+class JsonObject;
+class JsonArray;
+class JsonVariant;
+class JsonBuffer {
+ public:
+  virtual void *alloc(size_t bytes) = 0;
+};
+namespace Internals {
+template<typename T> class JsonBufferBase : public JsonBuffer {};
+}  // namespace Internals
+}  // namespace ArduinoJson
+
+using namespace ArduinoJson;
+
+#endif  // ESPHOME_TEST_ARDUINOJSON_H
@@ -0,0 +1,64 @@
+// Minimal stand-in for HardwareSerial and the Stream interface of the Arduino core. The hardware UARTs receive
+// the bytes a test queues in rx and record what is written in tx.
+#ifndef ESPHOME_TEST_HARDWARE_SERIAL_H
+#define ESPHOME_TEST_HARDWARE_SERIAL_H
+
+#include <deque>
+#include <vector>
+#include "Arduino.h"
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t data) = 0;
+  virtual size_t write(const uint8_t *data, size_t len) {
+    size_t n = 0;
+    while (len--)
+      n += this->write(*data++);
+    return n;
+  }
+  size_t write(const char *str) { return this->write(reinterpret_cast<const uint8_t *>(str), strlen(str)); }
+  virtual void flush() {}
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  size_t readBytes(uint8_t *data, size_t len) {
+    size_t n = 0;
+    for (int c; n < len && (c = this->read()) >= 0; n++)
+      data[n] = c;
+    return n;
+  }
+};
+
+class HardwareSerial : public Stream {
+ public:
+  explicit HardwareSerial(int uart_nr) {}
+  void begin(unsigned long baud) {}
+  void swap() {}
+  int available() override { return this->rx.size(); }
+  int read() override {
+    if (this->rx.empty())
+      return -1;
+    const uint8_t data = this->rx.front();
+    this->rx.pop_front();
+    return data;
+  }
+  int peek() override { return this->rx.empty() ? -1 : this->rx.front(); }
+  size_t write(uint8_t data) override {
+    this->tx.push_back(data);
+    return 1;
+  }
+  using Print::write;
+
+  std::deque<uint8_t> rx;
+  std::vector<uint8_t> tx;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+
+#endif  // ESPHOME_TEST_HARDWARE_SERIAL_H
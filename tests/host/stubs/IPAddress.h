@@ -0,0 +1,20 @@
+// Stand-in for the IPAddress class of the Arduino core, only the parts helpers.h needs.
+#ifndef ESPHOME_TEST_IPADDRESS_H
+#define ESPHOME_TEST_IPADDRESS_H
+
+#include <cstdint>
+#include "WString.h"
+
+class IPAddress {
+ public:
+  IPAddress() = default;
+  IPAddress(uint32_t address) : address_(address) {}  // NOLINT
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : address_(a | (b << 8) | (c << 16) | (uint32_t(d) << 24)) {}
+  operator uint32_t() const { return this->address_; }
+  String toString() const { return String(); }
+
+ protected:
+  uint32_t address_{0};
+};
+
+#endif  // ESPHOME_TEST_IPADDRESS_H
@@ -0,0 +1,14 @@
+#ifndef ESPHOME_TEST_WSTRING_H
+#define ESPHOME_TEST_WSTRING_H
+
+#include <string>
+
+class String : public std::string {
+ public:
+  String() {}
+  String(const char *s) : std::string(s) {}         // NOLINT
+  String(const std::string &s) : std::string(s) {}  // NOLINT
+};
+class __FlashStringHelper;
+
+#endif  // ESPHOME_TEST_WSTRING_H
@@ -0,0 +1,76 @@
+// Minimal stand-in for the TwoWire class of the Arduino core. The bus is simulated: each transmission and request
+// goes to the device a test attached to the address (see i2c_sim.h), and the bus operations are counted.
+#ifndef ESPHOME_TEST_WIRE_H
+#define ESPHOME_TEST_WIRE_H
+
+#include <vector>
+#include "Arduino.h"
+
+/// A device on the simulated bus.
+class TwoWireDevice {
+ public:
+  virtual ~TwoWireDevice() {}
+  /// The bytes of one transmission to the device, return false to NACK them.
+  virtual bool on_transmission(const uint8_t *data, size_t len) = 0;
+  /// Fill the bytes of a request from the device, return false to NACK the address.
+  virtual bool on_request(uint8_t *data, size_t len) = 0;
+};
+
+class TwoWire {
+ public:
+  TwoWire() {}
+  explicit TwoWire(uint8_t bus_num) {}
+  void begin(int sda, int scl) {}
+  void setClock(uint32_t frequency) {}
+  void beginTransmission(uint8_t address) {
+    this->address_ = address;
+    this->tx_.clear();
+  }
+  size_t write(uint8_t data) {
+    this->tx_.push_back(data);
+    return 1;
+  }
+  /// Like the ESP8266 core: 0 on success, 2 for a NACK of the address, 3 for a NACK of the data.
+  uint8_t endTransmission() {
+    this->transmissions++;
+    this->bytes += 1 + this->tx_.size();
+    TwoWireDevice *device = this->devices[this->address_ & 0x7F];
+    if (device == nullptr)
+      return 2;
+    return device->on_transmission(this->tx_.data(), this->tx_.size()) ? 0 : 3;
+  }
+  /// The number of bytes received, 0 if the address wasn't acknowledged.
+  uint8_t requestFrom(uint8_t address, uint8_t len) {
+    this->requests++;
+    this->rx_.assign(len, 0xFF);
+    this->rx_index_ = 0;
+    TwoWireDevice *device = this->devices[address & 0x7F];
+    if (device == nullptr || !device->on_request(this->rx_.data(), len)) {
+      this->rx_.clear();
+      this->bytes++;
+      return 0;
+    }
+    this->bytes += 1 + len;
+    return len;
+  }
+  int available() { return this->rx_.size() - this->rx_index_; }
+  int read() { return this->rx_index_ < this->rx_.size() ? this->rx_[this->rx_index_++] : -1; }
+
+  /// The devices on the bus by address.
+  TwoWireDevice *devices[128] = {};
+  /// The number of transmissions (endTransmission) and requests (requestFrom) on the bus.
+  uint32_t transmissions{0};
+  uint32_t requests{0};
+  /// The number of bytes on the bus including the address bytes, 9 clocks each.
+  uint32_t bytes{0};
+
+ protected:
+  uint8_t address_{0};
+  std::vector<uint8_t> tx_;
+  std::vector<uint8_t> rx_;
+  size_t rx_index_{0};
+};
+
+extern TwoWire Wire;
+
+#endif  // ESPHOME_TEST_WIRE_H
@@ -0,0 +1 @@
+// The host tests don't need the core version.
@@ -0,0 +1,160 @@
+// Definitions for the parts of the Arduino core and esphome the host tests link against.
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include "Arduino.h"
+#include "HardwareSerial.h"
+#include "Wire.h"
+#include "esphome/helpers.h"
+
+int esp_log_printf_(int level, const char *tag, const char *format, ...) {  // NOLINT
+  if (getenv("ESPHOME_TEST_LOG") == nullptr)
+    return 0;
+  va_list arg;
+  va_start(arg, format);
+  int ret = vfprintf(stderr, format, arg);
+  va_end(arg);
+  fputc('\n', stderr);
+  return ret;
+}
+volatile uint32_t *esp8266_test_registers = nullptr;
+
+uint32_t test_time_us = 0;
+uint32_t micros() { return test_time_us; }
+uint32_t millis() { return test_time_us / 1000; }
+void delay(uint32_t ms) { test_time_us += ms * 1000; }
+void delayMicroseconds(uint32_t us) { test_time_us += us; }
+void yield() {}
+uint32_t test_cycle_count = 0;
+EspClass ESP;
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+TwoWire Wire;
+void pinMode(uint8_t pin, uint8_t mode) {}
+extern "C" void __attachInterruptArg(uint8_t pin, void (*)(void *), void *arg, int mode) {}  // NOLINT
+
+ESPHOME_NAMESPACE_BEGIN
+
+// helpers.cpp needs the WiFi stack, these are the helpers the code under test uses.
+const char *HOSTNAME_CHARACTER_WHITELIST = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-_";
+std::string to_lowercase_underscore(std::string s) {
+  for (auto &c : s) {
+    c = tolower(c);
+    if (c == ' ')
+      c = '_';
+  }
+  return s;
+}
+std::string sanitize_string_whitelist(const std::string &s, const std::string &whitelist) {
+  std::string out(s);
+  for (auto &c : out) {
+    if (whitelist.find(c) == std::string::npos)
+      c = '_';
+  }
+  return out;
+}
+uint32_t fnv1_hash(const std::string &str) {
+  uint32_t hash = 2166136261UL;
+  for (char c : str) {
+    hash *= 16777619UL;
+    hash ^= c;
+  }
+  return hash;
+}
+uint32_t random_uint32() { return rand(); }
+void feed_wdt() {}
+std::string uint64_to_string(uint64_t num) {
+  char buffer[17];
+  auto *address16 = reinterpret_cast<uint16_t *>(&num);
+  snprintf(buffer, sizeof(buffer), "%04X%04X%04X%04X", address16[3], address16[2], address16[1], address16[0]);
+  return std::string(buffer);
+}
+ExponentialMovingAverage::ExponentialMovingAverage(float alpha) : alpha_(alpha), accumulator_(0) {}
+
+float ExponentialMovingAverage::get_alpha() const { return this->alpha_; }
+
+void ExponentialMovingAverage::set_alpha(float alpha) { this->alpha_ = alpha; }
+
+float ExponentialMovingAverage::calculate_average() { return this->accumulator_; }
+
+float ExponentialMovingAverage::next_value(float value) {
+  if (std::isnan(value)) {
+    return this->calculate_average();
+  }
+
+  if (this->first_value_) {
+    this->accumulator_ = value;
+  } else {
+    this->accumulator_ = (this->alpha_ * value) + (1.0f - this->alpha_) * this->accumulator_;
+  }
+  this->first_value_ = false;
+  return this->calculate_average();
+}
+
+SlidingWindowMovingAverage::SlidingWindowMovingAverage(size_t max_size) : max_size_(max_size), sum_(0) {}
+
+float SlidingWindowMovingAverage::next_value(float value) {
+  if (std::isnan(value))
+    return this->calculate_average();
+  if (this->queue_.size() == this->max_size_) {
+    this->sum_ -= this->queue_.front();
+    this->queue_.pop();
+  }
+  this->queue_.push(value);
+  this->sum_ += value;
+
+  return this->calculate_average();
+}
+
+float SlidingWindowMovingAverage::calculate_average() {
+  if (this->queue_.empty())
+    return 0;
+  else
+    return this->sum_ / this->queue_.size();
+}
+
+size_t SlidingWindowMovingAverage::get_max_size() const { return this->max_size_; }
+
+void SlidingWindowMovingAverage::set_max_size(size_t max_size) {
+  this->max_size_ = max_size;
+
+  while (this->queue_.size() > max_size) {
+    this->sum_ -= this->queue_.front();
+    this->queue_.pop();
+  }
+}
+uint8_t crc8(uint8_t *data, uint8_t len) {
+  uint8_t crc = 0;
+
+  while ((len--) != 0u) {
+    uint8_t inbyte = *data++;
+    for (uint8_t i = 8; i != 0u; i--) {
+      bool mix = (crc ^ inbyte) & 0x01;
+      crc >>= 1;
+      if (mix)
+        crc ^= 0x8C;
+      inbyte >>= 1;
+    }
+  }
+  return crc;
+}
+void add_shutdown_hook(std::function<void(const char *)> &&f) {}
+static int high_freq_num_requests = 0;
+void HighFrequencyLoopRequester::start() {
+  if (this->started_)
+    return;
+  high_freq_num_requests++;
+  this->started_ = true;
+}
+void HighFrequencyLoopRequester::stop() {
+  if (!this->started_)
+    return;
+  high_freq_num_requests--;
+  this->started_ = false;
+}
+bool HighFrequencyLoopRequester::is_high_frequency() { return high_freq_num_requests > 0; }
+void disable_interrupts() {}
+void enable_interrupts() {}
+
+ESPHOME_NAMESPACE_END
@@ -0,0 +1,211 @@
+// Scripts triggered at a high rate: every run has to be tracked until it ends (also when an action drops it),
+// and once the pending run slots of the delay and wait_until actions are warmed up, nothing is allocated anymore.
+#include "test_helpers.h"
+#include "esphome/automation.cpp"
+
+#include <cstdlib>
+#include <new>
+
+using namespace esphome;
+
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  void *ptr = malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+// Not inlined, otherwise GCC warns about free() on a pointer from operator new.
+__attribute__((noinline)) void operator delete(void *ptr) noexcept { free(ptr); }
+__attribute__((noinline)) void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
+/// A script with its automation, the actions are given by the test.
+struct TestScript {
+  explicit TestScript(ScriptMode mode, uint16_t max_runs = 0) : automation(&script) {
+    this->script.set_mode(mode);
+    this->script.set_max_runs(max_runs);
+  }
+  /// Run loop() of the components for the given time, in steps of 1ms.
+  void run(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+      test_time_us += 1000;
+      for (auto *component : this->components)
+        component->loop();
+    }
+  }
+
+  Script script;
+  Automation<> automation;
+  std::vector<Component *> components;
+};
+
+/// Count the runs that reach the end of the actions.
+static LambdaAction<> *count_action(int *counter) {
+  return new LambdaAction<>([counter]() { (*counter)++; });
+}
+
+static void test_parallel_delay() {
+  TestScript t(SCRIPT_MODE_PARALLEL);
+  auto *delay = new DelayAction<>();
+  delay->set_delay(10);
+  int done = 0;
+  t.automation.add_actions({delay, count_action(&done)});
+  t.components.push_back(delay);
+
+  // Warm up: 1000 runs per second, every run waits 10ms, so there are up to 11 pending runs.
+  for (int i = 0; i < 1000; i++) {
+    t.script.execute();
+    t.run(1);
+  }
+  const size_t before = allocations;
+  for (int i = 0; i < 100000; i++) {
+    t.script.execute();
+    EXPECT(t.script.is_running());
+    t.run(1);
+  }
+  EXPECT(allocations == before);
+  t.run(20);
+  EXPECT(!t.script.is_running());
+  EXPECT(done == 101000);
+}
+
+static void test_dropped_by_while() {
+  TestScript t(SCRIPT_MODE_PARALLEL);
+  bool loop = true;
+  auto *delay = new DelayAction<>();
+  delay->set_delay(5);
+  auto *while_action = new WhileAction<>({new LambdaCondition<>([&loop]() { return loop; })});
+  while_action->add_then({delay});
+  int done = 0;
+  t.automation.add_actions({while_action, count_action(&done)});
+  t.components.push_back(delay);
+
+  t.script.execute();
+  // The while action is already looping, so this run is dropped and never reaches the end.
+  t.script.execute();
+  t.run(20);
+  EXPECT(t.script.is_running());
+  loop = false;
+  t.run(10);
+  EXPECT(done == 1);
+  EXPECT(!t.script.is_running());
+
+  // The dropped run is forgotten, single mode doesn't ignore the next execution.
+  t.script.set_mode(SCRIPT_MODE_SINGLE);
+  loop = true;
+  t.script.execute();
+  EXPECT(t.script.is_running());
+  loop = false;
+  t.run(10);
+  EXPECT(done == 2);
+  EXPECT(!t.script.is_running());
+}
+
+static void test_condition_failed() {
+  TestScript t(SCRIPT_MODE_SINGLE);
+  bool allowed = false;
+  t.automation.add_condition(new LambdaCondition<>([&allowed]() { return allowed; }));
+  auto *delay = new DelayAction<>();
+  delay->set_delay(5);
+  int done = 0;
+  t.automation.add_actions({delay, count_action(&done)});
+  t.components.push_back(delay);
+
+  t.script.execute();
+  EXPECT(!t.script.is_running());
+  allowed = true;
+  t.script.execute();
+  EXPECT(t.script.is_running());
+  t.run(10);
+  EXPECT(done == 1);
+  EXPECT(!t.script.is_running());
+}
+
+static void test_single_and_restart() {
+  TestScript single(SCRIPT_MODE_SINGLE);
+  auto *delay = new DelayAction<>();
+  delay->set_delay(10);
+  int done = 0;
+  single.automation.add_actions({delay, count_action(&done)});
+  single.components.push_back(delay);
+  for (int i = 0; i < 1000; i++) {
+    single.script.execute();
+    single.run(1);
+  }
+  single.run(20);
+  // The run started at 0ms ends in the loop at 10ms, before the execution at 10ms: runs at 0, 10, ..., 990ms.
+  EXPECT(done == 100);
+  EXPECT(!single.script.is_running());
+
+  TestScript restart(SCRIPT_MODE_RESTART);
+  delay = new DelayAction<>();
+  delay->set_delay(10);
+  done = 0;
+  restart.automation.add_actions({delay, count_action(&done)});
+  restart.components.push_back(delay);
+  for (int i = 0; i < 1000; i++) {
+    restart.script.execute();
+    restart.run(1);
+  }
+  EXPECT(done == 0);
+  restart.run(20);
+  EXPECT(done == 1);
+  EXPECT(!restart.script.is_running());
+}
+
+static void test_queued() {
+  TestScript t(SCRIPT_MODE_QUEUED, 5);
+  bool ready = false;
+  auto *wait = new WaitUntilAction<>({new LambdaCondition<>([&ready]() { return ready; })});
+  wait->set_wait_timeout(3);
+  int done = 0;
+  t.automation.add_actions({wait, count_action(&done)});
+  t.components.push_back(wait);
+
+  // One run and 4 queued ones, the rest is dropped.
+  for (int i = 0; i < 100; i++)
+    t.script.execute();
+  t.run(100);
+  EXPECT(done == 5);
+  EXPECT(!t.script.is_running());
+
+  // Steady state with runs that continue right away and runs that wait.
+  const size_t before = allocations;
+  for (int i = 0; i < 10000; i++) {
+    ready = i % 3 == 0;
+    t.script.execute();
+    t.script.execute();
+    t.run(1);
+  }
+  EXPECT(allocations == before);
+  ready = true;
+  t.run(10);
+  EXPECT(!t.script.is_running());
+}
+
+static void test_self_execute() {
+  // Executing the script from its own actions after a delay, the continuing run has to stay counted.
+  TestScript t(SCRIPT_MODE_SINGLE);
+  auto *delay = new DelayAction<>();
+  delay->set_delay(5);
+  int done = 0;
+  t.automation.add_actions({delay, t.script.make_execute_action<>(), count_action(&done)});
+  t.components.push_back(delay);
+
+  t.script.execute();
+  t.run(10);
+  EXPECT(done == 1);
+  EXPECT(!t.script.is_running());
+}
+
+int main() {
+  test_parallel_delay();
+  test_dropped_by_while();
+  test_condition_failed();
+  test_single_and_restart();
+  test_queued();
+  test_self_execute();
+  return test_result();
+}
@@ -0,0 +1,209 @@
+// The MAC address table of the BLE tracker on replayed advertisement streams: each scan sees a random subset of
+// a population of devices (many of one vendor, several advertisements per device), and what the table reports
+// and remembers is compared with a simple model after every advertisement, including the eviction of old
+// addresses, the eviction when a scan fills the table and the wrap around of the scan generation.
+#include "test_helpers.h"
+#include "esphome/esp32_ble_mac_table.cpp"
+
+#include <map>
+#include <random>
+
+using namespace esphome;
+
+class TestMacTable : public ESPBTMacTable {
+ public:
+  using ESPBTMacTable::entries_;
+  using ESPBTMacTable::find_;
+  using ESPBTMacTable::ADDRESS_MASK;
+};
+
+/// The addresses ESPBTMacTable should remember, with the scan they were last seen in.
+class MacTableModel {
+ public:
+  void next_scan() {
+    this->scan_++;
+    this->evict_(ESPBTMacTable::MAX_AGE);
+  }
+  bool mark_seen(uint64_t address) {
+    auto it = this->last_seen_.find(address);
+    if (it != this->last_seen_.end()) {
+      const bool first = it->second != this->scan_;
+      it->second = this->scan_;
+      return first;
+    }
+    if (this->last_seen_.size() >= ESPBTMacTable::CAPACITY / 4 * 3) {
+      this->evict_(1);
+      if (this->last_seen_.size() >= ESPBTMacTable::CAPACITY / 4 * 3)
+        return true;
+    }
+    this->last_seen_[address] = this->scan_;
+    return true;
+  }
+  bool seen_in_current_scan(uint64_t address) const {
+    auto it = this->last_seen_.find(address);
+    return it != this->last_seen_.end() && it->second == this->scan_;
+  }
+  const std::map<uint64_t, uint32_t> &last_seen() const { return this->last_seen_; }
+
+ protected:
+  void evict_(uint32_t max_age) {
+    for (auto it = this->last_seen_.begin(); it != this->last_seen_.end();) {
+      if (this->scan_ - it->second >= max_age)
+        it = this->last_seen_.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  uint32_t scan_{0};
+  std::map<uint64_t, uint32_t> last_seen_;
+};
+
+/// The table holds exactly the addresses of the model, and each of them can be found from its home slot.
+static bool same_addresses(const TestMacTable &table, const MacTableModel &model) {
+  if (table.size() != model.last_seen().size())
+    return false;
+  size_t entries = 0;
+  for (size_t i = 0; i < ESPBTMacTable::CAPACITY; i++) {
+    const uint64_t entry = table.entries_[i];
+    if (entry == 0)
+      continue;
+    entries++;
+    const uint64_t address = entry & TestMacTable::ADDRESS_MASK;
+    if (model.last_seen().count(address) == 0 || table.find_(address) != i)
+      return false;
+  }
+  return entries == table.size();
+}
+
+static bool contains(const TestMacTable &table, uint64_t address) {
+  for (uint64_t entry : table.entries_) {
+    if (entry != 0 && (entry & TestMacTable::ADDRESS_MASK) == address)
+      return true;
+  }
+  return false;
+}
+
+/// A population of devices, half of them sharing the upper three bytes of one vendor.
+static std::vector<uint64_t> make_population(std::mt19937_64 &rng, size_t size) {
+  std::vector<uint64_t> addresses;
+  for (size_t i = 0; i < size; i++) {
+    uint64_t address = rng() & 0xFFFFFFFFFFFFULL;
+    if (i % 2 == 0)
+      address = 0xA4C138000000ULL | (address & 0xFFFFFF);
+    addresses.push_back(address);
+  }
+  return addresses;
+}
+
+/// Replay scans of random subsets of the population, returns the number of advertisements.
+static size_t replay(uint32_t scans, size_t population, size_t min_devices, size_t max_devices, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  const auto addresses = make_population(rng, population);
+  TestMacTable table;
+  MacTableModel model;
+  size_t advertisements = 0;
+  size_t mismatches = 0;
+  for (uint32_t scan = 0; scan < scans && mismatches < 10; scan++) {
+    table.next_scan();
+    model.next_scan();
+    const size_t devices = min_devices + rng() % (max_devices - min_devices + 1);
+    for (size_t i = 0; i < devices * 3; i++) {
+      // Some devices of this scan advertise more often than others.
+      const uint64_t address = addresses[(scan * 7 + rng() % devices + rng() % 3) % addresses.size()];
+      advertisements++;
+      const bool first = table.mark_seen(address);
+      if (first != model.mark_seen(address))
+        mismatches++;
+      if (table.seen_in_current_scan(address) != model.seen_in_current_scan(address))
+        mismatches++;
+    }
+    if (!same_addresses(table, model))
+      mismatches++;
+  }
+  EXPECT(mismatches == 0);
+  return advertisements;
+}
+
+static void test_dedup() {
+  TestMacTable table;
+  table.next_scan();
+  EXPECT(table.mark_seen(0x112233445566ULL));
+  EXPECT(!table.mark_seen(0x112233445566ULL));
+  // Only the lower 48 bits are the address.
+  EXPECT(!table.mark_seen(0xFFFF112233445566ULL));
+  EXPECT(table.seen_in_current_scan(0x112233445566ULL));
+  EXPECT(!table.seen_in_current_scan(0x112233445567ULL));
+  EXPECT(table.size() == 1);
+
+  table.next_scan();
+  EXPECT(!table.seen_in_current_scan(0x112233445566ULL));
+  EXPECT(table.mark_seen(0x112233445566ULL));
+  EXPECT(table.size() == 1);
+}
+
+static void test_eviction() {
+  // An address is remembered for MAX_AGE scans after it was last seen.
+  TestMacTable table;
+  table.next_scan();
+  table.mark_seen(1);
+  table.mark_seen(2);
+  for (uint16_t i = 1; i < ESPBTMacTable::MAX_AGE; i++) {
+    table.next_scan();
+    table.mark_seen(2);
+    EXPECT(table.size() == 2);
+  }
+  table.next_scan();
+  EXPECT(table.size() == 1);
+  EXPECT(!contains(table, 1));
+  EXPECT(contains(table, 2));
+}
+
+static void test_full_scan() {
+  // A scan with more devices than fit, the addresses of older scans make room first, then new addresses are
+  // reported every time they're seen.
+  const size_t limit = ESPBTMacTable::CAPACITY / 4 * 3;
+  TestMacTable table;
+  table.next_scan();
+  for (uint64_t address = 1; address <= 300; address++)
+    table.mark_seen(address);
+  table.next_scan();
+  for (uint64_t address = 1001; address < 1001 + limit; address++)
+    EXPECT(table.mark_seen(address));
+  EXPECT(table.size() == limit);
+  EXPECT(!table.mark_seen(1001));
+  EXPECT(table.mark_seen(5000));
+  EXPECT(table.mark_seen(5000));
+  EXPECT(!table.seen_in_current_scan(5000));
+  EXPECT(table.size() == limit);
+}
+
+static void test_generation_wrap() {
+  // The generation wraps around after 65535 scans, the table starts over.
+  TestMacTable table;
+  uint32_t scans = 0;
+  do {
+    table.mark_seen(1);
+    table.next_scan();
+    scans++;
+  } while (table.size() != 0 && scans < 0x20000);
+  // The generation started at 1.
+  EXPECT(scans == 0xFFFF);
+  EXPECT(table.mark_seen(2));
+  EXPECT(!table.mark_seen(2));
+  EXPECT(table.size() == 1);
+}
+
+int main() {
+  test_dedup();
+  test_eviction();
+  test_full_scan();
+  test_generation_wrap();
+  // A quiet area: the same few devices every scan.
+  replay(200, 40, 20, 40, 1);
+  // A busy area with churn, addresses are evicted with age.
+  replay(500, 2000, 50, 200, 2);
+  // Scans with more devices than fit into the table.
+  replay(100, 5000, 300, 500, 3);
+  return test_result();
+}
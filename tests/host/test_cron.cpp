@@ -0,0 +1,255 @@
+// CronTrigger::find_next against a brute-force oracle that checks every second with matches(), in time zones
+// with daylight saving time (also half an hour and on the southern hemisphere), around leap days and years.
+// The trigger itself runs against a simulated clock that's set forwards and backwards.
+#include "test_helpers.h"
+#include "esphome/time/rtc_component.cpp"
+
+#include <random>
+#include <sys/time.h>
+
+using namespace esphome;
+using namespace esphome::time;
+
+/// The simulated wall clock in microseconds, RealTimeClockComponent reads it through time() and gettimeofday().
+static int64_t wall_clock_us = 0;
+
+extern "C" time_t time(time_t *t) {
+  const time_t now = wall_clock_us / 1000000;
+  if (t != nullptr)
+    *t = now;
+  return now;
+}
+extern "C" int gettimeofday(struct timeval *tv, void *tz) {
+  tv->tv_sec = wall_clock_us / 1000000;
+  tv->tv_usec = wall_clock_us % 1000000;
+  return 0;
+}
+
+static void set_timezone(const char *tz) {
+  setenv("TZ", tz, 1);
+  tzset();
+}
+
+static ESPTime local_time(time_t t) {
+  struct tm c_tm;
+  localtime_r(&t, &c_tm);
+  return ESPTime::from_tm(&c_tm, t);
+}
+
+/// The unix time of a local time, the first one if it occurs twice.
+static time_t make_time(int year, int month, int day, int hour, int minute, int second) {
+  struct tm c_tm = {};
+  c_tm.tm_year = year - 1900;
+  c_tm.tm_mon = month - 1;
+  c_tm.tm_mday = day;
+  c_tm.tm_hour = hour;
+  c_tm.tm_min = minute;
+  c_tm.tm_sec = second;
+  c_tm.tm_isdst = 1;
+  time_t t = mktime(&c_tm);
+  struct tm check;
+  localtime_r(&t, &check);
+  if (check.tm_hour != hour || check.tm_min != minute) {
+    c_tm = {};
+    c_tm.tm_year = year - 1900;
+    c_tm.tm_mon = month - 1;
+    c_tm.tm_mday = day;
+    c_tm.tm_hour = hour;
+    c_tm.tm_min = minute;
+    c_tm.tm_sec = second;
+    c_tm.tm_isdst = 0;
+    t = mktime(&c_tm);
+  }
+  return t;
+}
+
+static const time_t ORACLE_HORIZON = 36 * 3600;
+
+/// Compare find_next with checking every second up to ORACLE_HORIZON after start.
+static void check_against_oracle(CronTrigger *cron, time_t start) {
+  optional<time_t> expected;
+  for (time_t t = start; t <= start + ORACLE_HORIZON; t++) {
+    if (cron->matches(local_time(t))) {
+      expected = t;
+      break;
+    }
+  }
+  const optional<time_t> next = cron->find_next(start);
+  if (expected.has_value()) {
+    EXPECT(next.has_value() && *next == *expected);
+    if (!next.has_value() || *next != *expected)
+      fprintf(stderr, "  start=%ld expected=%ld got=%ld (TZ=%s)\n", long(start), long(*expected),
+              next.has_value() ? long(*next) : -1L, getenv("TZ"));
+  } else {
+    EXPECT(!next.has_value() || *next > start + ORACLE_HORIZON);
+  }
+}
+
+/// The times in [start, end) at which the UTC offset changes.
+static std::vector<time_t> offset_changes(time_t start, time_t end) {
+  std::vector<time_t> changes;
+  int prev = local_time(start).is_dst;
+  for (time_t t = start; t < end; t += 900) {
+    if (local_time(t).is_dst != prev) {
+      time_t change = t - 900;
+      while (local_time(change).is_dst == prev)
+        change++;
+      changes.push_back(change);
+      prev = !prev;
+    }
+  }
+  return changes;
+}
+
+static CronTrigger *make_cron(std::initializer_list<uint8_t> seconds, std::initializer_list<uint8_t> minutes,
+                              std::initializer_list<uint8_t> hours, std::initializer_list<uint8_t> days_of_month,
+                              std::initializer_list<uint8_t> months, std::initializer_list<uint8_t> days_of_week,
+                              RealTimeClockComponent *rtc = nullptr) {
+  auto *cron = new CronTrigger(rtc);
+  auto add = [](std::initializer_list<uint8_t> values, int first, int last, std::function<void(uint8_t)> f) {
+    if (values.size() == 0) {
+      for (int i = first; i <= last; i++)
+        f(i);
+    }
+    for (uint8_t value : values)
+      f(value);
+  };
+  // An empty list means every value.
+  add(seconds, 0, 59, [cron](uint8_t x) { cron->add_second(x); });
+  add(minutes, 0, 59, [cron](uint8_t x) { cron->add_minute(x); });
+  add(hours, 0, 23, [cron](uint8_t x) { cron->add_hour(x); });
+  add(days_of_month, 1, 31, [cron](uint8_t x) { cron->add_day_of_month(x); });
+  add(months, 1, 12, [cron](uint8_t x) { cron->add_month(x); });
+  add(days_of_week, 1, 7, [cron](uint8_t x) { cron->add_day_of_week(x); });
+  return cron;
+}
+
+static void test_oracle() {
+  std::vector<CronTrigger *> crons = {
+      // Every minute, and every 15 minutes at second 0 and 30 around the hours daylight saving time changes.
+      make_cron({0}, {}, {}, {}, {}, {}),
+      make_cron({0, 30}, {0, 15, 30, 45}, {1, 2, 3}, {}, {}, {}),
+      // Daily in the hour that's skipped or repeated in Europe and the US.
+      make_cron({0}, {30}, {2}, {}, {}, {}),
+      // The last second of a day, and the first Monday of a month.
+      make_cron({59}, {59}, {23}, {}, {}, {}),
+      make_cron({0}, {0}, {9}, {1, 2, 3, 4, 5, 6, 7}, {}, {2}),
+      // Leap days, and the 31st which most months don't have.
+      make_cron({0}, {0}, {12}, {29}, {2}, {}),
+      make_cron({0}, {0}, {0}, {31}, {}, {}),
+  };
+  const char *timezones[] = {
+      "UTC0",
+      "CET-1CEST,M3.5.0,M10.5.0/3",
+      "EST5EDT,M3.2.0,M11.1.0",
+      "AEST-10AEDT,M10.1.0,M4.1.0/3",
+      "LHST-10:30LHDT-11,M10.1.0,M4.1.0",
+  };
+  std::mt19937 rng(42);
+  for (const char *tz : timezones) {
+    set_timezone(tz);
+    std::vector<time_t> starts;
+    // Shortly before and right at the changes of the UTC offset.
+    for (time_t change : offset_changes(make_time(2020, 1, 1, 0, 0, 0), make_time(2023, 1, 1, 0, 0, 0))) {
+      starts.push_back(change - 3600 - rng() % 3600);
+      starts.push_back(change);
+      starts.push_back(change + 1800);
+    }
+    // Around leap days (2100 isn't a leap year), year and month ends.
+    const int years[] = {2019, 2020, 2024, 2037, 2038, 2099, 2100};
+    for (int year : years) {
+      starts.push_back(make_time(year, 2, 28, 0, 0, 0) + rng() % 86400);
+      starts.push_back(make_time(year, 12, 31, 12, 0, 0) + rng() % 43200);
+      starts.push_back(make_time(year, 4, 30, 12, 0, 0) + rng() % 43200);
+    }
+    // And anywhere.
+    for (int i = 0; i < 10; i++)
+      starts.push_back(make_time(2019, 1, 1, 0, 0, 0) + time_t(rng() % (40 * 366)) * 86400 + rng() % 86400);
+
+    for (auto *cron : crons) {
+      for (time_t start : starts)
+        check_against_oracle(cron, start);
+    }
+  }
+}
+
+static void test_far_matches() {
+  set_timezone("CET-1CEST,M3.5.0,M10.5.0/3");
+  auto *leap_day = make_cron({0}, {0}, {12}, {29}, {2}, {});
+  EXPECT(leap_day->find_next(make_time(2021, 3, 1, 0, 0, 0)) == make_time(2024, 2, 29, 12, 0, 0));
+  EXPECT(leap_day->find_next(make_time(2096, 2, 29, 12, 0, 1)) == make_time(2104, 2, 29, 12, 0, 0));
+  // A leap day on a Monday.
+  auto *leap_monday = make_cron({0}, {0}, {12}, {29}, {2}, {2});
+  EXPECT(leap_monday->find_next(make_time(2021, 1, 1, 0, 0, 0)) == make_time(2044, 2, 29, 12, 0, 0));
+  // The 30th of February doesn't exist.
+  auto *never = make_cron({0}, {0}, {12}, {30}, {2}, {});
+  EXPECT(!never->find_next(make_time(2021, 1, 1, 0, 0, 0)).has_value());
+  // The second occurrence of 02:30 when daylight saving time ends, right after the first one.
+  auto *half_past_two = make_cron({0}, {30}, {2}, {}, {}, {});
+  const time_t first = make_time(2021, 10, 31, 2, 30, 0);
+  EXPECT(half_past_two->find_next(first) == first);
+  EXPECT(half_past_two->find_next(first + 1) == first + 3600);
+  // And none when it starts.
+  EXPECT(half_past_two->find_next(make_time(2021, 3, 28, 1, 0, 0)) == make_time(2021, 3, 29, 2, 30, 0));
+}
+
+static void test_clock_jumps() {
+  set_timezone("CET-1CEST,M3.5.0,M10.5.0/3");
+  RealTimeClockComponent rtc;
+  auto *cron = make_cron({0}, {}, {}, {}, {}, {}, &rtc);
+
+  std::vector<time_t> fired;
+  Automation<> automation(cron);
+  automation.add_action(new LambdaAction<>([&fired]() { fired.push_back(wall_clock_us / 1000000); }));
+
+  // The clock isn't set yet.
+  wall_clock_us = 0;
+  cron->call_setup();
+  auto run = [cron](uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+      test_time_us += 1000;
+      wall_clock_us += 1000;
+      cron->call_loop();
+    }
+  };
+  run(5000);
+  EXPECT(fired.empty());
+
+  // Set, half a minute before a full minute.
+  const time_t base = make_time(2021, 6, 1, 12, 0, 0);
+  wall_clock_us = int64_t(base - 30) * 1000000;
+  run(5 * 60 * 1000);
+  EXPECT(fired.size() == 5);
+  for (size_t i = 0; i < fired.size(); i++)
+    EXPECT(fired[i] == base + time_t(i) * 60);
+
+  // Forwards by an hour, 30s before the next match: the skipped matches are merged into one trigger when
+  // the trigger wakes up, then it continues every minute.
+  fired.clear();
+  wall_clock_us += int64_t(3600) * 1000000;
+  run(2 * 60 * 1000);
+  EXPECT(fired.size() == 2);
+  if (fired.size() == 2) {
+    EXPECT(fired[0] == base + 3600 + 5 * 60);
+    EXPECT(fired[1] == base + 3600 + 6 * 60);
+  }
+
+  // Backwards by ten minutes, 30s after the last match: the trigger wakes up 30s later (sleeping at most a
+  // minute) and matches the minutes again.
+  fired.clear();
+  wall_clock_us -= int64_t(600) * 1000000;
+  run(3 * 60 * 1000);
+  EXPECT(fired.size() == 3);
+  if (fired.size() == 3) {
+    EXPECT(fired[0] == base + 3600 - 3 * 60);
+    EXPECT(fired[1] == base + 3600 - 2 * 60);
+    EXPECT(fired[2] == base + 3600 - 1 * 60);
+  }
+}
+
+int main() {
+  test_oracle();
+  test_far_matches();
+  test_clock_jumps();
+  return test_result();
+}
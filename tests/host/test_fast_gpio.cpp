@@ -0,0 +1,111 @@
+// FastGPIOPin against the simulated GPIO registers: normal and inverted pins, the output enable registers, and the
+// fallbacks to the virtual GPIOPin methods for GPIO16 and pins of I/O expanders.
+#include "test_helpers.h"
+#include "gpio_sim.h"
+#include "esphome/esphal.cpp"
+
+using namespace esphome;
+
+/// A pin of an I/O expander, remembers what was written.
+class ExpanderPin : public GPIOPin {
+ public:
+  ExpanderPin(uint8_t pin, bool inverted) : GPIOPin(pin, OUTPUT, inverted) {}
+  void setup() override {}
+  void pin_mode(uint8_t mode) override { this->mode = mode; }
+  bool digital_read() override { return this->level != this->inverted_; }
+  void digital_write(bool value) override { this->level = value != this->inverted_; }
+  bool is_internal() const override { return false; }
+
+  uint8_t mode{INPUT};
+  bool level{false};
+};
+
+static void test_internal(bool inverted) {
+  GPIOPin pin(5, OUTPUT, inverted);
+  FastGPIOPin fast(&pin);
+  EXPECT(fast.is_fast());
+  EXPECT(fast.get_pin() == &pin);
+
+  gpio_sim_events.clear();
+  fast.digital_write(true);
+  EXPECT(bool(gpio_sim_peek(0x300) & (1 << 5)) != inverted);
+  fast.digital_write(false);
+  EXPECT(bool(gpio_sim_peek(0x300) & (1 << 5)) == inverted);
+  // Only pin 5 changed.
+  EXPECT(gpio_sim_events.size() == 2);
+  for (auto &event : gpio_sim_events)
+    EXPECT(event.pin == 5);
+
+  // The same levels as the virtual methods.
+  for (bool value : {true, false, true}) {
+    pin.digital_write(value);
+    const uint32_t slow = gpio_sim_peek(0x300);
+    fast.digital_write(!value);
+    fast.digital_write(value);
+    EXPECT(gpio_sim_peek(0x300) == slow);
+  }
+
+  gpio_sim_poke(0x318, 1 << 5);
+  EXPECT(fast.digital_read() == !inverted);
+  EXPECT(pin.digital_read() == !inverted);
+  gpio_sim_poke(0x318, ~uint32_t(1 << 5));
+  EXPECT(fast.digital_read() == inverted);
+  EXPECT(pin.digital_read() == inverted);
+
+  // Enabling the output changes neither the level nor other pins.
+  gpio_sim_poke(0x30C, 1 << 3);
+  const uint32_t level = gpio_sim_peek(0x300);
+  fast.set_output_enabled(true);
+  EXPECT(gpio_sim_peek(0x30C) == ((1 << 3) | (1 << 5)));
+  fast.set_output_enabled(false);
+  EXPECT(gpio_sim_peek(0x30C) == (1 << 3));
+  EXPECT(gpio_sim_peek(0x300) == level);
+}
+
+static void test_gpio16() {
+  // GPIO16 has no set/clear registers, writes go through GPIOPin::digital_write.
+  GPIOPin pin(16, OUTPUT, false);
+  FastGPIOPin fast(&pin);
+  EXPECT(!fast.is_fast());
+  gpio_sim_events.clear();
+  fast.digital_write(true);
+  EXPECT(gpio_sim_peek(0x768) & 1);
+  fast.digital_write(false);
+  EXPECT(!(gpio_sim_peek(0x768) & 1));
+  EXPECT(gpio_sim_events.size() == 2 && gpio_sim_events[0].pin == 16);
+
+  // Reads still use the input register.
+  gpio_sim_poke(0x78C, 1);
+  EXPECT(fast.digital_read());
+  gpio_sim_poke(0x78C, 0);
+  EXPECT(!fast.digital_read());
+}
+
+static void test_expander(bool inverted) {
+  ExpanderPin pin(3, inverted);
+  FastGPIOPin fast(&pin);
+  EXPECT(!fast.is_fast());
+  gpio_sim_events.clear();
+  fast.digital_write(true);
+  EXPECT(pin.level != inverted);
+  EXPECT(fast.digital_read());
+  fast.digital_write(false);
+  EXPECT(pin.level == inverted);
+  EXPECT(!fast.digital_read());
+  fast.set_output_enabled(true);
+  EXPECT(pin.mode == OUTPUT);
+  fast.set_output_enabled(false);
+  EXPECT(pin.mode == INPUT_PULLUP);
+  // Nothing went to the GPIO registers.
+  EXPECT(gpio_sim_events.empty());
+}
+
+int main() {
+  gpio_sim_begin();
+  test_internal(false);
+  test_internal(true);
+  test_gpio16();
+  test_expander(false);
+  test_expander(true);
+  return test_result();
+}
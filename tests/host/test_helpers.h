@@ -0,0 +1,27 @@
+#ifndef ESPHOME_TEST_HELPERS_H
+#define ESPHOME_TEST_HELPERS_H
+
+#include <cstdio>
+
+static int test_failures = 0;
+
+/// Record a failed check without aborting the test, so that one run reports every failure.
+#define EXPECT(cond) \
+  do { \
+    if (!(cond)) { \
+      test_failures++; \
+      if (test_failures <= 20) \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+  } while (0)
+
+static inline int test_result() {
+  if (test_failures != 0) {
+    fprintf(stderr, "%d checks failed\n", test_failures);
+    return 1;
+  }
+  printf("OK\n");
+  return 0;
+}
+
+#endif  // ESPHOME_TEST_HELPERS_H
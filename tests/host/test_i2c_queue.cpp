@@ -0,0 +1,415 @@
+// The transaction queue of the i2c bus on a simulated bus: transactions to one address run in order while other
+// addresses use the bus, reads wait for the conversion time without blocking loop(), and timeouts and NACKs end a
+// transaction with a failed callback. The ADS1115 and BME280 read flows run through the queue against simulated
+// chips that only have valid data once their conversion is done.
+#include "test_helpers.h"
+#include "i2c_sim.h"
+#include "esphome/i2c_component.cpp"
+#include "esphome/sensor/ads1115_component.h"
+#include "esphome/sensor/bme280_component.h"
+
+#include <string>
+
+using namespace esphome;
+using namespace esphome::sensor;
+
+/// Run loop() of the bus and the components every millisecond, returns the longest loop() call.
+static uint32_t run(I2CComponent &bus, const std::vector<Component *> &components, uint32_t ms) {
+  uint32_t max_call_us = 0;
+  for (uint32_t i = 0; i < ms; i++) {
+    const uint32_t start = test_time_us;
+    for (auto *component : components)
+      component->call_loop();
+    bus.call_loop();
+    max_call_us = std::max(max_call_us, test_time_us - start);
+    test_time_us += 1000;
+  }
+  return max_call_us;
+}
+
+static void test_ordering() {
+  i2c_sim_events.clear();
+  I2CComponent bus(4, 5);
+  bus.setup();
+  I2CSimDevice a(0x40), b(0x41);
+  a.registers[0x10] = 0x12;
+  a.registers[0x11] = 0x34;
+  b.registers[0x00] = 0x56;
+
+  std::vector<std::string> done;
+  bus.submit_read(0x40, 0x10, 2, 10, [&done](bool success, const uint8_t *data) {
+    EXPECT(success);
+    EXPECT(data[0] == 0x12 && data[1] == 0x34);
+    done.push_back("a1");
+  });
+  const uint8_t value = 0x78;
+  bus.submit_write(0x40, 0x20, &value, 1, [&done](bool success, const uint8_t *) {
+    EXPECT(success);
+    done.push_back("a2");
+  });
+  bus.submit_read(0x41, 0x00, 1, 0, [&done](bool success, const uint8_t *data) {
+    EXPECT(success);
+    EXPECT(data[0] == 0x56);
+    done.push_back("b1");
+  });
+  const uint32_t start = test_time_us;
+  const uint32_t max_call_us = run(bus, {}, 20);
+  // Nothing waits in loop().
+  EXPECT(max_call_us == 0);
+  EXPECT((done == std::vector<std::string>{"b1", "a1", "a2"}));
+  EXPECT(a.registers[0x20] == 0x78);
+
+  // The second transaction to 0x40 starts after the first one read its data, the conversion time after writing
+  // the register. 0x41 used the bus in the meantime.
+  const auto events = i2c_sim_events_for(0x40);
+  EXPECT(events.size() == 3);
+  if (events.size() == 3) {
+    EXPECT(!events[0].read && events[0].reg == 0x10 && events[0].len == 0);
+    EXPECT(events[1].read && events[1].reg == 0x10 && events[1].len == 2);
+    EXPECT(!events[2].read && events[2].reg == 0x20 && events[2].len == 1);
+    EXPECT(events[0].time_us == start);
+    EXPECT(events[1].time_us - events[0].time_us == 10000);
+    EXPECT(events[2].time_us == events[1].time_us);
+  }
+  EXPECT(i2c_sim_events.size() == 5);
+  if (i2c_sim_events.size() == 5) {
+    EXPECT(i2c_sim_events[1].address == 0x41 && !i2c_sim_events[1].read);
+    EXPECT(i2c_sim_events[2].address == 0x41 && i2c_sim_events[2].read);
+  }
+}
+
+static void test_errors() {
+  I2CComponent bus(4, 5);
+  bus.setup();
+  bus.set_transaction_timeout(50);
+  I2CSimDevice a(0x40);
+  std::vector<std::string> done;
+  auto record = [&done](const char *name) {
+    return [&done, name](bool success, const uint8_t *) { done.push_back(std::string(name) + (success ? "+" : "-")); };
+  };
+
+  // A transaction waiting behind a long conversion on its address times out without touching the bus, the
+  // converting one still completes.
+  i2c_sim_events.clear();
+  bus.submit_read(0x40, 0x00, 1, 100, record("convert"));
+  bus.submit_read(0x40, 0x01, 1, 0, record("waiting"));
+  run(bus, {}, 52);
+  EXPECT((done == std::vector<std::string>{"waiting-"}));
+  run(bus, {}, 50);
+  EXPECT((done == std::vector<std::string>{"waiting-", "convert+"}));
+  EXPECT(i2c_sim_events.size() == 2);
+
+  // No device at the address.
+  done.clear();
+  const uint32_t requests = Wire.requests;
+  bus.submit_read(0x50, 0x00, 1, 0, record("missing"));
+  run(bus, {}, 1);
+  EXPECT((done == std::vector<std::string>{"missing-"}));
+  EXPECT(Wire.requests == requests);
+
+  // The data of a write isn't acknowledged.
+  done.clear();
+  const uint8_t value = 1;
+  a.nack_data = true;
+  bus.submit_write(0x40, 0x02, &value, 1, record("write"));
+  run(bus, {}, 1);
+  EXPECT((done == std::vector<std::string>{"write-"}));
+  EXPECT(a.registers[0x02] == 0);
+  a.nack_data = false;
+
+  // The device stops answering during the conversion, the read fails. The next transaction to it runs again.
+  done.clear();
+  bus.submit_read(0x40, 0x00, 2, 5, record("read"));
+  run(bus, {}, 1);
+  a.nack_address = true;
+  run(bus, {}, 5);
+  EXPECT((done == std::vector<std::string>{"read-"}));
+  a.nack_address = false;
+  bus.submit_write(0x40, 0x02, &value, 1, record("next"));
+  run(bus, {}, 1);
+  EXPECT((done == std::vector<std::string>{"read-", "next+"}));
+  EXPECT(a.registers[0x02] == 1);
+}
+
+/// An ADS1115: 16 bit registers, a single-shot conversion starts with the OS bit of the config register and
+/// takes 1.2 ms at 860 samples per second, the OS bit reads 0 until it's done.
+class SimADS1115 : public TwoWireDevice {
+ public:
+  explicit SimADS1115(uint8_t address) : address_(address) { Wire.devices[address] = this; }
+  ~SimADS1115() override { Wire.devices[this->address_] = nullptr; }
+
+  bool on_transmission(const uint8_t *data, size_t len) override {
+    if (len == 0)
+      return true;
+    this->pointer_ = data[0] & 0b11;
+    i2c_sim_events.push_back({this->address_, false, this->pointer_, len - 1, test_time_us});
+    if (len == 3 && this->pointer_ == 1) {
+      const uint16_t value = (uint16_t(data[1]) << 8) | data[2];
+      this->config_ = value & 0x7FFF;
+      if (value & 0x8000) {
+        this->converting_ = true;
+        this->done_at_ = test_time_us + 1200;
+        this->conversions++;
+      }
+    }
+    return true;
+  }
+  bool on_request(uint8_t *data, size_t len) override {
+    i2c_sim_events.push_back({this->address_, true, this->pointer_, len, test_time_us});
+    if (this->converting_ && !this->stuck && int32_t(test_time_us - this->done_at_) >= 0) {
+      this->converting_ = false;
+      this->conversion_ = this->inputs[(this->config_ >> 12) & 0b111];
+    }
+    uint16_t value = uint16_t(this->conversion_);
+    if (this->pointer_ == 1)
+      value = this->config_ | (this->converting_ ? 0 : 0x8000);
+    for (size_t i = 0; i < len; i++)
+      data[i] = i == 0 ? value >> 8 : i == 1 ? value & 0xFF : 0;
+    return true;
+  }
+
+  /// The conversion result for each multiplexer setting.
+  int16_t inputs[8] = {};
+  /// Never finish a conversion.
+  bool stuck{false};
+  uint32_t conversions{0};
+
+ protected:
+  uint8_t address_;
+  uint8_t pointer_{0};
+  uint16_t config_{0x8583};
+  bool converting_{false};
+  uint32_t done_at_{0};
+  int16_t conversion_{0};
+};
+
+static void test_ads1115() {
+  i2c_sim_events.clear();
+  I2CComponent bus(4, 5);
+  bus.setup();
+  SimADS1115 chip(0x48);
+  chip.inputs[ADS1115_MULTIPLEXER_P0_NG] = 16000;
+  chip.inputs[ADS1115_MULTIPLEXER_P1_NG] = -8000;
+  ADS1115Component ads(&bus, 0x48);
+  auto *sensor_0 = ads.get_sensor("a0", ADS1115_MULTIPLEXER_P0_NG, ADS1115_GAIN_4P096, 1000);
+  auto *sensor_1 = ads.get_sensor("a1", ADS1115_MULTIPLEXER_P1_NG, ADS1115_GAIN_2P048, 1000);
+  std::vector<std::pair<Sensor *, float>> published;
+  for (auto *sensor : {sensor_0, sensor_1})
+    sensor->add_on_state_callback([&published, sensor](float state) { published.emplace_back(sensor, state); });
+  ads.setup();
+  EXPECT(!ads.is_failed());
+
+  // Both sensors are due, the second measurement waits for the first one.
+  i2c_sim_events.clear();
+  const uint32_t max_call_us = run(bus, {&ads}, 20);
+  EXPECT(max_call_us == 0);
+  EXPECT(chip.conversions == 2);
+  // The intervals have random offsets, the order of the sensors isn't fixed.
+  const std::vector<std::pair<Sensor *, float>> expected = {{sensor_0, 2.0f}, {sensor_1, -0.5f}};
+  std::sort(published.begin(), published.end());
+  EXPECT(published == expected);
+  EXPECT(!ads.status_has_warning());
+  // Per measurement: start the conversion, one poll of the config register 2 ms later (the conversion is done
+  // then), read the conversion register.
+  EXPECT(i2c_sim_events.size() == 10);
+  if (i2c_sim_events.size() == 10) {
+    for (size_t i = 0; i < 10; i += 5) {
+      EXPECT(!i2c_sim_events[i].read && i2c_sim_events[i].reg == 1 && i2c_sim_events[i].len == 2);
+      EXPECT(i2c_sim_events[i + 2].read && i2c_sim_events[i + 2].reg == 1);
+      EXPECT(i2c_sim_events[i + 2].time_us - i2c_sim_events[i].time_us == 2000);
+      EXPECT(i2c_sim_events[i + 4].read && i2c_sim_events[i + 4].reg == 0);
+    }
+  }
+
+  // A conversion that never finishes gives up after 100 ms, the queued sensor is measured after it.
+  published.clear();
+  chip.stuck = true;
+  run(bus, {&ads}, 1250);
+  EXPECT(chip.conversions == 4);
+  EXPECT(ads.status_has_warning());
+  EXPECT(published.empty());
+  chip.stuck = false;
+  run(bus, {&ads}, 1000);
+  EXPECT(chip.conversions == 6);
+  EXPECT(!ads.status_has_warning());
+  std::sort(published.begin(), published.end());
+  EXPECT(published == expected);
+}
+
+/// A BME280: a forced measurement starts with a write of the control register, the data registers only have the
+/// results once it's done (with the maximum measurement time of the datasheet).
+class SimBME280 : public I2CSimDevice {
+ public:
+  explicit SimBME280(uint8_t address) : I2CSimDevice(address) {
+    this->registers[0xD0] = 0x60;
+    // The calibration of the datasheet's example, and a humidity calibration of a real chip.
+    const uint16_t t_p[12] = {27504, 26435, uint16_t(-1000), 36477, uint16_t(-10685), 3024, 2855, 140,
+                              uint16_t(-7), 15500, uint16_t(-14600), 6000};
+    for (uint8_t i = 0; i < 12; i++) {
+      this->registers[0x88 + i * 2] = t_p[i] & 0xFF;
+      this->registers[0x89 + i * 2] = t_p[i] >> 8;
+    }
+    this->registers[0xA1] = 75;
+    this->registers[0xE1] = 362 & 0xFF;
+    this->registers[0xE2] = 362 >> 8;
+    this->registers[0xE3] = 0;
+    // h4 = 313, h5 = 50
+    this->registers[0xE4] = 313 >> 4;
+    this->registers[0xE5] = ((50 & 0xF) << 4) | (313 & 0xF);
+    this->registers[0xE6] = 50 >> 4;
+    this->registers[0xE7] = 30;
+    // The reset values of the data registers, "skipped".
+    this->registers[0xF7] = 0x80;
+    this->registers[0xFA] = 0x80;
+    this->registers[0xFD] = 0x80;
+  }
+
+  void write_register(uint8_t reg, uint8_t value) override {
+    I2CSimDevice::write_register(reg, value);
+    if (reg != 0xF4 || (value & 0b11) != 0b01)
+      return;
+    const uint8_t osrs_t = (value >> 5) & 0b111, osrs_p = (value >> 2) & 0b111;
+    const uint8_t osrs_h = this->registers[0xF2] & 0b111;
+    uint32_t time_us = 1250;
+    time_us += osrs_t ? 2300 << (osrs_t - 1) : 0;
+    time_us += osrs_p ? (2300 << (osrs_p - 1)) + 575 : 0;
+    time_us += osrs_h ? (2300 << (osrs_h - 1)) + 575 : 0;
+    this->done_at_ = test_time_us + time_us;
+    this->measuring_ = true;
+    this->measurements++;
+  }
+  uint8_t read_register(uint8_t reg) override {
+    if (this->measuring_ && int32_t(test_time_us - this->done_at_) >= 0) {
+      this->measuring_ = false;
+      this->registers[0xF4] &= ~0b11;
+      this->set_adc_(0xF7, this->adc_p);
+      this->set_adc_(0xFA, this->adc_t);
+      this->registers[0xFD] = this->adc_h >> 8;
+      this->registers[0xFE] = this->adc_h & 0xFF;
+    }
+    if (reg >= 0xF7 && this->measuring_)
+      this->early_reads++;
+    return I2CSimDevice::read_register(reg);
+  }
+
+  uint32_t adc_t{519888};
+  uint32_t adc_p{415148};
+  uint16_t adc_h{30000};
+  uint32_t measurements{0};
+  uint32_t early_reads{0};
+
+ protected:
+  void set_adc_(uint8_t reg, uint32_t adc) {
+    this->registers[reg] = adc >> 12;
+    this->registers[reg + 1] = (adc >> 4) & 0xFF;
+    this->registers[reg + 2] = (adc & 0xF) << 4;
+  }
+
+  bool measuring_{false};
+  uint32_t done_at_{0};
+};
+
+/// The humidity with the double precision formula of the datasheet.
+static double bme280_humidity(const SimBME280 &chip, double t_fine) {
+  const double h1 = 75, h2 = 362, h3 = 0, h4 = 313, h5 = 50, h6 = 30;
+  double h = t_fine - 76800.0;
+  h = (chip.adc_h - (h4 * 64.0 + h5 / 16384.0 * h)) *
+      (h2 / 65536.0 * (1.0 + h6 / 67108864.0 * h * (1.0 + h3 / 67108864.0 * h)));
+  h = h * (1.0 - h1 * h / 524288.0);
+  return std::min(100.0, std::max(0.0, h));
+}
+
+static void test_bme280() {
+  I2CComponent bus(4, 5);
+  bus.setup();
+  SimBME280 chip(0x77);
+  BME280Component bme(&bus, "t", "p", "h", 0x77, 60000);
+  std::vector<float> temperature, pressure, humidity;
+  bme.get_temperature_sensor()->add_on_state_callback([&temperature](float state) { temperature.push_back(state); });
+  bme.get_pressure_sensor()->add_on_state_callback([&pressure](float state) { pressure.push_back(state); });
+  bme.get_humidity_sensor()->add_on_state_callback([&humidity](float state) { humidity.push_back(state); });
+  bme.setup();
+  EXPECT(!bme.is_failed());
+  EXPECT((chip.registers[0xF2] & 0b111) == BME280_OVERSAMPLING_16X);
+  EXPECT((chip.registers[0xF5] & 0b11100) == 0);
+
+  // The data is read in one burst once the measurement is done, 112.8 ms with 16x oversampling everywhere.
+  i2c_sim_events.clear();
+  bme.update();
+  const uint32_t max_call_us = run(bus, {&bme}, 150);
+  EXPECT(max_call_us == 0);
+  EXPECT(chip.measurements == 1);
+  EXPECT(chip.early_reads == 0);
+  EXPECT(i2c_sim_events.size() == 3);
+  if (i2c_sim_events.size() == 3) {
+    EXPECT(i2c_sim_events[2].read && i2c_sim_events[2].reg == 0xF7 && i2c_sim_events[2].len == 8);
+    EXPECT(i2c_sim_events[2].time_us - i2c_sim_events[0].time_us >= 112800);
+    EXPECT(i2c_sim_events[2].time_us - i2c_sim_events[0].time_us < 115000);
+  }
+  // The example values of the datasheet: 25.08°C and 100653.27 Pa.
+  EXPECT(temperature.size() == 1 && temperature[0] == 25.08f);
+  EXPECT(pressure.size() == 1 && fabsf(pressure[0] - 1006.5327f) < 0.001f);
+  EXPECT(humidity.size() == 1 && fabs(humidity[0] - bme280_humidity(chip, 128422)) < 0.1);
+  EXPECT(!bme.status_has_warning());
+
+  // Lower oversampling (the humidity setting is written in setup), a shorter wait.
+  bme.set_temperature_oversampling(BME280_OVERSAMPLING_1X);
+  bme.set_pressure_oversampling(BME280_OVERSAMPLING_1X);
+  bme.set_humidity_oversampling(BME280_OVERSAMPLING_NONE);
+  bme.setup();
+  i2c_sim_events.clear();
+  bme.update();
+  run(bus, {&bme}, 20);
+  EXPECT(chip.early_reads == 0);
+  EXPECT(temperature.size() == 2);
+  if (i2c_sim_events.size() == 3)
+    EXPECT(i2c_sim_events[2].time_us - i2c_sim_events[0].time_us <= 7000);
+
+  // The chip stops answering during the measurement, nothing is published.
+  bme.update();
+  run(bus, {&bme}, 1);
+  chip.nack_address = true;
+  run(bus, {&bme}, 20);
+  EXPECT(bme.status_has_warning());
+  EXPECT(temperature.size() == 2);
+  chip.nack_address = false;
+  bme.update();
+  run(bus, {&bme}, 20);
+  EXPECT(!bme.status_has_warning());
+  EXPECT(temperature.size() == 3);
+}
+
+static void test_shared_bus() {
+  // The ADS1115 measurements run while the BME280 measures, on the synchronous path the bus was blocked for that.
+  I2CComponent bus(4, 5);
+  bus.setup();
+  SimBME280 bme_chip(0x76);
+  SimADS1115 ads_chip(0x48);
+  ads_chip.inputs[ADS1115_MULTIPLEXER_P0_NG] = 8000;
+  BME280Component bme(&bus, "t", "p", "h", 0x76, 60000);
+  ADS1115Component ads(&bus, 0x48);
+  auto *sensor = ads.get_sensor("a0", ADS1115_MULTIPLEXER_P0_NG, ADS1115_GAIN_6P144, 20);
+  bme.setup();
+  ads.setup();
+  uint32_t ads_published = 0, bme_published = 0;
+  sensor->add_on_state_callback([&ads_published](float) { ads_published++; });
+  bme.get_temperature_sensor()->add_on_state_callback([&bme_published](float) { bme_published++; });
+
+  bme.update();
+  run(bus, {&bme, &ads}, 100);
+  EXPECT(bme_published == 0);
+  EXPECT(ads_published >= 4);
+  run(bus, {&bme, &ads}, 20);
+  EXPECT(bme_published == 1);
+  EXPECT(bme_chip.early_reads == 0);
+  EXPECT(!ads.status_has_warning() && !bme.status_has_warning());
+}
+
+int main() {
+  test_ordering();
+  test_errors();
+  test_ads1115();
+  test_bme280();
+  test_shared_bus();
+  return test_result();
+}
@@ -0,0 +1,126 @@
+// The MY9231 bit stream, traced on the simulated GPIO registers: the driver writes DI and DCKI through the GPIO
+// set/clear registers, and the result has to be the same as through the virtual GPIOPin methods, for all
+// combinations of inverted pins. The trace is decoded like the chips do: DI is latched on both edges of DCKI,
+// and DI pulses while DCKI doesn't change are commands.
+#include "test_helpers.h"
+#include "gpio_sim.h"
+#include "esphome/output/my9231_output_component.cpp"
+
+using namespace esphome;
+using namespace esphome::output;
+
+static const uint8_t PIN_DI = 4;
+static const uint8_t PIN_DCKI = 5;
+
+/// An internal pin that claims not to be, so that FastGPIOPin uses the virtual methods.
+class SlowPin : public GPIOPin {
+ public:
+  SlowPin(uint8_t pin, bool inverted) : GPIOPin(pin, OUTPUT, inverted) {}
+  bool is_internal() const override { return false; }
+};
+
+/// A decoded part of the stream: a data bit latched on a DCKI edge, or a number of DI pulses.
+struct Token {
+  bool pulses;
+  uint16_t value;
+  bool operator==(const Token &other) const { return this->pulses == other.pulses && this->value == other.value; }
+};
+
+static std::vector<Token> decode(bool di_inverted, bool dcki_inverted) {
+  std::vector<Token> tokens;
+  bool di = false;
+  uint16_t falling = 0;
+  for (auto &event : gpio_sim_events) {
+    const bool level = event.level != (event.pin == PIN_DI ? di_inverted : dcki_inverted);
+    if (event.pin == PIN_DI) {
+      if (di && !level)
+        falling++;
+      di = level;
+    } else if (event.pin == PIN_DCKI) {
+      // A single falling edge between two DCKI edges is a change of the data bit.
+      if (falling > 1)
+        tokens.push_back(Token{true, falling});
+      falling = 0;
+      tokens.push_back(Token{false, di});
+    }
+  }
+  if (falling > 1)
+    tokens.push_back(Token{true, falling});
+  return tokens;
+}
+
+static void expect_word(std::vector<Token> &tokens, uint16_t value, uint8_t bits) {
+  for (int bit = bits - 1; bit >= 0; bit--)
+    tokens.push_back(Token{false, uint16_t((value >> bit) & 1)});
+}
+
+/// Run the driver with 6 channels on 2 chips at 12 bits, return the decoded stream.
+static std::vector<Token> run(GPIOPin *di, GPIOPin *dcki, bool expect_fast) {
+  const bool di_inverted = di->is_inverted(), dcki_inverted = dcki->is_inverted();
+  // Idle levels, as if the pins were set up before.
+  gpio_sim_poke(0x300, (di_inverted ? 1 << PIN_DI : 0) | (dcki_inverted ? 1 << PIN_DCKI : 0));
+  gpio_sim_events.clear();
+
+  MY9231OutputComponent my9231(di, dcki, 6, 2, 12);
+  my9231.setup();
+  EXPECT(my9231.get_bit_depth() == 12);
+  auto *channel_0 = my9231.create_channel(0);
+  auto *channel_3 = my9231.create_channel(3);
+  auto *channel_5 = my9231.create_channel(5);
+  channel_0->set_level(0.7f);
+  channel_3->set_level(0.2f);
+  my9231.loop();
+  // In a frame, both channels are sent in one transfer at the commit.
+  OutputFrame::begin();
+  channel_0->set_level(0.0f);
+  channel_5->set_level(1.0f);
+  OutputFrame::commit();
+  my9231.loop();
+
+  // FastGPIOPin is created in setup().
+  FastGPIOPin fast_di(di), fast_dcki(dcki);
+  EXPECT(fast_di.is_fast() == expect_fast && fast_dcki.is_fast() == expect_fast);
+  return decode(di_inverted, dcki_inverted);
+}
+
+static std::vector<Token> expected_stream() {
+  std::vector<Token> tokens;
+  // Command mode, the command for each chip (12 bit, APDM, no divider, fast reaction, frame cycle repeat).
+  tokens.push_back(Token{true, 12});
+  for (int chip = 0; chip < 2; chip++)
+    expect_word(tokens, 0x10, 8);
+  tokens.push_back(Token{true, 16});
+  // The initial duty data from setup(), the highest channel first.
+  for (int channel = 5; channel >= 0; channel--)
+    expect_word(tokens, 0, 12);
+  tokens.push_back(Token{true, 8});
+
+  const uint16_t max = 4095;
+  const uint16_t levels[] = {uint16_t(0.7f * max), 0, 0, uint16_t(0.2f * max), 0, 0};
+  for (int channel = 5; channel >= 0; channel--)
+    expect_word(tokens, levels[channel], 12);
+  tokens.push_back(Token{true, 8});
+
+  const uint16_t frame_levels[] = {0, 0, 0, uint16_t(0.2f * max), 0, max};
+  for (int channel = 5; channel >= 0; channel--)
+    expect_word(tokens, frame_levels[channel], 12);
+  tokens.push_back(Token{true, 8});
+  return tokens;
+}
+
+int main() {
+  gpio_sim_begin();
+  const std::vector<Token> expected = expected_stream();
+  for (int inverted = 0; inverted < 4; inverted++) {
+    const bool di_inverted = inverted & 1, dcki_inverted = inverted & 2;
+    GPIOPin fast_di(PIN_DI, OUTPUT, di_inverted), fast_dcki(PIN_DCKI, OUTPUT, dcki_inverted);
+    const std::vector<Token> fast = run(&fast_di, &fast_dcki, true);
+    SlowPin slow_di(PIN_DI, di_inverted), slow_dcki(PIN_DCKI, dcki_inverted);
+    const std::vector<Token> slow = run(&slow_di, &slow_dcki, false);
+    EXPECT(fast == expected);
+    EXPECT(slow == expected);
+    if (fast != expected)
+      fprintf(stderr, "  inverted=%d: %zu tokens, expected %zu\n", inverted, fast.size(), expected.size());
+  }
+  return test_result();
+}
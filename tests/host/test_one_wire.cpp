@@ -0,0 +1,435 @@
+// The 1-Wire engine and the batched Dallas reads against a simulated bus: the pin isn't internal, so every level
+// change and sample goes through the virtual GPIOPin methods, where simulated DS18B20s decode the reset pulses
+// and time slots of the master on the simulated clock and answer them like the real devices (wired-AND).
+#include "test_helpers.h"
+#include "esphome/esp_one_wire.cpp"
+#include "esphome/sensor/dallas_component.cpp"
+
+#include <algorithm>
+
+using namespace esphome;
+using namespace esphome::sensor;
+
+/// A DS18B20 (or another family with its scratch pad) on the simulated bus.
+class SimDevice {
+ public:
+  explicit SimDevice(uint64_t rom, float temperature) : rom_(rom), temperature_(temperature) {
+    // Power-on value of 85°C, 12 bits.
+    const uint8_t pad[9] = {0x50, 0x05, 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10, 0};
+    std::copy(pad, pad + 9, this->scratch_pad_);
+    this->scratch_pad_[8] = crc8(this->scratch_pad_, 8);
+  }
+
+  /// The master pulled the line low.
+  void on_fall(uint32_t now) {
+    bool bit = true;
+    if (this->state_ == State::SEND)
+      bit = this->send_[this->send_index_];
+    else if (this->state_ == State::SEARCH && this->search_slot_ % 3 != 2)
+      // The ROM bit, then its complement.
+      bit = bool((this->rom_ >> (this->search_slot_ / 3)) & 1) != (this->search_slot_ % 3 == 1);
+    if (!bit)
+      this->pull_low_until_ = now + 30;
+  }
+  /// The master released the line after holding it low for the given time.
+  void on_rise(uint32_t now, uint32_t low_us) {
+    if (low_us >= 480) {
+      this->state_ = State::ROM_COMMAND;
+      this->start_receive_(8);
+      this->presence_from_ = now + 30;
+      this->presence_until_ = now + 150;
+      return;
+    }
+    const bool bit = low_us < 15;
+    switch (this->state_) {
+      case State::IDLE:
+        break;
+      case State::SEND:
+        this->send_index_++;
+        if (this->send_index_ == this->send_.size())
+          this->state_ = State::IDLE;
+        break;
+      case State::SEARCH:
+        this->search_step_(bit);
+        break;
+      default:
+        this->receive_value_ |= uint64_t(bit) << this->receive_bits_;
+        if (++this->receive_bits_ == this->receive_length_)
+          this->on_received_(now);
+        break;
+    }
+  }
+  /// Whether the device holds the line low.
+  bool pulls_low(uint32_t now) const {
+    if (now < this->pull_low_until_)
+      return true;
+    return this->presence_from_ <= now && now < this->presence_until_;
+  }
+
+  uint64_t get_rom() const { return this->rom_; }
+  const uint8_t *get_scratch_pad() const { return this->scratch_pad_; }
+  uint32_t get_conversions() const { return this->conversions_; }
+  /// Flip a bit of each scratch pad that's sent.
+  void set_corrupt(bool corrupt) { this->corrupt_ = corrupt; }
+
+ protected:
+  enum class State { IDLE, ROM_COMMAND, MATCH_ROM, SEARCH, FUNCTION_COMMAND, WRITE_SCRATCH_PAD, SEND };
+
+  void start_receive_(uint8_t bits) {
+    this->receive_value_ = 0;
+    this->receive_bits_ = 0;
+    this->receive_length_ = bits;
+  }
+  void start_send_(const uint8_t *data, size_t length) {
+    this->send_.clear();
+    for (size_t i = 0; i < length * 8; i++)
+      this->send_.push_back((data[i / 8] >> (i % 8)) & 1);
+    this->send_index_ = 0;
+    this->state_ = State::SEND;
+  }
+  void search_step_(bool direction) {
+    // Devices whose ROM bit differs from the direction the master chose leave the search.
+    const bool rom_bit = (this->rom_ >> (this->search_slot_ / 3)) & 1;
+    if (this->search_slot_ % 3 == 2 && direction != rom_bit)
+      this->state_ = State::IDLE;
+    if (++this->search_slot_ == 64 * 3)
+      this->state_ = State::IDLE;
+  }
+  void on_received_(uint32_t now) {
+    const uint64_t value = this->receive_value_;
+    switch (this->state_) {
+      case State::ROM_COMMAND:
+        if (value == 0x55) {
+          this->state_ = State::MATCH_ROM;
+          this->start_receive_(64);
+        } else if (value == 0xCC) {
+          this->state_ = State::FUNCTION_COMMAND;
+          this->start_receive_(8);
+        } else if (value == 0xF0) {
+          this->state_ = State::SEARCH;
+          this->search_slot_ = 0;
+        } else {
+          this->state_ = State::IDLE;
+        }
+        break;
+      case State::MATCH_ROM:
+        this->state_ = value == this->rom_ ? State::FUNCTION_COMMAND : State::IDLE;
+        this->start_receive_(8);
+        break;
+      case State::FUNCTION_COMMAND:
+        if (value == 0x44) {
+          this->convert_(now);
+          this->state_ = State::IDLE;
+        } else if (value == 0xBE) {
+          this->update_conversion_(now);
+          uint8_t pad[9];
+          std::copy(this->scratch_pad_, this->scratch_pad_ + 9, pad);
+          if (this->corrupt_)
+            pad[0] ^= 0x01;
+          this->start_send_(pad, 9);
+        } else if (value == 0x4E) {
+          this->state_ = State::WRITE_SCRATCH_PAD;
+          this->start_receive_(24);
+        } else {
+          this->state_ = State::IDLE;
+        }
+        break;
+      case State::WRITE_SCRATCH_PAD:
+        this->scratch_pad_[2] = value;
+        this->scratch_pad_[3] = value >> 8;
+        this->scratch_pad_[4] = (value >> 16) | 0x1F;
+        this->scratch_pad_[8] = crc8(this->scratch_pad_, 8);
+        this->state_ = State::IDLE;
+        break;
+      default:
+        break;
+    }
+  }
+  uint8_t resolution_() const { return 9 + ((this->scratch_pad_[4] >> 5) & 3); }
+  void convert_(uint32_t now) {
+    this->conversions_++;
+    this->conversion_done_ = now + (750000u >> (12 - this->resolution_()));
+    this->converting_ = true;
+  }
+  /// The result is copied into the scratch pad once the conversion time of the resolution has passed.
+  void update_conversion_(uint32_t now) {
+    if (!this->converting_ || int32_t(now - this->conversion_done_) < 0)
+      return;
+    this->converting_ = false;
+    int16_t raw = int16_t(this->temperature_ * 16);
+    raw &= ~int16_t((1 << (12 - this->resolution_())) - 1);
+    this->scratch_pad_[0] = raw;
+    this->scratch_pad_[1] = raw >> 8;
+    this->scratch_pad_[8] = crc8(this->scratch_pad_, 8);
+  }
+
+  uint64_t rom_;
+  float temperature_;
+  uint8_t scratch_pad_[9];
+  State state_{State::IDLE};
+  uint64_t receive_value_{0};
+  uint8_t receive_bits_{0};
+  uint8_t receive_length_{0};
+  std::vector<bool> send_;
+  size_t send_index_{0};
+  uint32_t search_slot_{0};
+  uint32_t pull_low_until_{0};
+  uint32_t presence_from_{0};
+  uint32_t presence_until_{0};
+  uint32_t conversions_{0};
+  uint32_t conversion_done_{0};
+  bool converting_{false};
+  bool corrupt_{false};
+};
+
+/// The bus pin of the master, the line is low while the master or a device pulls it low.
+class SimBusPin : public GPIOPin {
+ public:
+  SimBusPin() : GPIOPin(4, INPUT_PULLUP) {}
+
+  void setup() override {}
+  bool is_internal() const override { return false; }
+  void pin_mode(uint8_t mode) override {
+    this->output_ = mode == OUTPUT;
+    this->update_();
+  }
+  void digital_write(bool value) override {
+    this->level_ = value;
+    this->update_();
+  }
+  bool digital_read() override {
+    if (this->driving_low_())
+      return false;
+    for (auto *device : this->devices)
+      if (device->pulls_low(test_time_us))
+        return false;
+    return true;
+  }
+
+  std::vector<SimDevice *> devices;
+  /// Reset pulses and time slots of the master.
+  uint32_t resets{0};
+  uint32_t slots{0};
+
+ protected:
+  bool driving_low_() const { return this->output_ && !this->level_; }
+  void update_() {
+    const bool low = this->driving_low_();
+    if (low == this->low_)
+      return;
+    this->low_ = low;
+    if (low) {
+      this->low_since_ = test_time_us;
+      for (auto *device : this->devices)
+        device->on_fall(test_time_us);
+    } else {
+      const uint32_t low_us = test_time_us - this->low_since_;
+      if (low_us >= 480)
+        this->resets++;
+      else
+        this->slots++;
+      for (auto *device : this->devices)
+        device->on_rise(test_time_us, low_us);
+    }
+  }
+
+  bool output_{false};
+  bool level_{true};
+  bool low_{false};
+  uint32_t low_since_{0};
+};
+
+/// A ROM with the family code and a valid CRC.
+static uint64_t make_rom(uint8_t family, uint64_t serial) {
+  uint64_t rom = family | ((serial & 0xFFFFFFFFFFFFULL) << 8);
+  auto *rom8 = reinterpret_cast<uint8_t *>(&rom);
+  rom8[7] = crc8(rom8, 7);
+  return rom;
+}
+
+class TestDallasComponent : public DallasComponent {
+ public:
+  using DallasComponent::DallasComponent;
+  using DallasComponent::found_sensors_;
+
+  bool engine_idle() const { return this->engine_->is_idle(); }
+};
+
+static void test_search() {
+  // ROMs of several families that share long prefixes, the search has to branch at many bits.
+  SimBusPin pin;
+  ESPOneWire one_wire(&pin);
+  std::vector<uint64_t> roms = {make_rom(0x28, 0x000000000001), make_rom(0x28, 0x000000000003),
+                                make_rom(0x28, 0x800000000001), make_rom(0x22, 0x000000000001),
+                                make_rom(0x28, 0x7FFFFFFFFFFF), make_rom(0x10, 0x123456789ABC)};
+  std::vector<SimDevice> devices;
+  for (uint64_t rom : roms)
+    devices.emplace_back(rom, 20.0f);
+  for (auto &device : devices)
+    pin.devices.push_back(&device);
+
+  // Like search_vec(), but a search that doesn't end fails instead of hanging.
+  std::vector<uint64_t> found;
+  one_wire.reset_search();
+  for (uint64_t address; found.size() <= roms.size() && (address = one_wire.search()) != 0;)
+    found.push_back(address);
+  std::sort(found.begin(), found.end());
+  std::sort(roms.begin(), roms.end());
+  EXPECT(found == roms);
+
+  // An empty bus has no presence pulse.
+  pin.devices.clear();
+  EXPECT(one_wire.search_vec().empty());
+}
+
+static void test_engine() {
+  SimBusPin pin;
+  ESPOneWire one_wire(&pin);
+  ESPOneWireEngine engine(&one_wire);
+  SimDevice first(make_rom(0x28, 1), 21.5f), second(make_rom(0x28, 2), -10.0f);
+  pin.devices = {&first, &second};
+
+  // Operations run in order, transactions end with their callback.
+  uint8_t pad[9] = {};
+  std::vector<int> calls;
+  engine.queue_reset();
+  engine.queue_select(second.get_rom());
+  engine.queue_write8(0xBE);
+  engine.queue_read(pad, sizeof(pad));
+  engine.queue_end_transaction([&calls](bool success) { calls.push_back(success); });
+  EXPECT(!engine.is_idle());
+  // Each process() call stops after its time budget.
+  uint32_t max_call_us = 0;
+  while (!engine.is_idle()) {
+    const uint32_t start = test_time_us;
+    engine.process(2000);
+    max_call_us = std::max(max_call_us, test_time_us - start);
+  }
+  EXPECT(calls == std::vector<int>{1});
+  EXPECT(std::equal(pad, pad + 9, second.get_scratch_pad()));
+  EXPECT(max_call_us < 2000 + 1000);
+
+  // Without a presence pulse the rest of the transaction is skipped, the next transaction runs again.
+  pin.devices.clear();
+  calls.clear();
+  engine.queue_reset();
+  engine.queue_skip();
+  engine.queue_write8(0x44);
+  engine.queue_delay(750);
+  engine.queue_end_transaction([&calls](bool success) { calls.push_back(success); });
+  pin.slots = 0;
+  const uint32_t start = test_time_us;
+  while (!engine.is_idle())
+    engine.process();
+  EXPECT(calls == std::vector<int>{0});
+  EXPECT(pin.slots == 0);
+  EXPECT(test_time_us - start < 10000);
+
+  pin.devices = {&first};
+  engine.queue_reset();
+  engine.queue_skip();
+  engine.queue_write8(0x44);
+  engine.queue_end_transaction([&calls](bool success) { calls.push_back(success); });
+  while (!engine.is_idle())
+    engine.process();
+  EXPECT((calls == std::vector<int>{0, 1}));
+  EXPECT(first.get_conversions() == 1);
+}
+
+/// Run the component loop every millisecond until the engine is idle, returns the longest loop() call.
+static uint32_t run_until_idle(TestDallasComponent &component, uint32_t max_ms) {
+  uint32_t max_call_us = 0;
+  for (uint32_t i = 0; i < max_ms; i++) {
+    const uint32_t start = test_time_us;
+    component.loop();
+    max_call_us = std::max(max_call_us, test_time_us - start);
+    if (component.engine_idle())
+      break;
+    test_time_us += 1000;
+  }
+  return max_call_us;
+}
+
+static void test_dallas() {
+  SimBusPin pin;
+  ESPOneWire one_wire(&pin);
+  // A device with a broken ROM CRC is skipped, the indices count the valid devices only.
+  uint64_t broken_rom = make_rom(0x28, 0x55) ^ (0x01ULL << 56);
+  SimDevice broken(broken_rom, 99.0f);
+  SimDevice a(make_rom(0x28, 0x10), 21.5f), b(make_rom(0x22, 0x20), -10.25f), c(make_rom(0x28, 0x30), 85.5f),
+      d(make_rom(0x28, 0x40), 0.5f);
+  pin.devices = {&broken, &a, &b, &c, &d};
+
+  TestDallasComponent component(&one_wire, 15000);
+  auto *sensor_a = component.get_sensor_by_address("a", a.get_rom(), 9);
+  auto *sensor_b = component.get_sensor_by_address("b", b.get_rom(), 10);
+  auto *sensor_c = component.get_sensor_by_address("c", c.get_rom(), 12);
+  auto *sensor_d = component.get_sensor_by_address("d", d.get_rom(), 11);
+  component.setup();
+  EXPECT(component.found_sensors_.size() == 4);
+  EXPECT(std::find(component.found_sensors_.begin(), component.found_sensors_.end(), broken_rom) ==
+         component.found_sensors_.end());
+  // The resolutions were written to the devices.
+  EXPECT(a.get_scratch_pad()[4] == 0x1F);
+  EXPECT(b.get_scratch_pad()[4] == 0x3F);
+  EXPECT(c.get_scratch_pad()[4] == 0x7F);
+  EXPECT(d.get_scratch_pad()[4] == 0x5F);
+
+  std::vector<std::pair<Sensor *, float>> published;
+  for (auto *sensor : {sensor_a, sensor_b, sensor_c, sensor_d})
+    sensor->add_on_state_callback([&published, sensor](float state) { published.emplace_back(sensor, state); });
+
+  // One conversion of all devices, the reads start once the slowest resolution is done (and not after the sum of
+  // the conversion times).
+  pin.resets = 0;
+  component.update();
+  const uint32_t start = test_time_us;
+  const uint32_t max_call_us = run_until_idle(component, 2000);
+  EXPECT(max_call_us < 3000);
+  EXPECT(pin.resets == 1 + 4);
+  for (auto *device : {&a, &b, &c, &d})
+    EXPECT(device->get_conversions() == 1);
+  EXPECT(test_time_us - start >= 750000);
+  EXPECT(test_time_us - start < 900000);
+  EXPECT(published.size() == 4);
+  EXPECT(!component.status_has_warning());
+  const std::vector<std::pair<Sensor *, float>> expected = {
+      {sensor_a, 21.5f}, {sensor_b, -10.25f}, {sensor_c, 85.5f}, {sensor_d, 0.5f}};
+  EXPECT(published == expected);
+
+  // A scratch pad with a wrong CRC isn't published, the other sensors are.
+  published.clear();
+  b.set_corrupt(true);
+  component.update();
+  run_until_idle(component, 2000);
+  EXPECT(published.size() == 3);
+  EXPECT(component.status_has_warning());
+  for (auto &it : published)
+    EXPECT(it.first != sensor_b);
+  b.set_corrupt(false);
+
+  // An update while the previous one still runs is skipped.
+  component.update();
+  component.loop();
+  EXPECT(!component.engine_idle());
+  pin.resets = 0;
+  component.update();
+  EXPECT(component.status_has_warning());
+  run_until_idle(component, 2000);
+  EXPECT(pin.resets == 4);
+
+  // Without devices the conversion fails and the reads are dropped.
+  published.clear();
+  pin.devices.clear();
+  component.update();
+  run_until_idle(component, 2000);
+  EXPECT(published.empty());
+  EXPECT(component.status_has_warning());
+}
+
+int main() {
+  test_search();
+  test_engine();
+  test_dallas();
+  return test_result();
+}
@@ -0,0 +1,206 @@
+// Round trip of scripts/ota_delta.py and OTADeltaPatcher: create a patch on the host and apply it to a base image
+// in simulated flash, feeding the patch in chunks of random size like the OTA receive loop does.
+#include "test_helpers.h"
+#include "esphome/ota_delta.cpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+
+static const size_t SECTOR_SIZE = 4096;
+
+/// NOR flash that can only be read in aligned words, like the ESP8266 flash the base image is read from.
+class SimFlash {
+ public:
+  explicit SimFlash(size_t size) : data_(size, 0xFF) {}
+
+  bool read_words(uint32_t address, uint32_t *data, size_t len) {
+    if (address % 4 != 0 || len % 4 != 0 || address + len > this->data_.size())
+      return false;
+    memcpy(data, &this->data_[address], len);
+    return true;
+  }
+  void erase(uint32_t sector) { std::fill_n(this->data_.begin() + sector * SECTOR_SIZE, SECTOR_SIZE, 0xFF); }
+  void write(uint32_t address, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++)
+      this->data_[address + i] &= data[i];
+  }
+
+  std::vector<uint8_t> data_;
+};
+
+/// Writes the new image sector by sector like Update does.
+class SimUpdater {
+ public:
+  explicit SimUpdater(SimFlash *flash) : flash_(flash) {}
+
+  bool write(const uint8_t *data, size_t len) {
+    while (len > 0) {
+      const size_t n = std::min(len, SECTOR_SIZE - this->buffer_.size());
+      this->buffer_.insert(this->buffer_.end(), data, data + n);
+      data += n;
+      len -= n;
+      if (this->buffer_.size() == SECTOR_SIZE && !this->flush())
+        return false;
+    }
+    return true;
+  }
+  bool flush() {
+    if (this->buffer_.empty())
+      return true;
+    if ((this->sector_ + 1) * SECTOR_SIZE > this->flash_->data_.size())
+      return false;
+    this->flash_->erase(this->sector_);
+    this->flash_->write(this->sector_ * SECTOR_SIZE, this->buffer_.data(), this->buffer_.size());
+    this->size_ += this->buffer_.size();
+    this->sector_++;
+    this->buffer_.clear();
+    return true;
+  }
+
+  size_t size_{0};
+
+ protected:
+  SimFlash *flash_;
+  std::vector<uint8_t> buffer_;
+  uint32_t sector_{0};
+};
+
+static std::string build_path(const char *name) { return std::string("build/ota_delta_") + name; }
+
+static void write_file(const std::string &path, const std::vector<uint8_t> &data) {
+  FILE *f = fopen(path.c_str(), "wb");
+  fwrite(data.data(), 1, data.size(), f);
+  fclose(f);
+}
+
+static std::vector<uint8_t> read_file(const std::string &path) {
+  std::vector<uint8_t> data;
+  FILE *f = fopen(path.c_str(), "rb");
+  if (f == nullptr)
+    return data;
+  uint8_t block[4096];
+  size_t n;
+  while ((n = fread(block, 1, sizeof(block), f)) > 0)
+    data.insert(data.end(), block, block + n);
+  fclose(f);
+  return data;
+}
+
+static std::string md5_of(const std::string &path) {
+  std::string cmd = "md5sum " + path;
+  FILE *p = popen(cmd.c_str(), "r");
+  char md5[33] = {0};
+  if (p == nullptr || fread(md5, 1, 32, p) != 32)
+    md5[0] = 0;
+  if (p != nullptr)
+    pclose(p);
+  return md5;
+}
+
+static std::vector<uint8_t> create_patch(const std::vector<uint8_t> &base, const std::vector<uint8_t> &image) {
+  write_file(build_path("base.bin"), base);
+  write_file(build_path("new.bin"), image);
+  const char *python = getenv("PYTHON");
+  std::string cmd = std::string(python != nullptr ? python : "python") + " ../../scripts/ota_delta.py " +
+                    build_path("base.bin") + " " + build_path("new.bin") + " " + build_path("patch.bin") +
+                    " > /dev/null";
+  EXPECT(system(cmd.c_str()) == 0);
+  return read_file(build_path("patch.bin"));
+}
+
+/// Apply the patch to base (stored at the start of the simulated flash), return the new image.
+static std::vector<uint8_t> apply_patch(const std::vector<uint8_t> &base, const std::string &base_md5,
+                                        const std::vector<uint8_t> &patch, uint32_t seed, bool *ok) {
+  SimFlash base_flash((base.size() + SECTOR_SIZE - 1) / SECTOR_SIZE * SECTOR_SIZE);
+  base_flash.write(0, base.data(), base.size());
+  SimFlash ota_flash(base_flash.data_.size() * 2);
+  SimUpdater updater(&ota_flash);
+
+  auto read_base = [&base_flash](uint32_t offset, uint8_t *data, size_t len) {
+    // Word aligned reads only, like ota_read_base on the ESP8266
+    uint32_t words[16];
+    while (len > 0) {
+      const uint32_t aligned = offset & ~3UL;
+      const size_t skip = offset - aligned;
+      const size_t n = std::min(len, sizeof(words) - skip);
+      if (!base_flash.read_words(aligned, words, (skip + n + 3) & ~3UL))
+        return false;
+      memcpy(data, reinterpret_cast<uint8_t *>(words) + skip, n);
+      offset += n;
+      data += n;
+      len -= n;
+    }
+    return true;
+  };
+  OTADeltaPatcher patcher(base_md5, base.size(), read_base,
+                          [&updater](const uint8_t *data, size_t len) { return updater.write(data, len); });
+
+  std::mt19937 rng(seed);
+  *ok = true;
+  for (size_t pos = 0; pos < patch.size() && *ok;) {
+    const size_t n = std::min(patch.size() - pos, size_t(1 + rng() % 3000));
+    *ok = patcher.write(&patch[pos], n);
+    pos += n;
+  }
+  *ok = *ok && patcher.is_finished() && updater.flush();
+  return std::vector<uint8_t>(ota_flash.data_.begin(), ota_flash.data_.begin() + updater.size_);
+}
+
+int main() {
+  std::mt19937 rng(42);
+  // Something that looks like code: random bytes with repeated instruction-like patterns.
+  std::vector<uint8_t> base(300000);
+  for (size_t i = 0; i < base.size(); i++)
+    base[i] = (i % 7 == 0) ? 0x40 : rng() & 0xFF;
+
+  // The new image: inserted code (shifts everything after it), relocated addresses (small changes every few
+  // bytes), a block moved to another place and new data at the end.
+  std::vector<uint8_t> image(base.begin(), base.begin() + 10000);
+  for (int i = 0; i < 333; i++)
+    image.push_back(rng() & 0xFF);
+  image.insert(image.end(), base.begin() + 10000, base.begin() + 150000);
+  for (size_t i = 20000; i < 60000; i += 16)
+    image[i] += 4;
+  image.insert(image.end(), base.begin() + 250000, base.end());
+  image.insert(image.end(), base.begin() + 150000, base.begin() + 250000);
+  for (int i = 0; i < 2000; i++)
+    image.push_back(rng() & 0xFF);
+
+  const std::vector<uint8_t> patch = create_patch(base, image);
+  const std::string base_md5 = md5_of(build_path("base.bin"));
+  EXPECT(base_md5.size() == 32);
+  EXPECT(!patch.empty());
+  // Most of the image comes from the base image
+  EXPECT(patch.size() < image.size() / 5);
+
+  for (uint32_t seed = 1; seed <= 5; seed++) {
+    bool ok;
+    auto result = apply_patch(base, base_md5, patch, seed, &ok);
+    EXPECT(ok);
+    EXPECT(result == image);
+  }
+
+  // A patch for another base image is rejected before anything is written
+  {
+    std::vector<uint8_t> other = base;
+    other[1234] ^= 1;
+    bool ok;
+    auto result = apply_patch(other, md5_of(build_path("new.bin")), patch, 1, &ok);
+    EXPECT(!ok);
+    EXPECT(result.empty());
+  }
+  // A truncated patch doesn't finish
+  {
+    bool ok;
+    std::vector<uint8_t> truncated(patch.begin(), patch.end() - 100);
+    apply_patch(base, base_md5, truncated, 1, &ok);
+    EXPECT(!ok);
+  }
+
+  return test_result();
+}
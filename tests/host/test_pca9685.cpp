@@ -0,0 +1,190 @@
+// The i2c transactions of the PCA9685 on a simulated bus: only the channels that changed are written, in
+// auto-increment bursts of up to 7 channels (the register and 28 bytes fit the 32 byte Wire buffer), and all 16
+// channels with the same level take a single write to the ALL_LED registers. The simulated chip decodes the
+// registers, so each check also compares the PWM of every channel with its level.
+#include "test_helpers.h"
+#include "i2c_sim.h"
+#include "esphome/output/pca9685_output_component.cpp"
+
+using namespace esphome;
+using namespace esphome::output;
+
+/// A PCA9685, the writes to ALL_LED go to the registers of all channels.
+class SimPCA9685 : public I2CSimDevice {
+ public:
+  SimPCA9685() : I2CSimDevice(PCA9685_ADDRESS) {}
+  void write_register(uint8_t reg, uint8_t value) override {
+    if (reg >= PCA9685_REGISTER_ALL_LED && reg < PCA9685_REGISTER_ALL_LED + 4) {
+      for (uint8_t channel = 0; channel < 16; channel++)
+        this->registers[PCA9685_REGISTER_LED0 + 4 * channel + reg - PCA9685_REGISTER_ALL_LED] = value;
+      return;
+    }
+    I2CSimDevice::write_register(reg, value);
+  }
+  /// The time the channel is on per 4096 clocks.
+  uint16_t duty(uint8_t channel) const {
+    const uint8_t *led = this->registers + PCA9685_REGISTER_LED0 + 4 * channel;
+    const uint16_t on = led[0] | (led[1] << 8);
+    const uint16_t off = led[2] | (led[3] << 8);
+    if (off & 0x1000)
+      return 0;
+    if (on & 0x1000)
+      return 4096;
+    return (off - on) & 0xFFF;
+  }
+};
+
+struct Setup {
+  explicit Setup(uint16_t channels) : bus(4, 5), pca9685(&bus, 1000.0f) {
+    for (uint8_t channel = 0; channel < 16; channel++)
+      this->outputs[channel] = channels & (1 << channel) ? this->pca9685.create_channel(channel) : nullptr;
+    this->pca9685.setup();
+    i2c_sim_events.clear();
+  }
+
+  /// Set the levels and return the number of transactions the next loop() takes.
+  uint32_t set_levels(const float *levels) {
+    for (uint8_t channel = 0; channel < 16; channel++) {
+      if (this->outputs[channel] != nullptr)
+        this->outputs[channel]->set_level(levels[channel]);
+    }
+    return this->loop();
+  }
+
+  uint32_t loop() {
+    i2c_sim_events.clear();
+    const uint32_t transactions = Wire.transmissions + Wire.requests;
+    this->pca9685.loop();
+    for (const auto &event : i2c_sim_events)
+      // The register and the data have to fit the Wire buffer.
+      EXPECT(!event.read && 1 + event.len <= 32);
+    return Wire.transmissions + Wire.requests - transactions;
+  }
+
+  void expect_duty(const float *levels) {
+    for (uint8_t channel = 0; channel < 16; channel++) {
+      if (this->outputs[channel] != nullptr)
+        EXPECT(this->chip.duty(channel) == uint16_t(roundf(levels[channel] * 4096)));
+    }
+  }
+
+  SimPCA9685 chip;
+  I2CComponent bus;
+  PCA9685OutputComponent pca9685;
+  PCA9685OutputComponent::Channel *outputs[16];
+};
+
+static void test_bursts() {
+  Setup setup(0xFFFF);
+  float levels[16];
+  for (uint8_t channel = 0; channel < 16; channel++)
+    levels[channel] = (channel + 1) / 20.0f;
+
+  // The channels written by setup() are clean.
+  EXPECT(setup.loop() == 0);
+
+  // All 16 channels changed: bursts of 7, 7 and 2 channels.
+  EXPECT(setup.set_levels(levels) == 3);
+  EXPECT(i2c_sim_events.size() == 3);
+  if (i2c_sim_events.size() == 3) {
+    EXPECT(i2c_sim_events[0].reg == PCA9685_REGISTER_LED0 && i2c_sim_events[0].len == 28);
+    EXPECT(i2c_sim_events[1].reg == PCA9685_REGISTER_LED0 + 4 * 7 && i2c_sim_events[1].len == 28);
+    EXPECT(i2c_sim_events[2].reg == PCA9685_REGISTER_LED0 + 4 * 14 && i2c_sim_events[2].len == 8);
+  }
+  setup.expect_duty(levels);
+
+  // Nothing changed.
+  EXPECT(setup.set_levels(levels) == 0);
+
+  // One channel.
+  levels[9] = 0.75f;
+  EXPECT(setup.set_levels(levels) == 1);
+  EXPECT(i2c_sim_events.size() == 1 && i2c_sim_events[0].reg == PCA9685_REGISTER_LED0 + 4 * 9);
+  setup.expect_duty(levels);
+
+  // Single clean channels between dirty ones are rewritten in the burst: 0-4 and 8-12, not 0, 2, 4, 8, 10, 12.
+  for (uint8_t channel : {0, 2, 4, 8, 10, 12})
+    levels[channel] += 0.1f;
+  EXPECT(setup.set_levels(levels) == 2);
+  EXPECT(i2c_sim_events.size() == 2 && i2c_sim_events[0].len == 20 && i2c_sim_events[1].len == 20);
+  setup.expect_duty(levels);
+
+  // Two clean channels end the burst.
+  levels[0] = 0.0f;
+  levels[3] = 1.0f;
+  EXPECT(setup.set_levels(levels) == 2);
+  setup.expect_duty(levels);
+
+  // A burst of 7 dirty channels with clean channels in between still ends at 7 channels: 0-6 and 8.
+  for (uint8_t channel : {0, 2, 4, 6, 8})
+    levels[channel] = 0.5f - channel / 100.0f;
+  EXPECT(setup.set_levels(levels) == 2);
+  EXPECT(i2c_sim_events.size() == 2 && i2c_sim_events[0].len == 28 && i2c_sim_events[1].len == 4);
+  setup.expect_duty(levels);
+}
+
+static void test_all_led() {
+  Setup setup(0xFFFF);
+  float levels[16];
+
+  // All channels at the same level take a single write to ALL_LED.
+  for (float level : {0.5f, 1.0f, 0.0f, 0.25f}) {
+    std::fill(levels, levels + 16, level);
+    EXPECT(setup.set_levels(levels) == 1);
+    EXPECT(i2c_sim_events.size() == 1 && i2c_sim_events[0].reg == PCA9685_REGISTER_ALL_LED &&
+           i2c_sim_events[0].len == 4);
+    setup.expect_duty(levels);
+  }
+
+  // Only some of the channels changed to the level of the others.
+  levels[5] = 0.8f;
+  EXPECT(setup.set_levels(levels) == 1);
+  EXPECT(i2c_sim_events.size() == 1 && i2c_sim_events[0].reg == PCA9685_REGISTER_LED0 + 4 * 5);
+  levels[5] = 0.25f;
+  EXPECT(setup.set_levels(levels) == 1);
+  EXPECT(i2c_sim_events.size() == 1 && i2c_sim_events[0].reg == PCA9685_REGISTER_ALL_LED);
+  setup.expect_duty(levels);
+}
+
+static void test_unused_channels() {
+  // The channels the component doesn't own keep their registers: no ALL_LED, and no bursts over them.
+  Setup setup(0x00FF | 0x0A00);
+  float levels[16];
+  std::fill(levels, levels + 16, 0.5f);
+  setup.chip.registers[PCA9685_REGISTER_LED0 + 4 * 8] = 0x12;
+  EXPECT(setup.set_levels(levels) == 4);
+  EXPECT(i2c_sim_events.size() == 4);
+  if (i2c_sim_events.size() == 4) {
+    EXPECT(i2c_sim_events[0].reg == PCA9685_REGISTER_LED0 && i2c_sim_events[0].len == 28);
+    EXPECT(i2c_sim_events[1].reg == PCA9685_REGISTER_LED0 + 4 * 7 && i2c_sim_events[1].len == 4);
+    EXPECT(i2c_sim_events[2].reg == PCA9685_REGISTER_LED0 + 4 * 9 && i2c_sim_events[2].len == 4);
+    EXPECT(i2c_sim_events[3].reg == PCA9685_REGISTER_LED0 + 4 * 11 && i2c_sim_events[3].len == 4);
+  }
+  EXPECT(setup.chip.registers[PCA9685_REGISTER_LED0 + 4 * 8] == 0x12);
+  setup.expect_duty(levels);
+}
+
+static void test_frame() {
+  // In a frame the changes are written when it's committed, not again in loop().
+  Setup setup(0xFFFF);
+  float levels[16];
+  for (uint8_t channel = 0; channel < 16; channel++)
+    levels[channel] = channel / 16.0f;
+  const uint32_t transactions = Wire.transmissions;
+  OutputFrame::begin();
+  for (uint8_t channel = 0; channel < 16; channel++)
+    setup.outputs[channel]->set_level(levels[channel]);
+  EXPECT(Wire.transmissions == transactions);
+  OutputFrame::commit();
+  EXPECT(Wire.transmissions == transactions + 3);
+  EXPECT(setup.loop() == 0);
+  setup.expect_duty(levels);
+}
+
+int main() {
+  test_bursts();
+  test_all_led();
+  test_unused_channels();
+  test_frame();
+  return test_result();
+}
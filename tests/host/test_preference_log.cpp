@@ -0,0 +1,200 @@
+// Power loss simulation for ESPPreferenceLog: cut the power after every single flash word write and erase of a
+// sequence of flushes, and check that loading afterwards always yields the last committed (or the new) image.
+#include "test_helpers.h"
+#include "esphome/esppreferences_log.cpp"
+
+#include <vector>
+#include <random>
+
+using namespace esphome;
+
+/// NOR flash: erase sets all bits, writes can only clear bits. Runs out of power after a number of operations.
+class SimFlash : public ESPPreferenceFlash {
+ public:
+  explicit SimFlash(uint8_t sectors) : data_(sectors * SECTOR_SIZE / 4, 0xFFFFFFFF) {}
+
+  bool read(uint8_t sector, uint32_t offset, uint32_t *data, size_t words) override {
+    for (size_t i = 0; i < words; i++)
+      data[i] = this->data_[(sector * SECTOR_SIZE + offset) / 4 + i];
+    return true;
+  }
+  bool write(uint8_t sector, uint32_t offset, const uint32_t *data, size_t words) override {
+    for (size_t i = 0; i < words; i++) {
+      if (!this->use_power_())
+        return false;
+      this->data_[(sector * SECTOR_SIZE + offset) / 4 + i] &= data[i];
+    }
+    return true;
+  }
+  bool erase(uint8_t sector) override {
+    if (!this->use_power_())
+      return false;
+    this->erases_++;
+    std::fill(this->data_.begin() + sector * SECTOR_SIZE / 4, this->data_.begin() + (sector + 1) * SECTOR_SIZE / 4,
+              0xFFFFFFFF);
+    return true;
+  }
+
+  /// Number of operations until the power is lost, -1 for unlimited.
+  int budget{-1};
+  /// Index of a single operation that fails without losing power (e.g. a timeout), -1 for none.
+  int fail_at{-1};
+  int ops_{0};
+  bool powered{true};
+  int erases_{0};
+
+ protected:
+  bool use_power_() {
+    if (!this->powered)
+      return false;
+    if (this->ops_++ == this->fail_at)
+      return false;
+    if (this->budget == 0) {
+      this->powered = false;
+      return false;
+    }
+    if (this->budget > 0)
+      this->budget--;
+    return true;
+  }
+
+  std::vector<uint32_t> data_;
+};
+
+static const uint16_t WORDS = 128;
+
+struct Change {
+  uint16_t offset;
+  uint16_t length;
+  uint32_t value;
+};
+
+static void apply(std::vector<uint32_t> &image, const Change &change) {
+  for (uint16_t i = 0; i < change.length; i++)
+    image[change.offset + i] = change.value + i;
+}
+
+static void test_power_loss(uint8_t sectors, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::vector<Change> changes;
+  for (int i = 0; i < 500; i++) {
+    Change change;
+    change.length = 1 + rng() % 16;
+    change.offset = rng() % (WORDS - change.length + 1);
+    change.value = rng();
+    changes.push_back(change);
+  }
+
+  // Count the operations of a complete run first
+  int total_ops;
+  {
+    SimFlash flash(sectors);
+    std::vector<uint32_t> image(WORDS, 0);
+    ESPPreferenceLog log(&flash, sectors, image.data(), WORDS);
+    log.load();
+    flash.budget = 1 << 30;
+    for (auto &change : changes) {
+      apply(image, change);
+      EXPECT(log.append(change.offset, change.length));
+    }
+    total_ops = (1 << 30) - flash.budget;
+    EXPECT(flash.erases_ > sectors);
+  }
+
+  for (int cut = 0; cut < total_ops; cut += 1 + cut / 200) {
+    SimFlash flash(sectors);
+    std::vector<uint32_t> image(WORDS, 0);
+    std::vector<uint32_t> committed(WORDS, 0);
+    ESPPreferenceLog log(&flash, sectors, image.data(), WORDS);
+    log.load();
+    flash.budget = cut;
+    std::vector<uint32_t> pending;
+    for (auto &change : changes) {
+      apply(image, change);
+      if (!log.append(change.offset, change.length)) {
+        pending = image;
+        break;
+      }
+      committed = image;
+    }
+
+    std::vector<uint32_t> loaded(WORDS, 0);
+    ESPPreferenceLog reloaded(&flash, sectors, loaded.data(), WORDS);
+    bool found = reloaded.load();
+    if (committed == std::vector<uint32_t>(WORDS, 0) && !found)
+      continue;
+    EXPECT(found);
+    EXPECT(loaded == committed || loaded == pending);
+
+    // The reloaded log must accept new records after the power comes back
+    flash.powered = true;
+    flash.budget = -1;
+    loaded[0] ^= 1;
+    EXPECT(reloaded.append(0, 1));
+    std::vector<uint32_t> again(WORDS, 0);
+    ESPPreferenceLog third(&flash, sectors, again.data(), WORDS);
+    EXPECT(third.load());
+    EXPECT(again == loaded);
+  }
+}
+
+/// A failed write or erase must not cost the last committed image, even when the log keeps being written to.
+static void test_transient_failure(uint8_t sectors) {
+  for (int fail_at = 0; fail_at < 4000; fail_at += 7) {
+    SimFlash flash(sectors);
+    std::vector<uint32_t> image(WORDS, 0);
+    std::vector<uint32_t> committed(WORDS, 0);
+    ESPPreferenceLog log(&flash, sectors, image.data(), WORDS);
+    log.load();
+    flash.fail_at = fail_at;
+    std::mt19937 rng(fail_at);
+    for (int i = 0; i < 200; i++) {
+      Change change;
+      change.length = 1 + rng() % 16;
+      change.offset = rng() % (WORDS - change.length + 1);
+      change.value = rng();
+      apply(image, change);
+      if (log.append(change.offset, change.length))
+        committed = image;
+
+      std::vector<uint32_t> loaded(WORDS, 0);
+      ESPPreferenceLog reloaded(&flash, sectors, loaded.data(), WORDS);
+      if (reloaded.load() || committed != std::vector<uint32_t>(WORDS, 0))
+        EXPECT(loaded == committed || loaded == image);
+    }
+  }
+}
+
+static void test_single_sector() {
+  SimFlash flash(1);
+  std::vector<uint32_t> image(WORDS, 0);
+  ESPPreferenceLog log(&flash, 1, image.data(), WORDS);
+  EXPECT(!log.load());
+  EXPECT(!log.append(0, 1));
+  EXPECT(!log.compact());
+  EXPECT(flash.erases_ == 0);
+}
+
+static void test_first_compaction_keeps_last_sector() {
+  SimFlash flash(3);
+  const uint32_t legacy = 0x12345678;
+  flash.write(2, 0, &legacy, 1);
+  std::vector<uint32_t> image(WORDS, 0);
+  ESPPreferenceLog log(&flash, 3, image.data(), WORDS);
+  EXPECT(!log.load());
+  EXPECT(log.append(0, 4));
+  uint32_t word;
+  flash.read(2, 0, &word, 1);
+  EXPECT(word == legacy);
+}
+
+int main() {
+  test_single_sector();
+  test_first_compaction_keeps_last_sector();
+  for (uint8_t sectors = 2; sectors <= 4; sectors++)
+    test_transient_failure(sectors);
+  for (uint8_t sectors = 2; sectors <= 4; sectors++)
+    for (uint32_t seed = 1; seed <= 3; seed++)
+      test_power_loss(sectors, seed);
+  return test_result();
+}
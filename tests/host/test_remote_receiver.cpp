@@ -0,0 +1,196 @@
+// The ESP8266 edge ring of the remote receiver on synthetic edge streams: the pin interrupt is called for each
+// edge on the simulated clock, and the frames that loop() splits off the ring are compared with what was sent,
+// also when the ring wraps around, several frames queue up, a level doesn't fit into an item, or the ring
+// overflows.
+#include "test_helpers.h"
+#include "esphome/remote/remote_receiver.cpp"
+
+#include <random>
+
+using namespace esphome;
+using namespace esphome::remote;
+
+static const uint8_t PIN_RX = 14;
+static const uint32_t IDLE_US = 10000;
+
+/// The registers the pin reads the line level from.
+static volatile uint32_t registers[0x800 / 4];
+
+class TestReceiver : public RemoteReceiverComponent {
+ public:
+  explicit TestReceiver(uint32_t buffer_size) : RemoteReceiverComponent(new GPIOPin(PIN_RX, INPUT)) {
+    this->set_buffer_size(buffer_size);
+    this->set_idle_us(IDLE_US);
+    this->add_dumper(&this->dumper);
+    GPI &= ~(1 << PIN_RX);
+    this->setup();
+  }
+
+  /// Change the line level after the given time, the interrupt sees the edge right away.
+  void edge(uint32_t after_us) {
+    test_time_us += after_us;
+    this->level_ = !this->level_;
+    if (this->level_)
+      GPI |= 1 << PIN_RX;
+    else
+      GPI &= ~(1 << PIN_RX);
+    RemoteReceiverComponentStore::gpio_intr(&this->store_);
+  }
+  /// Send a frame after an idle line, durations alternate between marks and spaces, starting with a mark.
+  void send(const std::vector<uint32_t> &durations, uint32_t idle_before_us = 2 * IDLE_US) {
+    this->edge(idle_before_us);
+    for (uint32_t duration : durations)
+      this->edge(duration);
+  }
+  /// Run loop() every millisecond for the given time.
+  void run(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+      test_time_us += 1000;
+      this->loop();
+    }
+  }
+
+  /// Remembers each frame it's given.
+  class FrameDumper : public RemoteReceiveDumper {
+   public:
+    bool dump(RemoteReceiveData *data) override {
+      std::vector<int32_t> frame;
+      for (int32_t i = 0; i < data->size(); i++)
+        frame.push_back(data->pos(i));
+      this->frames.push_back(frame);
+      return true;
+    }
+    std::vector<std::vector<int32_t>> frames;
+  } dumper;
+
+ protected:
+  bool level_{false};
+};
+
+/// What the dumper sees for a sent frame: signed durations, then the idle space that ended it.
+static std::vector<int32_t> expected_frame(const std::vector<uint32_t> &durations) {
+  std::vector<int32_t> frame;
+  for (size_t i = 0; i < durations.size(); i++)
+    frame.push_back(i % 2 == 0 ? int32_t(durations[i]) : -int32_t(durations[i]));
+  frame.push_back(-int32_t(IDLE_US));
+  return frame;
+}
+
+/// A frame with an odd number of levels (ending with a mark) of 100us to 5ms.
+static std::vector<uint32_t> random_frame(std::mt19937 &rng, size_t min_levels, size_t max_levels) {
+  std::vector<uint32_t> durations((min_levels + rng() % (max_levels - min_levels + 1)) | 1);
+  for (auto &duration : durations)
+    duration = 100 + rng() % 4900;
+  return durations;
+}
+
+static void test_frames() {
+  std::mt19937 rng(1);
+  TestReceiver receiver(1000);
+  for (int i = 0; i < 100; i++) {
+    const auto durations = random_frame(rng, 3, 99);
+    receiver.send(durations);
+    // Not complete before the line was idle for long enough.
+    receiver.run(IDLE_US / 1000 - 1);
+    EXPECT(receiver.dumper.frames.empty());
+    receiver.run(2);
+    EXPECT(receiver.dumper.frames.size() == 1);
+    if (receiver.dumper.frames.size() == 1)
+      EXPECT(receiver.dumper.frames[0] == expected_frame(durations));
+    receiver.dumper.frames.clear();
+  }
+}
+
+static void test_wraparound() {
+  // A ring of 64 items wraps around every few frames, the largest frames (62 items with the idle space that
+  // starts them) still fit.
+  std::mt19937 rng(2);
+  TestReceiver receiver(64);
+  for (int i = 0; i < 300; i++) {
+    const auto durations = random_frame(rng, 21, 61);
+    receiver.send(durations);
+    receiver.run(IDLE_US / 1000 + 1);
+    EXPECT(receiver.dumper.frames.size() == 1);
+    if (receiver.dumper.frames.size() == 1)
+      EXPECT(receiver.dumper.frames[0] == expected_frame(durations));
+    receiver.dumper.frames.clear();
+  }
+}
+
+static void test_queued_frames() {
+  // loop() was late, the frames separated by idle levels are all decoded in order.
+  std::mt19937 rng(3);
+  TestReceiver receiver(1000);
+  std::vector<std::vector<uint32_t>> sent;
+  for (int i = 0; i < 5; i++) {
+    sent.push_back(random_frame(rng, 3, 99));
+    receiver.send(sent.back(), IDLE_US + rng() % 30000);
+  }
+  receiver.run(IDLE_US / 1000 + 1);
+  EXPECT(receiver.dumper.frames.size() == sent.size());
+  for (size_t i = 0; i < sent.size() && i < receiver.dumper.frames.size(); i++)
+    EXPECT(receiver.dumper.frames[i] == expected_frame(sent[i]));
+}
+
+static void test_long_levels() {
+  // A mark longer than fits into an item ends the frame, even if the idle time is longer.
+  TestReceiver receiver(1000);
+  receiver.set_idle_us(50000);
+  receiver.send({500, 600, 700, 800, 40000, 900, 1000, 1100, 1200}, 60000);
+  receiver.run(60);
+  EXPECT(receiver.dumper.frames.size() == 2);
+  if (receiver.dumper.frames.size() == 2) {
+    EXPECT((receiver.dumper.frames[0] == std::vector<int32_t>{500, -600, 700, -800, -50000}));
+    EXPECT((receiver.dumper.frames[1] == std::vector<int32_t>{-900, 1000, -1100, 1200, -50000}));
+  }
+}
+
+static void test_filter() {
+  // A bounce of the line right after an edge is filtered out.
+  TestReceiver receiver(1000);
+  receiver.edge(2 * IDLE_US);
+  receiver.edge(500);
+  receiver.edge(3);
+  receiver.edge(3);
+  receiver.edge(994);
+  receiver.edge(500);
+  receiver.run(IDLE_US / 1000 + 1);
+  EXPECT(receiver.dumper.frames.size() == 1);
+  if (receiver.dumper.frames.size() == 1)
+    EXPECT(receiver.dumper.frames[0] == expected_frame({500, 1000, 500}));
+}
+
+static void test_overflow() {
+  // A burst longer than the ring is dropped as a whole, the frames after it are complete again.
+  std::mt19937 rng(4);
+  for (size_t burst = 63; burst < 70; burst += 2) {
+    TestReceiver receiver(64);
+    std::vector<uint32_t> durations(burst);
+    for (auto &duration : durations)
+      duration = 200 + rng() % 800;
+    receiver.send(durations);
+    receiver.run(IDLE_US / 1000 + 1);
+    EXPECT(receiver.dumper.frames.empty());
+
+    for (int i = 0; i < 10; i++) {
+      const auto frame = random_frame(rng, 3, 61);
+      receiver.send(frame);
+      receiver.run(IDLE_US / 1000 + 1);
+      EXPECT(receiver.dumper.frames.size() == 1);
+      if (receiver.dumper.frames.size() == 1)
+        EXPECT(receiver.dumper.frames[0] == expected_frame(frame));
+      receiver.dumper.frames.clear();
+    }
+  }
+}
+
+int main() {
+  esp8266_test_registers = registers;
+  test_frames();
+  test_wraparound();
+  test_queued_frames();
+  test_long_levels();
+  test_filter();
+  test_overflow();
+  return test_result();
+}
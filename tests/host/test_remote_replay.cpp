@@ -0,0 +1,88 @@
+// Captured remote codes replayed through the code table of the remote receiver: each capture has to trigger
+// exactly the receivers that parse the frame themselves (the path without the table) trigger, that is the
+// receiver configured for its code, none of the decoys with close codes, and the raw receiver of the NEC TV
+// address for the frames of that remote.
+#include "test_helpers.h"
+#include "esphome/remote/remote_receiver.cpp"
+#include "remote_captures.h"
+
+#include <map>
+
+using namespace esphome;
+
+class TestReceiverComponent : public RemoteReceiverComponent {
+ public:
+  TestReceiverComponent() : RemoteReceiverComponent(new GPIOPin(14, INPUT)) {}
+
+  using RemoteReceiverComponent::classifiers_;
+  using RemoteReceiverComponent::process_;
+};
+
+/// Count how often each receiver was triggered.
+static void count_fired(const std::vector<RemoteReceiver *> &receivers, std::map<std::string, int> *fired) {
+  for (auto *receiver : receivers) {
+    const std::string name = receiver->get_name();
+    receiver->add_on_state_callback([fired, name](bool state) {
+      if (state)
+        (*fired)[name]++;
+    });
+  }
+}
+
+static void test_replay() {
+  TestReceiverComponent component;
+  const auto receivers = make_remote_receivers();
+  for (auto *receiver : receivers)
+    component.add_decoder(receiver);
+  EXPECT(component.classifiers_.size() == REMOTE_CAPTURE_CLASSIFIERS);
+  // The same receivers, each parsing every frame.
+  const auto reference = make_remote_receivers();
+
+  std::map<std::string, int> fired, reference_fired;
+  count_fired(receivers, &fired);
+  count_fired(reference, &reference_fired);
+
+  for (const auto &capture : REMOTE_CAPTURES) {
+    std::vector<int32_t> frame(capture.data, capture.data + capture.size);
+    fired.clear();
+    reference_fired.clear();
+
+    RemoteReceiveData data(&component, &frame);
+    component.process_(&data);
+    RemoteReceiveData reference_data(&component, &frame);
+    for (auto *receiver : reference)
+      receiver->process(&reference_data);
+
+    std::map<std::string, int> expected{{capture.receiver, 1}};
+    if (std::string(capture.name).compare(0, 7, "NEC_TV_") == 0)
+      expected["nec_tv_address"] = 1;
+    EXPECT(fired == expected);
+    EXPECT(reference_fired == expected);
+    if (fired != expected) {
+      fprintf(stderr, "  %s triggered:", capture.name);
+      for (const auto &it : fired)
+        fprintf(stderr, " %s (%d)", it.first.c_str(), it.second);
+      fprintf(stderr, "\n");
+    }
+  }
+}
+
+static void test_unknown() {
+  // A frame of no configured protocol triggers nothing.
+  TestReceiverComponent component;
+  const auto receivers = make_remote_receivers();
+  for (auto *receiver : receivers)
+    component.add_decoder(receiver);
+  std::map<std::string, int> fired;
+  count_fired(receivers, &fired);
+  std::vector<int32_t> frame = {3000, -3000, 1000, -1000, 1000, -1000, 1000, -10000};
+  RemoteReceiveData data(&component, &frame);
+  component.process_(&data);
+  EXPECT(fired.empty());
+}
+
+int main() {
+  test_replay();
+  test_unknown();
+  return test_result();
+}
@@ -0,0 +1,134 @@
+// The RX side of ESP8266SoftwareSerial on synthetic edge streams: random bytes at the common baud rates, sent
+// with a clock that's off by up to 2%, edges seen by the interrupt with some latency, and the bytes read at
+// random times (also in the middle of a byte) while the CPU cycle counter wraps around.
+#include "test_helpers.h"
+#include "esphome/uart_component.cpp"
+
+#include <random>
+
+using namespace esphome;
+
+static const uint8_t PIN_RX = 3;
+
+/// The registers the RX pin reads the line level from.
+static volatile uint32_t registers[0x800 / 4];
+
+class TestSoftwareSerial : public ESP8266SoftwareSerial {
+ public:
+  using ESP8266SoftwareSerial::gpio_intr;
+};
+
+static void set_line(bool level) {
+  if (level)
+    GPI |= 1 << PIN_RX;
+  else
+    GPI &= ~(1 << PIN_RX);
+}
+
+/// Send bytes in random bursts and compare what's read, returns the number of bytes that were read.
+static size_t check_stream(uint32_t baud, std::mt19937 &rng) {
+  TestSoftwareSerial serial;
+  serial.setup(-1, PIN_RX, baud);
+  const uint32_t bit_time = F_CPU / baud;
+
+  // The sender's bit time is off by up to +-2%, the interrupt sees the edge up to 1/8 bit (at least 1us) late.
+  const double sender_bit = bit_time * (1.0 + (int(rng() % 41) - 20) / 1000.0);
+  const uint32_t max_latency = std::max<uint32_t>(bit_time / 8, F_CPU / 1000000);
+  // The cycle counter wraps around somewhere in the first 200 bits.
+  const uint32_t start = 0xFFFFFFFFUL - uint32_t(rng() % (bit_time * 200));
+  // The time since start in cycles, the last edge was seen then.
+  double now = 0;
+  double last_event = 0;
+  std::vector<uint8_t> sent, received;
+
+  auto advance = [&](double at) {
+    last_event = std::max(last_event, at);
+    test_cycle_count = start + uint32_t(uint64_t(last_event));
+  };
+  auto poll = [&](double at) {
+    advance(at);
+    while (serial.available() > 0)
+      received.push_back(serial.read_byte());
+  };
+  bool line = true;
+  set_line(true);
+  auto edge = [&](double at, bool level) {
+    if (level == line)
+      return;
+    line = level;
+    set_line(level);
+    advance(at + rng() % max_latency);
+    TestSoftwareSerial::gpio_intr(&serial);
+  };
+
+  uint8_t unpolled = 0;
+  for (int n = 0; n < 40; n++) {
+    // Bytes without edges in the data bits, with only the stop bit edge and with an edge at every bit.
+    const uint8_t special[] = {0x00, 0xFF, 0x7F, 0x55, 0xAA};
+    const uint8_t data = n < 5 ? special[n] : rng();
+    sent.push_back(data);
+    // Most of the time the loop reads the bytes while they come in.
+    const bool poll_inside = rng() % 2;
+    const double poll_at = now + (rng() % 10) * sender_bit + rng() % bit_time;
+
+    edge(now, false);
+    for (int bit = 0; bit < 9; bit++) {
+      const double at = now + sender_bit * (bit + 1);
+      if (poll_inside && poll_at >= at - sender_bit && poll_at < at)
+        poll(poll_at);
+      // The stop bit after the data bits.
+      edge(at, bit == 8 || (data >> bit) & 1);
+    }
+    now += sender_bit * 10;
+    unpolled = poll_inside ? 0 : unpolled + 1;
+    // The edge buffer holds the edges of at least 25 bytes.
+    if (unpolled == 20) {
+      poll(now);
+      unpolled = 0;
+    }
+    // Back to back or with an idle line in between.
+    if (rng() % 3 != 0)
+      now += (rng() % 4) * sender_bit + rng() % bit_time;
+  }
+  // Half a bit after the end of the last stop bit, every byte is complete.
+  poll(now + sender_bit / 2);
+
+  EXPECT(received == sent);
+  if (received != sent)
+    fprintf(stderr, "  baud=%u: sent %zu bytes, received %zu\n", baud, sent.size(), received.size());
+  return received.size();
+}
+
+static void test_partial_byte() {
+  // A byte isn't complete before its stop bit is sampled, even without an edge after the last data bit.
+  TestSoftwareSerial serial;
+  const uint32_t baud = 9600;
+  serial.setup(-1, PIN_RX, baud);
+  const uint32_t bit_time = F_CPU / baud;
+  set_line(true);
+  test_cycle_count = 1000;
+  set_line(false);
+  TestSoftwareSerial::gpio_intr(&serial);
+  test_cycle_count += bit_time;
+  set_line(true);
+  TestSoftwareSerial::gpio_intr(&serial);
+  test_cycle_count = 1000 + bit_time * 9;
+  EXPECT(serial.available() == 0);
+  test_cycle_count = 1000 + bit_time * 9 + bit_time * 2 / 3;
+  EXPECT(serial.available() == 1);
+  EXPECT(serial.read_byte() == 0xFF);
+  EXPECT(serial.available() == 0);
+}
+
+int main() {
+  esp8266_test_registers = registers;
+  std::mt19937 rng(42);
+  for (uint32_t baud : {300, 1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200}) {
+    size_t received = 0;
+    for (int trial = 0; trial < 20; trial++)
+      received += check_stream(baud, rng);
+    EXPECT(received == 20 * 40);
+  }
+  test_partial_byte();
+  return test_result();
+}
@@ -0,0 +1,198 @@
+// The step timing of the stepper engine against the ideal motion: constant acceleration up to the max speed,
+// cruise, and constant deceleration that stops exactly at the target. The steps are generated like in the
+// timer interrupt (each step is followed by the delay the engine computed) and from loop() on the simulated
+// clock, also with a profile that changes in the middle of the move.
+#include "test_helpers.h"
+#include "esphome/stepper/stepper.cpp"
+
+#include <cmath>
+#include <functional>
+
+using namespace esphome;
+using namespace esphome::stepper;
+
+class TestStepper : public Stepper {
+ public:
+  TestStepper(float acceleration, float deceleration, float max_speed) {
+    this->set_acceleration(acceleration);
+    this->set_deceleration(deceleration);
+    this->set_max_speed(max_speed);
+  }
+  using Stepper::delay_;
+  using Stepper::loop_step_engine_;
+  using Stepper::profile_;
+  using Stepper::run_step_;
+
+  /// The time and direction of each step.
+  std::vector<double> step_times;
+  std::vector<int32_t> step_dirs;
+  double now{0};
+
+ protected:
+  void on_step_(int32_t dir) override {
+    this->step_times.push_back(this->now);
+    this->step_dirs.push_back(dir);
+  }
+};
+
+struct Profile {
+  double acceleration;
+  double deceleration;
+  double max_speed;
+};
+
+/// A change of the profile after the step to position at.
+struct ProfileSwap {
+  int32_t at;
+  Profile profile;
+};
+
+/** The ideal time of each step of a move from 0 to steps.
+ *
+ * The first step is at time 0 and the last one when the motor stops, so the ideal motion covers steps - 1 and
+ * step k is at the time it passes k - 1. The acceleration and cruise are integrated numerically, the deceleration
+ * follows the braking curve v = sqrt(2 * d * remaining).
+ */
+static std::vector<double> ideal_step_times(int32_t steps, Profile profile, ProfileSwap swap) {
+  const double distance = steps - 1;
+  const double dt = 1e-6;
+  std::vector<double> times = {0};
+  double t = 0, x = 0, v = 0;
+  while (true) {
+    const Profile &p = x >= swap.at - 1 ? swap.profile : profile;
+    const double accelerated = std::min(v + p.acceleration * dt, p.max_speed);
+    const double braking = std::sqrt(2 * p.deceleration * (distance - x));
+    if (braking <= accelerated)
+      break;
+    v = accelerated;
+    x += v * dt;
+    t += dt;
+    while (times.size() < size_t(steps) && x >= times.size())
+      times.push_back(t);
+  }
+  // Decelerate from x, at the speed of the braking curve.
+  const double d = x >= swap.at - 1 ? swap.profile.deceleration : profile.deceleration;
+  const double v_brake = std::sqrt(2 * d * (distance - x));
+  while (times.size() < size_t(steps)) {
+    const double remaining = distance - times.size();
+    times.push_back(t + (v_brake - std::sqrt(2 * d * remaining)) / d);
+  }
+  return times;
+}
+
+static void set_profile(Stepper &stepper, const Profile &profile) {
+  stepper.set_acceleration(profile.acceleration);
+  stepper.set_deceleration(profile.deceleration);
+  stepper.set_max_speed(profile.max_speed);
+}
+
+/// Run the move like the timer interrupt does.
+static void run_timer(TestStepper &stepper, int32_t steps, const ProfileSwap &swap) {
+  stepper.set_target(steps);
+  uint64_t now = 0;
+  bool swapped = false;
+  for (uint32_t i = 0; i < 10 * uint32_t(steps); i++) {
+    stepper.now = now / 16e6;
+    const bool running = stepper.run_step_();
+    if (!swapped && stepper.current_position == swap.at) {
+      set_profile(stepper, swap.profile);
+      swapped = true;
+    }
+    if (!running)
+      return;
+    now += stepper.delay_ != 0 ? stepper.delay_ : stepper.profile_.first_delay;
+  }
+  EXPECT(false);
+}
+
+/// Run the move from loop() on the simulated clock, the loop takes loop_us.
+static void run_loop(TestStepper &stepper, int32_t steps, uint32_t loop_us) {
+  stepper.set_target(steps);
+  const uint32_t start = test_time_us;
+  for (uint32_t i = 0; i < 100000000 / loop_us; i++) {
+    stepper.now = (test_time_us - start) / 1e6;
+    if (!stepper.loop_step_engine_())
+      return;
+    test_time_us += loop_us;
+  }
+  EXPECT(false);
+}
+
+/** Compare the steps with the ideal ones.
+ *
+ * The first and the last delay of AVR446 are 0.676 times the ideal ones (the recurrence is inexact for the first
+ * steps, so the first delay is corrected for that), which shifts the whole move and shortens its end. Apart from
+ * that, the step times may differ by tolerance times the duration of the move.
+ */
+static void check_move(TestStepper &stepper, int32_t steps, Profile profile, ProfileSwap swap, double tolerance) {
+  EXPECT(stepper.current_position == steps);
+  EXPECT(stepper.step_times.size() == size_t(steps));
+  EXPECT(stepper.has_reached_target() && stepper.delay_ == 0);
+  for (int32_t dir : stepper.step_dirs)
+    EXPECT(dir == 1);
+  if (stepper.step_times.size() != size_t(steps))
+    return;
+
+  const std::vector<double> ideal = ideal_step_times(steps, profile, swap);
+  const double deceleration = swap.at < steps ? swap.profile.deceleration : profile.deceleration;
+  const double first_last_error =
+      (1 - 0.676) * (std::sqrt(2 / profile.acceleration) + std::sqrt(2 / deceleration));
+  const double max_error = first_last_error + tolerance * ideal.back();
+  for (int32_t i = 0; i < steps; i++)
+    EXPECT(std::fabs(stepper.step_times[i] - ideal[i]) <= max_error);
+
+  // Never faster than the max speed.
+  for (int32_t i = 1; i < steps; i++) {
+    const double max_speed = i <= swap.at ? profile.max_speed : swap.profile.max_speed;
+    EXPECT(stepper.step_times[i] - stepper.step_times[i - 1] >= 1 / max_speed - 1e-6);
+  }
+}
+
+static const ProfileSwap NO_SWAP = {0x7FFFFFFF, {}};
+
+static void test_trapezoid() {
+  // 0.5s to reach 500 steps/s in 125 steps, then cruise and the same ramp down.
+  const Profile profile = {1000, 1000, 500};
+  TestStepper stepper(profile.acceleration, profile.deceleration, profile.max_speed);
+  run_timer(stepper, 2000, NO_SWAP);
+  check_move(stepper, 2000, profile, NO_SWAP, 0.002);
+}
+
+static void test_triangle() {
+  // Never reaches the max speed, decelerates 4 times slower than it accelerates.
+  const Profile profile = {2000, 500, 10000};
+  TestStepper stepper(profile.acceleration, profile.deceleration, profile.max_speed);
+  run_timer(stepper, 1000, NO_SWAP);
+  check_move(stepper, 1000, profile, NO_SWAP, 0.002);
+}
+
+static void test_profile_swap() {
+  // Cruising at 400 steps/s, then a higher max speed and a harder deceleration.
+  const Profile profile = {1000, 1000, 400};
+  const ProfileSwap swap = {1000, {1000, 2000, 800}};
+  TestStepper stepper(profile.acceleration, profile.deceleration, profile.max_speed);
+  run_timer(stepper, 3000, swap);
+  check_move(stepper, 3000, profile, swap, 0.002);
+
+  // During the acceleration: the acceleration and max speed change.
+  const ProfileSwap accelerating = {20, {3000, 1000, 1500}};
+  TestStepper stepper2(profile.acceleration, profile.deceleration, profile.max_speed);
+  run_timer(stepper2, 3000, accelerating);
+  check_move(stepper2, 3000, profile, accelerating, 0.002);
+}
+
+static void test_loop() {
+  // From loop() each step is late by up to one loop cycle, the delays don't include that.
+  const Profile profile = {1000, 1000, 500};
+  TestStepper stepper(profile.acceleration, profile.deceleration, profile.max_speed);
+  run_loop(stepper, 2000, 16);
+  check_move(stepper, 2000, profile, NO_SWAP, 0.004);
+}
+
+int main() {
+  test_trapezoid();
+  test_triangle();
+  test_profile_swap();
+  test_loop();
+  return test_result();
+}
@@ -0,0 +1,348 @@
+// UARTFrameReader and the sensors that use it on captured byte streams: valid frames split at every possible
+// point, corrupt checksums, garbage (also garbage that looks like a header) before a frame, partial frames that
+// time out and more data than fits in the buffer. The sensors get their bytes from the hardware UART stub in
+// chunks, one chunk per loop cycle.
+#include "test_helpers.h"
+#include "esphome/uart_component.cpp"
+#include "esphome/sensor/cse7766.h"
+#include "esphome/sensor/mhz19_component.h"
+#include "esphome/sensor/sds011_component.h"
+#include "esphome/sensor/pmsx003.h"
+#include "esphome/binary_sensor/rdm6300.h"
+
+#include <cmath>
+#include <random>
+
+using namespace esphome;
+
+using bytes_t = std::vector<uint8_t>;
+
+/// Captured frames of each sensor.
+static const bytes_t CSE7766_FRAME = {0x55, 0x5A, 0x02, 0xE9, 0x50, 0x00, 0x03, 0x31, 0x00, 0x3E, 0x9E, 0x00,
+                                      0x7D, 0x3C, 0x4F, 0x44, 0xD8, 0x00, 0xAD, 0xD0, 0x71, 0x81, 0x76, 0x54};
+static const bytes_t MHZ19_FRAME = {0xFF, 0x86, 0x02, 0x60, 0x47, 0x00, 0x00, 0x00, 0xD1};
+static const bytes_t SDS011_FRAME = {0xAA, 0xC0, 0xD4, 0x00, 0xF4, 0x01, 0x12, 0x34, 0x0F, 0xAB};
+static const bytes_t PMSX003_FRAME = {0x42, 0x4D, 0x00, 0x1C, 0x00, 0x05, 0x00, 0x07, 0x00, 0x08, 0x00,
+                                      0x04, 0x00, 0x06, 0x00, 0x09, 0x03, 0xE7, 0x01, 0x2C, 0x00, 0x26,
+                                      0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x97, 0x00, 0x02, 0xAA};
+/// Card 0x00A1B2C3.
+static const bytes_t RDM6300_FRAME = {0x02, 0x30, 0x46, 0x30, 0x30, 0x41, 0x31,
+                                      0x42, 0x32, 0x43, 0x33, 0x44, 0x46, 0x03};
+static const uint32_t RDM6300_CARD = 0x00A1B2C3;
+
+static bytes_t concat(std::initializer_list<bytes_t> parts) {
+  bytes_t result;
+  for (const auto &part : parts)
+    result.insert(result.end(), part.begin(), part.end());
+  return result;
+}
+
+/// The frame with one byte changed, which breaks its checksum.
+static bytes_t corrupt(bytes_t frame, size_t index) {
+  frame[index] ^= 0x10;
+  return frame;
+}
+
+static bool approx(float a, float b) { return std::fabs(a - b) <= std::fabs(b) * 1e-4f; }
+
+/// Queue the bytes on the hardware UART in chunks of chunk bytes and run the component once per chunk, 1ms apart.
+static void stream(Component &component, const bytes_t &data, size_t chunk) {
+  for (size_t i = 0; i < data.size(); i += chunk) {
+    const size_t end = std::min(data.size(), i + chunk);
+    Serial.rx.insert(Serial.rx.end(), data.begin() + i, data.begin() + end);
+    component.loop();
+    test_time_us += 1000;
+  }
+  EXPECT(Serial.rx.empty());
+}
+
+static UARTComponent *make_uart() {
+  Serial.rx.clear();
+  Serial.tx.clear();
+  auto *uart = new UARTComponent(9600);
+  uart->setup();
+  return uart;
+}
+
+/// Records the frames the reader passes on.
+struct FrameLog {
+  void feed(UARTFrameReader &reader, const bytes_t &data) {
+    reader.feed(data.data(), data.size(), [this](const uint8_t *frame, size_t len) {
+      this->frames.emplace_back(frame, frame + len);
+    });
+  }
+
+  std::vector<bytes_t> frames;
+};
+
+static UARTFrameSpec sds011_spec() {
+  UARTFrameSpec spec;
+  spec.header = {0xAA, 0xC0};
+  spec.length = 10;
+  spec.max_length = 10;
+  spec.checksum = UART_FRAME_CHECKSUM_SUM8;
+  spec.checksum_start = 2;
+  spec.trailer = {0xAB};
+  return spec;
+}
+
+static UARTFrameSpec pmsx003_spec() {
+  UARTFrameSpec spec;
+  spec.header = {0x42, 0x4D};
+  spec.length_offset = 2;
+  spec.length = 4;
+  spec.max_length = 40;
+  spec.checksum = UART_FRAME_CHECKSUM_SUM16;
+  return spec;
+}
+
+static void test_feed_splits() {
+  // Two frames back to back, split in two at every position.
+  for (const auto &spec : {sds011_spec(), pmsx003_spec()}) {
+    const bytes_t &frame = spec.length_offset < 0 ? SDS011_FRAME : PMSX003_FRAME;
+    const bytes_t data = concat({frame, frame});
+    for (size_t split = 0; split <= data.size(); split++) {
+      UARTFrameReader reader(nullptr, spec);
+      FrameLog log;
+      log.feed(reader, bytes_t(data.begin(), data.begin() + split));
+      log.feed(reader, bytes_t(data.begin() + split, data.end()));
+      EXPECT(log.frames.size() == 2);
+      for (const auto &found : log.frames)
+        EXPECT(found == frame);
+    }
+  }
+
+  // Random chunks of a long stream.
+  std::mt19937 rng(40);
+  UARTFrameReader reader(nullptr, pmsx003_spec());
+  FrameLog log;
+  bytes_t data;
+  for (int i = 0; i < 50; i++)
+    data = concat({data, PMSX003_FRAME});
+  for (size_t i = 0; i < data.size();) {
+    const size_t n = std::min(data.size() - i, size_t(rng() % 40));
+    log.feed(reader, bytes_t(data.begin() + i, data.begin() + i + n));
+    i += n;
+  }
+  EXPECT(log.frames.size() == 50);
+}
+
+static void test_feed_checksums() {
+  // Every corrupt byte after the header drops the frame, the next frame is found.
+  for (size_t i = 2; i < SDS011_FRAME.size(); i++) {
+    UARTFrameReader reader(nullptr, sds011_spec());
+    FrameLog log;
+    log.feed(reader, concat({corrupt(SDS011_FRAME, i), SDS011_FRAME}));
+    EXPECT(log.frames.size() == 1 && log.frames[0] == SDS011_FRAME);
+  }
+  for (size_t i = 4; i < PMSX003_FRAME.size(); i++) {
+    UARTFrameReader reader(nullptr, pmsx003_spec());
+    FrameLog log;
+    log.feed(reader, concat({corrupt(PMSX003_FRAME, i), PMSX003_FRAME}));
+    EXPECT(log.frames.size() == 1 && log.frames[0] == PMSX003_FRAME);
+  }
+}
+
+static void test_feed_garbage() {
+  // Random garbage, and garbage that starts like a frame: a header without the rest, a header with a length
+  // longer than the maximum and a header with a length that's too short.
+  std::mt19937 rng(41);
+  bytes_t noise(200);
+  for (auto &b : noise)
+    b = rng();
+  const std::vector<bytes_t> garbage = {noise, {0xAA}, {0xAA, 0xC0, 0x00}, {0x42, 0x4D, 0xFF, 0xFF},
+                                        {0x42, 0x4D, 0x00, 0x00}, {0x42, 0x42, 0x4D}};
+  for (const auto &before : garbage) {
+    UARTFrameReader sds011(nullptr, sds011_spec());
+    FrameLog sds011_log;
+    sds011_log.feed(sds011, concat({before, SDS011_FRAME, before, SDS011_FRAME}));
+    EXPECT(sds011_log.frames.size() == 2);
+
+    UARTFrameReader pmsx003(nullptr, pmsx003_spec());
+    FrameLog pmsx003_log;
+    pmsx003_log.feed(pmsx003, concat({before, PMSX003_FRAME, before, PMSX003_FRAME}));
+    EXPECT(pmsx003_log.frames.size() == 2);
+  }
+}
+
+static void test_spec_validation() {
+  // A fixed-size frame longer than max_length still fits in the buffer.
+  UARTFrameSpec spec = sds011_spec();
+  spec.max_length = 4;
+  UARTFrameReader fixed(nullptr, spec);
+  FrameLog fixed_log;
+  fixed_log.feed(fixed, concat({SDS011_FRAME, SDS011_FRAME}));
+  EXPECT(fixed_log.frames.size() == 2);
+
+  // A buffer too short for the length field would wait for it forever, all frames are too long for it.
+  spec = pmsx003_spec();
+  spec.max_length = 3;
+  UARTFrameReader length_field(nullptr, spec);
+  FrameLog length_field_log;
+  length_field_log.feed(length_field, concat({PMSX003_FRAME, PMSX003_FRAME}));
+  EXPECT(length_field_log.frames.empty());
+}
+
+static void test_read() {
+  UARTComponent *uart = make_uart();
+  UARTFrameReader reader(uart, sds011_spec());
+  size_t frames = 0;
+  auto count = [&frames](const uint8_t *frame, size_t len) { frames++; };
+
+  // Much more data than fits in the buffer at once.
+  std::mt19937 rng(42);
+  for (int i = 0; i < 1000; i++)
+    Serial.rx.push_back(rng() & 0x7F);
+  Serial.rx.insert(Serial.rx.end(), SDS011_FRAME.begin(), SDS011_FRAME.end());
+  reader.read(count);
+  EXPECT(Serial.rx.empty() && frames == 1);
+
+  // A partial frame is dropped after the timeout, so its rest doesn't make a frame with the next one.
+  Serial.rx.insert(Serial.rx.end(), SDS011_FRAME.begin(), SDS011_FRAME.begin() + 5);
+  reader.read(count);
+  test_time_us += 600000;
+  Serial.rx.insert(Serial.rx.end(), SDS011_FRAME.begin() + 5, SDS011_FRAME.end());
+  Serial.rx.insert(Serial.rx.end(), SDS011_FRAME.begin(), SDS011_FRAME.end());
+  reader.read(count);
+  EXPECT(frames == 2);
+
+  // A partial frame within the timeout is completed.
+  Serial.rx.insert(Serial.rx.end(), SDS011_FRAME.begin(), SDS011_FRAME.begin() + 5);
+  reader.read(count);
+  test_time_us += 100000;
+  Serial.rx.insert(Serial.rx.end(), SDS011_FRAME.begin() + 5, SDS011_FRAME.end());
+  reader.read(count);
+  EXPECT(frames == 3);
+  delete uart;
+}
+
+/// The states a sensor published.
+template<typename T> static std::vector<float> *record(T *sensor) {
+  auto *states = new std::vector<float>();
+  sensor->add_on_state_callback([states](float state) { states->push_back(state); });
+  return states;
+}
+
+static void test_cse7766() {
+  UARTComponent *uart = make_uart();
+  sensor::CSE7766Component cse7766(uart);
+  auto *voltage = cse7766.make_voltage_sensor("Voltage");
+  auto *current = cse7766.make_current_sensor("Current");
+  auto *power = cse7766.make_power_sensor("Power");
+  // The chip sends a frame every 50ms, the reader gets them with garbage in between and in chunks of 7 bytes.
+  // The corrupt frames would change the averages.
+  const bytes_t data = concat({{0x00, 0x5A, 0x13}, CSE7766_FRAME, corrupt(CSE7766_FRAME, 3), CSE7766_FRAME,
+                               corrupt(CSE7766_FRAME, 20), {0x55}, CSE7766_FRAME});
+  stream(cse7766, data, 7);
+  cse7766.update();
+  EXPECT(approx(voltage->state, 233.537f));
+  EXPECT(approx(current->state, 0.5f));
+  EXPECT(approx(power->state, 116.751f));
+
+  // An invalid first header byte drops the frame.
+  bytes_t bad_header = CSE7766_FRAME;
+  bad_header[0] = 0x12;
+  stream(cse7766, bad_header, 24);
+  EXPECT(cse7766.status_has_warning());
+  stream(cse7766, CSE7766_FRAME, 1);
+  EXPECT(!cse7766.status_has_warning());
+  cse7766.update();
+  EXPECT(approx(voltage->state, 233.537f));
+  delete uart;
+}
+
+static void test_mhz19() {
+  UARTComponent *uart = make_uart();
+  sensor::MHZ19Component mhz19(uart, "CO2");
+  auto *temperature = mhz19.make_temperature_sensor("Temperature");
+  auto *co2_states = record(mhz19.get_co2_sensor());
+
+  // The response of the previous request that came in too late is dropped with the request.
+  Serial.rx.insert(Serial.rx.end(), MHZ19_FRAME.begin(), MHZ19_FRAME.begin() + 4);
+  mhz19.update();
+  const bytes_t request = {0xFF, 0x01, 0x86, 0x00, 0x00, 0x00, 0x00, 0x00, 0x79};
+  EXPECT(Serial.tx == request);
+  Serial.rx.clear();
+  stream(mhz19, concat({{0x00, 0xFF}, MHZ19_FRAME}), 4);
+  EXPECT(co2_states->size() == 1 && (*co2_states)[0] == 608.0f);
+  EXPECT(temperature->state == 31.0f);
+
+  // A corrupt response is dropped and reported as a missing response with the next request.
+  mhz19.update();
+  stream(mhz19, corrupt(MHZ19_FRAME, 3), 9);
+  EXPECT(co2_states->size() == 1);
+  mhz19.update();
+  EXPECT(mhz19.status_has_warning());
+  delete co2_states;
+  delete uart;
+}
+
+static void test_sds011() {
+  UARTComponent *uart = make_uart();
+  sensor::SDS011Component sds011(uart, 1);
+  auto *pm_2_5 = sds011.make_pm_2_5_sensor("PM2.5");
+  auto *pm_10_0 = sds011.make_pm_10_0_sensor("PM10");
+  auto *pm_2_5_states = record(pm_2_5);
+  sds011.setup();
+  // Active reporting and the working period.
+  EXPECT(Serial.tx.size() == 38 && Serial.tx[1] == 0xB4 && Serial.tx[2] == 0x02 && Serial.tx[18] == 0xAB);
+  EXPECT(Serial.tx[20] == 0xB4 && Serial.tx[21] == 0x08 && Serial.tx[23] == 1);
+
+  stream(sds011, concat({{0xAA, 0xAA}, SDS011_FRAME, corrupt(SDS011_FRAME, 4), {0xAB}, SDS011_FRAME}), 3);
+  EXPECT(pm_2_5_states->size() == 2);
+  EXPECT(approx(pm_2_5->state, 21.2f));
+  EXPECT(approx(pm_10_0->state, 50.0f));
+  delete pm_2_5_states;
+  delete uart;
+}
+
+static void test_pmsx003() {
+  UARTComponent *uart = make_uart();
+  sensor::PMSX003Component pmsx003(uart, sensor::PMSX003_TYPE_X003);
+  auto *pm_1_0 = pmsx003.make_pm_1_0_sensor("PM1.0");
+  auto *pm_2_5 = pmsx003.make_pm_2_5_sensor("PM2.5");
+  auto *pm_10_0 = pmsx003.make_pm_10_0_sensor("PM10");
+  auto *pm_2_5_states = record(pm_2_5);
+
+  // A header with a length that's too long, a corrupt frame and a frame cut short by the next one.
+  const bytes_t truncated(PMSX003_FRAME.begin(), PMSX003_FRAME.begin() + 20);
+  stream(pmsx003, concat({{0x42, 0x4D, 0x7F, 0x00}, PMSX003_FRAME, corrupt(PMSX003_FRAME, 13), truncated,
+                          PMSX003_FRAME}), 5);
+  EXPECT(pm_2_5_states->size() == 2);
+  EXPECT(pm_1_0->state == 4.0f && pm_2_5->state == 6.0f && pm_10_0->state == 9.0f);
+  delete pm_2_5_states;
+  delete uart;
+}
+
+static void test_rdm6300() {
+  UARTComponent *uart = make_uart();
+  binary_sensor::RDM6300Component rdm6300(uart);
+  auto *card = rdm6300.make_card("Card", RDM6300_CARD);
+  auto *other = rdm6300.make_card("Other Card", RDM6300_CARD + 1);
+  std::vector<bool> states, other_states;
+  card->add_on_state_callback([&states](bool state) { states.push_back(state); });
+  other->add_on_state_callback([&other_states](bool state) { other_states.push_back(state); });
+
+  // A frame with a wrong XOR checksum, a read cut short by the next one and a good read.
+  bytes_t bad_xor = RDM6300_FRAME;
+  bad_xor[12] = '0';
+  const bytes_t truncated(RDM6300_FRAME.begin(), RDM6300_FRAME.begin() + 6);
+  stream(rdm6300, concat({{0x03, 0x41}, bad_xor, truncated, RDM6300_FRAME}), 4);
+  EXPECT(states == std::vector<bool>({true, false}));
+  EXPECT(other_states.empty());
+  delete uart;
+}
+
+int main() {
+  test_feed_splits();
+  test_feed_checksums();
+  test_feed_garbage();
+  test_spec_validation();
+  test_read();
+  test_cse7766();
+  test_mhz19();
+  test_sds011();
+  test_pmsx003();
+  test_rdm6300();
+  return test_result();
+}